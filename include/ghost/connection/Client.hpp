@@ -47,6 +47,15 @@ public:
 	}
 
 	virtual ~Client() = default;
+
+	/// @return the statistics of the transport and of the queues of this client.
+	ghost::ConnectionStatistics getStatistics() const override
+	{
+		ghost::ConnectionStatistics statistics = getTransportStatistics();
+		addReaderStatistics(statistics);
+		addWriterStatistics(statistics);
+		return statistics;
+	}
 };
 } // namespace ghost
 
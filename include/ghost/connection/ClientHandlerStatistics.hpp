@@ -0,0 +1,44 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_CLIENTHANDLERSTATISTICS_HPP
+#define GHOST_CLIENTHANDLERSTATISTICS_HPP
+
+#include <cstddef>
+#include <ghost/connection/LatencyStatistics.hpp>
+
+namespace ghost
+{
+/**
+ * @brief Counters describing how a server keeps up with the clients it accepts.
+ *
+ * Servers running the ghost::ClientHandler on a bounded pool of threads queue the accepted clients
+ * until a thread is available.
+ */
+struct ClientHandlerStatistics
+{
+	/// number of accepted clients currently waiting for a thread of the client handler.
+	size_t pendingClients = 0;
+	/// highest number of accepted clients that waited for a thread at the same time.
+	size_t pendingClientsPeak = 0;
+	/// number of accepted clients disconnected because too many clients were waiting.
+	size_t rejectedClients = 0;
+	/// time between the acceptance of the clients and the call of the client handler.
+	LatencyPercentiles acceptToHandle = LatencyPercentiles();
+};
+} // namespace ghost
+
+#endif // GHOST_CLIENTHANDLERSTATISTICS_HPP
@@ -17,6 +17,8 @@
 #ifndef GHOST_CONNECTION_HPP
 #define GHOST_CONNECTION_HPP
 
+#include <ghost/connection/ConnectionStatistics.hpp>
+
 namespace ghost
 {
 /**
@@ -52,6 +54,28 @@ public:
 	 * @return	true if the connection is currently running, false otherwise.
 	 */
 	virtual bool isRunning() const = 0;
+
+	/**
+	 * Gets the counters of the traffic, of the queues and of the transport of this connection.
+	 * The counters are collected with relaxed atomic operations and can be queried at any time.
+	 * @return a snapshot of the statistics of this connection.
+	 */
+	virtual ghost::ConnectionStatistics getStatistics() const
+	{
+		return getTransportStatistics();
+	}
+
+protected:
+	/**
+	 * Implementations override this method to report the counters of their transport, such as
+	 * the reconnections and the state transitions. The counters of the reader and writer queues
+	 * are added by the readable and writable connections.
+	 * @return the statistics of the transport, zero values by default.
+	 */
+	virtual ghost::ConnectionStatistics getTransportStatistics() const
+	{
+		return ghost::ConnectionStatistics();
+	}
 };
 } // namespace ghost
 
@@ -17,6 +17,7 @@
 #ifndef GHOST_CONNECTIONCONFIGURATION_HPP
 #define GHOST_CONNECTIONCONFIGURATION_HPP
 
+#include <chrono>
 #include <ghost/connection/Configuration.hpp>
 #include <memory>
 #include <string>
@@ -29,6 +30,38 @@ namespace ghost
 class ConnectionConfiguration
 {
 public:
+	/**
+	 *	Backends available to queue the messages between the readers/writers and the
+	 *	connection.
+	 */
+	enum class QueueType
+	{
+		/// unbounded queue protected by a mutex, supports any number of threads (default).
+		BLOCKING_QUEUE,
+		/// lock-free bounded ring buffer for one producing thread and one consuming thread. Only the
+		/// reader queues, filled by their connection alone, use it: the writer queues, which any thread
+		/// may write to, use MPSC_RING_BUFFER instead.
+		SPSC_RING_BUFFER,
+		/// lock-free bounded ring buffer for several producing threads and one consuming thread.
+		MPSC_RING_BUFFER
+	};
+
+	/**
+	 *	Behavior of a reader or writer queue when it reached its maximum depth.
+	 */
+	enum class OverflowPolicy
+	{
+		/// waits for space in the queue, up to the overflow timeout, then fails the operation (default).
+		BLOCK,
+		/// removes the oldest message of the queue to make space for the new one. Ring buffers do not
+		/// support this policy and drop the new message instead.
+		DROP_OLDEST,
+		/// drops the new message, the write operation still succeeds.
+		DROP_NEWEST,
+		/// drops the new message and fails the write operation.
+		FAIL
+	};
+
 	ConnectionConfiguration(const std::string& name = "");
 	virtual ~ConnectionConfiguration() = default;
 
@@ -48,6 +81,66 @@ public:
 	 */
 	bool isOperationBlocking() const;
 
+	/**
+	 * @return the type of queue used by the readers and writers of the connection.
+	 */
+	QueueType getQueueType() const;
+
+	/**
+	 * @return the number of preallocated slots of the ring buffers. This value is not
+	 * used if the queue type is QueueType::BLOCKING_QUEUE.
+	 */
+	size_t getQueueCapacity() const;
+
+	/**
+	 * @return the maximum number of messages waiting to be read, zero if it is not limited.
+	 */
+	size_t getReaderQueueDepth() const;
+
+	/**
+	 * @return the maximum number of messages waiting to be sent, zero if it is not limited.
+	 */
+	size_t getWriterQueueDepth() const;
+
+	/**
+	 * @return the behavior of the reader queue when it is full.
+	 */
+	OverflowPolicy getReaderOverflowPolicy() const;
+
+	/**
+	 * @return the behavior of the writer queue when it is full.
+	 */
+	OverflowPolicy getWriterOverflowPolicy() const;
+
+	/**
+	 * @return how long OverflowPolicy::BLOCK waits for space in a queue. A negative value means
+	 * that it waits as long as necessary.
+	 */
+	std::chrono::milliseconds getOverflowTimeout() const;
+
+	/**
+	 * @return the size in bytes of the arenas in which message handlers parse incoming protobuf
+	 * messages, zero if the messages are not allocated in arenas.
+	 */
+	size_t getMessageArenaSize() const;
+
+	/**
+	 * @return the number of threads calling the message handlers, zero if the handlers are
+	 * called by the threads of the connection.
+	 */
+	size_t getHandlerThreadCount() const;
+
+	/**
+	 * @return true if the connection traces the latency of its messages, false otherwise.
+	 */
+	bool isLatencyTracingEnabled() const;
+
+	/**
+	 * @return the number of messages of a priority class sent for each message of the next
+	 * lower class while both have messages waiting, zero if the priority is strict.
+	 */
+	size_t getPriorityWeight() const;
+
 	/**
 	 * @param id the ID of the connection
 	 */
@@ -63,6 +156,82 @@ public:
 	 */
 	void setOperationBlocking(bool value);
 
+	/**
+	 * Ring buffers require a single consuming thread: a connection may only use them
+	 * if its messages are read by one thread at a time. With QueueType::SPSC_RING_BUFFER,
+	 * the messages must also be put into the reader sink by one thread at a time.
+	 * @param type the type of queue used by the readers and writers of the connection.
+	 */
+	void setQueueType(QueueType type);
+
+	/**
+	 * @param capacity the number of slots of the ring buffers, rounded up to the next power of two.
+	 * Writers block while the ring buffer is full.
+	 */
+	void setQueueCapacity(size_t capacity);
+
+	/**
+	 * @param depth the maximum number of messages waiting to be read, zero to not limit it.
+	 */
+	void setReaderQueueDepth(size_t depth);
+
+	/**
+	 * @param depth the maximum number of messages waiting to be sent, zero to not limit it.
+	 */
+	void setWriterQueueDepth(size_t depth);
+
+	/**
+	 * @param policy the behavior of the reader queue when it is full.
+	 */
+	void setReaderOverflowPolicy(OverflowPolicy policy);
+
+	/**
+	 * @param policy the behavior of the writer queue when it is full.
+	 */
+	void setWriterOverflowPolicy(OverflowPolicy policy);
+
+	/**
+	 * @param timeout how long OverflowPolicy::BLOCK waits for space in a queue, negative to wait as
+	 * long as necessary.
+	 */
+	void setOverflowTimeout(std::chrono::milliseconds timeout);
+
+	/**
+	 * Protobuf messages passed to message handlers are then allocated in an arena which is
+	 * recycled once the handler returns, or once the handler threads processed the batch of
+	 * messages they took from their queue: handlers must copy the messages they want to keep.
+	 * @param size the size in bytes of the initial block of the arenas, zero to allocate the
+	 * messages individually (default).
+	 */
+	void setMessageArenaSize(size_t size);
+
+	/**
+	 * Message handlers are then called by their own threads instead of the threads of the
+	 * connection, which keep receiving messages while the handlers run. Each handler thread
+	 * has a queue with the depth and overflow policy of the reader queue.
+	 * @param count the number of threads calling the message handlers, zero to call them from
+	 * the threads of the connection (default).
+	 */
+	void setHandlerThreadCount(size_t count);
+
+	/**
+	 * Written messages then carry the time at which they went through each stage of their
+	 * delivery, and the reading connection measures the latency of these stages, see
+	 * ghost::ReadableConnection::getLatencyStatistics. This adds a few dozen bytes and some
+	 * processing to every message.
+	 * @param enabled true to trace the latency of the messages, false otherwise (default).
+	 */
+	void setLatencyTracingEnabled(bool enabled);
+
+	/**
+	 * Connections always send the messages of the higher priority classes first (see
+	 * ghost::MessagePriority). To keep the lower classes from starving, a class that sent
+	 * "weight" messages while the next lower class had messages waiting lets one of them through.
+	 * @param weight the number of messages of a class sent for each message of the next lower
+	 * class (default: 8), zero to always send the higher classes first.
+	 */
+	void setPriorityWeight(size_t weight);
+
 	/**
 	 *	@return the configuration used by this object.
 	 */
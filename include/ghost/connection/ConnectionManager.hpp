@@ -20,6 +20,7 @@
 #include <ghost/connection/Client.hpp>
 #include <ghost/connection/ConnectionConfiguration.hpp>
 #include <ghost/connection/ConnectionFactory.hpp>
+#include <ghost/connection/ConnectionStatistics.hpp>
 #include <ghost/connection/Publisher.hpp>
 #include <ghost/connection/Server.hpp>
 #include <ghost/connection/Subscriber.hpp>
@@ -57,6 +58,16 @@ public:
 	 * @return the connection factory of this connection manager.
 	 */
 	virtual std::shared_ptr<ghost::ConnectionFactory> getConnectionFactory() = 0;
+
+	/**
+	 * @brief Aggregates the statistics of the connections managed by this connection manager.
+	 *
+	 * The counters of the connections are summed, the peak queue depths are the highest peak
+	 * depths of the connections. Connections that were stopped and released are not included.
+	 *
+	 * @return the sum of the statistics of the managed connections.
+	 */
+	virtual ghost::ConnectionStatistics getStatistics() const = 0;
 };
 } // namespace ghost
 
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_CONNECTIONSTATISTICS_HPP
+#define GHOST_CONNECTIONSTATISTICS_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+namespace ghost
+{
+/**
+ * @brief Counters describing the traffic and the health of a connection.
+ *
+ * The counters are maintained with relaxed atomic operations: a snapshot taken while the
+ * connection is running is not guaranteed to be consistent across the fields.
+ * Statistics of several connections can be summed with operator+=, in which case the peak
+ * depths are the maximum of the peak depths of the connections.
+ */
+struct ConnectionStatistics
+{
+	/// number of messages received by the connection.
+	size_t messagesIn = 0;
+	/// size of the payload of the received messages, in bytes.
+	size_t bytesIn = 0;
+	/// number of messages taken from the writer queue by the connection to be sent.
+	size_t messagesOut = 0;
+	/// size of the payload of the messages taken to be sent, in bytes.
+	size_t bytesOut = 0;
+	/// number of messages currently waiting in the reader queue.
+	size_t readerQueueDepth = 0;
+	/// highest number of messages that waited in the reader queue at the same time.
+	size_t readerQueuePeakDepth = 0;
+	/// number of messages currently waiting in the writer queue.
+	size_t writerQueueDepth = 0;
+	/// highest number of messages that waited in the writer queue at the same time.
+	size_t writerQueuePeakDepth = 0;
+	/// number of messages dropped or rejected because the reader or the writer queue was full.
+	size_t droppedMessages = 0;
+	/// number of written messages replaced in the writer queue by a newer message with the same conflation key.
+	size_t conflatedMessages = 0;
+	/// number of written messages that were not sent because the connection stopped or failed.
+	size_t writeFailures = 0;
+	/// number of times the transport established its connection again after losing it.
+	size_t reconnects = 0;
+	/// number of state changes of the underlying transport, for instance of the gRPC calls.
+	size_t stateTransitions = 0;
+
+	ConnectionStatistics& operator+=(const ConnectionStatistics& other)
+	{
+		messagesIn += other.messagesIn;
+		bytesIn += other.bytesIn;
+		messagesOut += other.messagesOut;
+		bytesOut += other.bytesOut;
+		readerQueueDepth += other.readerQueueDepth;
+		readerQueuePeakDepth = std::max(readerQueuePeakDepth, other.readerQueuePeakDepth);
+		writerQueueDepth += other.writerQueueDepth;
+		writerQueuePeakDepth = std::max(writerQueuePeakDepth, other.writerQueuePeakDepth);
+		droppedMessages += other.droppedMessages;
+		conflatedMessages += other.conflatedMessages;
+		writeFailures += other.writeFailures;
+		reconnects += other.reconnects;
+		stateTransitions += other.stateTransitions;
+		return *this;
+	}
+};
+} // namespace ghost
+
+#endif // GHOST_CONNECTIONSTATISTICS_HPP
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_LATENCYSTATISTICS_HPP
+#define GHOST_LATENCYSTATISTICS_HPP
+
+#include <chrono>
+#include <cstddef>
+
+namespace ghost
+{
+/**
+ * @brief Distribution of the time spent by messages in one stage of their delivery.
+ *
+ * The percentiles are approximated within 4% of their exact value.
+ */
+struct LatencyPercentiles
+{
+	/// number of measured messages.
+	size_t samples;
+	/// median duration.
+	std::chrono::nanoseconds p50;
+	/// duration that 99% of the messages did not exceed.
+	std::chrono::nanoseconds p99;
+	/// duration that 99.9% of the messages did not exceed.
+	std::chrono::nanoseconds p999;
+};
+
+/**
+ * @brief Latency of the messages received by a connection, split into the stages of their delivery.
+ *
+ * Messages are only traced if both the writing and the reading connections enable the latency
+ * tracing, see ghost::ConnectionConfiguration::setLatencyTracingEnabled. A stage is not measured
+ * for the messages of transports that do not report it.
+ */
+struct LatencyStatistics
+{
+	/// from the write call to the hand-off to the transport: the time spent in the writer queue.
+	LatencyPercentiles writerQueue;
+	/// from the hand-off to the reception. Assumes synchronized clocks if the writer runs on another host.
+	LatencyPercentiles network;
+	/// from the reception to the call of the message handler: the time spent in the reader queues.
+	LatencyPercentiles readerQueue;
+	/// execution time of the message handler.
+	LatencyPercentiles handler;
+	/// from the write call to the return of the message handler.
+	LatencyPercentiles endToEnd;
+};
+} // namespace ghost
+
+#endif // GHOST_LATENCYSTATISTICS_HPP
@@ -17,6 +17,9 @@
 #ifndef GHOST_MESSAGEHANDLER_HPP
 #define GHOST_MESSAGEHANDLER_HPP
 
+#include <google/protobuf/any.pb.h>
+
+#include <chrono>
 #include <functional>
 #include <ghost/connection/internal/MessageHandlerCallback.hpp>
 #include <memory>
@@ -36,12 +39,35 @@ namespace ghost
 class MessageHandler
 {
 public:
+	/**
+	 * @brief Metrics of the dispatch of the messages to the handler threads.
+	 *
+	 * All the values are zero if the handlers are called by the threads of the connection,
+	 * see ghost::ConnectionConfiguration::setHandlerThreadCount.
+	 */
+	struct DispatchMetrics
+	{
+		/// number of messages waiting for a handler thread.
+		size_t backlog;
+		/// number of messages processed by the handler threads.
+		size_t handledMessages;
+		/// time spent in the handlers.
+		std::chrono::nanoseconds totalHandlerTime;
+		/// longest time spent in a handler for one message.
+		std::chrono::nanoseconds maximumHandlerTime;
+	};
+
 	virtual ~MessageHandler() = default;
 
 	/**
 	 * @brief Adds a handler that processes messages of the templated type.
 	 *
 	 * If a handler already exists for the given message type, it will be replaced.
+	 * Handlers are called by the threads of the connection, or by handler threads if the
+	 * connection is configured with a handler thread count.
+	 * The message passed to the handler is only valid until the handler returns: if the
+	 * connection is configured with a message arena size, it is allocated in an arena that
+	 * is reused for the next messages.
 	 *
 	 * @tparam MessageType the type of messages handled by this handler
 	 * @param handler the handler that can handle the messages of this type
@@ -53,6 +79,23 @@ public:
 								ghost::Message>::type* = nullptr>
 	void addHandler(std::function<void(const MessageType& message)> handler);
 
+	/**
+	 * @brief Sets the function computing the ordering key of the incoming messages.
+	 *
+	 * If the connection uses handler threads, messages with the same key are handled in
+	 * order by the same thread, and messages with different keys may be handled in parallel.
+	 * By default, messages are ordered per type. This must be called before messages are
+	 * received.
+	 *
+	 * @param key function returning the ordering key of a message
+	 */
+	virtual void setOrderingKey(std::function<size_t(const google::protobuf::Any& message)> key) = 0;
+
+	/**
+	 * @return the metrics of the dispatch of the messages to the handler threads.
+	 */
+	virtual DispatchMetrics getDispatchMetrics() const = 0;
+
 protected:
 	// the following contains internal implementation detail. Please do not rely on this in your code.
 
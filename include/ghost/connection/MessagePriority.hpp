@@ -0,0 +1,41 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_MESSAGEPRIORITY_HPP
+#define GHOST_MESSAGEPRIORITY_HPP
+
+namespace ghost
+{
+/**
+ * @brief Priority class of the messages written by a ghost::Writer.
+ *
+ * Each class has its own lane in the writer queue of the connection. Connections send the
+ * messages of the higher classes first, and give the lower classes a share of the bandwidth
+ * set by ghost::ConnectionConfiguration::setPriorityWeight so that they are not starved.
+ * The order of the messages is only kept within a class.
+ */
+enum class MessagePriority
+{
+	/// bulk data, sent when the other classes leave bandwidth.
+	LOW = 0,
+	/// default class of the writers.
+	NORMAL = 1,
+	/// control messages such as heartbeats and commands, sent before the other classes.
+	HIGH = 2
+};
+} // namespace ghost
+
+#endif // GHOST_MESSAGEPRIORITY_HPP
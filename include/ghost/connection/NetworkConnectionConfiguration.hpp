@@ -28,7 +28,8 @@ namespace ghost
  * This connection configuration contains additional required parameters
  * for network connections:
  * - The IP address of the target connection
- * - the port number to reach.
+ * - the port number to reach
+ * - or, alternatively, the path of a Unix domain socket.
  */
 class NetworkConnectionConfiguration : public ghost::ConnectionConfiguration
 {
@@ -54,6 +55,14 @@ public:
 	 * @return the requested port number
 	 */
 	int getServerPortNumber() const;
+	/**
+	 * @brief Accessor for the path of the Unix domain socket of the target connection.
+	 * When this path is set, connections supporting Unix domain sockets use it instead
+	 * of the IP address and the port number.
+	 *
+	 * @return the requested socket path, or an empty string if the connection uses TCP
+	 */
+	std::string getUnixSocketPath() const;
 
 	/**
 	 * @brief Set the IP address of the target connection
@@ -67,6 +76,12 @@ public:
 	 * @param port the new port number to set
 	 */
 	void setServerPortNumber(int port);
+	/**
+	 * @brief Set the path of the Unix domain socket of the target connection
+	 *
+	 * @param path the new socket path to set, or an empty string to use TCP
+	 */
+	void setUnixSocketPath(const std::string& path);
 
 	/**
 	 * @brief Creates a network connection configuration from a connection
@@ -18,7 +18,14 @@
 #define GHOST_PUBLISHER_HPP
 
 #include <ghost/connection/Connection.hpp>
+#include <ghost/connection/SubscriberLag.hpp>
 #include <ghost/connection/WritableConnection.hpp>
+#include <ghost/connection/internal/ConflationKeys.hpp>
+#include <ghost/connection/internal/ProtobufMessage.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace ghost
 {
@@ -34,15 +41,83 @@ namespace ghost
  *
  * Particular implementations of Connection classes may define new connection
  * parameters which can be passed through the ConnectionConfiguration.
+ *
+ * Message types representing a state, for instance the position of an entity, can
+ * be conflated with setConflationKey: the pending messages then only keep the last
+ * value of every key.
  */
 class Publisher : public ghost::Connection, public ghost::WritableConnection
 {
 public:
-	Publisher(const ghost::ConnectionConfiguration& configuration) : ghost::WritableConnection(configuration)
+	Publisher(const ghost::ConnectionConfiguration& configuration)
+	    : ghost::WritableConnection(configuration)
+	    , _conflationKeys(std::make_shared<ghost::internal::ConflationKeys>())
 	{
+		setConflationKeys(_conflationKeys);
 	}
 
 	virtual ~Publisher() = default;
+
+	/// @return the statistics of the transport and of the queues of this publisher.
+	ghost::ConnectionStatistics getStatistics() const override
+	{
+		ghost::ConnectionStatistics statistics = getTransportStatistics();
+		addWriterStatistics(statistics);
+		return statistics;
+	}
+
+	/**
+	 * @brief Returns how far each connected subscriber is behind the published messages, in the
+	 * order in which the subscribers connected. Publishers that do not keep one queue per subscriber
+	 * return an empty list.
+	 *
+	 * @return the lag of every subscriber
+	 */
+	virtual std::vector<ghost::SubscriberLag> getSubscriberLags() const
+	{
+		return std::vector<ghost::SubscriberLag>();
+	}
+
+	/**
+	 * @brief Conflates the messages of the templated type by the key returned by "key".
+	 *
+	 * A message that is written while a message with the same key still waits to be sent
+	 * to a subscriber replaces it in place: the queues keep at most one message per key, and
+	 * the writer of the replaced message is told that it was not sent. The messages of the
+	 * other types are not affected. This must be called before the publisher is started.
+	 *
+	 * @tparam MessageType the type of the conflated messages
+	 * @param key function returning the key of a message, for instance the identifier of an entity
+	 */
+	template <typename MessageType,
+		  typename std::enable_if<!std::is_base_of<ghost::Message, MessageType>::value, void>::type* = nullptr>
+	void setConflationKey(std::function<std::string(const MessageType& message)> key)
+	{
+		_conflationKeys->add(ghost::internal::GHOSTMESSAGE_FORMAT_NAME, MessageType::descriptor()->full_name(),
+				     std::unique_ptr<ghost::internal::BaseConflationKeyExtractor>(
+					 new ghost::internal::ConflationKeyExtractor<MessageType>(key)));
+	}
+
+	/// Implementation for ghost::Message
+	template <typename MessageType, typename std::enable_if<std::is_base_of<ghost::Message, MessageType>::value,
+								ghost::Message>::type* = nullptr>
+	void setConflationKey(std::function<std::string(const MessageType& message)> key)
+	{
+		auto msg = MessageType();
+		_conflationKeys->add(msg.getMessageFormatName(), msg.getMessageTypeName(),
+				     std::unique_ptr<ghost::internal::BaseConflationKeyExtractor>(
+					 new ghost::internal::ConflationKeyExtractor<MessageType>(key)));
+	}
+
+protected:
+	/// @return the conflated message types, to be shared with the writer queues of the subscribers.
+	std::shared_ptr<const ghost::internal::ConflationKeys> getConflationKeys() const
+	{
+		return _conflationKeys;
+	}
+
+private:
+	std::shared_ptr<ghost::internal::ConflationKeys> _conflationKeys;
 };
 } // namespace ghost
 
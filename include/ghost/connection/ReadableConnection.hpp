@@ -18,6 +18,8 @@
 #define GHOST_READABLECONNECTION_HPP
 
 #include <ghost/connection/ConnectionConfiguration.hpp>
+#include <ghost/connection/ConnectionStatistics.hpp>
+#include <ghost/connection/LatencyStatistics.hpp>
 #include <ghost/connection/MessageHandler.hpp>
 #include <ghost/connection/Reader.hpp>
 #include <ghost/connection/ReaderSink.hpp>
@@ -64,6 +66,19 @@ public:
 		return ghost::Reader<MessageType>::create(_readerSink, _blocking);
 	}
 
+	/**
+	 *	@return the number of messages received by this connection that were dropped
+	 *	because the reader queue was full.
+	 */
+	size_t getDroppedReadMessagesCount() const;
+
+	/**
+	 *	@return the latency of the messages passed to the message handler of this connection,
+	 *	split into the stages of their delivery. All the values are zero if the configuration of
+	 *	the connection does not enable the latency tracing.
+	 */
+	ghost::LatencyStatistics getLatencyStatistics() const;
+
 protected:
 	/**
 	 *	Gets the ghost::ReaderSink of this connection.
@@ -72,6 +87,9 @@ protected:
 	 */
 	std::shared_ptr<ghost::ReaderSink> getReaderSink() const;
 
+	/// Adds the received messages and the usage of the reader queue to "statistics".
+	void addReaderStatistics(ghost::ConnectionStatistics& statistics) const;
+
 private:
 	std::shared_ptr<ghost::ReaderSink> _readerSink;
 	bool _blocking;
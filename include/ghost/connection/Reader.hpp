@@ -17,8 +17,10 @@
 #ifndef GHOST_READER_HPP
 #define GHOST_READER_HPP
 
+#include <chrono>
 #include <ghost/connection/ReaderSink.hpp>
 #include <memory>
+#include <vector>
 
 namespace ghost
 {
@@ -66,6 +68,25 @@ public:
 	 */
 	virtual bool read(MessageType& message) = 0;
 
+	/**
+	 * @brief Reads up to "maximum" messages from the reader at once.
+	 *
+	 * The available messages are taken from the connection in one operation and
+	 * appended to "messages". If the connection was set to block during I/O calls,
+	 * this method waits up to "timeout" for the first message (a negative timeout
+	 * waits as long as necessary), otherwise it returns immediately.
+	 * Incoming messages that do not match the expected type MessageType are
+	 * discarded, as with read.
+	 *
+	 * @param messages the vector the read messages are appended to (input)
+	 * @param maximum the maximum number of messages to read
+	 * @param timeout how long to wait for the first message
+	 * @return true if at least one message was read
+	 * @return false if no message was read during this call.
+	 */
+	virtual bool readBatch(std::vector<MessageType>& messages, size_t maximum,
+			       std::chrono::milliseconds timeout = std::chrono::milliseconds(-1)) = 0;
+
 	/**
 	 * @brief Gets the last read message.
 	 *
@@ -42,6 +42,17 @@ public:
 	 */
 	virtual bool put(const google::protobuf::Any& message) = 0;
 
+	/**
+	 *	Pushes a message into the readers connected to this sink. Implementations
+	 *	may take over the content of the message instead of copying it.
+	 *	@param message	the new message to pass to the readers.
+	 *	@return true if the message was successfully passed.
+	 */
+	virtual bool put(google::protobuf::Any&& message)
+	{
+		return put(static_cast<const google::protobuf::Any&>(message));
+	}
+
 	virtual std::shared_ptr<ghost::MessageHandler> addMessageHandler() = 0;
 
 	/**
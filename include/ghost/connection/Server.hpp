@@ -18,6 +18,7 @@
 #define GHOST_SERVER_HPP
 
 #include <ghost/connection/ClientHandler.hpp>
+#include <ghost/connection/ClientHandlerStatistics.hpp>
 #include <ghost/connection/Connection.hpp>
 #include <memory>
 
@@ -45,6 +46,17 @@ public:
 	 * @param handler custom implementation of a ClientHandler
 	 */
 	virtual void setClientHandler(std::shared_ptr<ghost::ClientHandler> handler) = 0;
+
+	/**
+	 * @brief Returns the statistics of the handling of the incoming Client connections.
+	 * Servers that do not queue their clients return empty statistics.
+	 *
+	 * @return the statistics of the client handler
+	 */
+	virtual ghost::ClientHandlerStatistics getClientHandlerStatistics() const
+	{
+		return ghost::ClientHandlerStatistics();
+	}
 };
 } // namespace ghost
 
@@ -43,6 +43,14 @@ public:
 	}
 
 	virtual ~Subscriber() = default;
+
+	/// @return the statistics of the transport and of the queues of this subscriber.
+	ghost::ConnectionStatistics getStatistics() const override
+	{
+		ghost::ConnectionStatistics statistics = getTransportStatistics();
+		addReaderStatistics(statistics);
+		return statistics;
+	}
 };
 } // namespace ghost
 
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_SUBSCRIBERLAG_HPP
+#define GHOST_SUBSCRIBERLAG_HPP
+
+#include <chrono>
+#include <cstddef>
+
+namespace ghost
+{
+/**
+ * @brief Describes how far a subscriber connected to a ghost::Publisher is behind the published messages.
+ *
+ * Publishers keeping one queue per subscriber report the messages which still wait in the queue of
+ * every subscriber.
+ */
+struct SubscriberLag
+{
+	/// number of published messages that were not sent to the subscriber yet.
+	size_t messages = 0;
+	/// time since the queue of the subscriber was last found empty, zero if it is empty.
+	std::chrono::milliseconds duration = std::chrono::milliseconds(0);
+	/// number of published messages that were dropped because the queue of the subscriber was full.
+	size_t droppedMessages = 0;
+};
+} // namespace ghost
+
+#endif // GHOST_SUBSCRIBERLAG_HPP
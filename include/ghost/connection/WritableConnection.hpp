@@ -18,8 +18,11 @@
 #define GHOST_WRITABLECONNECTION_HPP
 
 #include <ghost/connection/ConnectionConfiguration.hpp>
+#include <ghost/connection/ConnectionStatistics.hpp>
+#include <ghost/connection/MessagePriority.hpp>
 #include <ghost/connection/Writer.hpp>
 #include <ghost/connection/WriterSink.hpp>
+#include <ghost/connection/internal/ConflationKeys.hpp>
 #include <memory>
 
 namespace ghost
@@ -37,14 +40,23 @@ public:
 
 	/**
 	 *	Creates a writer for this connection.
+	 *	@param priority	the priority class of the messages written by this writer. The connection
+	 *	sends the messages of the higher classes first, see ghost::MessagePriority.
 	 *	@return a writer configured for this connection.
 	 */
 	template <typename MessageType>
-	std::shared_ptr<ghost::Writer<MessageType>> getWriter() const
+	std::shared_ptr<ghost::Writer<MessageType>> getWriter(
+	    ghost::MessagePriority priority = ghost::MessagePriority::NORMAL) const
 	{
-		return ghost::Writer<MessageType>::create(_writerSink, _blocking);
+		return ghost::Writer<MessageType>::create(_writerSink, _blocking, priority);
 	}
 
+	/**
+	 *	@return the number of messages written to this connection that were dropped or
+	 *	rejected because the writer queue was full.
+	 */
+	size_t getDroppedWriteMessagesCount() const;
+
 protected:
 	/**
 	 *	Gets the ghost::WriterSink of this connection.
@@ -53,6 +65,13 @@ protected:
 	 */
 	std::shared_ptr<ghost::WriterSink> getWriterSink() const;
 
+	/// Adds the sent messages and the usage of the writer queue to "statistics".
+	void addWriterStatistics(ghost::ConnectionStatistics& statistics) const;
+
+	/// Conflates the messages waiting in the writer queue with the given keys. Must be called before
+	/// the messages are written.
+	void setConflationKeys(const std::shared_ptr<const ghost::internal::ConflationKeys>& keys);
+
 private:
 	std::shared_ptr<ghost::WriterSink> _writerSink;
 	bool _blocking;
@@ -17,8 +17,12 @@
 #ifndef GHOST_WRITER_HPP
 #define GHOST_WRITER_HPP
 
+#include <functional>
+#include <future>
+#include <ghost/connection/MessagePriority.hpp>
 #include <ghost/connection/WriterSink.hpp>
 #include <memory>
+#include <vector>
 
 namespace ghost
 {
@@ -48,10 +52,12 @@ public:
 
 	/**
 	 *	Creates a ghost::Writer bound to the provided connection.
+	 *	@param priority	the priority class of the messages written by this writer.
 	 *	@return a ghost::Writer object that can write to the provided connection.
 	 */
-	static std::shared_ptr<ghost::Writer<MessageType>> create(const std::shared_ptr<ghost::WriterSink>& sink,
-								  bool blocking);
+	static std::shared_ptr<ghost::Writer<MessageType>> create(
+	    const std::shared_ptr<ghost::WriterSink>& sink, bool blocking,
+	    ghost::MessagePriority priority = ghost::MessagePriority::NORMAL);
 
 	/**
 	 * @brief Forwards the message to the connection which provided
@@ -65,16 +71,75 @@ public:
 	 * if applicable). If this conversion fails, this method returns
 	 * false.
 	 *
+	 * If the connection is blocking, this method waits until the connection
+	 * sent the message.
+	 *
 	 * @param message the message to send
 	 * @return true if the message was added to the processing queue
+	 * (and sent, for blocking connections)
 	 * @return false if the message was not added to the queue
 	 */
 	virtual bool write(const MessageType& message) = 0;
+
+	/**
+	 * @brief Forwards the message to the connection which provided
+	 * this Writer and returns without waiting for it to be sent,
+	 * regardless of the blocking setting of the connection.
+	 *
+	 * @param message the message to send
+	 * @return a future set to true once the connection sent the message,
+	 * or to false if the message could not be converted, was dropped or
+	 * if the connection stopped before sending it.
+	 */
+	virtual std::future<bool> writeAsync(const MessageType& message) = 0;
+
+	/**
+	 * @brief Forwards all the messages to the connection which provided
+	 * this Writer at once.
+	 *
+	 * All the messages are converted first, then added to the processing
+	 * queue in one operation, so that the connection is only woken up once.
+	 * If one of them cannot be converted or if they do not fit in the queue,
+	 * none of them is added.
+	 *
+	 * If the connection is blocking, this method waits until the connection
+	 * sent the last message.
+	 *
+	 * @param messages the messages to send, in order
+	 * @return true if the messages were added to the processing queue
+	 * (and sent, for blocking connections)
+	 * @return false if the messages were not added to the queue
+	 */
+	bool writeBatch(const std::vector<MessageType>& messages)
+	{
+		return writeBatch(messages.begin(), messages.end());
+	}
+
+	/**
+	 * @brief Forwards the messages of the range [first, last) to the connection
+	 * which provided this Writer at once. See writeBatch(const std::vector<MessageType>&).
+	 *
+	 * @param first iterator to the first message to send
+	 * @param last iterator past the last message to send
+	 * @return true if the messages were added to the processing queue
+	 * (and sent, for blocking connections)
+	 * @return false if the messages were not added to the queue
+	 */
+	template <typename InputIterator>
+	bool writeBatch(InputIterator first, InputIterator last)
+	{
+		std::vector<std::reference_wrapper<const MessageType>> messages(first, last);
+		return writeReferences(messages);
+	}
+
+protected:
+	/// Implementation of writeBatch: the messages are referenced to avoid copying them.
+	virtual bool writeReferences(const std::vector<std::reference_wrapper<const MessageType>>& messages) = 0;
 };
 
 template <>
 std::shared_ptr<ghost::Writer<google::protobuf::Any>> ghost::Writer<google::protobuf::Any>::create(
-    const std::shared_ptr<ghost::WriterSink>& sink, bool blocking);
+    const std::shared_ptr<ghost::WriterSink>& sink, bool blocking, ghost::MessagePriority priority);
 } // namespace ghost
 
 #include <ghost/connection/internal/GenericWriter.hpp>
@@ -82,9 +147,9 @@ std::shared_ptr<ghost::Writer<google::protobuf::Any>> ghost::Writer<google::prot
 // Template definition //
 template <typename MessageType>
 std::shared_ptr<ghost::Writer<MessageType>> ghost::Writer<MessageType>::create(
-    const std::shared_ptr<ghost::WriterSink>& sink, bool blocking)
+    const std::shared_ptr<ghost::WriterSink>& sink, bool blocking, ghost::MessagePriority priority)
 {
-	return std::make_shared<ghost::internal::GenericWriter<MessageType>>(sink, blocking);
+	return std::make_shared<ghost::internal::GenericWriter<MessageType>>(sink, blocking, priority);
 }
 
 #endif // GHOST_WRITER_HPP
@@ -20,6 +20,7 @@
 #include <google/protobuf/any.pb.h>
 
 #include <chrono>
+#include <vector>
 
 namespace ghost
 {
@@ -45,9 +46,24 @@ public:
 	 */
 	virtual bool get(google::protobuf::Any& message, std::chrono::milliseconds timeout) = 0;
 
+	/**
+	 *	Gets up to "maximum" messages from the writing object at once and appends
+	 *	them to "messages". The call waits up to "timeout" for the first message,
+	 *	a negative timeout waits as long as necessary.
+	 *	The messages are taken out of the writer, but each of them must still be
+	 *	completed by a call to ghost::WriterSink::pop() once it is sent, in order.
+	 *	@param messages	Messages gotten by the writer (input).
+	 *	@param maximum	maximum number of messages to get.
+	 *	@param timeout	this call will wait for this duration for the first message.
+	 *	@return the number of messages gotten from the writer.
+	 */
+	virtual size_t getBatch(std::vector<google::protobuf::Any>& messages, size_t maximum,
+				std::chrono::milliseconds timeout) = 0;
+
 	/**
 	 *	Remove the last message from the queue. This method must be called after the message
-	 *	is effectively sent.
+	 *	is effectively sent: it completes the write operation of the message.
+	 *	Messages gotten with ghost::WriterSink::getBatch() are completed first.
 	 */
 	virtual void pop() = 0;
 
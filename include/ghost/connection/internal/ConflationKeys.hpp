@@ -0,0 +1,124 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_INTERNAL_CONFLATIONKEYS_HPP
+#define GHOST_INTERNAL_CONFLATIONKEYS_HPP
+
+#include <google/protobuf/any.pb.h>
+
+#include <functional>
+#include <ghost/connection/Message.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "GenericMessageConverter.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Base class of the key extractors of the conflated message types.
+ */
+class BaseConflationKeyExtractor
+{
+public:
+	virtual ~BaseConflationKeyExtractor() = default;
+	/**
+	 * Computes the key of a message whose type matches the type of this extractor.
+	 * @return false if the message could not be parsed, in which case it is not conflated.
+	 */
+	virtual bool getKey(const google::protobuf::Any& message, std::string& key) const = 0;
+};
+
+template <typename MessageType, bool = std::is_base_of<ghost::Message, MessageType>::value>
+class ConflationKeyExtractor;
+
+/// Implementation for protobuf messages
+template <typename MessageType>
+class ConflationKeyExtractor<MessageType, false> : public BaseConflationKeyExtractor
+{
+public:
+	ConflationKeyExtractor(std::function<std::string(const MessageType& message)> key) : _key(key)
+	{
+	}
+
+	bool getKey(const google::protobuf::Any& message, std::string& key) const override
+	{
+		MessageType proto;
+		if (!message.UnpackTo(&proto)) return false;
+
+		key = _key(proto);
+		return true;
+	}
+
+private:
+	std::function<std::string(const MessageType& message)> _key;
+};
+
+/// Implementation for ghost::Message
+template <typename MessageType>
+class ConflationKeyExtractor<MessageType, true> : public BaseConflationKeyExtractor
+{
+public:
+	ConflationKeyExtractor(std::function<std::string(const MessageType& message)> key) : _key(key)
+	{
+	}
+
+	bool getKey(const google::protobuf::Any& message, std::string& key) const override
+	{
+		MessageType msg;
+		if (!GenericMessageConverter::parse(message, msg)) return false;
+
+		key = _key(msg);
+		return true;
+	}
+
+private:
+	std::function<std::string(const MessageType& message)> _key;
+};
+
+/**
+ *	Key extractors of the message types that a publisher conflates. Messages of these types that
+ *	wait in a writer queue are replaced by the newer messages with the same key.
+ *	The extractors are added before the publisher starts, and only read afterwards.
+ */
+class ConflationKeys
+{
+public:
+	/// Sets the extractor of the messages of the given format and type name, replacing the previous one.
+	void add(const std::string& format, const std::string& name,
+		 std::unique_ptr<BaseConflationKeyExtractor>&& extractor);
+
+	/**
+	 * Computes the conflation key of a message. The key is prefixed by the type of the message
+	 * so that the keys of different types never collide.
+	 * @return false if the type of the message is not conflated.
+	 */
+	bool getKey(const google::protobuf::Any& message, std::string& key) const;
+
+	bool empty() const;
+
+private:
+	/// Extractors by type, formatted as "<format>/<name>".
+	std::map<std::string, std::unique_ptr<BaseConflationKeyExtractor>> _extractors;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_CONFLATIONKEYS_HPP
@@ -19,13 +19,43 @@
 
 #include <google/protobuf/any.pb.h>
 
+#include <cstddef>
 #include <ghost/connection/Message.hpp>
 #include <string>
+#include <utility>
 
 namespace ghost
 {
 namespace internal
 {
+/**
+ * Non-owning reference to a sequence of characters, for instance to a field of a serialized
+ * message. The referenced buffer must outlive the view.
+ */
+struct BufferView
+{
+	const char* data;
+	size_t size;
+
+	std::string toString() const
+	{
+		return std::string(data, size);
+	}
+
+	bool operator==(const BufferView& other) const;
+	bool operator==(const std::string& other) const;
+};
+
+/**
+ * Fields of a GenericMessage envelope, referencing the serialized envelope they were parsed from.
+ */
+struct GenericMessageEnvelope
+{
+	BufferView format;
+	BufferView name;
+	BufferView serial;
+};
+
 /**
  * Converter for GenericMessages and Messages. GenericMessage objects are protobuf messages
  * which can contain any other protobuf message (namely represented by a protobuf::Any object)
@@ -54,6 +84,14 @@ public:
 	 */
 	static bool create(google::protobuf::Any& message, const ghost::Message& from);
 
+	/**
+	 * Packs the protobuf message into the Any message without wrapping it into a ghost::Message.
+	 * @param [in,out]	message	the Any message that will be filled by the method.
+	 * @param 		  	from   	message to convert.
+	 * @return	True if the conversion succeeded, false otherwise.
+	 */
+	static bool create(google::protobuf::Any& message, const google::protobuf::Message& from);
+
 	/**
 	 * Parses the GenericMessage into the provided Message instance. If the conversion goes wrong,
 	 * this method returns false.
@@ -65,6 +103,14 @@ public:
 	 */
 	static bool parse(const google::protobuf::Any& message, ghost::Message& to);
 
+	/**
+	 * Unpacks the Any message into the protobuf message without wrapping it into a ghost::Message.
+	 * @param 		  	message	message to convert.
+	 * @param [in,out]	to	   	protobuf message which will represent the converted message.
+	 * @return	True if it succeeds, false if it fails.
+	 */
+	static bool parse(const google::protobuf::Any& message, google::protobuf::Message& to);
+
 	/**
 	 * Gets the format name of the encapsulated message. If the message sent was originally a
 	 * protobuf message, this call will return the value of internal::GHOSTMESSAGE_FORMAT_NAME.
@@ -82,6 +128,21 @@ public:
 
 	static std::pair<std::string, std::string> getFormatAndName(const google::protobuf::Any& message);
 
+	/**
+	 * Parses the GenericMessage envelope contained in the message without copying its fields:
+	 * the views of "envelope" reference the value of "message".
+	 * @param 		  	message	message to analyze.
+	 * @param [in,out]	envelope	the fields of the envelope.
+	 * @return	false if the message does not contain a GenericMessage or if it is malformed.
+	 */
+	static bool parseEnvelope(const google::protobuf::Any& message, GenericMessageEnvelope& envelope);
+
+	/**
+	 * @param	message	message to analyze.
+	 * @return	true if the message contains a GenericMessage, i.e. a message of a user format.
+	 */
+	static bool isGenericMessage(const google::protobuf::Any& message);
+
 	/**
 	 * Gets the name of the contained message without the host part of the Any URL.
 	 * @author	Mathieu Nassar
@@ -90,6 +151,13 @@ public:
 	 * @return	The true type name.
 	 */
 	static std::string getTrueTypeName(const google::protobuf::Any& message);
+
+	/**
+	 * Gets the name of the contained message without the host part of the Any URL, without copying it.
+	 * @param	message	The message.
+	 * @return	A view on the type URL of the message.
+	 */
+	static BufferView getTrueTypeNameView(const google::protobuf::Any& message);
 };
 } // namespace internal
 } // namespace ghost
@@ -23,9 +23,9 @@
 #include <ghost/connection/ReaderSink.hpp>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include "GenericMessageConverter.hpp"
-#include "ProtobufMessage.hpp"
 
 namespace ghost
 {
@@ -50,17 +50,14 @@ public:
 	// From ghost::Reader<MessageType>
 	bool read(MessageType& message) override;
 	bool lastRead(MessageType& message) override;
+	bool readBatch(std::vector<MessageType>& messages, size_t maximum, std::chrono::milliseconds timeout) override;
 
 private:
 	template <class Q = MessageType>
 	typename std::enable_if<!std::is_base_of<ghost::Message, Q>::value, bool>::type makeMessage(
 	    const google::protobuf::Any& any, MessageType& message)
 	{
-		auto proto = std::make_shared<MessageType>();
-		ghost::internal::ProtobufMessage container(proto);
-		bool parseResult = GenericMessageConverter::parse(any, container);
-		message = *proto;
-		return parseResult;
+		return GenericMessageConverter::parse(any, static_cast<google::protobuf::Message&>(message));
 	}
 
 	template <class Q = MessageType>
@@ -71,6 +68,8 @@ private:
 	}
 
 	std::shared_ptr<ghost::Reader<google::protobuf::Any>> _internal;
+	google::protobuf::Any _buffer; // reused between reads to keep its allocated storage
+	std::vector<google::protobuf::Any> _batchBuffer;
 };
 
 // TEMPLATE DEFINITION //
@@ -78,11 +77,32 @@ private:
 template <typename MessageType>
 bool GenericReader<MessageType>::read(MessageType& message)
 {
-	google::protobuf::Any tmp;
-	bool readResult = _internal->read(tmp);
+	bool readResult = _internal->read(_buffer);
 	if (!readResult) return false;
 
-	return makeMessage(tmp, message);
+	return makeMessage(_buffer, message);
+}
+
+template <typename MessageType>
+bool GenericReader<MessageType>::readBatch(std::vector<MessageType>& messages, size_t maximum,
+					   std::chrono::milliseconds timeout)
+{
+	_batchBuffer.clear();
+	bool readResult = _internal->readBatch(_batchBuffer, maximum, timeout);
+	if (!readResult) return false;
+
+	// the messages are parsed in place, the ones of the wrong type are removed again
+	size_t count = 0;
+	messages.reserve(messages.size() + _batchBuffer.size());
+	for (const auto& any : _batchBuffer)
+	{
+		messages.emplace_back();
+		if (makeMessage(any, messages.back()))
+			++count;
+		else
+			messages.pop_back();
+	}
+	return count > 0;
 }
 
 template <typename MessageType>
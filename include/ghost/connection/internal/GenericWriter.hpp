@@ -21,9 +21,9 @@
 #include <ghost/connection/Writer.hpp>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include "GenericMessageConverter.hpp"
-#include "ProtobufMessage.hpp"
 
 namespace ghost
 {
@@ -34,13 +34,17 @@ class GenericWriter : public ghost::Writer<MessageType>
 {
 public:
 	/// Constructor. The value of blocking determines whether calls to "write" will
-	/// be blocking or not.
-	GenericWriter(const std::shared_ptr<ghost::WriterSink>& sink, bool blocking)
-	    : _internal(ghost::Writer<google::protobuf::Any>::create(sink, blocking))
+	/// be blocking or not, the priority is the one of the written messages.
+	GenericWriter(const std::shared_ptr<ghost::WriterSink>& sink, bool blocking, ghost::MessagePriority priority)
+	    : _internal(ghost::Writer<google::protobuf::Any>::create(sink, blocking, priority))
 	{
 	}
 
 	bool write(const MessageType& message) override;
+	std::future<bool> writeAsync(const MessageType& message) override;
+
+protected:
+	bool writeReferences(const std::vector<std::reference_wrapper<const MessageType>>& messages) override;
 
 private:
 	template <class Q = MessageType>
@@ -56,8 +60,7 @@ private:
 	    !std::is_base_of<ghost::Message, Q>::value && !std::is_same<google::protobuf::Any, Q>::value, bool>::type
 	makeAny(google::protobuf::Any& any, const MessageType& message)
 	{
-		return GenericMessageConverter::create(
-		    any, ghost::internal::ProtobufMessage(std::make_shared<MessageType>(message)));
+		return GenericMessageConverter::create(any, static_cast<const google::protobuf::Message&>(message));
 	}
 
 	template <class Q = MessageType>
@@ -85,6 +88,37 @@ bool GenericWriter<MessageType>::write(const MessageType& message)
 
 	return _internal->write(any);
 }
+
+template <typename MessageType>
+std::future<bool> GenericWriter<MessageType>::writeAsync(const MessageType& message)
+{
+	google::protobuf::Any any;
+
+	bool createSuccess = makeAny(any, message);
+
+	if (!createSuccess)
+	{
+		std::promise<bool> result;
+		result.set_value(false);
+		return result.get_future();
+	}
+
+	return _internal->writeAsync(any);
+}
+
+template <typename MessageType>
+bool GenericWriter<MessageType>::writeReferences(
+    const std::vector<std::reference_wrapper<const MessageType>>& messages)
+{
+	// all the messages are converted before anything is written
+	std::vector<google::protobuf::Any> anys(messages.size());
+	for (size_t i = 0; i < messages.size(); ++i)
+	{
+		if (!makeAny(anys[i], messages[i].get())) return false;
+	}
+
+	return _internal->writeBatch(anys);
+}
 } // namespace internal
 } // namespace ghost
 
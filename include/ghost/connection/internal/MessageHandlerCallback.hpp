@@ -18,9 +18,11 @@
 #define GHOST_INTERNAL_MESSAGEHANDLERCALLBACK_HPP
 
 #include <google/protobuf/any.pb.h>
+#include <google/protobuf/arena.h>
 
 #include <functional>
 #include <ghost/connection/Message.hpp>
+#include <string>
 
 #include "GenericMessageConverter.hpp"
 #include "ProtobufMessage.hpp"
@@ -36,7 +38,16 @@ class BaseMessageHandlerCallback
 {
 public:
 	virtual ~BaseMessageHandlerCallback() = default;
-	virtual void handle(const google::protobuf::Any& message) = 0;
+	/**
+	 * Handles a message whose type matches the type of this handler.
+	 * @param arena if not null, arena in which the message can be parsed. It is reset after this call,
+	 * or after the batch of messages this call belongs to.
+	 */
+	virtual void handle(const google::protobuf::Any& message, google::protobuf::Arena* arena) = 0;
+	/// Handles the serialized payload of a user format message, whose format and name were already checked.
+	virtual void handleSerialized(const BufferView& serial)
+	{
+	}
 };
 
 template <typename MessageType, bool = std::is_base_of<ghost::Message, MessageType>::value>
@@ -51,11 +62,19 @@ public:
 	{
 	}
 
-	void handle(const google::protobuf::Any& message) override
+	void handle(const google::protobuf::Any& message, google::protobuf::Arena* arena) override
 	{
-		auto proto = std::make_shared<MessageType>();
-		ghost::internal::ProtobufMessage msg(proto);
-		bool parseSuccess = GenericMessageConverter::parse(message, msg);
+		if (!arena)
+		{
+			MessageType proto;
+			bool parseSuccess = message.UnpackTo(&proto);
+			if (parseSuccess) _callback(proto);
+			return;
+		}
+
+		// the message and its sub-messages are allocated in the arena, and destroyed with its reset
+		MessageType* proto = google::protobuf::Arena::CreateMessage<MessageType>(arena);
+		bool parseSuccess = message.UnpackTo(proto);
 		if (parseSuccess) _callback(*proto);
 	}
 
@@ -72,13 +91,20 @@ public:
 	{
 	}
 
-	void handle(const google::protobuf::Any& message) override
+	void handle(const google::protobuf::Any& message, google::protobuf::Arena* arena) override
 	{
 		MessageType msg;
 		bool parseSuccess = GenericMessageConverter::parse(message, msg);
 		if (parseSuccess) _callback(msg);
 	}
 
+	void handleSerialized(const BufferView& serial) override
+	{
+		MessageType msg;
+		bool parseSuccess = msg.deserialize(serial.toString());
+		if (parseSuccess) _callback(msg);
+	}
+
 private:
 	std::function<void(const MessageType& message)> _callback;
 };
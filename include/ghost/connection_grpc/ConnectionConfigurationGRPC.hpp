@@ -17,6 +17,7 @@
 #ifndef GHOST_CONNECTIONCONFIGURATIONGRPC_HPP
 #define GHOST_CONNECTIONCONFIGURATIONGRPC_HPP
 
+#include <chrono>
 #include <ghost/connection/NetworkConnectionConfiguration.hpp>
 
 namespace ghost
@@ -29,6 +30,29 @@ namespace ghost
 class ConnectionConfigurationGRPC : public ghost::NetworkConnectionConfiguration
 {
 public:
+	/// Compression algorithms proposed by gRPC for the messages of a connection.
+	enum class Compression
+	{
+		NONE,
+		DEFLATE,
+		GZIP
+	};
+
+	/**
+	 * Behaviour of a publisher towards a subscriber which lags behind the published messages. Whatever
+	 * the policy, the queues of the subscribers keep one message per key of ghost::Publisher::setConflationKey.
+	 */
+	enum class SubscriberLagPolicy
+	{
+		/// the messages published while the queue of the subscriber is full are not sent to it.
+		DROP_NEWEST,
+		/// the messages published while the queue of the subscriber is full replace its oldest ones. Ring
+		/// buffers do not support this policy and drop the new messages instead.
+		DROP_OLDEST,
+		/// the subscriber is disconnected once its queue is full, or once it lagged for too long.
+		DISCONNECT
+	};
+
 	/**
 	 * @brief Constructs a new NetworkConnectionConfiguration object with
 	 * default parameters, i.e. any IP address and any remote port number.
@@ -37,6 +61,168 @@ public:
 	 */
 	ConnectionConfigurationGRPC(const std::string& name = "");
 	ConnectionConfigurationGRPC(const std::string& ip, int port);
+
+	/**
+	 * @brief Creates a configuration for gRPC connections over a Unix domain socket, for
+	 * programs running on the same host. The socket file is created by the server.
+	 *
+	 * @param path the path of the socket
+	 * @return the created configuration
+	 */
+	static ConnectionConfigurationGRPC createForUnixSocket(const std::string& path);
+
+	/**
+	 * @brief Accessor for the compression algorithm used to send messages. The algorithm is
+	 * negotiated with the remote peer: a peer that does not support it receives raw messages.
+	 *
+	 * @return the compression algorithm
+	 */
+	Compression getCompression() const;
+
+	/**
+	 * @brief Accessor for the size in bytes under which messages are sent without compression.
+	 * Compressing small messages costs CPU time for a low gain.
+	 *
+	 * @return the compression threshold in bytes
+	 */
+	size_t getCompressionThreshold() const;
+
+	/**
+	 * @brief Accessor for the number of completion queues of a server. The incoming calls are
+	 * spread across the queues, and the thread pool is split between them with at least one thread
+	 * per queue: one queue per CPU core lets the server scale with the number of cores.
+	 *
+	 * @return the number of completion queues
+	 */
+	size_t getCompletionQueueCount() const;
+
+	/**
+	 * @brief Accessor for the pinning of the threads polling the completion queues to CPU cores.
+	 * If enabled, every polling thread runs on its own core as long as there are enough of them.
+	 * Only supported on Linux.
+	 *
+	 * @return true if the polling threads are pinned to CPU cores
+	 */
+	bool isCpuPinningEnabled() const;
+
+	/**
+	 * @brief Accessor for the number of threads of a server calling the ghost::ClientHandler of the
+	 * incoming clients. A handler occupies its thread until it returns, so at most this many clients
+	 * are handled at the same time. A handler looping for the lifetime of its client therefore limits
+	 * the server to this many connected clients: the next ones wait for a thread, and are rejected with
+	 * RESOURCE_EXHAUSTED once getMaximumPendingClients() clients are waiting. Such servers need at least
+	 * one thread per client connected at the same time.
+	 *
+	 * @return the number of threads calling the client handler
+	 */
+	size_t getClientHandlerThreadCount() const;
+
+	/**
+	 * @brief Accessor for the number of accepted clients that may wait for a thread of the client
+	 * handler. Clients accepted while this many are waiting are disconnected.
+	 *
+	 * @return the maximum number of clients waiting to be handled
+	 */
+	size_t getMaximumPendingClients() const;
+
+	/**
+	 * @brief Accessor for the behaviour of a publisher towards the subscribers which do not keep up
+	 * with the published messages. Every subscriber has its own queue: a slow subscriber never delays
+	 * the publisher nor the other subscribers.
+	 *
+	 * @return the policy applied to the lagging subscribers
+	 */
+	SubscriberLagPolicy getSubscriberLagPolicy() const;
+
+	/**
+	 * @brief Accessor for the number of messages of one priority that may wait in the queue of a
+	 * subscriber. If zero, the queues of the subscribers have the depth of the writer queue.
+	 *
+	 * @return the maximum number of messages a subscriber may be behind
+	 */
+	size_t getMaximumSubscriberLag() const;
+
+	/**
+	 * @brief Accessor for the time after which a subscriber which did not catch up with the
+	 * published messages is disconnected. Only used by the SubscriberLagPolicy::DISCONNECT policy,
+	 * if zero the subscribers are only disconnected when their queue is full.
+	 *
+	 * @return the maximum time a subscriber may be behind
+	 */
+	std::chrono::milliseconds getMaximumSubscriberLagDuration() const;
+
+	/**
+	 * @brief Set the compression algorithm used to send messages.
+	 *
+	 * @param compression the new compression algorithm
+	 */
+	void setCompression(Compression compression);
+
+	/**
+	 * @brief Set the size in bytes under which messages are sent without compression.
+	 *
+	 * @param threshold the new compression threshold in bytes
+	 */
+	void setCompressionThreshold(size_t threshold);
+
+	/**
+	 * @brief Set the number of completion queues of a server.
+	 *
+	 * @param count the new number of completion queues, at least one
+	 */
+	void setCompletionQueueCount(size_t count);
+
+	/**
+	 * @brief Enables or disables the pinning of the threads polling the completion queues to CPU cores.
+	 *
+	 * @param enabled true to pin the polling threads
+	 */
+	void setCpuPinningEnabled(bool enabled);
+
+	/**
+	 * @brief Set the number of threads of a server calling the ghost::ClientHandler, which is the
+	 * number of clients handled at the same time, see getClientHandlerThreadCount().
+	 *
+	 * @param count the new number of threads, at least one
+	 */
+	void setClientHandlerThreadCount(size_t count);
+
+	/**
+	 * @brief Set the number of accepted clients that may wait for a thread of the client handler.
+	 *
+	 * @param count the new maximum number of clients waiting to be handled
+	 */
+	void setMaximumPendingClients(size_t count);
+
+	/**
+	 * @brief Set the behaviour of a publisher towards the subscribers which lag behind.
+	 *
+	 * @param policy the new policy applied to the lagging subscribers
+	 */
+	void setSubscriberLagPolicy(SubscriberLagPolicy policy);
+
+	/**
+	 * @brief Set the number of messages of one priority that may wait in the queue of a subscriber.
+	 *
+	 * @param messages the new maximum number of messages a subscriber may be behind
+	 */
+	void setMaximumSubscriberLag(size_t messages);
+
+	/**
+	 * @brief Set the time after which a lagging subscriber is disconnected.
+	 *
+	 * @param duration the new maximum time a subscriber may be behind
+	 */
+	void setMaximumSubscriberLagDuration(std::chrono::milliseconds duration);
+
+	/**
+	 * @brief Creates a gRPC connection configuration from a connection configuration
+	 *
+	 * @param from source connection configuration
+	 *
+	 * @return ConnectionConfigurationGRPC the created configuration
+	 */
+	static ghost::ConnectionConfigurationGRPC initializeFrom(const ghost::ConnectionConfiguration& from);
 };
 } // namespace ghost
 
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_CONNECTIONCONFIGURATIONINPROC_HPP
+#define GHOST_CONNECTIONCONFIGURATIONINPROC_HPP
+
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+
+namespace ghost
+{
+/**
+ * @brief Extended connection configuration for in-process connections.
+ * This configuration possesses an additional attribute that allows the ghost::ConnectionFactory
+ * to differentiate in-process connections from other network connection technologies.
+ * The IP address and port number do not open any socket: they only name the endpoint within
+ * the process, so that switching a program between gRPC and in-process connections only
+ * requires changing the configuration type.
+ */
+class ConnectionConfigurationInproc : public ghost::NetworkConnectionConfiguration
+{
+public:
+	/**
+	 * @brief Constructs a new ConnectionConfigurationInproc object with
+	 * default parameters, i.e. any IP address and any remote port number.
+	 *
+	 * @param name the name of the configuration
+	 */
+	ConnectionConfigurationInproc(const std::string& name = "");
+	ConnectionConfigurationInproc(const std::string& ip, int port);
+};
+} // namespace ghost
+
+#endif // GHOST_CONNECTIONCONFIGURATIONINPROC_HPP
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_CONNECTIONINPROC_HPP
+#define GHOST_CONNECTIONINPROC_HPP
+
+#include <ghost/connection/ConnectionManager.hpp>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <ghost/connection_inproc/ConnectionConfigurationInproc.hpp>
+
+namespace ghost
+{
+/**
+ *	Manages the ghost_connection_inproc content.
+ *	Use the "initialize" method to load new rules for the connection manager's factory.
+ *	The initialization method can be called multiple times with different minimum configurations.
+ *
+ *	In-process connections link the sinks of the connected objects directly: messages written
+ *	on one side are moved to the readers of the other side by a forwarding thread, without
+ *	socket, framing or additional serialization. They are meant for modules of the same program
+ *	that would otherwise communicate over a loopback gRPC connection.
+ *
+ *	To use in-process connections, use the create methods of the ghost::ConnectionManager after
+ *	this initialization with configurations of type ghost::ConnectionConfigurationInproc if the
+ *	default value was used.
+ */
+class ConnectionInproc
+{
+public:
+	/**
+	 *	Loads factory rules into the given connection manager objects to enable the creation
+	 *	of in-process connections.
+	 *	The default value of the "minimumConfiguration" param is a network connection configuration
+	 *	that specifically requires in-process connections.
+	 *
+	 *	@params connectionManager	the connection manager used by this program.
+	 *	@params minimumConfiguration	the minimum configuration that can create in-process connections.
+	 */
+	static void initialize(
+	    const std::shared_ptr<ghost::ConnectionManager>& connectionManager,
+	    const ghost::NetworkConnectionConfiguration& minimumConfiguration = ghost::ConnectionConfigurationInproc());
+};
+} // namespace ghost
+
+#endif // GHOST_CONNECTIONINPROC_HPP
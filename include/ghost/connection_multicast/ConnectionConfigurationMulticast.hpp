@@ -0,0 +1,119 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_CONNECTIONCONFIGURATIONMULTICAST_HPP
+#define GHOST_CONNECTIONCONFIGURATIONMULTICAST_HPP
+
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+
+namespace ghost
+{
+/**
+ * @brief Extended connection configuration for publishers and subscribers exchanging messages
+ * through a UDP multicast group.
+ * This configuration possesses an additional attribute that allows the ghost::ConnectionFactory
+ * to differentiate multicast connections from other network connection technologies.
+ * The IP address and port number are the ones of the multicast group, e.g. 239.255.0.1.
+ */
+class ConnectionConfigurationMulticast : public ghost::NetworkConnectionConfiguration
+{
+public:
+	/**
+	 *	Behavior of a subscriber when messages of the publisher were lost.
+	 */
+	enum class LossPolicy
+	{
+		/// counts the lost messages and continues with the next ones (default).
+		SKIP,
+		/// stops the subscriber, for consumers that cannot miss any message.
+		STOP
+	};
+
+	/**
+	 * @brief Constructs a new ConnectionConfigurationMulticast object with
+	 * default parameters, i.e. any IP address and any remote port number.
+	 *
+	 * @param name the name of the configuration
+	 */
+	ConnectionConfigurationMulticast(const std::string& name = "");
+	ConnectionConfigurationMulticast(const std::string& ip, int port);
+
+	/**
+	 * @brief Accessor for the IP address of the local interface used to send and receive the datagrams.
+	 *
+	 * @return the address of the interface, or an empty string to let the system choose it
+	 */
+	std::string getInterfaceAddress() const;
+	/**
+	 * @brief Accessor for the number of routers the datagrams of a publisher may cross.
+	 *
+	 * @return the time to live of the datagrams
+	 */
+	int getTimeToLive() const;
+	/**
+	 * @brief Accessor for the maximum size of the UDP payload of a datagram. Larger messages are sent in
+	 * several fragments. The default value fits in an Ethernet frame.
+	 *
+	 * @return the maximum size of a datagram, in bytes
+	 */
+	size_t getMaximumDatagramSize() const;
+	/**
+	 * @brief Accessor for the behavior of a subscriber when messages were lost.
+	 *
+	 * @return the loss policy of a subscriber
+	 */
+	LossPolicy getLossPolicy() const;
+
+	/**
+	 * @brief Set the IP address of the local interface used to send and receive the datagrams,
+	 * e.g. 127.0.0.1 to stay on the local host.
+	 *
+	 * @param address the address of the interface
+	 */
+	void setInterfaceAddress(const std::string& address);
+	/**
+	 * @brief Set the number of routers the datagrams of a publisher may cross. The default value
+	 * of 1 keeps them in the local network.
+	 *
+	 * @param ttl the new time to live of the datagrams
+	 */
+	void setTimeToLive(int ttl);
+	/**
+	 * @brief Set the maximum size of the UDP payload of a datagram.
+	 *
+	 * @param size the new maximum size of a datagram, in bytes
+	 */
+	void setMaximumDatagramSize(size_t size);
+	/**
+	 * @brief Set the behavior of a subscriber when messages were lost.
+	 *
+	 * @param policy the new loss policy
+	 */
+	void setLossPolicy(LossPolicy policy);
+
+	/**
+	 * @brief Creates a multicast connection configuration from a connection configuration
+	 *
+	 * @param from source connection configuration
+	 *
+	 * @return ConnectionConfigurationMulticast the created configuration
+	 */
+	static ghost::ConnectionConfigurationMulticast initializeFrom(const ghost::ConnectionConfiguration& from);
+};
+} // namespace ghost
+
+#endif // GHOST_CONNECTIONCONFIGURATIONMULTICAST_HPP
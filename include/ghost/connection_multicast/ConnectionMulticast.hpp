@@ -0,0 +1,59 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_CONNECTIONMULTICAST_HPP
+#define GHOST_CONNECTIONMULTICAST_HPP
+
+#include <ghost/connection/ConnectionManager.hpp>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <ghost/connection_multicast/ConnectionConfigurationMulticast.hpp>
+
+namespace ghost
+{
+/**
+ *	Manages the ghost_connection_multicast content.
+ *	Use the "initialize" method to load new rules for the connection manager's factory.
+ *	The initialization method can be called multiple times with different minimum configurations.
+ *
+ *	Multicast connections send every message of a publisher once to a UDP multicast group, and all
+ *	the subscribers that joined the group receive it. Only publishers and subscribers are provided.
+ *	Messages are numbered: subscribers detect the lost ones and handle them according to the loss
+ *	policy of their configuration. Messages larger than a datagram are fragmented.
+ *
+ *	To use multicast connections, use the create methods of the ghost::ConnectionManager after
+ *	this initialization with configurations of type ghost::ConnectionConfigurationMulticast if the default
+ *	value was used.
+ */
+class ConnectionMulticast
+{
+public:
+	/**
+	 *	Loads factory rules into the given connection manager objects to enable the creation
+	 *	of multicast publishers and subscribers.
+	 *	The default value of the "minimumConfiguration" param is a network connection configuration
+	 *	that specifically requires multicast connections.
+	 *
+	 *	@params connectionManager	the connection manager used by this program.
+	 *	@params minimumConfiguration	the minimum configuration that can create multicast connections.
+	 */
+	static void initialize(const std::shared_ptr<ghost::ConnectionManager>& connectionManager,
+			       const ghost::NetworkConnectionConfiguration& minimumConfiguration =
+				   ghost::ConnectionConfigurationMulticast());
+};
+} // namespace ghost
+
+#endif // GHOST_CONNECTIONMULTICAST_HPP
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_CONNECTIONCONFIGURATIONSHM_HPP
+#define GHOST_CONNECTIONCONFIGURATIONSHM_HPP
+
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+
+namespace ghost
+{
+/**
+ * @brief Extended connection configuration for connections between processes of the same host,
+ * using shared memory.
+ * This configuration possesses an additional attribute that allows the ghost::ConnectionFactory
+ * to differentiate shared memory connections from other network connection technologies.
+ * The IP address and port number name the shared memory segment of the server or publisher.
+ */
+class ConnectionConfigurationSHM : public ghost::NetworkConnectionConfiguration
+{
+public:
+	/**
+	 * @brief Constructs a new ConnectionConfigurationSHM object with
+	 * default parameters, i.e. any IP address and any remote port number.
+	 *
+	 * @param name the name of the configuration
+	 */
+	ConnectionConfigurationSHM(const std::string& name = "");
+	ConnectionConfigurationSHM(const std::string& ip, int port);
+
+	/**
+	 * @brief Accessor for the size of the ring buffers exchanging the messages.
+	 * Messages larger than half of this size cannot be sent. A publisher overwrites the messages that
+	 * slow subscribers did not read in time, a client or a server waits for its peer to read them.
+	 *
+	 * @return the size of the ring buffers, in bytes
+	 */
+	size_t getRingSize() const;
+	/**
+	 * @brief Accessor for the number of clients that can be connected to a server at the same time.
+	 *
+	 * @return the maximum number of clients of a server
+	 */
+	size_t getMaximumClients() const;
+
+	/**
+	 * @brief Set the size of the ring buffers exchanging the messages. Connected parties must use the same
+	 * size: the size used is the one of the server or of the publisher.
+	 *
+	 * @param size the new size of the ring buffers, in bytes
+	 */
+	void setRingSize(size_t size);
+	/**
+	 * @brief Set the number of clients that can be connected to a server at the same time.
+	 *
+	 * @param count the new maximum number of clients of a server
+	 */
+	void setMaximumClients(size_t count);
+
+	/**
+	 * @brief Creates a shared memory connection configuration from a connection configuration
+	 *
+	 * @param from source connection configuration
+	 *
+	 * @return ConnectionConfigurationSHM the created configuration
+	 */
+	static ghost::ConnectionConfigurationSHM initializeFrom(const ghost::ConnectionConfiguration& from);
+};
+} // namespace ghost
+
+#endif // GHOST_CONNECTIONCONFIGURATIONSHM_HPP
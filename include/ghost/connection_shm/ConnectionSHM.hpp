@@ -0,0 +1,58 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_CONNECTIONSHM_HPP
+#define GHOST_CONNECTIONSHM_HPP
+
+#include <ghost/connection/ConnectionManager.hpp>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <ghost/connection_shm/ConnectionConfigurationSHM.hpp>
+
+namespace ghost
+{
+/**
+ *	Manages the ghost_connection_shm content.
+ *	Use the "initialize" method to load new rules for the connection manager's factory.
+ *	The initialization method can be called multiple times with different minimum configurations.
+ *
+ *	Shared memory connections exchange messages between processes of the same host through ring
+ *	buffers mapped in both processes. Waiting readers are woken up with futexes. Connections end
+ *	when the process on the other side stops or crashes.
+ *
+ *	To use shared memory connections, use the create methods of the ghost::ConnectionManager after
+ *	this initialization with configurations of type ghost::ConnectionConfigurationSHM if the default
+ *	value was used.
+ */
+class ConnectionSHM
+{
+public:
+	/**
+	 *	Loads factory rules into the given connection manager objects to enable the creation
+	 *	of shared memory connections.
+	 *	The default value of the "minimumConfiguration" param is a network connection configuration
+	 *	that specifically requires shared memory connections.
+	 *
+	 *	@params connectionManager	the connection manager used by this program.
+	 *	@params minimumConfiguration	the minimum configuration that can create shared memory connections.
+	 */
+	static void initialize(
+	    const std::shared_ptr<ghost::ConnectionManager>& connectionManager,
+	    const ghost::NetworkConnectionConfiguration& minimumConfiguration = ghost::ConnectionConfigurationSHM());
+};
+} // namespace ghost
+
+#endif // GHOST_CONNECTIONSHM_HPP
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_CONNECTIONCONFIGURATIONTCP_HPP
+#define GHOST_CONNECTIONCONFIGURATIONTCP_HPP
+
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+
+namespace ghost
+{
+/**
+ * @brief Extended connection configuration for connections using plain TCP sockets.
+ * This configuration possesses an additional attribute that allows the ghost::ConnectionFactory
+ * to differentiate these connections from other network connection technologies.
+ * If a unix socket path is set, the connection uses this unix domain socket instead of the
+ * IP address and port number.
+ */
+class ConnectionConfigurationTCP : public ghost::NetworkConnectionConfiguration
+{
+public:
+	/**
+	 * @brief Constructs a new ConnectionConfigurationTCP object with
+	 * default parameters, i.e. any IP address and any remote port number.
+	 *
+	 * @param name the name of the configuration
+	 */
+	ConnectionConfigurationTCP(const std::string& name = "");
+	ConnectionConfigurationTCP(const std::string& ip, int port);
+
+	/**
+	 * @brief Accessor for the number of I/O threads serving all the TCP connections of the process.
+	 * The threads are created with the first connection: the value of later connections is ignored.
+	 *
+	 * @return the number of I/O threads
+	 */
+	size_t getIOThreadCount() const;
+
+	/**
+	 * @brief Set the number of I/O threads serving all the TCP connections of the process.
+	 *
+	 * @param count the new number of I/O threads
+	 */
+	void setIOThreadCount(size_t count);
+
+	/**
+	 * @brief Creates a TCP connection configuration from a connection configuration
+	 *
+	 * @param from source connection configuration
+	 *
+	 * @return ConnectionConfigurationTCP the created configuration
+	 */
+	static ghost::ConnectionConfigurationTCP initializeFrom(const ghost::ConnectionConfiguration& from);
+};
+} // namespace ghost
+
+#endif // GHOST_CONNECTIONCONFIGURATIONTCP_HPP
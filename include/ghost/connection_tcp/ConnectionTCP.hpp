@@ -0,0 +1,58 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_CONNECTIONTCP_HPP
+#define GHOST_CONNECTIONTCP_HPP
+
+#include <ghost/connection/ConnectionManager.hpp>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <ghost/connection_tcp/ConnectionConfigurationTCP.hpp>
+
+namespace ghost
+{
+/**
+ *	Manages the ghost_connection_tcp content.
+ *	Use the "initialize" method to load new rules for the connection manager's factory.
+ *	The initialization method can be called multiple times with different minimum configurations.
+ *
+ *	TCP connections exchange length-prefixed serialized messages over plain sockets. All the
+ *	sockets of the process are multiplexed with epoll on a small fixed number of I/O threads,
+ *	and the messages waiting in a writer are sent together with a single system call.
+ *
+ *	To use TCP connections, use the create methods of the ghost::ConnectionManager after
+ *	this initialization with configurations of type ghost::ConnectionConfigurationTCP if the default
+ *	value was used.
+ */
+class ConnectionTCP
+{
+public:
+	/**
+	 *	Loads factory rules into the given connection manager objects to enable the creation
+	 *	of TCP connections.
+	 *	The default value of the "minimumConfiguration" param is a network connection configuration
+	 *	that specifically requires TCP connections.
+	 *
+	 *	@params connectionManager	the connection manager used by this program.
+	 *	@params minimumConfiguration	the minimum configuration that can create TCP connections.
+	 */
+	static void initialize(
+	    const std::shared_ptr<ghost::ConnectionManager>& connectionManager,
+	    const ghost::NetworkConnectionConfiguration& minimumConfiguration = ghost::ConnectionConfigurationTCP());
+};
+} // namespace ghost
+
+#endif // GHOST_CONNECTIONTCP_HPP
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ArenaPool.hpp"
+
+using namespace ghost::internal;
+
+ArenaPool::Lease::Lease() : _pool(nullptr)
+{
+}
+
+ArenaPool::Lease::Lease(ArenaPool& pool, std::unique_ptr<PooledArena>&& arena)
+    : _pool(&pool), _arena(std::move(arena))
+{
+}
+
+ArenaPool::Lease::~Lease()
+{
+	if (_arena) _pool->release(std::move(_arena));
+}
+
+google::protobuf::Arena* ArenaPool::Lease::get() const
+{
+	return _arena ? _arena->arena.get() : nullptr;
+}
+
+ArenaPool::ArenaPool(size_t blockSize) : _blockSize(blockSize)
+{
+}
+
+ArenaPool::Lease ArenaPool::acquire()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (!_available.empty())
+		{
+			std::unique_ptr<PooledArena> arena = std::move(_available.back());
+			_available.pop_back();
+			return Lease(*this, std::move(arena));
+		}
+	}
+
+	// the pool grows up to the number of threads handling messages at the same time
+	std::unique_ptr<PooledArena> arena(new PooledArena());
+	arena->block.reset(new char[_blockSize]);
+	google::protobuf::ArenaOptions options;
+	options.initial_block = arena->block.get();
+	options.initial_block_size = _blockSize;
+	arena->arena.reset(new google::protobuf::Arena(options));
+	return Lease(*this, std::move(arena));
+}
+
+void ArenaPool::release(std::unique_ptr<PooledArena>&& arena)
+{
+	arena->arena->Reset(); // destroys the messages, keeps the initial block
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_available.push_back(std::move(arena));
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_INTERNAL_ARENAPOOL_HPP
+#define GHOST_INTERNAL_ARENAPOOL_HPP
+
+#include <google/protobuf/arena.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Pool of protobuf arenas in which incoming messages are parsed.
+ * Every arena owns an initial block of the configured size: an arena is reset when it
+ * returns to the pool, which keeps this block, so that the messages of the next lease
+ * are allocated without calling the allocator as long as they fit in it.
+ */
+class ArenaPool
+{
+	struct PooledArena
+	{
+		std::unique_ptr<char[]> block;
+		std::unique_ptr<google::protobuf::Arena> arena;
+	};
+
+public:
+	/**
+	 * Gives access to an arena of the pool, which returns to the pool with the lease.
+	 * The messages allocated in the arena are destroyed at the same time.
+	 */
+	class Lease
+	{
+	public:
+		/// Creates an empty lease, which gives no arena.
+		Lease();
+		Lease(ArenaPool& pool, std::unique_ptr<PooledArena>&& arena);
+		Lease(Lease&& other) = default;
+		~Lease();
+
+		/// @return the arena of the lease, or nullptr if the lease is empty.
+		google::protobuf::Arena* get() const;
+
+	private:
+		ArenaPool* _pool;
+		std::unique_ptr<PooledArena> _arena;
+	};
+
+	/// @param blockSize the size of the initial block of every arena, in bytes.
+	explicit ArenaPool(size_t blockSize);
+
+	Lease acquire();
+
+private:
+	void release(std::unique_ptr<PooledArena>&& arena);
+
+	size_t _blockSize;
+	std::mutex _mutex;
+	std::vector<std::unique_ptr<PooledArena>> _available;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_ARENAPOOL_HPP
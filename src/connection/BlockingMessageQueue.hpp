@@ -0,0 +1,239 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_INTERNAL_BLOCKINGMESSAGEQUEUE_HPP
+#define GHOST_INTERNAL_BLOCKINGMESSAGEQUEUE_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <utility>
+
+#include "MessageQueue.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Mutex protected message queue, supporting any number of producers and consumers.
+ * The queue is unbounded unless a maximum size is passed to tryPush().
+ * This is the default backend of the sinks.
+ */
+template <typename T>
+class BlockingMessageQueue : public MessageQueue<T>
+{
+public:
+	BlockingMessageQueue();
+
+	void push(const T& element) override;
+	bool tryPush(T&& element, size_t maximumSize, std::chrono::milliseconds timeout) override;
+	bool tryPushBatch(std::vector<T>&& elements, size_t maximumSize, std::chrono::milliseconds timeout) override;
+	bool dropOldest(T& element) override;
+	void get(T& element) override;
+	bool tryGet(std::chrono::milliseconds timeout, T& element) override;
+	void pop() override;
+	bool pop(T& element) override;
+	bool tryPop(std::chrono::milliseconds timeout, T& element) override;
+	size_t tryPopBatch(std::chrono::milliseconds timeout, std::vector<T>& elements, size_t maximum) override;
+	size_t size() const override;
+
+private:
+	mutable std::mutex _mutex;
+	/// Signaled when an element was pushed.
+	std::condition_variable _readable;
+	/// Signaled when an element was removed.
+	std::condition_variable _writable;
+	std::deque<T> _queue;
+	/// Set between a get() and the following pop(): the head is being processed and must not be dropped.
+	bool _headInUse;
+};
+
+/////////////////////////// Template definition ///////////////////////////
+
+template <typename T>
+BlockingMessageQueue<T>::BlockingMessageQueue() : _headInUse(false)
+{
+}
+
+template <typename T>
+void BlockingMessageQueue<T>::push(const T& element)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_queue.push_back(element);
+		MessageQueue<T>::updatePeakSize(_queue.size());
+	}
+	_readable.notify_all();
+}
+
+template <typename T>
+bool BlockingMessageQueue<T>::tryPush(T&& element, size_t maximumSize, std::chrono::milliseconds timeout)
+{
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		auto hasSpace = [&]() { return maximumSize == 0 || _queue.size() < maximumSize; };
+		if (timeout < std::chrono::milliseconds(0))
+			_writable.wait(lock, hasSpace);
+		else if (!_writable.wait_for(lock, timeout, hasSpace))
+			return false;
+
+		_queue.push_back(std::move(element));
+		MessageQueue<T>::updatePeakSize(_queue.size());
+	}
+	_readable.notify_all();
+	return true;
+}
+
+template <typename T>
+bool BlockingMessageQueue<T>::tryPushBatch(std::vector<T>&& elements, size_t maximumSize,
+					   std::chrono::milliseconds timeout)
+{
+	if (maximumSize != 0 && elements.size() > maximumSize) return false; // would never fit
+
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		auto hasSpace = [&]() { return maximumSize == 0 || _queue.size() + elements.size() <= maximumSize; };
+		if (timeout < std::chrono::milliseconds(0))
+			_writable.wait(lock, hasSpace);
+		else if (!_writable.wait_for(lock, timeout, hasSpace))
+			return false;
+
+		std::move(elements.begin(), elements.end(), std::back_inserter(_queue));
+		MessageQueue<T>::updatePeakSize(_queue.size());
+	}
+	_readable.notify_all();
+	return true;
+}
+
+template <typename T>
+bool BlockingMessageQueue<T>::dropOldest(T& element)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	size_t index = _headInUse ? 1 : 0;
+	if (_queue.size() <= index) return false;
+
+	element = std::move(_queue[index]);
+	_queue.erase(_queue.begin() + index);
+	return true;
+}
+
+template <typename T>
+void BlockingMessageQueue<T>::get(T& element)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_readable.wait(lock, [this]() { return !_queue.empty(); });
+	element = _queue.front();
+	_headInUse = true;
+}
+
+template <typename T>
+bool BlockingMessageQueue<T>::tryGet(std::chrono::milliseconds timeout, T& element)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	if (!_readable.wait_for(lock, timeout, [this]() { return !_queue.empty(); })) return false;
+
+	element = _queue.front();
+	_headInUse = true;
+	return true;
+}
+
+template <typename T>
+void BlockingMessageQueue<T>::pop()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_headInUse = false;
+		if (_queue.empty()) return;
+
+		_queue.pop_front();
+	}
+	_writable.notify_all();
+}
+
+template <typename T>
+bool BlockingMessageQueue<T>::pop(T& element)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_headInUse = false;
+		if (_queue.empty()) return false;
+
+		element = std::move(_queue.front());
+		_queue.pop_front();
+	}
+	_writable.notify_all();
+	return true;
+}
+
+template <typename T>
+bool BlockingMessageQueue<T>::tryPop(std::chrono::milliseconds timeout, T& element)
+{
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		auto hasElement = [this]() { return !_queue.empty(); };
+		if (timeout < std::chrono::milliseconds(0))
+			_readable.wait(lock, hasElement);
+		else if (!_readable.wait_for(lock, timeout, hasElement))
+			return false;
+
+		element = std::move(_queue.front());
+		_queue.pop_front();
+		_headInUse = false;
+	}
+	_writable.notify_all();
+	return true;
+}
+
+template <typename T>
+size_t BlockingMessageQueue<T>::tryPopBatch(std::chrono::milliseconds timeout, std::vector<T>& elements,
+					    size_t maximum)
+{
+	if (maximum == 0) return 0;
+
+	size_t count = 0;
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		auto hasElement = [this]() { return !_queue.empty(); };
+		if (timeout < std::chrono::milliseconds(0))
+			_readable.wait(lock, hasElement);
+		else if (!_readable.wait_for(lock, timeout, hasElement))
+			return 0;
+
+		// all the elements are taken under a single lock acquisition
+		count = std::min(maximum, _queue.size());
+		elements.reserve(elements.size() + count);
+		std::move(_queue.begin(), _queue.begin() + count, std::back_inserter(elements));
+		_queue.erase(_queue.begin(), _queue.begin() + count);
+		_headInUse = false;
+	}
+	if (count > 0) _writable.notify_all();
+	return count;
+}
+
+template <typename T>
+size_t BlockingMessageQueue<T>::size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _queue.size();
+}
+
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_BLOCKINGMESSAGEQUEUE_HPP
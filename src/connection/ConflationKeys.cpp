@@ -0,0 +1,59 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ghost/connection/internal/ConflationKeys.hpp>
+#include <ghost/connection/internal/ProtobufMessage.hpp>
+
+using namespace ghost::internal;
+
+namespace
+{
+std::string makeTypeName(const std::string& format, const std::string& name)
+{
+	return format + '/' + name;
+}
+} // namespace
+
+void ConflationKeys::add(const std::string& format, const std::string& name,
+			 std::unique_ptr<BaseConflationKeyExtractor>&& extractor)
+{
+	_extractors[makeTypeName(format, name)] = std::move(extractor);
+}
+
+bool ConflationKeys::getKey(const google::protobuf::Any& message, std::string& key) const
+{
+	if (_extractors.empty()) return false;
+
+	std::string type;
+	GenericMessageEnvelope envelope;
+	if (GenericMessageConverter::parseEnvelope(message, envelope))
+		type = makeTypeName(envelope.format.toString(), envelope.name.toString());
+	else
+		type = makeTypeName(GHOSTMESSAGE_FORMAT_NAME,
+				    GenericMessageConverter::getTrueTypeNameView(message).toString());
+
+	auto it = _extractors.find(type);
+	if (it == _extractors.end() || !it->second->getKey(message, key)) return false;
+
+	// a type name never contains a line break: the prefix cannot be confused with a key
+	key = type + '\n' + key;
+	return true;
+}
+
+bool ConflationKeys::empty() const
+{
+	return _extractors.empty();
+}
@@ -25,6 +25,17 @@ namespace internal
 static std::string CONNECTIONCONFIGURATION_ID = "CONNECTIONCONFIGURATION_ID";
 static std::string CONNECTIONCONFIGURATION_THREADPOOLSIZE = "CONNECTIONCONFIGURATION_THREADPOOLSIZE";
 static std::string CONNECTIONCONFIGURATION_BLOCKING = "CONNECTIONCONFIGURATION_BLOCKING";
+static std::string CONNECTIONCONFIGURATION_QUEUETYPE = "CONNECTIONCONFIGURATION_QUEUETYPE";
+static std::string CONNECTIONCONFIGURATION_QUEUECAPACITY = "CONNECTIONCONFIGURATION_QUEUECAPACITY";
+static std::string CONNECTIONCONFIGURATION_READERQUEUEDEPTH = "CONNECTIONCONFIGURATION_READERQUEUEDEPTH";
+static std::string CONNECTIONCONFIGURATION_WRITERQUEUEDEPTH = "CONNECTIONCONFIGURATION_WRITERQUEUEDEPTH";
+static std::string CONNECTIONCONFIGURATION_READEROVERFLOWPOLICY = "CONNECTIONCONFIGURATION_READEROVERFLOWPOLICY";
+static std::string CONNECTIONCONFIGURATION_WRITEROVERFLOWPOLICY = "CONNECTIONCONFIGURATION_WRITEROVERFLOWPOLICY";
+static std::string CONNECTIONCONFIGURATION_OVERFLOWTIMEOUT = "CONNECTIONCONFIGURATION_OVERFLOWTIMEOUT";
+static std::string CONNECTIONCONFIGURATION_MESSAGEARENASIZE = "CONNECTIONCONFIGURATION_MESSAGEARENASIZE";
+static std::string CONNECTIONCONFIGURATION_HANDLERTHREADCOUNT = "CONNECTIONCONFIGURATION_HANDLERTHREADCOUNT";
+static std::string CONNECTIONCONFIGURATION_LATENCYTRACING = "CONNECTIONCONFIGURATION_LATENCYTRACING";
+static std::string CONNECTIONCONFIGURATION_PRIORITYWEIGHT = "CONNECTIONCONFIGURATION_PRIORITYWEIGHT";
 } // namespace internal
 } // namespace ghost
 
@@ -42,6 +53,39 @@ ConnectionConfiguration::ConnectionConfiguration(const std::string& name)
 
 	ghost::ConfigurationValue defaultBlocking;
 	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_BLOCKING, defaultBlocking);
+
+	ghost::ConfigurationValue defaultQueueType;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_QUEUETYPE, defaultQueueType);
+
+	ghost::ConfigurationValue defaultQueueCapacity;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_QUEUECAPACITY, defaultQueueCapacity);
+
+	ghost::ConfigurationValue defaultReaderQueueDepth;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_READERQUEUEDEPTH, defaultReaderQueueDepth);
+
+	ghost::ConfigurationValue defaultWriterQueueDepth;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_WRITERQUEUEDEPTH, defaultWriterQueueDepth);
+
+	ghost::ConfigurationValue defaultReaderOverflowPolicy;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_READEROVERFLOWPOLICY, defaultReaderOverflowPolicy);
+
+	ghost::ConfigurationValue defaultWriterOverflowPolicy;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_WRITEROVERFLOWPOLICY, defaultWriterOverflowPolicy);
+
+	ghost::ConfigurationValue defaultOverflowTimeout;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_OVERFLOWTIMEOUT, defaultOverflowTimeout);
+
+	ghost::ConfigurationValue defaultMessageArenaSize;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_MESSAGEARENASIZE, defaultMessageArenaSize);
+
+	ghost::ConfigurationValue defaultHandlerThreadCount;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_HANDLERTHREADCOUNT, defaultHandlerThreadCount);
+
+	ghost::ConfigurationValue defaultLatencyTracing;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_LATENCYTRACING, defaultLatencyTracing);
+
+	ghost::ConfigurationValue defaultPriorityWeight;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_PRIORITYWEIGHT, defaultPriorityWeight);
 }
 
 int ConnectionConfiguration::getConnectionId() const
@@ -86,6 +130,160 @@ bool ConnectionConfiguration::isOperationBlocking() const
 	return res;
 }
 
+ConnectionConfiguration::QueueType ConnectionConfiguration::getQueueType() const
+{
+	int res = (int)QueueType::BLOCKING_QUEUE;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<int>((int)QueueType::BLOCKING_QUEUE);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATION_QUEUETYPE, value,
+				     defaultValue); // if the field was removed, returns BLOCKING_QUEUE
+	value.read<int>(res);
+
+	return (QueueType)res;
+}
+
+size_t ConnectionConfiguration::getQueueCapacity() const
+{
+	size_t res = 1024;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<size_t>(1024);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATION_QUEUECAPACITY, value,
+				     defaultValue); // if the field was removed, returns 1024
+	value.read<size_t>(res);
+
+	return res;
+}
+
+size_t ConnectionConfiguration::getReaderQueueDepth() const
+{
+	size_t res = 0;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<size_t>(0);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATION_READERQUEUEDEPTH, value,
+				     defaultValue); // if the field was removed, returns 0
+	value.read<size_t>(res);
+
+	return res;
+}
+
+size_t ConnectionConfiguration::getWriterQueueDepth() const
+{
+	size_t res = 0;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<size_t>(0);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATION_WRITERQUEUEDEPTH, value,
+				     defaultValue); // if the field was removed, returns 0
+	value.read<size_t>(res);
+
+	return res;
+}
+
+ConnectionConfiguration::OverflowPolicy ConnectionConfiguration::getReaderOverflowPolicy() const
+{
+	int res = (int)OverflowPolicy::BLOCK;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<int>((int)OverflowPolicy::BLOCK);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATION_READEROVERFLOWPOLICY, value,
+				     defaultValue); // if the field was removed, returns BLOCK
+	value.read<int>(res);
+
+	return (OverflowPolicy)res;
+}
+
+ConnectionConfiguration::OverflowPolicy ConnectionConfiguration::getWriterOverflowPolicy() const
+{
+	int res = (int)OverflowPolicy::BLOCK;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<int>((int)OverflowPolicy::BLOCK);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATION_WRITEROVERFLOWPOLICY, value,
+				     defaultValue); // if the field was removed, returns BLOCK
+	value.read<int>(res);
+
+	return (OverflowPolicy)res;
+}
+
+std::chrono::milliseconds ConnectionConfiguration::getOverflowTimeout() const
+{
+	long long res = -1;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<long long>(-1);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATION_OVERFLOWTIMEOUT, value,
+				     defaultValue); // if the field was removed, returns -1
+	value.read<long long>(res);
+
+	return std::chrono::milliseconds(res);
+}
+
+size_t ConnectionConfiguration::getMessageArenaSize() const
+{
+	size_t res = 0;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<size_t>(0);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATION_MESSAGEARENASIZE, value,
+				     defaultValue); // if the field was removed, returns 0
+	value.read<size_t>(res);
+
+	return res;
+}
+
+size_t ConnectionConfiguration::getHandlerThreadCount() const
+{
+	size_t res = 0;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<size_t>(0);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATION_HANDLERTHREADCOUNT, value,
+				     defaultValue); // if the field was removed, returns 0
+	value.read<size_t>(res);
+
+	return res;
+}
+
+bool ConnectionConfiguration::isLatencyTracingEnabled() const
+{
+	bool res = false;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<bool>(false);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATION_LATENCYTRACING, value,
+				     defaultValue); // if the field was removed, returns false
+	value.read<bool>(res);
+
+	return res;
+}
+
+size_t ConnectionConfiguration::getPriorityWeight() const
+{
+	size_t res = 8;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<size_t>(8);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATION_PRIORITYWEIGHT, value,
+				     defaultValue); // if the field was removed, returns 8
+	value.read<size_t>(res);
+
+	return res;
+}
+
 // setters of connection configuration parameters
 void ConnectionConfiguration::setConnectionId(int id)
 {
@@ -111,6 +309,94 @@ void ConnectionConfiguration::setOperationBlocking(bool blocking)
 				     true); // checks if the attribute is there as well
 }
 
+void ConnectionConfiguration::setQueueType(QueueType type)
+{
+	ghost::ConfigurationValue value;
+	value.write<int>((int)type);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_QUEUETYPE, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfiguration::setQueueCapacity(size_t capacity)
+{
+	ghost::ConfigurationValue value;
+	value.write<size_t>(capacity);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_QUEUECAPACITY, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfiguration::setReaderQueueDepth(size_t depth)
+{
+	ghost::ConfigurationValue value;
+	value.write<size_t>(depth);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_READERQUEUEDEPTH, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfiguration::setWriterQueueDepth(size_t depth)
+{
+	ghost::ConfigurationValue value;
+	value.write<size_t>(depth);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_WRITERQUEUEDEPTH, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfiguration::setReaderOverflowPolicy(OverflowPolicy policy)
+{
+	ghost::ConfigurationValue value;
+	value.write<int>((int)policy);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_READEROVERFLOWPOLICY, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfiguration::setWriterOverflowPolicy(OverflowPolicy policy)
+{
+	ghost::ConfigurationValue value;
+	value.write<int>((int)policy);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_WRITEROVERFLOWPOLICY, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfiguration::setOverflowTimeout(std::chrono::milliseconds timeout)
+{
+	ghost::ConfigurationValue value;
+	value.write<long long>(timeout.count());
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_OVERFLOWTIMEOUT, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfiguration::setMessageArenaSize(size_t size)
+{
+	ghost::ConfigurationValue value;
+	value.write<size_t>(size);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_MESSAGEARENASIZE, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfiguration::setHandlerThreadCount(size_t count)
+{
+	ghost::ConfigurationValue value;
+	value.write<size_t>(count);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_HANDLERTHREADCOUNT, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfiguration::setLatencyTracingEnabled(bool enabled)
+{
+	ghost::ConfigurationValue value;
+	value.write<bool>(enabled);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_LATENCYTRACING, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfiguration::setPriorityWeight(size_t weight)
+{
+	ghost::ConfigurationValue value;
+	value.write<size_t>(weight);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATION_PRIORITYWEIGHT, value,
+				     true); // checks if the attribute is there as well
+}
+
 std::shared_ptr<ghost::Configuration> ConnectionConfiguration::getConfiguration() const
 {
 	return _configuration;
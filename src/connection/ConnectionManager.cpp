@@ -75,6 +75,13 @@ std::shared_ptr<ghost::ConnectionFactory> ConnectionManager::getConnectionFactor
 	return _connectionFactory;
 }
 
+ghost::ConnectionStatistics ConnectionManager::getStatistics() const
+{
+	ghost::ConnectionStatistics statistics;
+	for (const auto& connection : _connections) statistics += connection->getStatistics();
+	return statistics;
+}
+
 void ConnectionManager::purgeDeadClients()
 {
 	auto it = _connections.begin();
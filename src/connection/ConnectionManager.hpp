@@ -44,6 +44,8 @@ public:
 
 	std::shared_ptr<ghost::ConnectionFactory> getConnectionFactory() override;
 
+	ghost::ConnectionStatistics getStatistics() const override;
+
 private:
 	void purgeDeadClients();
 
@@ -14,79 +14,137 @@
  * limitations under the License.
  */
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include <cstring>
 #include <ghost/connection/internal/GenericMessageConverter.hpp>
 #include <ghost/connection/internal/ProtobufMessage.hpp>
+#include <limits>
 
 #include "../../protobuf/ghost/connection/GenericMessage.pb.h"
 
 using namespace ghost::internal;
 
-bool GenericMessageConverter::create(google::protobuf::Any& message, const ghost::Message& from)
+namespace
+{
+// field numbers of GenericMessage, the envelope is read and written without GenericMessage objects
+const int SERIAL_FIELD_NUMBER = 2;
+const int FORMAT_FIELD_NUMBER = 3;
+const int NAME_FIELD_NUMBER = 4;
+
+// the tag of a field number below 16 fits in one byte
+size_t getFieldSize(const std::string& value)
+{
+	return 1 + google::protobuf::io::CodedOutputStream::VarintSize32(static_cast<uint32_t>(value.size())) +
+	       value.size();
+}
+
+uint8_t* writeField(uint8_t* target, int fieldNumber, const std::string& value)
+{
+	target = google::protobuf::io::CodedOutputStream::WriteTagToArray(
+	    google::protobuf::internal::WireFormatLite::MakeTag(
+		fieldNumber, google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED),
+	    target);
+	target = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(static_cast<uint32_t>(value.size()),
+									       target);
+	if (!value.empty()) std::memcpy(target, value.data(), value.size());
+	return target + value.size();
+}
+
+const std::string& getGenericMessageTypeUrl()
+{
+	static const std::string typeUrl =
+	    "type.googleapis.com/" + ghost::protobuf::connection::GenericMessage::descriptor()->full_name();
+	return typeUrl;
+}
+} // namespace
+
+bool BufferView::operator==(const BufferView& other) const
 {
-	std::shared_ptr<google::protobuf::Message> payload;
+	return size == other.size && (size == 0 || std::memcmp(data, other.data, size) == 0);
+}
+
+bool BufferView::operator==(const std::string& other) const
+{
+	return *this == BufferView{other.data(), other.size()};
+}
 
+bool GenericMessageConverter::create(google::protobuf::Any& message, const ghost::Message& from)
+{
 	std::string formatName = from.getMessageFormatName();
 	if (formatName == internal::GHOSTMESSAGE_FORMAT_NAME) // this is already a protobuf message
 	{
 		const ghost::internal::ProtobufMessage& fromProtobuf =
 		    static_cast<const ghost::internal::ProtobufMessage&>(from);
-		payload = fromProtobuf.getProtobufMessage();
+		auto payload = fromProtobuf.getProtobufMessage();
 
 		if (!payload)
 		{
 			return false; // there is no message in this source, return false as documented
 		}
+
+		return create(message, *payload);
 	}
-	else // this is a user format
-	{
-		std::string fromSerialized;
-		bool serializationSuccess = from.serialize(fromSerialized);
-		if (!serializationSuccess)
-		{
-			return false; // serialization failed, return false as documented
-		}
 
-		auto defaultPayload = std::make_shared<protobuf::connection::GenericMessage>();
-		defaultPayload->set_format(formatName);
-		defaultPayload->set_name(from.getMessageTypeName());
-		defaultPayload->set_serial(fromSerialized);
-		payload = defaultPayload;
+	// this is a user format: its size is only known once serialized, so it is serialized in a buffer reused
+	// by the thread, then the GenericMessage envelope is written in a value sized once for all its fields
+	thread_local std::string serial;
+	serial.clear();
+	bool serializationSuccess = from.serialize(serial);
+	if (!serializationSuccess || serial.size() > std::numeric_limits<int32_t>::max())
+	{
+		message.Clear();
+		return false; // serialization failed, return false as documented
 	}
 
-	// fill the message
-	message.PackFrom(*payload);
+	std::string name = from.getMessageTypeName();
+	// proto3 does not serialize default values
+	size_t size = getFieldSize(serial) + (formatName.empty() ? 0 : getFieldSize(formatName)) +
+		      (name.empty() ? 0 : getFieldSize(name));
+
+	std::string* value = message.mutable_value();
+	value->resize(size);
+	uint8_t* target = reinterpret_cast<uint8_t*>(&(*value)[0]);
+	target = writeField(target, SERIAL_FIELD_NUMBER, serial);
+	if (!formatName.empty()) target = writeField(target, FORMAT_FIELD_NUMBER, formatName);
+	if (!name.empty()) writeField(target, NAME_FIELD_NUMBER, name);
+	message.set_type_url(getGenericMessageTypeUrl());
+
+	return true;
+}
 
+bool GenericMessageConverter::create(google::protobuf::Any& message, const google::protobuf::Message& from)
+{
+	message.PackFrom(from);
 	return true;
 }
 
 bool GenericMessageConverter::parse(const google::protobuf::Any& message, ghost::Message& to)
 {
 	std::string targetFormatName = to.getMessageFormatName();
-	std::string targetTypeName = to.getMessageTypeName();
 
-	if (getTrueTypeName(message) ==
-	    protobuf::connection::GenericMessage::descriptor()->full_name()) // payload is of a user defined format
+	if (isGenericMessage(message)) // payload is of a user defined format
 	{
-		protobuf::connection::GenericMessage defaultPayload;
-		bool unpackSuccess = message.UnpackTo(&defaultPayload);
-		if (!unpackSuccess)
+		GenericMessageEnvelope envelope;
+		if (!parseEnvelope(message, envelope))
 		{
-			return false; // failed to convert Any to default payload, return false as documented
+			return false; // failed to read the envelope, return false as documented
 		}
 
-		if (defaultPayload.format() != targetFormatName)
+		if (!(envelope.format == targetFormatName))
 		{
 			return false; // source format is different than the format expected by the user, return false
 				      // as documented
 		}
 
-		if (defaultPayload.name() != targetTypeName)
+		if (!(envelope.name == to.getMessageTypeName()))
 		{
 			return false;
 		}
 
 		// deserialize
-		return to.deserialize(defaultPayload.serial());
+		return to.deserialize(envelope.serial.toString());
 	}
 
 	// else, payload is a protobuf message
@@ -107,62 +165,114 @@ bool GenericMessageConverter::parse(const google::protobuf::Any& message, ghost:
 	return message.UnpackTo(toProtobuf.getProtobufMessage().get());
 }
 
+bool GenericMessageConverter::parse(const google::protobuf::Any& message, google::protobuf::Message& to)
+{
+	if (isGenericMessage(message)) return false; // payload is of a user defined format
+
+	return message.UnpackTo(&to);
+}
+
 std::string GenericMessageConverter::getFormatName(const google::protobuf::Any& message)
 {
 	// if the any message is not a default payload, then it's already a protobuf message
-	if (getTrueTypeName(message) != protobuf::connection::GenericMessage::descriptor()->full_name())
+	if (!isGenericMessage(message))
 	{
 		return internal::GHOSTMESSAGE_FORMAT_NAME;
 	}
 
-	protobuf::connection::GenericMessage defaultPayload;
-	bool unpackSuccess = message.UnpackTo(&defaultPayload);
-	if (!unpackSuccess)
+	GenericMessageEnvelope envelope;
+	if (!parseEnvelope(message, envelope))
 	{
 		return "UNKNOWN"; // cannot convert it back to a default payload although it is not a native protobuf
 				  // message... who sent the message!?
 	}
 
-	return defaultPayload.format(); // return the format stored in the default payload message
+	return envelope.format.toString(); // return the format stored in the default payload message
 }
 
 std::pair<std::string, std::string> GenericMessageConverter::getFormatAndName(const google::protobuf::Any& message)
 {
-	std::string format, name;
-
 	// if the any message is not a default payload, then it's already a protobuf message
-	if (getTrueTypeName(message) != protobuf::connection::GenericMessage::descriptor()->full_name())
+	if (!isGenericMessage(message))
+	{
+		return std::make_pair(internal::GHOSTMESSAGE_FORMAT_NAME, getTrueTypeName(message));
+	}
+
+	GenericMessageEnvelope envelope;
+	if (!parseEnvelope(message, envelope))
 	{
-		format = internal::GHOSTMESSAGE_FORMAT_NAME;
-		name = getTrueTypeName(message);
+		// cannot convert it back to a default payload although it is not a native protobuf message... who sent
+		// the message!?
+		return std::make_pair(std::string("UNKNOWN"), std::string("UNKNOWN"));
 	}
-	else
+
+	return std::make_pair(envelope.format.toString(), envelope.name.toString());
+}
+
+bool GenericMessageConverter::parseEnvelope(const google::protobuf::Any& message, GenericMessageEnvelope& envelope)
+{
+	using google::protobuf::internal::WireFormatLite;
+
+	if (!isGenericMessage(message)) return false;
+
+	const std::string& value = message.value();
+	envelope.format = BufferView{value.data(), 0};
+	envelope.name = BufferView{value.data(), 0};
+	envelope.serial = BufferView{value.data(), 0};
+
+	google::protobuf::io::CodedInputStream input(reinterpret_cast<const uint8_t*>(value.data()),
+						     static_cast<int>(value.size()));
+	uint32_t tag;
+	while ((tag = input.ReadTag()) != 0)
 	{
-		protobuf::connection::GenericMessage defaultPayload;
-		bool unpackSuccess = message.UnpackTo(&defaultPayload);
-		if (!unpackSuccess)
+		if (WireFormatLite::GetTagWireType(tag) != WireFormatLite::WIRETYPE_LENGTH_DELIMITED)
 		{
-			format = "UNKNOWN"; // cannot convert it back to a default payload although it is not a native
-					    // protobuf message... who sent the message!?
-			name = "UNKNOWN";
+			if (!WireFormatLite::SkipField(&input, tag)) return false;
+			continue;
 		}
-		else
+
+		// the field is referenced in place instead of being copied
+		uint32_t length;
+		if (!input.ReadVarint32(&length)) return false;
+		BufferView field{value.data() + input.CurrentPosition(), length};
+		if (!input.Skip(static_cast<int>(length))) return false;
+
+		switch (WireFormatLite::GetTagFieldNumber(tag))
 		{
-			format = defaultPayload.format();
-			name = defaultPayload.name();
+			case SERIAL_FIELD_NUMBER:
+				envelope.serial = field;
+				break;
+			case FORMAT_FIELD_NUMBER:
+				envelope.format = field;
+				break;
+			case NAME_FIELD_NUMBER:
+				envelope.name = field;
+				break;
+			default: // the header, and unknown fields
+				break;
 		}
 	}
 
-	return std::make_pair(format, name);
+	return input.ConsumedEntireMessage();
+}
+
+bool GenericMessageConverter::isGenericMessage(const google::protobuf::Any& message)
+{
+	return getTrueTypeNameView(message) == protobuf::connection::GenericMessage::descriptor()->full_name();
 }
 
 std::string GenericMessageConverter::getTrueTypeName(const google::protobuf::Any& message)
+{
+	return getTrueTypeNameView(message).toString();
+}
+
+BufferView GenericMessageConverter::getTrueTypeNameView(const google::protobuf::Any& message)
 {
 	const std::string& url = message.type_url();
 	size_t last = url.find_last_of('/');
 	if (last == std::string::npos)
 	{
-		return url;
+		return BufferView{url.data(), url.size()};
 	}
-	return url.substr(last + 1);
+	return BufferView{url.data() + last + 1, url.size() - last - 1};
 }
@@ -0,0 +1,216 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LatencyTracer.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "../../protobuf/ghost/connection/GenericMessage.pb.h"
+
+using namespace ghost::internal;
+
+const size_t LatencyHistogram::SUB_BUCKET_BITS;
+const size_t LatencyHistogram::SUB_BUCKET_COUNT;
+const size_t LatencyHistogram::BUCKET_COUNT;
+const int LatencyTracer::HEADER_FIELD_NUMBER;
+
+namespace
+{
+int64_t toNanoseconds(std::chrono::system_clock::time_point time)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+std::string readHostName()
+{
+#ifdef _WIN32
+	const char* name = std::getenv("COMPUTERNAME");
+	return name ? name : "";
+#else
+	char name[256] = {};
+	if (gethostname(name, sizeof(name) - 1) != 0) return "";
+	return name;
+#endif
+}
+
+const std::string& getHostName()
+{
+	static const std::string hostName = readHostName();
+	return hostName;
+}
+
+/// Returns the index of the header in the unknown fields of a message, or -1 if the message does not have one.
+int findHeader(const google::protobuf::UnknownFieldSet& fields)
+{
+	for (int i = 0; i < fields.field_count(); ++i)
+	{
+		const google::protobuf::UnknownField& field = fields.field(i);
+		if (field.number() == LatencyTracer::HEADER_FIELD_NUMBER &&
+		    field.type() == google::protobuf::UnknownField::TYPE_LENGTH_DELIMITED)
+			return i;
+	}
+	return -1;
+}
+
+/// Returns the serialized header of the message to complete it, or nullptr if the message does not have one.
+std::string* findMutableHeader(google::protobuf::Message& message)
+{
+	const google::protobuf::Reflection* reflection = message.GetReflection();
+	// the unknown fields are checked first since they are allocated by MutableUnknownFields()
+	const google::protobuf::UnknownFieldSet& fields = reflection->GetUnknownFields(message);
+	if (fields.empty()) return nullptr;
+
+	int index = findHeader(fields);
+	if (index < 0) return nullptr;
+
+	return reflection->MutableUnknownFields(&message)->mutable_field(index)->mutable_length_delimited();
+}
+} // namespace
+
+LatencyHistogram::LatencyHistogram()
+{
+	for (auto& count : _counts) count.store(0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration)
+{
+	// a negative duration results from clocks that are not synchronized
+	uint64_t value = duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0;
+	_counts[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+}
+
+ghost::LatencyPercentiles LatencyHistogram::getPercentiles() const
+{
+	uint64_t total = 0;
+	for (const auto& count : _counts) total += count.load(std::memory_order_relaxed);
+
+	return ghost::LatencyPercentiles{static_cast<size_t>(total), getPercentile(total, 0.5),
+					 getPercentile(total, 0.99), getPercentile(total, 0.999)};
+}
+
+size_t LatencyHistogram::getBucketIndex(uint64_t value)
+{
+	if (value < SUB_BUCKET_COUNT) return static_cast<size_t>(value);
+
+	// "value >> shift" is between SUB_BUCKET_COUNT and 2 * SUB_BUCKET_COUNT
+	size_t shift = 0;
+	while ((value >> shift) >= 2 * SUB_BUCKET_COUNT) shift++;
+
+	return (shift + 1) * SUB_BUCKET_COUNT + static_cast<size_t>((value >> shift) - SUB_BUCKET_COUNT);
+}
+
+uint64_t LatencyHistogram::getBucketValue(size_t index)
+{
+	if (index < SUB_BUCKET_COUNT) return index;
+
+	// middle of the bucket
+	size_t shift = index / SUB_BUCKET_COUNT - 1;
+	uint64_t lower = static_cast<uint64_t>(SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT) << shift;
+	return lower + ((uint64_t(1) << shift) >> 1);
+}
+
+std::chrono::nanoseconds LatencyHistogram::getPercentile(uint64_t total, double percentile) const
+{
+	if (total == 0) return std::chrono::nanoseconds(0);
+
+	uint64_t rank = static_cast<uint64_t>(std::ceil(total * percentile));
+	if (rank == 0) rank = 1;
+
+	// the counts only grow while they are read: the rank is always reached
+	uint64_t cumulated = 0;
+	for (size_t i = 0; i < BUCKET_COUNT; ++i)
+	{
+		cumulated += _counts[i].load(std::memory_order_relaxed);
+		if (cumulated >= rank) return std::chrono::nanoseconds(getBucketValue(i));
+	}
+	return std::chrono::nanoseconds(getBucketValue(BUCKET_COUNT - 1));
+}
+
+void LatencyTracer::stampWrite(google::protobuf::Message& message)
+{
+	// a message relayed by another connection keeps the header of its first writer
+	if (findMutableHeader(message)) return;
+
+	auto now = std::chrono::system_clock::now();
+	ghost::protobuf::connection::GenericMessageHeader header;
+	header.set_timestamp(std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count());
+	header.set_hostname(getHostName());
+	header.set_write_time(toNanoseconds(now));
+
+	header.SerializeToString(
+	    message.GetReflection()->MutableUnknownFields(&message)->AddLengthDelimited(HEADER_FIELD_NUMBER));
+}
+
+void LatencyTracer::stampHandoff(google::protobuf::Message& message)
+{
+	std::string* serializedHeader = findMutableHeader(message);
+	if (!serializedHeader) return;
+
+	// parsing concatenated messages merges them: the new field is appended instead of parsing the header
+	ghost::protobuf::connection::GenericMessageHeader stamp;
+	stamp.set_handoff_time(toNanoseconds(std::chrono::system_clock::now()));
+	stamp.AppendToString(serializedHeader);
+}
+
+void LatencyTracer::stampReceipt(google::protobuf::Message& message)
+{
+	std::string* serializedHeader = findMutableHeader(message);
+	if (!serializedHeader) return;
+
+	ghost::protobuf::connection::GenericMessageHeader stamp;
+	stamp.set_receipt_time(toNanoseconds(std::chrono::system_clock::now()));
+	stamp.AppendToString(serializedHeader);
+}
+
+bool LatencyTracer::getHeader(const google::protobuf::Message& message,
+			      ghost::protobuf::connection::GenericMessageHeader& header)
+{
+	const google::protobuf::UnknownFieldSet& fields = message.GetReflection()->GetUnknownFields(message);
+	if (fields.empty()) return false;
+
+	int index = findHeader(fields);
+	return index >= 0 && header.ParseFromString(fields.field(index).length_delimited());
+}
+
+void LatencyTracer::record(const google::protobuf::Any& message, std::chrono::system_clock::time_point handlerStart,
+			   std::chrono::system_clock::time_point handlerEnd)
+{
+	_handler.record(handlerEnd - handlerStart);
+
+	ghost::protobuf::connection::GenericMessageHeader header;
+	if (!getHeader(message, header)) return;
+
+	// stages are measured if the transport stamped both of their ends
+	if (header.write_time() != 0 && header.handoff_time() != 0)
+		_writerQueue.record(std::chrono::nanoseconds(header.handoff_time() - header.write_time()));
+	if (header.handoff_time() != 0 && header.receipt_time() != 0)
+		_network.record(std::chrono::nanoseconds(header.receipt_time() - header.handoff_time()));
+	if (header.receipt_time() != 0)
+		_readerQueue.record(std::chrono::nanoseconds(toNanoseconds(handlerStart) - header.receipt_time()));
+	if (header.write_time() != 0)
+		_endToEnd.record(std::chrono::nanoseconds(toNanoseconds(handlerEnd) - header.write_time()));
+}
+
+ghost::LatencyStatistics LatencyTracer::getStatistics() const
+{
+	return ghost::LatencyStatistics{_writerQueue.getPercentiles(), _network.getPercentiles(),
+					_readerQueue.getPercentiles(), _handler.getPercentiles(),
+					_endToEnd.getPercentiles()};
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_INTERNAL_LATENCYTRACER_HPP
+#define GHOST_INTERNAL_LATENCYTRACER_HPP
+
+#include <google/protobuf/any.pb.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ghost/connection/LatencyStatistics.hpp>
+
+namespace ghost
+{
+namespace protobuf
+{
+namespace connection
+{
+class GenericMessageHeader;
+}
+} // namespace protobuf
+
+namespace internal
+{
+/**
+ * Histogram of durations with logarithmic buckets, divided in 16 linear sub-buckets.
+ * Recording is lock-free and may be done by several threads at once.
+ */
+class LatencyHistogram
+{
+public:
+	LatencyHistogram();
+
+	void record(std::chrono::nanoseconds duration);
+	ghost::LatencyPercentiles getPercentiles() const;
+
+private:
+	static const size_t SUB_BUCKET_BITS = 4;
+	static const size_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+	/// durations below SUB_BUCKET_COUNT have their own bucket, the others one per power of two and sub-bucket.
+	static const size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+	static size_t getBucketIndex(uint64_t value);
+	static uint64_t getBucketValue(size_t index);
+	std::chrono::nanoseconds getPercentile(uint64_t total, double percentile) const;
+
+	std::array<std::atomic<uint64_t>, BUCKET_COUNT> _counts;
+};
+
+/**
+ * Traces the latency of the messages of a connection.
+ * Connections tracing their latency attach a ghost::protobuf::connection::GenericMessageHeader to the
+ * google::protobuf::Any envelope of the messages they write, as a field unknown to google.protobuf.Any.
+ * The header then travels with the message, whatever its format, and is completed at every stage of the
+ * delivery. Receivers that do not trace their latency ignore it.
+ */
+class LatencyTracer
+{
+public:
+	/// Field number of the header in the google.protobuf.Any envelope, which only uses the numbers 1 and 2.
+	static const int HEADER_FIELD_NUMBER = 15;
+
+	/// Attaches a header with the current time as write time, if the message does not have one already.
+	static void stampWrite(google::protobuf::Message& message);
+	/// Sets the time at which the message is handed off to the transport, if it has a header.
+	static void stampHandoff(google::protobuf::Message& message);
+	/// Sets the time at which the message is received, if it has a header.
+	static void stampReceipt(google::protobuf::Message& message);
+	/// Reads the header of the message, returns false if the message does not have one.
+	static bool getHeader(const google::protobuf::Message& message,
+			      ghost::protobuf::connection::GenericMessageHeader& header);
+
+	/// Records the latencies of a message whose handler was called between "handlerStart" and "handlerEnd".
+	void record(const google::protobuf::Any& message, std::chrono::system_clock::time_point handlerStart,
+		    std::chrono::system_clock::time_point handlerEnd);
+	ghost::LatencyStatistics getStatistics() const;
+
+private:
+	LatencyHistogram _writerQueue;
+	LatencyHistogram _network;
+	LatencyHistogram _readerQueue;
+	LatencyHistogram _handler;
+	LatencyHistogram _endToEnd;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_LATENCYTRACER_HPP
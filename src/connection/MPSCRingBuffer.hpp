@@ -0,0 +1,285 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_INTERNAL_MPSCRINGBUFFER_HPP
+#define GHOST_INTERNAL_MPSCRINGBUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "RingBuffer.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Lock-free bounded queue for any number of producer threads and one consumer thread.
+ * Every slot carries a sequence number telling whether it is free or holds a published
+ * element, producers reserve slots with a compare-and-swap on the tail index.
+ * push() blocks while the buffer is full.
+ */
+template <typename T>
+class MPSCRingBuffer : public RingBuffer<T>
+{
+public:
+	explicit MPSCRingBuffer(size_t capacity);
+
+	void push(const T& element) override;
+	bool tryPush(T&& element, size_t maximumSize, std::chrono::milliseconds timeout) override;
+	bool tryPushBatch(std::vector<T>&& elements, size_t maximumSize, std::chrono::milliseconds timeout) override;
+	void get(T& element) override;
+	bool tryGet(std::chrono::milliseconds timeout, T& element) override;
+	void pop() override;
+	bool pop(T& element) override;
+	bool tryPop(std::chrono::milliseconds timeout, T& element) override;
+	size_t tryPopBatch(std::chrono::milliseconds timeout, std::vector<T>& elements, size_t maximum) override;
+	size_t size() const override;
+
+private:
+	/// Updates the peak size of the queue from the index following the last published element.
+	void updatePeakSizeFromTail(size_t tail);
+
+	using RingBuffer<T>::CACHE_LINE_SIZE;
+
+	struct Slot
+	{
+		/// equals the slot position when free, position + 1 when an element is published.
+		std::atomic<size_t> sequence;
+		T element;
+	};
+
+	std::unique_ptr<Slot[]> _slots;
+	char _padding0[CACHE_LINE_SIZE];
+	/// Index of the next slot to read, only written by the consumer.
+	std::atomic<size_t> _head;
+	char _padding1[CACHE_LINE_SIZE];
+	/// Index of the next slot to reserve, shared by the producers.
+	std::atomic<size_t> _tail;
+	char _padding2[CACHE_LINE_SIZE];
+};
+
+/////////////////////////// Template definition ///////////////////////////
+
+template <typename T>
+MPSCRingBuffer<T>::MPSCRingBuffer(size_t capacity)
+    : RingBuffer<T>(capacity), _slots(new Slot[RingBuffer<T>::_capacity]), _head(0), _tail(0)
+{
+	for (size_t i = 0; i < RingBuffer<T>::_capacity; ++i) _slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <typename T>
+void MPSCRingBuffer<T>::push(const T& element)
+{
+	T copy(element);
+	tryPush(std::move(copy), 0, std::chrono::milliseconds(-1));
+}
+
+template <typename T>
+bool MPSCRingBuffer<T>::tryPush(T&& element, size_t maximumSize, std::chrono::milliseconds timeout)
+{
+	size_t limit = RingBuffer<T>::getLimit(maximumSize);
+	auto hasSpace = [&]() {
+		size_t head = _head.load(std::memory_order_acquire);
+		return _tail.load(std::memory_order_relaxed) - head < limit;
+	};
+
+	std::chrono::steady_clock::time_point deadline;
+	if (timeout > std::chrono::milliseconds(0)) deadline = std::chrono::steady_clock::now() + timeout;
+
+	size_t position = _tail.load(std::memory_order_relaxed);
+	Slot* slot;
+	while (true)
+	{
+		slot = &_slots[position & RingBuffer<T>::_mask];
+		size_t sequence = slot->sequence.load(std::memory_order_acquire);
+		intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+		if (difference < 0 || (difference == 0 && position - _head.load(std::memory_order_acquire) >= limit))
+		{
+			// the buffer is full: wait for the consumer to remove elements
+			if (timeout < std::chrono::milliseconds(0))
+				RingBuffer<T>::_writable.wait(hasSpace);
+			else if (timeout == std::chrono::milliseconds(0) ||
+				 !RingBuffer<T>::_writable.waitUntil(hasSpace, deadline))
+				return false;
+			position = _tail.load(std::memory_order_relaxed);
+		}
+		else if (difference == 0) // the slot is free: try to reserve it
+		{
+			if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+		}
+		else // another producer reserved this slot
+			position = _tail.load(std::memory_order_relaxed);
+	}
+
+	slot->element = std::move(element);
+	slot->sequence.store(position + 1, std::memory_order_release);
+	updatePeakSizeFromTail(position + 1);
+	RingBuffer<T>::_readable.notify();
+	return true;
+}
+
+template <typename T>
+bool MPSCRingBuffer<T>::tryPushBatch(std::vector<T>&& elements, size_t maximumSize, std::chrono::milliseconds timeout)
+{
+	size_t limit = RingBuffer<T>::getLimit(maximumSize);
+	size_t count = elements.size();
+	if (count > limit) return false; // would never fit
+	if (count == 0) return true;
+
+	// the consumer frees the slots in order: all the slots below head + limit are free
+	auto hasSpace = [&]() {
+		size_t head = _head.load(std::memory_order_acquire);
+		return _tail.load(std::memory_order_relaxed) + count - head <= limit;
+	};
+
+	std::chrono::steady_clock::time_point deadline;
+	if (timeout > std::chrono::milliseconds(0)) deadline = std::chrono::steady_clock::now() + timeout;
+
+	// reserves "count" consecutive slots with a single compare-and-swap
+	size_t position = _tail.load(std::memory_order_relaxed);
+	while (true)
+	{
+		if (position + count - _head.load(std::memory_order_acquire) > limit)
+		{
+			if (timeout < std::chrono::milliseconds(0))
+				RingBuffer<T>::_writable.wait(hasSpace);
+			else if (timeout == std::chrono::milliseconds(0) ||
+				 !RingBuffer<T>::_writable.waitUntil(hasSpace, deadline))
+				return false;
+			position = _tail.load(std::memory_order_relaxed);
+		}
+		else if (_tail.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+			break;
+	}
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		Slot& slot = _slots[(position + i) & RingBuffer<T>::_mask];
+		slot.element = std::move(elements[i]);
+		slot.sequence.store(position + i + 1, std::memory_order_release);
+	}
+	updatePeakSizeFromTail(position + count);
+	RingBuffer<T>::_readable.notify();
+	return true;
+}
+
+template <typename T>
+void MPSCRingBuffer<T>::get(T& element)
+{
+	tryGet(std::chrono::milliseconds(-1), element);
+}
+
+template <typename T>
+bool MPSCRingBuffer<T>::tryGet(std::chrono::milliseconds timeout, T& element)
+{
+	size_t head = _head.load(std::memory_order_relaxed);
+	Slot& slot = _slots[head & RingBuffer<T>::_mask];
+	auto hasElement = [&]() { return slot.sequence.load(std::memory_order_acquire) == head + 1; };
+	if (!RingBuffer<T>::_readable.waitFor(hasElement, timeout)) return false;
+
+	element = slot.element;
+	return true;
+}
+
+template <typename T>
+void MPSCRingBuffer<T>::pop()
+{
+	size_t head = _head.load(std::memory_order_relaxed);
+	Slot& slot = _slots[head & RingBuffer<T>::_mask];
+	if (slot.sequence.load(std::memory_order_acquire) != head + 1) return; // nothing to remove
+
+	slot.element = T(); // releases the memory held by the element
+	slot.sequence.store(head + RingBuffer<T>::_capacity, std::memory_order_release);
+	_head.store(head + 1, std::memory_order_release);
+	RingBuffer<T>::_writable.notify();
+}
+
+template <typename T>
+bool MPSCRingBuffer<T>::pop(T& element)
+{
+	size_t head = _head.load(std::memory_order_relaxed);
+	Slot& slot = _slots[head & RingBuffer<T>::_mask];
+	if (slot.sequence.load(std::memory_order_acquire) != head + 1) return false;
+
+	element = std::move(slot.element);
+	slot.element = T();
+	slot.sequence.store(head + RingBuffer<T>::_capacity, std::memory_order_release);
+	_head.store(head + 1, std::memory_order_release);
+	RingBuffer<T>::_writable.notify();
+	return true;
+}
+
+template <typename T>
+bool MPSCRingBuffer<T>::tryPop(std::chrono::milliseconds timeout, T& element)
+{
+	size_t head = _head.load(std::memory_order_relaxed);
+	Slot& slot = _slots[head & RingBuffer<T>::_mask];
+	auto hasElement = [&]() { return slot.sequence.load(std::memory_order_acquire) == head + 1; };
+	if (!RingBuffer<T>::_readable.waitFor(hasElement, timeout)) return false;
+
+	return pop(element);
+}
+
+template <typename T>
+size_t MPSCRingBuffer<T>::tryPopBatch(std::chrono::milliseconds timeout, std::vector<T>& elements, size_t maximum)
+{
+	size_t head = _head.load(std::memory_order_relaxed);
+	auto isPublished = [this](size_t position) {
+		return _slots[position & RingBuffer<T>::_mask].sequence.load(std::memory_order_acquire) == position + 1;
+	};
+	if (maximum == 0 || !RingBuffer<T>::_readable.waitFor([&]() { return isPublished(head); }, timeout))
+		return 0;
+
+	// stops at the first slot that is reserved but not published yet to keep the order of the elements
+	size_t count = 0;
+	while (count < maximum && isPublished(head + count))
+	{
+		Slot& slot = _slots[(head + count) & RingBuffer<T>::_mask];
+		elements.push_back(std::move(slot.element));
+		slot.element = T();
+		slot.sequence.store(head + count + RingBuffer<T>::_capacity, std::memory_order_release);
+		++count;
+	}
+	_head.store(head + count, std::memory_order_release);
+	RingBuffer<T>::_writable.notify();
+	return count;
+}
+
+template <typename T>
+void MPSCRingBuffer<T>::updatePeakSizeFromTail(size_t tail)
+{
+	// the head may have moved past "tail" if the consumer already removed the elements
+	size_t head = _head.load(std::memory_order_relaxed);
+	if (tail > head) MessageQueue<T>::updatePeakSize(tail - head);
+}
+
+template <typename T>
+size_t MPSCRingBuffer<T>::size() const
+{
+	size_t head = _head.load(std::memory_order_acquire);
+	size_t tail = _tail.load(std::memory_order_acquire);
+	return tail > head ? tail - head : 0; // counts the slots reserved by producers that are still being written
+}
+
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_MPSCRINGBUFFER_HPP
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessageDispatcher.hpp"
+
+using namespace ghost::internal;
+
+namespace
+{
+// number of messages a thread takes from its queue at once
+const size_t MAXIMUM_BATCH_SIZE = 64;
+} // namespace
+
+MessageDispatcher::MessageDispatcher(const ghost::ConnectionConfiguration& configuration, size_t threadCount,
+				     std::function<void(const google::protobuf::Any&, google::protobuf::Arena*)>
+					 process,
+				     ArenaPool* arenaPool)
+    : _process(process)
+    , _arenaPool(arenaPool)
+    , _processedMessages(0)
+    , _totalProcessingTime(0)
+    , _maximumProcessingTime(0)
+{
+	for (size_t i = 0; i < threadCount; ++i)
+		_workers.push_back(std::unique_ptr<Worker>(new Worker(*this, configuration)));
+
+	for (auto& worker : _workers) worker->start();
+}
+
+MessageDispatcher::~MessageDispatcher()
+{
+	for (auto& worker : _workers) worker->stop();
+}
+
+bool MessageDispatcher::dispatch(google::protobuf::Any&& message, size_t key)
+{
+	return _workers[key % _workers.size()]->put(std::move(message));
+}
+
+size_t MessageDispatcher::getBacklog() const
+{
+	size_t backlog = 0;
+	for (const auto& worker : _workers) backlog += worker->size();
+	return backlog;
+}
+
+size_t MessageDispatcher::getProcessedMessagesCount() const
+{
+	return _processedMessages;
+}
+
+std::chrono::nanoseconds MessageDispatcher::getTotalProcessingTime() const
+{
+	return std::chrono::nanoseconds(_totalProcessingTime.load());
+}
+
+std::chrono::nanoseconds MessageDispatcher::getMaximumProcessingTime() const
+{
+	return std::chrono::nanoseconds(_maximumProcessingTime.load());
+}
+
+void MessageDispatcher::process(const google::protobuf::Any& message, google::protobuf::Arena* arena)
+{
+	auto start = std::chrono::steady_clock::now();
+	_process(message, arena);
+	long long duration =
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+	_processedMessages++;
+	_totalProcessingTime += duration;
+	long long maximum = _maximumProcessingTime.load();
+	while (duration > maximum && !_maximumProcessingTime.compare_exchange_weak(maximum, duration))
+	{
+	}
+}
+
+MessageDispatcher::Worker::Worker(MessageDispatcher& parent, const ghost::ConnectionConfiguration& configuration)
+    : QueuedSink<google::protobuf::Any>(configuration, configuration.getReaderQueueDepth(),
+					configuration.getReaderOverflowPolicy())
+    , _parent(parent)
+    , _running(false)
+{
+}
+
+bool MessageDispatcher::Worker::put(google::protobuf::Any&& message)
+{
+	return enqueue(std::move(message));
+}
+
+size_t MessageDispatcher::Worker::size()
+{
+	return getMessageQueue()->size();
+}
+
+void MessageDispatcher::Worker::start()
+{
+	_running = true;
+	_thread = std::thread(&MessageDispatcher::Worker::run, this);
+}
+
+void MessageDispatcher::Worker::stop()
+{
+	_running = false;
+	getMessageQueue()->push(google::protobuf::Any()); // wakes the thread up, empty messages are not processed
+	if (_thread.joinable()) _thread.join();
+}
+
+void MessageDispatcher::Worker::run()
+{
+	std::vector<google::protobuf::Any> messages;
+	while (_running)
+	{
+		messages.clear();
+		getMessageQueue()->tryPopBatch(std::chrono::milliseconds(-1), messages, MAXIMUM_BATCH_SIZE);
+
+		// the arena is reset once, when the lease ends after the batch
+		ArenaPool::Lease arena = _parent._arenaPool ? _parent._arenaPool->acquire() : ArenaPool::Lease();
+		for (const auto& message : messages)
+		{
+			if (!message.type_url().empty()) _parent.process(message, arena.get());
+		}
+	}
+}
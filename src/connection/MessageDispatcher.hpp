@@ -0,0 +1,101 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_INTERNAL_MESSAGEDISPATCHER_HPP
+#define GHOST_INTERNAL_MESSAGEDISPATCHER_HPP
+
+#include <google/protobuf/any.pb.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <ghost/connection/ConnectionConfiguration.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ArenaPool.hpp"
+#include "QueuedSink.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Hands incoming messages over to a fixed number of threads which process them.
+ * Each thread owns a queue, configured like the reader queue of the connection. The
+ * messages are distributed according to their ordering key: messages with the same key
+ * are processed in order by the same thread, messages with different keys may be
+ * processed in parallel.
+ * If an arena pool is given, each thread leases one arena for every batch of messages it
+ * pops from its queue: the messages of the batch are parsed in this arena, which is reset
+ * once the whole batch was processed.
+ */
+class MessageDispatcher
+{
+public:
+	/// @param arenaPool the pool of the arenas leased for the batches, or nullptr to process
+	/// the messages without arena.
+	MessageDispatcher(const ghost::ConnectionConfiguration& configuration, size_t threadCount,
+			  std::function<void(const google::protobuf::Any&, google::protobuf::Arena*)> process,
+			  ArenaPool* arenaPool);
+	~MessageDispatcher();
+
+	/// Moves the message into the queue of the thread responsible for "key".
+	/// @return false if the message was rejected because the queue was full.
+	bool dispatch(google::protobuf::Any&& message, size_t key);
+
+	/// @return the number of messages waiting to be processed.
+	size_t getBacklog() const;
+	/// @return the number of messages that were processed.
+	size_t getProcessedMessagesCount() const;
+	/// @return the time spent processing the messages.
+	std::chrono::nanoseconds getTotalProcessingTime() const;
+	/// @return the longest time spent processing one message.
+	std::chrono::nanoseconds getMaximumProcessingTime() const;
+
+private:
+	class Worker : public QueuedSink<google::protobuf::Any>
+	{
+	public:
+		Worker(MessageDispatcher& parent, const ghost::ConnectionConfiguration& configuration);
+
+		bool put(google::protobuf::Any&& message);
+		size_t size();
+		void start();
+		void stop();
+
+	private:
+		void run();
+
+		MessageDispatcher& _parent;
+		std::atomic_bool _running;
+		std::thread _thread;
+	};
+
+	void process(const google::protobuf::Any& message, google::protobuf::Arena* arena);
+
+	std::function<void(const google::protobuf::Any&, google::protobuf::Arena*)> _process;
+	ArenaPool* _arenaPool;
+	std::vector<std::unique_ptr<Worker>> _workers;
+	std::atomic<size_t> _processedMessages;
+	std::atomic<long long> _totalProcessingTime;
+	std::atomic<long long> _maximumProcessingTime;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_MESSAGEDISPATCHER_HPP
@@ -16,19 +16,172 @@
 
 #include "MessageHandler.hpp"
 
-#include <ghost/connection/internal/GenericMessageConverter.hpp>
+#include <cstdint>
 
 using namespace ghost::internal;
 
-void MessageHandler::handle(const google::protobuf::Any& message)
+namespace
 {
-	std::pair<std::string, std::string> formatAndName = GenericMessageConverter::getFormatAndName(message);
+// FNV-1a
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
 
-	if (_handlers.count(formatAndName)) _handlers.at(formatAndName)->handle(message);
+uint64_t hashBuffer(const BufferView& view, uint64_t hash)
+{
+	for (size_t i = 0; i < view.size; ++i)
+	{
+		hash ^= static_cast<unsigned char>(view.data[i]);
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+} // namespace
+
+MessageHandler::MessageHandler(const ghost::ConnectionConfiguration& configuration,
+			       const std::shared_ptr<LatencyTracer>& latencyTracer)
+    : _orderingKey(&getTypeKey), _latencyTracer(latencyTracer)
+{
+	size_t arenaSize = configuration.getMessageArenaSize();
+	if (arenaSize > 0) _arenaPool.reset(new ArenaPool(arenaSize));
+
+	size_t threadCount = configuration.getHandlerThreadCount();
+	if (threadCount > 0)
+	{
+		auto process = [this](const google::protobuf::Any& message, google::protobuf::Arena* arena) {
+			this->process(message, arena);
+		};
+		_dispatcher.reset(new MessageDispatcher(configuration, threadCount, process, _arenaPool.get()));
+	}
+}
+
+bool MessageHandler::handle(const google::protobuf::Any& message)
+{
+	if (_dispatcher) return handle(google::protobuf::Any(message));
+
+	process(message);
+	return true;
+}
+
+bool MessageHandler::handle(google::protobuf::Any&& message)
+{
+	if (!_dispatcher)
+	{
+		process(message);
+		return true;
+	}
+
+	size_t key = _orderingKey(message);
+	return _dispatcher->dispatch(std::move(message), key);
+}
+
+void MessageHandler::setOrderingKey(std::function<size_t(const google::protobuf::Any& message)> key)
+{
+	_orderingKey = key;
+}
+
+MessageHandler::DispatchMetrics MessageHandler::getDispatchMetrics() const
+{
+	DispatchMetrics metrics{0, 0, std::chrono::nanoseconds(0), std::chrono::nanoseconds(0)};
+	if (!_dispatcher) return metrics;
+
+	metrics.backlog = _dispatcher->getBacklog();
+	metrics.handledMessages = _dispatcher->getProcessedMessagesCount();
+	metrics.totalHandlerTime = _dispatcher->getTotalProcessingTime();
+	metrics.maximumHandlerTime = _dispatcher->getMaximumProcessingTime();
+	return metrics;
+}
+
+void MessageHandler::process(const google::protobuf::Any& message, google::protobuf::Arena* arena)
+{
+	if (!_latencyTracer)
+	{
+		callHandler(message, arena);
+		return;
+	}
+
+	auto start = std::chrono::system_clock::now();
+	callHandler(message, arena);
+	_latencyTracer->record(message, start, std::chrono::system_clock::now());
+}
+
+void MessageHandler::callHandler(const google::protobuf::Any& message, google::protobuf::Arena* arena)
+{
+	if (GenericMessageConverter::isGenericMessage(message))
+	{
+		processUserFormat(message);
+		return;
+	}
+
+	auto it = _protobufHandlers.find(GenericMessageConverter::getTrueTypeNameView(message));
+	if (it == _protobufHandlers.end()) return;
+
+	if (arena || !_arenaPool)
+	{
+		it->second->callback->handle(message, arena);
+		return;
+	}
+
+	// the message is handled on its own, by the thread which received it
+	ArenaPool::Lease lease = _arenaPool->acquire();
+	it->second->callback->handle(message, lease.get());
 }
 
 void MessageHandler::addHandler(const std::string& format, const std::string& name,
 				std::unique_ptr<ghost::internal::BaseMessageHandlerCallback>&& handler)
 {
-	_handlers[std::make_pair(format, name)] = std::move(handler);
+	// the keys reference the names owned by the entries: the previous entry is removed first
+	std::unique_ptr<HandlerEntry> entry(new HandlerEntry());
+	entry->format = format;
+	entry->typeName = name;
+	entry->callback = std::move(handler);
+	BufferView formatView{entry->format.data(), entry->format.size()};
+	BufferView nameView{entry->typeName.data(), entry->typeName.size()};
+
+	if (format != internal::GHOSTMESSAGE_FORMAT_NAME)
+	{
+		_userHandlers.erase(UserHandlerKey{{format.data(), format.size()}, {name.data(), name.size()}});
+		_userHandlers.emplace(UserHandlerKey{formatView, nameView}, std::move(entry));
+		return;
+	}
+
+	_protobufHandlers.erase(BufferView{name.data(), name.size()});
+	_protobufHandlers.emplace(nameView, std::move(entry));
+}
+
+void MessageHandler::processUserFormat(const google::protobuf::Any& message)
+{
+	if (_userHandlers.empty()) return; // no need to decode the message
+
+	GenericMessageEnvelope envelope;
+	if (!GenericMessageConverter::parseEnvelope(message, envelope)) return;
+
+	auto handler = _userHandlers.find(UserHandlerKey{envelope.format, envelope.name});
+	if (handler != _userHandlers.end()) handler->second->callback->handleSerialized(envelope.serial);
+}
+
+size_t MessageHandler::getTypeKey(const google::protobuf::Any& message)
+{
+	GenericMessageEnvelope envelope;
+	if (GenericMessageConverter::parseEnvelope(message, envelope))
+		return UserHandlerKeyHash()(UserHandlerKey{envelope.format, envelope.name});
+
+	return BufferViewHash()(GenericMessageConverter::getTrueTypeNameView(message));
+}
+
+bool MessageHandler::UserHandlerKey::operator==(const UserHandlerKey& other) const
+{
+	return format == other.format && name == other.name;
+}
+
+size_t MessageHandler::BufferViewHash::operator()(const BufferView& view) const
+{
+	return static_cast<size_t>(hashBuffer(view, FNV_OFFSET_BASIS));
+}
+
+size_t MessageHandler::UserHandlerKeyHash::operator()(const UserHandlerKey& key) const
+{
+	// the separator prevents "ab" + "c" and "a" + "bc" from colliding
+	uint64_t hash = hashBuffer(key.format, FNV_OFFSET_BASIS);
+	hash = (hash ^ 0xFF) * FNV_PRIME;
+	return static_cast<size_t>(hashBuffer(key.name, hash));
 }
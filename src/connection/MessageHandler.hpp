@@ -19,11 +19,18 @@
 
 #include <google/protobuf/any.pb.h>
 
+#include <functional>
+#include <ghost/connection/ConnectionConfiguration.hpp>
 #include <ghost/connection/MessageHandler.hpp>
+#include <ghost/connection/internal/GenericMessageConverter.hpp>
 #include <ghost/connection/internal/MessageHandlerCallback.hpp>
-#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+
+#include "ArenaPool.hpp"
+#include "LatencyTracer.hpp"
+#include "MessageDispatcher.hpp"
 
 namespace ghost
 {
@@ -31,20 +38,80 @@ namespace internal
 {
 /**
  * Base class for message handlers.
+ * Handlers of protobuf messages are indexed by the type name found in the type URL of
+ * the incoming messages, so that dispatching them does not allocate. Messages of a user
+ * format are looked up with views on their envelope and their serialized payload is
+ * handed to the handler.
+ * If an arena size is configured, the protobuf messages are parsed in arenas taken from a pool
+ * for the duration of the call to the handler, or of the batch processed by a handler thread.
+ * If handler threads are configured, "handle" queues the messages for a MessageDispatcher
+ * whose threads call the handlers.
+ * If a latency tracer is given, it measures the calls to the handlers.
  * @author	Mathieu Nassar
  * @date	15.06.2018
  */
 class MessageHandler : public ghost::MessageHandler
 {
 public:
-	void handle(const google::protobuf::Any& message);
+	explicit MessageHandler(const ghost::ConnectionConfiguration& configuration = ghost::ConnectionConfiguration(),
+				const std::shared_ptr<LatencyTracer>& latencyTracer = nullptr);
+
+	/// @return false if the message was rejected because the queue of its handler thread was full.
+	bool handle(const google::protobuf::Any& message);
+	bool handle(google::protobuf::Any&& message);
+
+	void setOrderingKey(std::function<size_t(const google::protobuf::Any& message)> key) override;
+	DispatchMetrics getDispatchMetrics() const override;
 
 protected:
 	void addHandler(const std::string& format, const std::string& name,
 			std::unique_ptr<ghost::internal::BaseMessageHandlerCallback>&& handler) override;
 
 private:
-	std::map<std::pair<std::string, std::string>, std::unique_ptr<BaseMessageHandlerCallback>> _handlers;
+	struct BufferViewHash
+	{
+		size_t operator()(const BufferView& view) const;
+	};
+
+	/// Key of the user format handlers, referencing the names owned by the entry.
+	struct UserHandlerKey
+	{
+		BufferView format;
+		BufferView name;
+
+		bool operator==(const UserHandlerKey& other) const;
+	};
+
+	struct UserHandlerKeyHash
+	{
+		size_t operator()(const UserHandlerKey& key) const;
+	};
+
+	/// Owns the names referenced by the key of the entry.
+	struct HandlerEntry
+	{
+		std::string format;
+		std::string typeName;
+		std::unique_ptr<BaseMessageHandlerCallback> callback;
+	};
+
+	/// Calls the handler of the message, and records its latency if it is traced.
+	/// @param arena the arena leased for the batch of the message, or nullptr to lease one
+	/// for this message only.
+	void process(const google::protobuf::Any& message, google::protobuf::Arena* arena = nullptr);
+	void callHandler(const google::protobuf::Any& message, google::protobuf::Arena* arena);
+	void processUserFormat(const google::protobuf::Any& message);
+	/// @return the default ordering key: a hash of the type of the message.
+	static size_t getTypeKey(const google::protobuf::Any& message);
+
+	std::unique_ptr<ArenaPool> _arenaPool;
+	std::function<size_t(const google::protobuf::Any& message)> _orderingKey;
+	std::shared_ptr<LatencyTracer> _latencyTracer;
+	std::unordered_map<BufferView, std::unique_ptr<HandlerEntry>, BufferViewHash> _protobufHandlers;
+	/// Handlers of user formats, indexed by format name and message type name.
+	std::unordered_map<UserHandlerKey, std::unique_ptr<HandlerEntry>, UserHandlerKeyHash> _userHandlers;
+	/// Declared last: its threads are stopped before the handlers are destroyed.
+	std::unique_ptr<MessageDispatcher> _dispatcher;
 };
 } // namespace internal
 } // namespace ghost
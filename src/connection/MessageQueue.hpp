@@ -0,0 +1,111 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_INTERNAL_MESSAGEQUEUE_HPP
+#define GHOST_INTERNAL_MESSAGEQUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Interface of the queues used by the sinks to transfer messages between the
+ * user and the connection implementation.
+ * Elements are read with get() or tryGet() and only removed from the queue
+ * by a subsequent call to pop().
+ */
+template <typename T>
+class MessageQueue
+{
+public:
+	virtual ~MessageQueue() = default;
+
+	/// Adds an element at the end of the queue, waits as long as necessary if the queue is full.
+	virtual void push(const T& element) = 0;
+	/**
+	 * Moves an element at the end of the queue if it contains less than "maximumSize" elements.
+	 * The element is left unchanged if it could not be added.
+	 * @param maximumSize	maximum number of elements in the queue, zero if there is no limit.
+	 * @param timeout	how long to wait for space in the queue, negative to wait as long as necessary.
+	 * @return false if the element could not be added.
+	 */
+	virtual bool tryPush(T&& element, size_t maximumSize, std::chrono::milliseconds timeout) = 0;
+	/**
+	 * Moves all the elements at the end of the queue at once if they fit in "maximumSize".
+	 * Either all the elements are added, or none of them and they are left unchanged.
+	 * @param maximumSize	maximum number of elements in the queue, zero if there is no limit.
+	 * @param timeout	how long to wait for space in the queue, negative to wait as long as necessary.
+	 * @return false if the elements could not be added.
+	 */
+	virtual bool tryPushBatch(std::vector<T>&& elements, size_t maximumSize, std::chrono::milliseconds timeout) = 0;
+	/// Moves the oldest element that is not being read into "element" and removes it from the queue.
+	/// @return false if no element could be removed.
+	virtual bool dropOldest(T& element) = 0;
+	/// Blocks until an element is available and copies the head of the queue into "element".
+	virtual void get(T& element) = 0;
+	/// Copies the head of the queue into "element", waits up to "timeout" for it to be available.
+	virtual bool tryGet(std::chrono::milliseconds timeout, T& element) = 0;
+	/// Removes the head of the queue.
+	virtual void pop() = 0;
+	/// Moves the head of the queue into "element" and removes it. @return false if the queue was empty.
+	virtual bool pop(T& element) = 0;
+	/**
+	 * Moves the head of the queue into "element" and removes it, waits up to "timeout" for it to be available.
+	 * A negative timeout waits as long as necessary.
+	 * @return false if the queue was empty.
+	 */
+	virtual bool tryPop(std::chrono::milliseconds timeout, T& element) = 0;
+	/**
+	 * Moves up to "maximum" elements from the head of the queue to the end of "elements" and removes them,
+	 * waits up to "timeout" for the first one to be available. A negative timeout waits as long as necessary.
+	 * @return the number of elements that were moved.
+	 */
+	virtual size_t tryPopBatch(std::chrono::milliseconds timeout, std::vector<T>& elements, size_t maximum) = 0;
+	/// @return the number of elements in the queue.
+	virtual size_t size() const = 0;
+
+	/// @return the highest number of elements that were in the queue at the same time.
+	size_t peakSize() const
+	{
+		return _peakSize.load(std::memory_order_relaxed);
+	}
+
+protected:
+	MessageQueue() : _peakSize(0)
+	{
+	}
+
+	/// Called by the implementations after elements were added, with the resulting number of elements.
+	void updatePeakSize(size_t size)
+	{
+		size_t peak = _peakSize.load(std::memory_order_relaxed);
+		while (size > peak && !_peakSize.compare_exchange_weak(peak, size, std::memory_order_relaxed))
+		{
+		}
+	}
+
+private:
+	std::atomic<size_t> _peakSize;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_MESSAGEQUEUE_HPP
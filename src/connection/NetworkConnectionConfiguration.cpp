@@ -24,6 +24,7 @@ namespace internal
 {
 static std::string NETWORKCONNECTIONCONFIGURATION_SERVERIP = "NETWORKCONNECTIONCONFIGURATION_SERVERIP";
 static std::string NETWORKCONNECTIONCONFIGURATION_SERVERPORT = "NETWORKCONNECTIONCONFIGURATION_SERVERPORT";
+static std::string NETWORKCONNECTIONCONFIGURATION_UNIXSOCKETPATH = "NETWORKCONNECTIONCONFIGURATION_UNIXSOCKETPATH";
 } // namespace internal
 } // namespace ghost
 
@@ -36,6 +37,9 @@ NetworkConnectionConfiguration::NetworkConnectionConfiguration(const std::string
 
 	ghost::ConfigurationValue defaultPort;
 	_configuration->addAttribute(internal::NETWORKCONNECTIONCONFIGURATION_SERVERPORT, defaultPort);
+
+	ghost::ConfigurationValue defaultSocketPath;
+	_configuration->addAttribute(internal::NETWORKCONNECTIONCONFIGURATION_UNIXSOCKETPATH, defaultSocketPath);
 }
 
 // getters of connection configuration parameters
@@ -66,6 +70,19 @@ int NetworkConnectionConfiguration::getServerPortNumber() const
 	return res;
 }
 
+std::string NetworkConnectionConfiguration::getUnixSocketPath() const
+{
+	std::string res;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue("");
+
+	_configuration->getAttribute(internal::NETWORKCONNECTIONCONFIGURATION_UNIXSOCKETPATH, value,
+				     defaultValue); // if the field was removed, returns ""
+	if (!value.read<std::string>(res)) res.clear();
+
+	return res;
+}
+
 // setters of connection configuration parameters
 void NetworkConnectionConfiguration::setServerIpAddress(const std::string& ip)
 {
@@ -83,6 +100,14 @@ void NetworkConnectionConfiguration::setServerPortNumber(int port)
 				     true); // checks if the attribute is there as well
 }
 
+void NetworkConnectionConfiguration::setUnixSocketPath(const std::string& path)
+{
+	ghost::ConfigurationValue value;
+	value.write<std::string>(path);
+	_configuration->addAttribute(internal::NETWORKCONNECTIONCONFIGURATION_UNIXSOCKETPATH, value,
+				     true); // checks if the attribute is there as well
+}
+
 NetworkConnectionConfiguration NetworkConnectionConfiguration::initializeFrom(const ConnectionConfiguration& from)
 {
 	NetworkConnectionConfiguration newconfig(from.getConfiguration()->getConfigurationName());
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_INTERNAL_QUEUESIGNAL_HPP
+#define GHOST_INTERNAL_QUEUESIGNAL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Parks the threads waiting on a lock-free queue until another thread signals a change.
+ * Waiting threads spin shortly before falling back to a condition variable. The
+ * condition variable is only touched by notify() when a thread is actually parked,
+ * so that the fast path of the queues stays free of locks.
+ */
+class QueueSignal
+{
+public:
+	QueueSignal() : _waiters(0)
+	{
+	}
+
+	/// Blocks until "ready" returns true. Returns false if "deadline" was reached first.
+	template <typename Predicate>
+	bool waitUntil(const Predicate& ready, std::chrono::steady_clock::time_point deadline)
+	{
+		for (int i = 0; i < SPIN_ITERATIONS; ++i)
+		{
+			if (ready()) return true;
+			std::this_thread::yield();
+		}
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		_waiters.fetch_add(1);
+		std::atomic_thread_fence(std::memory_order_seq_cst); // pairs with the fence in notify()
+		bool result = _condition.wait_until(lock, deadline, ready);
+		_waiters.fetch_sub(1);
+		return result;
+	}
+
+	/// Blocks until "ready" returns true.
+	template <typename Predicate>
+	void wait(const Predicate& ready)
+	{
+		for (int i = 0; i < SPIN_ITERATIONS; ++i)
+		{
+			if (ready()) return;
+			std::this_thread::yield();
+		}
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		_waiters.fetch_add(1);
+		std::atomic_thread_fence(std::memory_order_seq_cst); // pairs with the fence in notify()
+		_condition.wait(lock, ready);
+		_waiters.fetch_sub(1);
+	}
+
+	/**
+	 * Blocks until "ready" returns true, or until "timeout" expired.
+	 * A negative timeout waits as long as necessary, a zero timeout does not wait.
+	 * @return the last value returned by "ready".
+	 */
+	template <typename Predicate>
+	bool waitFor(const Predicate& ready, std::chrono::milliseconds timeout)
+	{
+		if (ready()) return true;
+		if (timeout == std::chrono::milliseconds(0)) return false;
+
+		if (timeout < std::chrono::milliseconds(0))
+		{
+			wait(ready);
+			return true;
+		}
+		return waitUntil(ready, std::chrono::steady_clock::now() + timeout);
+	}
+
+	/// Wakes up the parked threads. Must be called after the state observed by the predicates changed.
+	void notify()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (_waiters.load(std::memory_order_relaxed) == 0) return;
+
+		// taking the lock guarantees that a waiter that evaluated its predicate is already waiting
+		std::lock_guard<std::mutex> lock(_mutex);
+		_condition.notify_all();
+	}
+
+private:
+	static const int SPIN_ITERATIONS = 64;
+
+	std::atomic<int> _waiters;
+	std::mutex _mutex;
+	std::condition_variable _condition;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_QUEUESIGNAL_HPP
@@ -17,31 +17,222 @@
 #ifndef GHOST_INTERNAL_QUEUEDSINK_HPP
 #define GHOST_INTERNAL_QUEUEDSINK_HPP
 
-#include <google/protobuf/any.pb.h>
+#include <algorithm>
+#include <atomic>
+#include <ghost/connection/ConnectionConfiguration.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
 
-#include <BlockingQueue.hpp>
+#include "BlockingMessageQueue.hpp"
+#include "MPSCRingBuffer.hpp"
+#include "MessageQueue.hpp"
+#include "SPSCRingBuffer.hpp"
 
 namespace ghost
 {
 namespace internal
 {
+/**
+ *	Base class of the sinks, owns the queue of elements shared between the
+ *	readers/writers and the connection. The backend of the queue is selected by
+ *	the connection configuration, its depth and overflow policy by the sink.
+ *	A sink may split its queue into several lanes, each of them with the depth
+ *	and the overflow policy of the sink.
+ *	The SPSC ring buffer is only used by the sinks whose elements are enqueued by a
+ *	single thread, the others use the MPSC ring buffer instead.
+ */
+template <typename ElementType>
 class QueuedSink
 {
 public:
-	QueuedSink() : _messageQueue(new BlockingQueue<google::protobuf::Any>())
-	{
-	}
+	/// @param singleProducer	true if the elements are enqueued by one thread at a time.
+	QueuedSink(const ghost::ConnectionConfiguration& configuration, size_t maximumDepth,
+		   ghost::ConnectionConfiguration::OverflowPolicy overflowPolicy, size_t lanes = 1,
+		   bool singleProducer = false);
 	virtual ~QueuedSink() = default;
 
+	/// @return the number of elements that were dropped or rejected because the queue was full.
+	size_t getDroppedMessagesCount() const;
+	/// @return the number of elements currently in the queue, summed over the lanes.
+	size_t getQueueDepth() const;
+	/// @return the highest number of elements that were in one lane of the queue at the same time.
+	size_t getQueuePeakDepth() const;
+
 protected:
-	std::shared_ptr<BlockingQueue<google::protobuf::Any>> getMessageQueue()
+	std::shared_ptr<MessageQueue<ElementType>> getMessageQueue(size_t lane = 0)
+	{
+		return _messageQueues[lane];
+	}
+
+	size_t getLanesCount() const
+	{
+		return _messageQueues.size();
+	}
+
+	/// Moves an element into the queue of "lane" according to the overflow policy.
+	/// @return false if the element was rejected.
+	bool enqueue(ElementType&& element, size_t lane = 0);
+	/// Moves all the elements into the queue of "lane" at once according to the overflow policy: if
+	/// they do not fit, the whole batch is rejected. @return false if the elements were rejected.
+	bool enqueueBatch(std::vector<ElementType>&& elements, size_t lane = 0);
+	/// Same as above. @param pushed	set to true if the elements were enqueued, false if they were rejected
+	/// or dropped.
+	bool enqueueBatch(std::vector<ElementType>&& elements, size_t lane, bool& pushed);
+
+	/// Called for every element that is dropped or rejected because the queue is full.
+	virtual void onMessageDropped(const ElementType& element)
 	{
-		return _messageQueue;
 	}
 
 private:
-	std::shared_ptr<BlockingQueue<google::protobuf::Any>> _messageQueue;
+	static std::shared_ptr<MessageQueue<ElementType>> createMessageQueue(
+	    const ghost::ConnectionConfiguration& configuration, bool singleProducer);
+	bool dropOldest(MessageQueue<ElementType>& queue);
+
+	std::vector<std::shared_ptr<MessageQueue<ElementType>>> _messageQueues;
+	size_t _maximumDepth;
+	ghost::ConnectionConfiguration::OverflowPolicy _overflowPolicy;
+	std::chrono::milliseconds _overflowTimeout;
+	std::atomic<size_t> _droppedMessages;
 };
+
+/////////////////////////// Template definition ///////////////////////////
+
+template <typename ElementType>
+QueuedSink<ElementType>::QueuedSink(const ghost::ConnectionConfiguration& configuration, size_t maximumDepth,
+				    ghost::ConnectionConfiguration::OverflowPolicy overflowPolicy, size_t lanes,
+				    bool singleProducer)
+    : _maximumDepth(maximumDepth)
+    , _overflowPolicy(overflowPolicy)
+    , _overflowTimeout(configuration.getOverflowTimeout())
+    , _droppedMessages(0)
+{
+	for (size_t i = 0; i < std::max<size_t>(lanes, 1); ++i)
+		_messageQueues.push_back(createMessageQueue(configuration, singleProducer));
+}
+
+template <typename ElementType>
+size_t QueuedSink<ElementType>::getDroppedMessagesCount() const
+{
+	return _droppedMessages;
+}
+
+template <typename ElementType>
+size_t QueuedSink<ElementType>::getQueueDepth() const
+{
+	size_t depth = 0;
+	for (const auto& queue : _messageQueues) depth += queue->size();
+	return depth;
+}
+
+template <typename ElementType>
+size_t QueuedSink<ElementType>::getQueuePeakDepth() const
+{
+	size_t peak = 0;
+	for (const auto& queue : _messageQueues) peak = std::max(peak, queue->peakSize());
+	return peak;
+}
+
+template <typename ElementType>
+bool QueuedSink<ElementType>::enqueue(ElementType&& element, size_t lane)
+{
+	using OverflowPolicy = ghost::ConnectionConfiguration::OverflowPolicy;
+
+	auto& queue = *_messageQueues[lane];
+	bool pushed = false;
+	switch (_overflowPolicy)
+	{
+		case OverflowPolicy::BLOCK:
+			pushed = queue.tryPush(std::move(element), _maximumDepth, _overflowTimeout);
+			break;
+		case OverflowPolicy::DROP_OLDEST:
+			pushed = queue.tryPush(std::move(element), _maximumDepth, std::chrono::milliseconds(0));
+			// if nothing can be removed, the new element is dropped
+			while (!pushed && dropOldest(queue))
+				pushed = queue.tryPush(std::move(element), _maximumDepth, std::chrono::milliseconds(0));
+			break;
+		default: // DROP_NEWEST and FAIL
+			pushed = queue.tryPush(std::move(element), _maximumDepth, std::chrono::milliseconds(0));
+			break;
+	}
+
+	if (pushed) return true;
+
+	_droppedMessages++;
+	onMessageDropped(element);
+	return _overflowPolicy == OverflowPolicy::DROP_NEWEST || _overflowPolicy == OverflowPolicy::DROP_OLDEST;
+}
+
+template <typename ElementType>
+bool QueuedSink<ElementType>::enqueueBatch(std::vector<ElementType>&& elements, size_t lane)
+{
+	bool pushed = false;
+	return enqueueBatch(std::move(elements), lane, pushed);
+}
+
+template <typename ElementType>
+bool QueuedSink<ElementType>::enqueueBatch(std::vector<ElementType>&& elements, size_t lane, bool& pushed)
+{
+	using OverflowPolicy = ghost::ConnectionConfiguration::OverflowPolicy;
+
+	auto& queue = *_messageQueues[lane];
+	auto tryPushBatch = [&](std::chrono::milliseconds timeout) {
+		return queue.tryPushBatch(std::move(elements), _maximumDepth, timeout);
+	};
+
+	pushed = false;
+	switch (_overflowPolicy)
+	{
+		case OverflowPolicy::BLOCK:
+			pushed = tryPushBatch(_overflowTimeout);
+			break;
+		case OverflowPolicy::DROP_OLDEST:
+			pushed = tryPushBatch(std::chrono::milliseconds(0));
+			// if nothing can be removed anymore, the batch is dropped
+			while (!pushed && dropOldest(queue)) pushed = tryPushBatch(std::chrono::milliseconds(0));
+			break;
+		default: // DROP_NEWEST and FAIL
+			pushed = tryPushBatch(std::chrono::milliseconds(0));
+			break;
+	}
+
+	if (pushed) return true;
+
+	_droppedMessages += elements.size();
+	for (const auto& element : elements) onMessageDropped(element);
+	return _overflowPolicy == OverflowPolicy::DROP_NEWEST || _overflowPolicy == OverflowPolicy::DROP_OLDEST;
+}
+
+template <typename ElementType>
+bool QueuedSink<ElementType>::dropOldest(MessageQueue<ElementType>& queue)
+{
+	ElementType dropped;
+	if (!queue.dropOldest(dropped)) return false;
+
+	_droppedMessages++;
+	onMessageDropped(dropped);
+	return true;
+}
+
+template <typename ElementType>
+std::shared_ptr<MessageQueue<ElementType>> QueuedSink<ElementType>::createMessageQueue(
+    const ghost::ConnectionConfiguration& configuration, bool singleProducer)
+{
+	switch (configuration.getQueueType())
+	{
+		case ghost::ConnectionConfiguration::QueueType::SPSC_RING_BUFFER:
+			// concurrent producers would overwrite each other's slots
+			if (singleProducer)
+				return std::make_shared<SPSCRingBuffer<ElementType>>(configuration.getQueueCapacity());
+			return std::make_shared<MPSCRingBuffer<ElementType>>(configuration.getQueueCapacity());
+		case ghost::ConnectionConfiguration::QueueType::MPSC_RING_BUFFER:
+			return std::make_shared<MPSCRingBuffer<ElementType>>(configuration.getQueueCapacity());
+		default:
+			return std::make_shared<BlockingMessageQueue<ElementType>>();
+	}
+}
+
 } // namespace internal
 } // namespace ghost
 
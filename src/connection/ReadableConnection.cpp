@@ -21,7 +21,8 @@
 using namespace ghost;
 
 ReadableConnection::ReadableConnection(const ghost::ConnectionConfiguration& configuration)
-    : _readerSink(std::make_shared<ghost::internal::ReaderSink>()), _blocking(configuration.isOperationBlocking())
+    : _readerSink(std::make_shared<ghost::internal::ReaderSink>(configuration))
+    , _blocking(configuration.isOperationBlocking())
 {
 }
 
@@ -34,3 +35,18 @@ std::shared_ptr<ghost::ReaderSink> ReadableConnection::getReaderSink() const
 {
 	return _readerSink;
 }
+
+size_t ReadableConnection::getDroppedReadMessagesCount() const
+{
+	return std::static_pointer_cast<ghost::internal::ReaderSink>(_readerSink)->getDroppedMessagesCount();
+}
+
+ghost::LatencyStatistics ReadableConnection::getLatencyStatistics() const
+{
+	return std::static_pointer_cast<ghost::internal::ReaderSink>(_readerSink)->getLatencyStatistics();
+}
+
+void ReadableConnection::addReaderStatistics(ghost::ConnectionStatistics& statistics) const
+{
+	std::static_pointer_cast<ghost::internal::ReaderSink>(_readerSink)->addStatistics(statistics);
+}
@@ -38,17 +38,23 @@ Reader::Reader(const std::shared_ptr<ghost::ReaderSink>& sink, bool blocking) :
 
 bool Reader::read(google::protobuf::Any& message)
 {
-	google::protobuf::Any msg;
-	bool messageGotten = _readerSink->get(msg, _blocking);
+	// the message is moved out of the sink, only the last read message is copied
+	if (!_readerSink->get(message, _blocking)) return false;
 
-	if (messageGotten)
-	{
-		message = msg;
-		_last = msg;
-		return true;
-	}
+	_last = message;
+	return true;
+}
 
-	return false;
+bool Reader::readBatch(std::vector<google::protobuf::Any>& messages, size_t maximum,
+		       std::chrono::milliseconds timeout)
+{
+	size_t first = messages.size();
+	// a non blocking reader does not wait for the first message
+	size_t count = _readerSink->getBatch(messages, maximum, _blocking ? timeout : std::chrono::milliseconds(0));
+	if (count == 0) return false;
+
+	_last = messages[first + count - 1];
+	return true;
 }
 
 bool Reader::lastRead(google::protobuf::Any& message)
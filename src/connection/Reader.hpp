@@ -37,6 +37,8 @@ public:
 
 	bool read(google::protobuf::Any& message) override;
 	bool lastRead(google::protobuf::Any& message) override;
+	bool readBatch(std::vector<google::protobuf::Any>& messages, size_t maximum,
+		       std::chrono::milliseconds timeout) override;
 
 private:
 	std::shared_ptr<ReaderSink> _readerSink;
@@ -16,27 +16,54 @@
 
 #include "ReaderSink.hpp"
 
+#include <algorithm>
+
 using namespace ghost::internal;
 
-ReaderSink::ReaderSink() : _drained(false)
+ReaderSink::ReaderSink(const ghost::ConnectionConfiguration& configuration)
+    : QueuedSink<google::protobuf::Any>(configuration, configuration.getReaderQueueDepth(),
+					configuration.getReaderOverflowPolicy(), 1, true)
+    , _drained(false)
+    , _receivedMessages(0)
+    , _receivedBytes(0)
+    , _configuration(configuration)
 {
+	if (configuration.isLatencyTracingEnabled()) _latencyTracer = std::make_shared<LatencyTracer>();
 }
 
 bool ReaderSink::put(const google::protobuf::Any& message)
 {
 	if (_drained) return false;
 
+	_receivedMessages.fetch_add(1, std::memory_order_relaxed);
+	_receivedBytes.fetch_add(message.value().size(), std::memory_order_relaxed);
+
 	if (_messageHandler) // if there is a message handler, don't use the read queue
-		_messageHandler->handle(message);
-	else
-		getMessageQueue()->push(message);
+	{
+		return _messageHandler->handle(message);
+	}
 
-	return true;
+	return enqueue(google::protobuf::Any(message));
+}
+
+bool ReaderSink::put(google::protobuf::Any&& message)
+{
+	if (_drained) return false;
+
+	_receivedMessages.fetch_add(1, std::memory_order_relaxed);
+	_receivedBytes.fetch_add(message.value().size(), std::memory_order_relaxed);
+
+	if (_messageHandler) // if there is a message handler, don't use the read queue
+	{
+		return _messageHandler->handle(std::move(message));
+	}
+
+	return enqueue(std::move(message));
 }
 
 std::shared_ptr<ghost::MessageHandler> ReaderSink::addMessageHandler()
 {
-	_messageHandler = std::make_shared<ghost::internal::MessageHandler>();
+	_messageHandler = std::make_shared<ghost::internal::MessageHandler>(_configuration, _latencyTracer);
 	return _messageHandler;
 }
 
@@ -53,10 +80,32 @@ bool ReaderSink::get(google::protobuf::Any& message, bool blocking)
 
 	// call is non blocking and there is nothing to read, return false.
 	// User can find out that there is no issue by calling "isRunnung()" on the connection
-	if (!blocking && getMessageQueue()->size() == 0) return false;
+	return getMessageQueue()->tryPop(blocking ? std::chrono::milliseconds(-1) : std::chrono::milliseconds(0),
+					 message);
+}
 
-	// else, connection is blocking or there is something to read
-	message = getMessageQueue()->get(); // copy is called here
-	getMessageQueue()->pop();
-	return true;
+size_t ReaderSink::getBatch(std::vector<google::protobuf::Any>& messages, size_t maximum,
+			    std::chrono::milliseconds timeout)
+{
+	if (_drained) return 0;
+
+	if (_messageHandler) return 0;
+
+	return getMessageQueue()->tryPopBatch(timeout, messages, maximum);
+}
+
+ghost::LatencyStatistics ReaderSink::getLatencyStatistics() const
+{
+	if (!_latencyTracer) return ghost::LatencyStatistics{};
+
+	return _latencyTracer->getStatistics();
+}
+
+void ReaderSink::addStatistics(ghost::ConnectionStatistics& statistics) const
+{
+	statistics.messagesIn += _receivedMessages.load(std::memory_order_relaxed);
+	statistics.bytesIn += _receivedBytes.load(std::memory_order_relaxed);
+	statistics.readerQueueDepth += getQueueDepth();
+	statistics.readerQueuePeakDepth = std::max(statistics.readerQueuePeakDepth, getQueuePeakDepth());
+	statistics.droppedMessages += getDroppedMessagesCount();
 }
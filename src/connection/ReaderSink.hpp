@@ -20,8 +20,12 @@
 #include <google/protobuf/any.pb.h>
 
 #include <atomic>
+#include <chrono>
+#include <ghost/connection/ConnectionStatistics.hpp>
 #include <ghost/connection/ReaderSink.hpp>
+#include <vector>
 
+#include "LatencyTracer.hpp"
 #include "MessageHandler.hpp"
 #include "QueuedSink.hpp"
 
@@ -32,26 +36,39 @@ namespace internal
 /**
  *	The internal implementation of the API class ghost::ReaderSink.
  *	This implementation manages google::protobuf::Any messages and
- *	shares them with with the bound connection over a blocking queue,
- *	which is a member of the QueuedSink class.
+ *	shares them with with the bound connection over a queue, which is a
+ *	member of the QueuedSink class.
  */
-class ReaderSink : public QueuedSink, public ghost::ReaderSink
+class ReaderSink : public QueuedSink<google::protobuf::Any>, public ghost::ReaderSink
 {
 public:
-	ReaderSink();
+	ReaderSink(const ghost::ConnectionConfiguration& configuration = ghost::ConnectionConfiguration());
 	virtual ~ReaderSink() = default;
 
 	// From ghost::ReaderSink
 	bool put(const google::protobuf::Any& message) override;
+	bool put(google::protobuf::Any&& message) override;
 	std::shared_ptr<ghost::MessageHandler> addMessageHandler() override;
 	void drain() override;
 
-	// gets a message from the sink
+	// moves a message out of the sink
 	bool get(google::protobuf::Any& message, bool blocking);
+	// moves up to "maximum" messages out of the sink and appends them to "messages", returns their count
+	size_t getBatch(std::vector<google::protobuf::Any>& messages, size_t maximum, std::chrono::milliseconds timeout);
+
+	/// @return the latency of the messages passed to the message handler, zero if it is not traced.
+	ghost::LatencyStatistics getLatencyStatistics() const;
+	/// Adds the traffic and the queue usage of this sink to "statistics".
+	void addStatistics(ghost::ConnectionStatistics& statistics) const;
 
 private:
 	std::shared_ptr<ghost::internal::MessageHandler> _messageHandler;
+	/// Set if the configuration enables the latency tracing, shared with the message handler.
+	std::shared_ptr<LatencyTracer> _latencyTracer;
 	std::atomic_bool _drained;
+	std::atomic<size_t> _receivedMessages;
+	std::atomic<size_t> _receivedBytes;
+	ghost::ConnectionConfiguration _configuration;
 };
 } // namespace internal
 } // namespace ghost
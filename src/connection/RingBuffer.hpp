@@ -0,0 +1,94 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_INTERNAL_RINGBUFFER_HPP
+#define GHOST_INTERNAL_RINGBUFFER_HPP
+
+#include <cstddef>
+
+#include "MessageQueue.hpp"
+#include "QueueSignal.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Base class of the lock-free ring buffers.
+ * The slots are preallocated at construction. The capacity is rounded up to the next
+ * power of two so that indices can be wrapped with a mask.
+ * Ring buffers support a single consumer: get(), tryGet() and pop() must not be called
+ * concurrently. The number of elements is always limited by the capacity of the buffer.
+ */
+template <typename T>
+class RingBuffer : public MessageQueue<T>
+{
+public:
+	explicit RingBuffer(size_t capacity);
+
+	/// @return the number of slots of this ring buffer.
+	size_t capacity() const;
+
+	/// Ring buffers have a single consumer: the head cannot be removed by producers.
+	bool dropOldest(T& element) override;
+
+protected:
+	/// @return the number of elements allowed in the buffer given the "maximumSize" passed to tryPush().
+	size_t getLimit(size_t maximumSize) const;
+
+	/// Used to place the indices written by different threads on separate cache lines.
+	static const size_t CACHE_LINE_SIZE = 64;
+
+	size_t _capacity;
+	size_t _mask;
+	/// Signaled when an element was pushed.
+	QueueSignal _readable;
+	/// Signaled when an element was popped.
+	QueueSignal _writable;
+};
+
+/////////////////////////// Template definition ///////////////////////////
+
+template <typename T>
+RingBuffer<T>::RingBuffer(size_t capacity) : _capacity(1)
+{
+	while (_capacity < capacity) _capacity <<= 1;
+	_mask = _capacity - 1;
+}
+
+template <typename T>
+size_t RingBuffer<T>::capacity() const
+{
+	return _capacity;
+}
+
+template <typename T>
+bool RingBuffer<T>::dropOldest(T& element)
+{
+	return false;
+}
+
+template <typename T>
+size_t RingBuffer<T>::getLimit(size_t maximumSize) const
+{
+	if (maximumSize == 0 || maximumSize > _capacity) return _capacity;
+	return maximumSize;
+}
+
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_RINGBUFFER_HPP
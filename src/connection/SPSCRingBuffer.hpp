@@ -0,0 +1,196 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_INTERNAL_SPSCRINGBUFFER_HPP
+#define GHOST_INTERNAL_SPSCRINGBUFFER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "RingBuffer.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Lock-free bounded queue for one producer thread and one consumer thread.
+ */
+template <typename T>
+class SPSCRingBuffer : public RingBuffer<T>
+{
+public:
+	explicit SPSCRingBuffer(size_t capacity);
+
+	void push(const T& element) override;
+	bool tryPush(T&& element, size_t maximumSize, std::chrono::milliseconds timeout) override;
+	bool tryPushBatch(std::vector<T>&& elements, size_t maximumSize, std::chrono::milliseconds timeout) override;
+	void get(T& element) override;
+	bool tryGet(std::chrono::milliseconds timeout, T& element) override;
+	void pop() override;
+	bool pop(T& element) override;
+	bool tryPop(std::chrono::milliseconds timeout, T& element) override;
+	size_t tryPopBatch(std::chrono::milliseconds timeout, std::vector<T>& elements, size_t maximum) override;
+	size_t size() const override;
+
+private:
+	using RingBuffer<T>::CACHE_LINE_SIZE;
+
+	std::vector<T> _slots;
+	char _padding0[CACHE_LINE_SIZE];
+	/// Index of the next slot to read, only written by the consumer.
+	std::atomic<size_t> _head;
+	char _padding1[CACHE_LINE_SIZE];
+	/// Index of the next slot to write, only written by the producer.
+	std::atomic<size_t> _tail;
+	char _padding2[CACHE_LINE_SIZE];
+};
+
+/////////////////////////// Template definition ///////////////////////////
+
+template <typename T>
+SPSCRingBuffer<T>::SPSCRingBuffer(size_t capacity) : RingBuffer<T>(capacity), _head(0), _tail(0)
+{
+	_slots.resize(RingBuffer<T>::_capacity);
+}
+
+template <typename T>
+void SPSCRingBuffer<T>::push(const T& element)
+{
+	T copy(element);
+	tryPush(std::move(copy), 0, std::chrono::milliseconds(-1));
+}
+
+template <typename T>
+bool SPSCRingBuffer<T>::tryPush(T&& element, size_t maximumSize, std::chrono::milliseconds timeout)
+{
+	size_t limit = RingBuffer<T>::getLimit(maximumSize);
+	size_t tail = _tail.load(std::memory_order_relaxed);
+	auto hasSpace = [&]() { return tail - _head.load(std::memory_order_acquire) < limit; };
+	if (!RingBuffer<T>::_writable.waitFor(hasSpace, timeout)) return false;
+
+	_slots[tail & RingBuffer<T>::_mask] = std::move(element);
+	_tail.store(tail + 1, std::memory_order_release);
+	MessageQueue<T>::updatePeakSize(tail + 1 - _head.load(std::memory_order_relaxed));
+	RingBuffer<T>::_readable.notify();
+	return true;
+}
+
+template <typename T>
+bool SPSCRingBuffer<T>::tryPushBatch(std::vector<T>&& elements, size_t maximumSize, std::chrono::milliseconds timeout)
+{
+	size_t limit = RingBuffer<T>::getLimit(maximumSize);
+	if (elements.size() > limit) return false; // would never fit
+
+	size_t tail = _tail.load(std::memory_order_relaxed);
+	auto hasSpace = [&]() { return tail + elements.size() - _head.load(std::memory_order_acquire) <= limit; };
+	if (!RingBuffer<T>::_writable.waitFor(hasSpace, timeout)) return false;
+
+	for (size_t i = 0; i < elements.size(); ++i)
+		_slots[(tail + i) & RingBuffer<T>::_mask] = std::move(elements[i]);
+	// the elements are published to the consumer at once
+	_tail.store(tail + elements.size(), std::memory_order_release);
+	MessageQueue<T>::updatePeakSize(tail + elements.size() - _head.load(std::memory_order_relaxed));
+	RingBuffer<T>::_readable.notify();
+	return true;
+}
+
+template <typename T>
+void SPSCRingBuffer<T>::get(T& element)
+{
+	tryGet(std::chrono::milliseconds(-1), element);
+}
+
+template <typename T>
+bool SPSCRingBuffer<T>::tryGet(std::chrono::milliseconds timeout, T& element)
+{
+	size_t head = _head.load(std::memory_order_relaxed);
+	auto hasElement = [&]() { return _tail.load(std::memory_order_acquire) != head; };
+	if (!RingBuffer<T>::_readable.waitFor(hasElement, timeout)) return false;
+
+	element = _slots[head & RingBuffer<T>::_mask];
+	return true;
+}
+
+template <typename T>
+void SPSCRingBuffer<T>::pop()
+{
+	size_t head = _head.load(std::memory_order_relaxed);
+	if (_tail.load(std::memory_order_acquire) == head) return; // nothing to remove
+
+	_slots[head & RingBuffer<T>::_mask] = T(); // releases the memory held by the element
+	_head.store(head + 1, std::memory_order_release);
+	RingBuffer<T>::_writable.notify();
+}
+
+template <typename T>
+bool SPSCRingBuffer<T>::pop(T& element)
+{
+	size_t head = _head.load(std::memory_order_relaxed);
+	if (_tail.load(std::memory_order_acquire) == head) return false;
+
+	T& slot = _slots[head & RingBuffer<T>::_mask];
+	element = std::move(slot);
+	slot = T();
+	_head.store(head + 1, std::memory_order_release);
+	RingBuffer<T>::_writable.notify();
+	return true;
+}
+
+template <typename T>
+bool SPSCRingBuffer<T>::tryPop(std::chrono::milliseconds timeout, T& element)
+{
+	size_t head = _head.load(std::memory_order_relaxed);
+	auto hasElement = [&]() { return _tail.load(std::memory_order_acquire) != head; };
+	if (!RingBuffer<T>::_readable.waitFor(hasElement, timeout)) return false;
+
+	return pop(element);
+}
+
+template <typename T>
+size_t SPSCRingBuffer<T>::tryPopBatch(std::chrono::milliseconds timeout, std::vector<T>& elements, size_t maximum)
+{
+	size_t head = _head.load(std::memory_order_relaxed);
+	auto hasElement = [&]() { return _tail.load(std::memory_order_acquire) != head; };
+	if (maximum == 0 || !RingBuffer<T>::_readable.waitFor(hasElement, timeout)) return 0;
+
+	size_t count = std::min(maximum, _tail.load(std::memory_order_acquire) - head);
+	elements.reserve(elements.size() + count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		T& slot = _slots[(head + i) & RingBuffer<T>::_mask];
+		elements.push_back(std::move(slot));
+		slot = T();
+	}
+	// the slots are released to the producer at once
+	_head.store(head + count, std::memory_order_release);
+	RingBuffer<T>::_writable.notify();
+	return count;
+}
+
+template <typename T>
+size_t SPSCRingBuffer<T>::size() const
+{
+	size_t head = _head.load(std::memory_order_acquire);
+	return _tail.load(std::memory_order_acquire) - head;
+}
+
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_SPSCRINGBUFFER_HPP
@@ -21,7 +21,8 @@
 using namespace ghost;
 
 WritableConnection::WritableConnection(const ghost::ConnectionConfiguration& configuration)
-    : _writerSink(std::make_shared<ghost::internal::WriterSink>()), _blocking(configuration.isOperationBlocking())
+    : _writerSink(std::make_shared<ghost::internal::WriterSink>(configuration))
+    , _blocking(configuration.isOperationBlocking())
 {
 }
 
@@ -29,3 +30,18 @@ std::shared_ptr<ghost::WriterSink> WritableConnection::getWriterSink() const
 {
 	return _writerSink;
 }
+
+size_t WritableConnection::getDroppedWriteMessagesCount() const
+{
+	return std::static_pointer_cast<ghost::internal::WriterSink>(_writerSink)->getDroppedMessagesCount();
+}
+
+void WritableConnection::setConflationKeys(const std::shared_ptr<const ghost::internal::ConflationKeys>& keys)
+{
+	std::static_pointer_cast<ghost::internal::WriterSink>(_writerSink)->setConflationKeys(keys);
+}
+
+void WritableConnection::addWriterStatistics(ghost::ConnectionStatistics& statistics) const
+{
+	std::static_pointer_cast<ghost::internal::WriterSink>(_writerSink)->addStatistics(statistics);
+}
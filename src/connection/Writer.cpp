@@ -22,14 +22,15 @@ using namespace ghost::internal;
 
 template <>
 std::shared_ptr<ghost::Writer<google::protobuf::Any>> ghost::Writer<google::protobuf::Any>::create(
-    const std::shared_ptr<ghost::WriterSink>& sink, bool blocking)
+    const std::shared_ptr<ghost::WriterSink>& sink, bool blocking, ghost::MessagePriority priority)
 {
-	return std::make_shared<ghost::internal::Writer>(sink, blocking);
+	return std::make_shared<ghost::internal::Writer>(sink, blocking, priority);
 }
 
 // Implementation of the internal part (ghost::internal::Writer)
 
-Writer::Writer(const std::shared_ptr<ghost::WriterSink>& sink, bool blocking) : _blocking(blocking)
+Writer::Writer(const std::shared_ptr<ghost::WriterSink>& sink, bool blocking, ghost::MessagePriority priority)
+    : _blocking(blocking), _priority(priority)
 {
 	auto internalSink = std::dynamic_pointer_cast<ghost::internal::WriterSink>(sink);
 	if (!internalSink) throw std::invalid_argument("The provided connection does not have a valid writer sink.");
@@ -39,5 +40,15 @@ Writer::Writer(const std::shared_ptr<ghost::WriterSink>& sink, bool blocking) :
 
 bool Writer::write(const google::protobuf::Any& message)
 {
-	return _writerSink->push(message, _blocking);
+	return _writerSink->push(message, _blocking, _priority);
+}
+
+std::future<bool> Writer::writeAsync(const google::protobuf::Any& message)
+{
+	return _writerSink->pushAsync(message, _priority);
+}
+
+bool Writer::writeReferences(const std::vector<std::reference_wrapper<const google::protobuf::Any>>& messages)
+{
+	return _writerSink->pushBatch(messages, _blocking, _priority);
 }
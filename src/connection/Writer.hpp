@@ -33,13 +33,18 @@ namespace internal
 class Writer : public ghost::Writer<google::protobuf::Any>
 {
 public:
-	Writer(const std::shared_ptr<ghost::WriterSink>& sink, bool blocking);
+	Writer(const std::shared_ptr<ghost::WriterSink>& sink, bool blocking, ghost::MessagePriority priority);
 
 	bool write(const google::protobuf::Any& message) override;
+	std::future<bool> writeAsync(const google::protobuf::Any& message) override;
+
+protected:
+	bool writeReferences(const std::vector<std::reference_wrapper<const google::protobuf::Any>>& messages) override;
 
 private:
 	std::shared_ptr<WriterSink> _writerSink;
 	bool _blocking;
+	ghost::MessagePriority _priority;
 };
 } // namespace internal
 
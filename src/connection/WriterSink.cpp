@@ -16,49 +16,620 @@
 
 #include "WriterSink.hpp"
 
+#include <algorithm>
+#include <limits>
+
+#include "LatencyTracer.hpp"
+
 using namespace ghost::internal;
 
-WriterSink::WriterSink() : _drained(false)
+const size_t WriterSink::LANES_COUNT;
+
+SerializedMessage::SerializedMessage(const google::protobuf::Any& message,
+				     const std::shared_ptr<const ConflationKeys>& conflationKeys)
+    : payloadSize(message.value().size())
+{
+	message.SerializeToString(&bytes);
+	if (conflationKeys) conflationKeys->getKey(message, conflationKey);
+}
+
+google::protobuf::Any SerializedMessage::getMessage() const
+{
+	google::protobuf::Any message;
+	message.ParseFromString(bytes);
+	return message;
+}
+
+WriterSink::WriterSink(const ghost::ConnectionConfiguration& configuration)
+    : QueuedSink<WriterSinkElement>(configuration, configuration.getWriterQueueDepth(),
+							     configuration.getWriterOverflowPolicy(), LANES_COUNT)
+    , _drained(false)
+    , _latencyTracing(configuration.isLatencyTracingEnabled())
+    , _sentMessages(0)
+    , _sentBytes(0)
+    , _failedMessages(0)
+    , _activeLanes(0)
+    , _gotLane(static_cast<size_t>(ghost::MessagePriority::NORMAL))
+    , _laneQuotas(LANES_COUNT)
+    , _replacedMessages(0)
+{
+	// a lane takes "weight" times the quota of the next lower lane, without limit if the weight is zero
+	size_t weight = configuration.getPriorityWeight();
+	size_t quota = 1;
+	for (size_t lane = 0; lane < LANES_COUNT; ++lane)
+	{
+		_laneQuotas[lane] = weight == 0 ? std::numeric_limits<size_t>::max() : quota;
+		quota = quota > std::numeric_limits<size_t>::max() / std::max<size_t>(weight, 1)
+			    ? std::numeric_limits<size_t>::max()
+			    : quota * weight;
+	}
+	_laneCredits = _laneQuotas;
+}
+
+WriterSink::~WriterSink()
 {
+	failPendingMessages();
 }
 
 bool WriterSink::get(google::protobuf::Any& message, std::chrono::milliseconds timeout)
 {
 	if (_drained) return false;
 
-	if (timeout == std::chrono::milliseconds(-1))
+	// the head of the highest lane is read, the weights only apply to getBatch()
+	WriterSinkElement element;
+	auto getHead = [&]() {
+		std::lock_guard<std::mutex> lock(_consumerMutex);
+		unsigned activeLanes = _activeLanes.load(std::memory_order_acquire);
+		for (size_t lane = LANES_COUNT; lane-- > 0;)
+		{
+			if ((activeLanes & (1u << lane)) &&
+			    getMessageQueue(lane)->tryGet(std::chrono::milliseconds(0), element))
+			{
+				_gotLane = lane;
+				return true;
+			}
+		}
+		return false;
+	};
+	if (!_messagesPushed.waitFor(getHead, timeout)) return false;
+
+	if (!element.conflationKey.empty())
 	{
-		message = getMessageQueue()->get();
+		// the message is taken out of the sink once, and kept until it is popped in case get() is repeated
+		std::lock_guard<std::mutex> lock(_conflationMutex);
+		if (_gotConflated.conflationKey != element.conflationKey)
+		{
+			resolveConflated(element);
+			_gotConflated = std::move(element);
+		}
+		message = _gotConflated.serialized ? _gotConflated.serialized->getMessage() : _gotConflated.element;
 		return true;
 	}
 
-	return getMessageQueue()->tryGet(timeout, message);
+	if (element.serialized)
+		message = element.serialized->getMessage();
+	else
+		message.Swap(&element.element);
+	return true;
+}
+
+size_t WriterSink::getBatch(std::vector<google::protobuf::Any>& messages, size_t maximum,
+			    std::chrono::milliseconds timeout)
+{
+	std::vector<WriterSinkElement> elements;
+	ghost::MessagePriority priority;
+	size_t count = getElements(elements, maximum, timeout, false, priority);
+	moveMessages(elements, messages);
+	return count;
+}
+
+size_t WriterSink::getBatch(std::vector<google::protobuf::Any>& messages, size_t maximum,
+			    std::chrono::milliseconds timeout, ghost::MessagePriority& priority)
+{
+	std::vector<WriterSinkElement> elements;
+	size_t count = getElements(elements, maximum, timeout, true, priority);
+	moveMessages(elements, messages);
+	return count;
+}
+
+size_t WriterSink::getBatch(std::vector<WriterSinkMessage>& messages, size_t maximum,
+			    std::chrono::milliseconds timeout)
+{
+	std::vector<WriterSinkElement> elements;
+	ghost::MessagePriority priority;
+	size_t count = getElements(elements, maximum, timeout, false, priority);
+
+	messages.reserve(messages.size() + count);
+	for (auto& element : elements)
+	{
+		messages.emplace_back();
+		messages.back().message.Swap(&element.element);
+		messages.back().serialized = std::move(element.serialized);
+	}
+	return count;
+}
+
+size_t WriterSink::getElements(std::vector<WriterSinkElement>& elements, size_t maximum,
+			       std::chrono::milliseconds timeout, bool singleLane, ghost::MessagePriority& priority)
+{
+	if (_drained) return 0;
+
+	// the elements are taken by the predicate as soon as a writer signals them
+	size_t lane = static_cast<size_t>(ghost::MessagePriority::NORMAL);
+	size_t count = 0;
+	auto takeAvailable = [&]() {
+		std::lock_guard<std::mutex> lock(_consumerMutex);
+		return (count = takeElements(elements, maximum, singleLane, lane)) > 0;
+	};
+	_messagesPushed.waitFor(takeAvailable, timeout);
+	priority = static_cast<ghost::MessagePriority>(lane);
+
+	for (auto& element : elements)
+	{
+		if (element.conflationKey.empty()) continue;
+
+		std::lock_guard<std::mutex> lock(_conflationMutex);
+		resolveConflated(element);
+	}
+
+	{
+		// the messages left the queue: their promises wait here for the calls to pop()
+		std::lock_guard<std::mutex> lock(_inFlightMutex);
+		for (auto& element : elements)
+		{
+			countSentMessage(element);
+			_inFlight.push_back(std::move(element.result));
+		}
+	}
+	if (_drained) failPendingMessages(); // the sink was drained concurrently, the messages will not be sent
+
+	return count;
 }
 
 void WriterSink::pop()
 {
-	getMessageQueue()->pop();
+	{
+		// the messages gotten by getBatch() are completed first
+		std::lock_guard<std::mutex> lock(_inFlightMutex);
+		if (!_inFlight.empty())
+		{
+			if (_inFlight.front()) _inFlight.front()->set_value(true);
+			_inFlight.pop_front();
+			return;
+		}
+	}
+
+	WriterSinkElement element;
+	{
+		std::lock_guard<std::mutex> lock(_consumerMutex);
+		if (!getMessageQueue(_gotLane)->pop(element)) return;
+	}
+
+	if (!element.conflationKey.empty())
+	{
+		std::lock_guard<std::mutex> lock(_conflationMutex);
+		if (_gotConflated.conflationKey == element.conflationKey)
+			element = std::move(_gotConflated);
+		else // popped without get()
+			resolveConflated(element);
+		_gotConflated = WriterSinkElement();
+	}
+
+	countSentMessage(element);
+	if (element.result) element.result->set_value(true); // the message was sent, release its writer
 }
 
 void WriterSink::drain()
 {
 	_drained = true;
+	failPendingMessages();
 }
 
-bool WriterSink::push(const google::protobuf::Any& message, bool blocking)
+bool WriterSink::push(const google::protobuf::Any& message, bool blocking, ghost::MessagePriority priority)
 {
-	if (_drained) return false;
+	if (blocking) return pushAsync(message, priority).get();
+
+	if (_drained)
+	{
+		_failedMessages.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	WriterSinkElement element;
+	element.element = message;
+	if (_latencyTracing) LatencyTracer::stampWrite(element.element);
+	if (conflate(element)) return true; // a pending message was replaced, its place in the queue is taken
+
+	bool enqueued = enqueue(std::move(element), activateLane(priority));
+	if (enqueued) notifyMessagesAvailable();
+	return enqueued;
+}
+
+std::future<bool> WriterSink::pushAsync(const google::protobuf::Any& message, ghost::MessagePriority priority)
+{
+	WriterSinkElement element;
+	element.result = std::make_shared<std::promise<bool>>();
+	std::future<bool> result = element.result->get_future();
+
+	if (_drained)
+	{
+		_failedMessages.fetch_add(1, std::memory_order_relaxed);
+		element.result->set_value(false);
+		return result;
+	}
+
+	element.element = message;
+	if (_latencyTracing) LatencyTracer::stampWrite(element.element);
+	// a rejected message fulfills the promise in onMessageDropped
+	if (!conflate(element) && enqueue(std::move(element), activateLane(priority))) notifyMessagesAvailable();
+	if (_drained) failPendingMessages(); // the sink was drained concurrently, the message will not be sent
+
+	return result;
+}
+
+bool WriterSink::pushBatch(const std::vector<std::reference_wrapper<const google::protobuf::Any>>& messages,
+			   bool blocking, ghost::MessagePriority priority)
+{
+	if (_drained)
+	{
+		_failedMessages.fetch_add(messages.size(), std::memory_order_relaxed);
+		return false;
+	}
+	if (messages.empty()) return true;
 
-	getMessageQueue()->push(message);
+	std::vector<WriterSinkElement> elements(messages.size());
+	for (size_t i = 0; i < messages.size(); ++i)
+	{
+		elements[i].element = messages[i];
+		if (_latencyTracing) LatencyTracer::stampWrite(elements[i].element);
+	}
 
+	// the messages are sent in order: a blocking writer only waits for the last one
+	std::future<bool> result;
 	if (blocking)
 	{
-		while (getMessageQueue()->size() != 0 &&
-		       !_drained) // blocks until the message is gone, use blocking queue instead!
+		elements.back().result = std::make_shared<std::promise<bool>>();
+		result = elements.back().result->get_future();
+	}
+
+	bool enqueued = enqueueConflated(std::move(elements), activateLane(priority));
+	if (enqueued) notifyMessagesAvailable();
+	if (!blocking) return enqueued;
+
+	if (_drained) failPendingMessages(); // the sink was drained concurrently, the messages will not be sent
+	return result.get();
+}
+
+bool WriterSink::pushSerialized(const std::vector<std::shared_ptr<const SerializedMessage>>& messages,
+				ghost::MessagePriority priority)
+{
+	if (_drained)
+	{
+		_failedMessages.fetch_add(messages.size(), std::memory_order_relaxed);
+		return false;
+	}
+	if (messages.empty()) return true;
+
+	// the messages were stamped by the sink they were first written to, if their latency is traced
+	std::vector<WriterSinkElement> elements(messages.size());
+	for (size_t i = 0; i < messages.size(); ++i) elements[i].serialized = messages[i];
+
+	bool enqueued = enqueueConflated(std::move(elements), activateLane(priority));
+	if (enqueued) notifyMessagesAvailable();
+	return enqueued;
+}
+
+void WriterSink::setMessagesAvailableCallback(const std::function<void()>& callback)
+{
+	std::shared_ptr<std::function<void()>> newCallback;
+	if (callback) newCallback = std::make_shared<std::function<void()>>(callback);
+	std::atomic_store(&_messagesAvailableCallback, newCallback);
+}
+
+void WriterSink::setConflationKeys(const std::shared_ptr<const ConflationKeys>& keys)
+{
+	_conflationKeys = keys;
+}
+
+void WriterSink::notifyMessagesAvailable()
+{
+	_messagesPushed.notify();
+
+	auto callback = std::atomic_load(&_messagesAvailableCallback);
+	if (callback) (*callback)();
+}
+
+size_t WriterSink::activateLane(ghost::MessagePriority priority)
+{
+	size_t lane = static_cast<size_t>(priority);
+	if (!(_activeLanes.load(std::memory_order_relaxed) & (1u << lane)))
+		_activeLanes.fetch_or(1u << lane, std::memory_order_release);
+	return lane;
+}
+
+size_t WriterSink::takeElements(std::vector<WriterSinkElement>& elements, size_t maximum,
+				bool singleLane, size_t& lane)
+{
+	unsigned activeLanes = _activeLanes.load(std::memory_order_acquire);
+	if ((activeLanes & (activeLanes - 1)) == 0) // at most one lane is used: nothing to schedule
+	{
+		for (size_t i = 0; i < LANES_COUNT; ++i)
 		{
-			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			if (activeLanes == (1u << i)) lane = i;
 		}
+		return getMessageQueue(lane)->tryPopBatch(std::chrono::milliseconds(0), elements, maximum);
 	}
 
+	std::lock_guard<std::mutex> lock(_lanesMutex);
+	size_t count = 0;
+	bool roundRestarted = false;
+	while (count < maximum)
+	{
+		size_t previousCount = count;
+		for (size_t i = LANES_COUNT; i-- > 0 && count < maximum;)
+		{
+			if (!(activeLanes & (1u << i)) || _laneCredits[i] == 0) continue;
+
+			size_t taken = getMessageQueue(i)->tryPopBatch(std::chrono::milliseconds(0), elements,
+								      std::min(_laneCredits[i], maximum - count));
+			if (taken == 0) continue;
+
+			_laneCredits[i] -= taken;
+			count += taken;
+			lane = i;
+			if (singleLane) return count;
+		}
+
+		if (count > previousCount)
+			roundRestarted = false;
+		else if (roundRestarted) // every lane had credits left: they are all empty
+			break;
+		else // the lanes with messages used their quota: the next round starts
+		{
+			_laneCredits = _laneQuotas;
+			roundRestarted = true;
+		}
+	}
+	return count;
+}
+
+bool WriterSink::conflate(WriterSinkElement& element)
+{
+	std::string key;
+	if (!getConflationKey(element, key)) return false;
+
+	std::shared_ptr<std::promise<bool>> replaced;
+	{
+		std::lock_guard<std::mutex> lock(_conflationMutex);
+		auto it = _conflatedMessages.find(key);
+		if (it == _conflatedMessages.end())
+		{
+			// first pending message of this key: it waits aside and the queue gets its placeholder
+			WriterSinkElement& pending = _conflatedMessages[key];
+			swapMessages(pending, element);
+			pending.result = std::move(element.result);
+			element.result.reset();
+			element.conflationKey = std::move(key);
+			return false;
+		}
+
+		swapMessages(it->second, element);
+		replaced = std::move(it->second.result);
+		it->second.result = std::move(element.result);
+	}
+
+	_replacedMessages.fetch_add(1, std::memory_order_relaxed);
+	if (replaced) replaced->set_value(false); // the replaced message will not be sent
 	return true;
 }
+
+bool WriterSink::getConflationKey(const WriterSinkElement& element, std::string& key) const
+{
+	if (!_conflationKeys) return false;
+
+	// the key of a shared message was computed once, when it was serialized
+	if (!element.serialized) return _conflationKeys->getKey(element.element, key);
+	key = element.serialized->conflationKey;
+	return !key.empty();
+}
+
+bool WriterSink::enqueueConflated(std::vector<WriterSinkElement>&& elements, size_t lane)
+{
+	if (!_conflationKeys) return enqueueBatch(std::move(elements), lane);
+
+	// the messages of a key replace the previous ones of the batch, in place
+	std::vector<WriterSinkElement> batch;
+	std::vector<std::shared_ptr<std::promise<bool>>> replaced;
+	std::unordered_map<std::string, size_t> batchKeys;
+	batch.reserve(elements.size());
+	for (auto& element : elements)
+	{
+		std::string key;
+		if (getConflationKey(element, key))
+		{
+			auto it = batchKeys.find(key);
+			if (it != batchKeys.end())
+			{
+				WriterSinkElement& previous = batch[it->second];
+				swapMessages(previous, element);
+				replaced.push_back(std::move(previous.result));
+				previous.result = std::move(element.result);
+				continue;
+			}
+			batchKeys[key] = batch.size();
+			element.conflationKey = std::move(key);
+		}
+		batch.push_back(std::move(element));
+	}
+
+	// the new keys wait aside with a placeholder in the batch, the keys with a pending message will replace it
+	std::vector<WriterSinkElement> replacements;
+	{
+		std::lock_guard<std::mutex> lock(_conflationMutex);
+		size_t kept = 0;
+		for (size_t i = 0; i < batch.size(); ++i)
+		{
+			auto& element = batch[i];
+			if (!element.conflationKey.empty())
+			{
+				if (_conflatedMessages.count(element.conflationKey) > 0)
+				{
+					replacements.push_back(std::move(element));
+					continue;
+				}
+				WriterSinkElement& pending = _conflatedMessages[element.conflationKey];
+				swapMessages(pending, element);
+				pending.result = std::move(element.result);
+				element.result.reset();
+			}
+			if (kept != i) batch[kept] = std::move(element);
+			++kept;
+		}
+		batch.resize(kept);
+	}
+
+	// the pending messages are only replaced if the batch fits: the placeholders of a rejected batch are
+	// dropped with their messages, and the sink is left as it was
+	bool pushed = true;
+	bool enqueued = batch.empty() || enqueueBatch(std::move(batch), lane, pushed);
+	if (!pushed)
+	{
+		for (const auto& result : replaced)
+		{
+			if (result) result->set_value(false);
+		}
+		for (const auto& element : replacements)
+		{
+			if (element.result) element.result->set_value(false);
+		}
+		return enqueued;
+	}
+
+	for (auto& element : replacements)
+	{
+		// if the pending message was sent in between, the element takes a new place in the queue
+		if (!conflate(element)) enqueue(std::move(element), lane);
+	}
+
+	_replacedMessages.fetch_add(replaced.size(), std::memory_order_relaxed);
+	for (const auto& result : replaced)
+	{
+		if (result) result->set_value(false); // the replaced message will not be sent
+	}
+	return enqueued;
+}
+
+void WriterSink::swapMessages(WriterSinkElement& first, WriterSinkElement& second)
+{
+	first.element.Swap(&second.element);
+	first.serialized.swap(second.serialized);
+}
+
+void WriterSink::resolveConflated(WriterSinkElement& element)
+{
+	auto it = _conflatedMessages.find(element.conflationKey);
+	if (it == _conflatedMessages.end()) return; // the sink was drained in between
+
+	swapMessages(element, it->second);
+	element.result = std::move(it->second.result);
+	_conflatedMessages.erase(it);
+}
+
+void WriterSink::failConflated(const WriterSinkElement& element)
+{
+	std::shared_ptr<std::promise<bool>> result;
+	{
+		std::lock_guard<std::mutex> lock(_conflationMutex);
+		auto it = _conflatedMessages.find(element.conflationKey);
+		if (it == _conflatedMessages.end()) return;
+
+		result = std::move(it->second.result);
+		_conflatedMessages.erase(it);
+	}
+	if (result) result->set_value(false);
+}
+
+void WriterSink::addStatistics(ghost::ConnectionStatistics& statistics) const
+{
+	statistics.messagesOut += _sentMessages.load(std::memory_order_relaxed);
+	statistics.bytesOut += _sentBytes.load(std::memory_order_relaxed);
+	statistics.writerQueueDepth += getQueueDepth();
+	statistics.writerQueuePeakDepth = std::max(statistics.writerQueuePeakDepth, getQueuePeakDepth());
+	statistics.droppedMessages += getDroppedMessagesCount();
+	statistics.writeFailures += _failedMessages.load(std::memory_order_relaxed);
+	statistics.conflatedMessages += _replacedMessages.load(std::memory_order_relaxed);
+}
+
+void WriterSink::moveMessages(std::vector<WriterSinkElement>& elements,
+			      std::vector<google::protobuf::Any>& messages)
+{
+	messages.reserve(messages.size() + elements.size());
+	for (auto& element : elements)
+	{
+		if (element.serialized)
+			messages.push_back(element.serialized->getMessage());
+		else
+			messages.push_back(std::move(element.element));
+	}
+}
+
+void WriterSink::countSentMessage(const WriterSinkElement& element)
+{
+	size_t size = element.serialized ? element.serialized->payloadSize : element.element.value().size();
+	_sentMessages.fetch_add(1, std::memory_order_relaxed);
+	_sentBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void WriterSink::onMessageDropped(const WriterSinkElement& element)
+{
+	if (!element.conflationKey.empty())
+	{
+		failConflated(element); // the placeholder was dropped, and its message with it
+		return;
+	}
+
+	if (element.result) element.result->set_value(false);
+}
+
+void WriterSink::failPendingMessages()
+{
+	{
+		std::lock_guard<std::mutex> lock(_inFlightMutex);
+		for (const auto& result : _inFlight)
+		{
+			if (result) result->set_value(false);
+		}
+		_failedMessages.fetch_add(_inFlight.size(), std::memory_order_relaxed);
+		_inFlight.clear();
+	}
+
+	{
+		// the thread draining the sink or a writer which saw it drained may run concurrently to the connection
+		std::lock_guard<std::mutex> lock(_consumerMutex);
+		WriterSinkElement element;
+		for (size_t lane = 0; lane < getLanesCount(); ++lane)
+		{
+			while (getMessageQueue(lane)->pop(element))
+			{
+				// the message of a placeholder is failed with the conflated ones
+				if (!element.conflationKey.empty()) continue;
+				_failedMessages.fetch_add(1, std::memory_order_relaxed);
+				if (element.result) element.result->set_value(false);
+			}
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(_conflationMutex);
+	for (auto& entry : _conflatedMessages)
+	{
+		_failedMessages.fetch_add(1, std::memory_order_relaxed);
+		if (entry.second.result) entry.second.result->set_value(false);
+	}
+	_conflatedMessages.clear();
+	if (!_gotConflated.conflationKey.empty())
+	{
+		_failedMessages.fetch_add(1, std::memory_order_relaxed);
+		if (_gotConflated.result) _gotConflated.result->set_value(false);
+		_gotConflated = WriterSinkElement();
+	}
+}
@@ -19,37 +19,227 @@
 
 #include <google/protobuf/any.pb.h>
 
+#include <BlockingQueue.hpp>
 #include <atomic>
+#include <deque>
+#include <functional>
+#include <future>
+#include <ghost/connection/ConnectionStatistics.hpp>
+#include <ghost/connection/MessagePriority.hpp>
 #include <ghost/connection/WriterSink.hpp>
+#include <ghost/connection/internal/ConflationKeys.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "QueueSignal.hpp"
 #include "QueuedSink.hpp"
 
 namespace ghost
 {
 namespace internal
 {
+/**
+ *	Message written to several sinks at once. It is serialized once, and the sinks share it instead of
+ *	copying it: the connections supporting it write the serialized bytes as they are. Only the bytes are
+ *	kept, the few consumers needing the message itself parse them again.
+ */
+struct SerializedMessage
+{
+	/// @param conflationKeys	if set, the key conflating the message in the sinks is computed once here.
+	explicit SerializedMessage(const google::protobuf::Any& message,
+				   const std::shared_ptr<const ConflationKeys>& conflationKeys = nullptr);
+
+	/// @return the message, parsed from its bytes.
+	google::protobuf::Any getMessage() const;
+
+	/// The message in the protobuf wire format.
+	std::string bytes;
+	/// Size of the payload of the message, counted in the statistics of the sinks.
+	size_t payloadSize;
+	/// Not empty if the message is conflated.
+	std::string conflationKey;
+};
+
+/**
+ *	Element of the queue of the writer sink. The queue only holds the key of a conflated message:
+ *	the message itself is kept by the sink until the connection gets it, and replaced by the newer
+ *	messages with the same key.
+ */
+struct WriterSinkElement : public ghost::QueueElement<google::protobuf::Any>
+{
+	/// Not empty if the element stands for a conflated message.
+	std::string conflationKey;
+	/// Set instead of the message if the message is shared with other sinks.
+	std::shared_ptr<const SerializedMessage> serialized;
+};
+
+/// Message taken from the sink by a connection: "serialized" is set instead of "message" if it is shared.
+struct WriterSinkMessage
+{
+	google::protobuf::Any message;
+	std::shared_ptr<const SerializedMessage> serialized;
+};
+
 /**
  *	The internal implementation of the API class ghost::WriterSink.
  *	This implementation manages google::protobuf::Any messages and
- *	shares them with with the bound connection over a blocking queue,
- *	which is a member of the QueuedSink class.
+ *	shares them with with the bound connection over a queue, which is a
+ *	member of the QueuedSink class.
+ *	Each message may carry a promise, which is fulfilled when the connection
+ *	pops the message (i.e. after it was sent) or when it is dropped.
+ *	The queue has one lane per ghost::MessagePriority. The connection gets the
+ *	messages of the higher lanes first, a lane letting one message of the next
+ *	lower lane through every "priority weight" messages.
+ *	If conflation keys are set, the messages with a key keep the place in the queue of the first
+ *	pending message with the same key, and only the last of them is sent.
  */
-class WriterSink : public QueuedSink, public ghost::WriterSink
+class WriterSink : public QueuedSink<WriterSinkElement>, public ghost::WriterSink
 {
 public:
-	WriterSink();
-	virtual ~WriterSink() = default;
+	WriterSink(const ghost::ConnectionConfiguration& configuration = ghost::ConnectionConfiguration());
+	virtual ~WriterSink();
 
 	// From ghost::WriterSink
 	bool get(google::protobuf::Any& message, std::chrono::milliseconds timeout) override;
+	size_t getBatch(std::vector<google::protobuf::Any>& messages, size_t maximum,
+			std::chrono::milliseconds timeout) override;
 	void pop() override;
 	void drain() override;
 
-	/// Adds a new message into the sink
-	bool push(const google::protobuf::Any& message, bool blocking);
+	/**
+	 *	Gets up to "maximum" messages of a single priority, see getBatch(). Used by the connections
+	 *	that forward the messages to other sinks and need to keep their priority.
+	 *	@param priority	set to the priority of the messages gotten.
+	 */
+	size_t getBatch(std::vector<google::protobuf::Any>& messages, size_t maximum, std::chrono::milliseconds timeout,
+			ghost::MessagePriority& priority);
+	/**
+	 *	Gets up to "maximum" messages, see getBatch(). The messages shared with other sinks are not
+	 *	copied: used by the connections that write the serialized messages as they are.
+	 */
+	size_t getBatch(std::vector<WriterSinkMessage>& messages, size_t maximum, std::chrono::milliseconds timeout);
+
+	/// Adds a new message into the sink. If blocking is true, waits until the connection sent it.
+	bool push(const google::protobuf::Any& message, bool blocking,
+		  ghost::MessagePriority priority = ghost::MessagePriority::NORMAL);
+	/// Adds a new message into the sink. The future is set to true once the connection sent it, or
+	/// to false if it was dropped or if the sink was drained.
+	std::future<bool> pushAsync(const google::protobuf::Any& message,
+				    ghost::MessagePriority priority = ghost::MessagePriority::NORMAL);
+	/// Adds all the messages into the sink at once, or none of them if they do not fit.
+	/// If blocking is true, waits until the connection sent the last one.
+	bool pushBatch(const std::vector<std::reference_wrapper<const google::protobuf::Any>>& messages,
+		       bool blocking, ghost::MessagePriority priority = ghost::MessagePriority::NORMAL);
+	/// Adds all the messages shared with other sinks at once, or none of them if they do not fit. Does not
+	/// wait for the messages to be sent, but waits for room in the queue if its overflow policy is BLOCK.
+	bool pushSerialized(const std::vector<std::shared_ptr<const SerializedMessage>>& messages,
+			    ghost::MessagePriority priority = ghost::MessagePriority::NORMAL);
+
+	/**
+	 *	Sets a function called by the writers after they added messages into the sink. Connections
+	 *	that are driven by events use it instead of waiting for the messages in a dedicated thread.
+	 *	The function is called by the writing thread and must not block.
+	 */
+	void setMessagesAvailableCallback(const std::function<void()>& callback);
+
+	/// Conflates the messages that have a key. Must be called before messages are pushed.
+	void setConflationKeys(const std::shared_ptr<const ConflationKeys>& keys);
+
+	/// Adds the traffic and the queue usage of this sink to "statistics".
+	void addStatistics(ghost::ConnectionStatistics& statistics) const;
+
+protected:
+	void onMessageDropped(const WriterSinkElement& element) override;
 
 private:
+	/// Removes the remaining messages and notifies their writers that they will not be sent.
+	void failPendingMessages();
+	/// Implementation of the getBatch(): "singleLane" is true if the messages must share their priority.
+	size_t getElements(std::vector<WriterSinkElement>& elements, size_t maximum,
+			   std::chrono::milliseconds timeout, bool singleLane, ghost::MessagePriority& priority);
+	/// Moves the messages of "elements" to "messages", the shared messages are copied.
+	static void moveMessages(std::vector<WriterSinkElement>& elements,
+				 std::vector<google::protobuf::Any>& messages);
+	void notifyMessagesAvailable();
+	void countSentMessage(const WriterSinkElement& element);
+	/// @return the lane of "priority", after marking it as used.
+	size_t activateLane(ghost::MessagePriority priority);
+	/**
+	 *	Replaces the pending message with the same key as "element" by "element", if there is one.
+	 *	Otherwise, keeps the message of "element" aside and turns "element" into its placeholder.
+	 *	@return true if the element replaced a pending message and must not be enqueued.
+	 */
+	bool conflate(WriterSinkElement& element);
+	/// @return false if the message of this element is not conflated.
+	bool getConflationKey(const WriterSinkElement& element, std::string& key) const;
+	/**
+	 *	Conflates the messages of "elements" and enqueues them at once, see enqueueBatch(). The pending
+	 *	messages are only replaced once the other elements fit in the queue: a rejected batch leaves the
+	 *	sink unchanged. @return false if the elements were rejected.
+	 */
+	bool enqueueConflated(std::vector<WriterSinkElement>&& elements, size_t lane);
+	/// Swaps the messages of "first" and "second", whether they are shared or not.
+	static void swapMessages(WriterSinkElement& first, WriterSinkElement& second);
+	/// Puts the message kept aside for the placeholder "element" back into it. _conflationMutex must be locked.
+	void resolveConflated(WriterSinkElement& element);
+	/// Fails the message kept aside for the placeholder "element", which was dropped.
+	void failConflated(const WriterSinkElement& element);
+	/**
+	 *	Moves up to "maximum" elements out of the lanes, from the highest one, within the quota
+	 *	of the lanes. If "singleLane" is true, stops after the first lane that had elements.
+	 *	@param lane	set to the last lane that elements were taken from.
+	 */
+	size_t takeElements(std::vector<WriterSinkElement>& elements, size_t maximum,
+			    bool singleLane, size_t& lane);
+
+	/// One lane per value of ghost::MessagePriority.
+	static const size_t LANES_COUNT = 3;
+
 	std::atomic_bool _drained;
+	/// If true, the messages get the header of the latency tracing when they are pushed.
+	bool _latencyTracing;
+	/// Messages taken from the queue by the connection and their payload size.
+	std::atomic<size_t> _sentMessages;
+	std::atomic<size_t> _sentBytes;
+	/// Messages that were not sent because the sink was drained.
+	std::atomic<size_t> _failedMessages;
+	/// Promises of the messages taken out of the queue by getBatch() and not completed by pop() yet.
+	std::deque<std::shared_ptr<std::promise<bool>>> _inFlight;
+	std::mutex _inFlightMutex;
+	/**
+	 *	Serializes the removals from the queue: the ring buffers support a single consumer, while the sink
+	 *	is also emptied by the thread draining it and by the writers that find it drained. Only the consumer
+	 *	side is locked, the writers push without it. The lock is uncontended until the sink is drained, and
+	 *	getBatch() takes it once per batch, whose pop() calls only complete the in-flight messages; get()
+	 *	and pop() take it once per message. Handing the queue over to the draining thread without a lock
+	 *	would cost the consumer the same atomic exchange, for a more fragile protocol.
+	 */
+	std::mutex _consumerMutex;
+	/// Accessed with std::atomic_load and std::atomic_store since it may be set while messages are written.
+	std::shared_ptr<std::function<void()>> _messagesAvailableCallback;
+
+	/// Wakes up the connection waiting for messages in any lane.
+	QueueSignal _messagesPushed;
+	/// Bit mask of the lanes that received messages: the lanes are only scheduled if several are used.
+	std::atomic<unsigned> _activeLanes;
+	/// Lane of the message returned by get(), removed by the next call to pop().
+	size_t _gotLane;
+	/// Number of messages each lane may take in a scheduling round, and what is left of it.
+	std::vector<size_t> _laneQuotas;
+	std::vector<size_t> _laneCredits;
+	std::mutex _lanesMutex;
+
+	std::shared_ptr<const ConflationKeys> _conflationKeys;
+	/// Last message of every key that has a placeholder in the queue.
+	std::unordered_map<std::string, WriterSinkElement> _conflatedMessages;
+	/// Conflated message returned by get(), kept until the next call to pop() in case get() is repeated.
+	WriterSinkElement _gotConflated;
+	/// Messages that were replaced by a newer message with the same key.
+	std::atomic<size_t> _replacedMessages;
+	std::mutex _conflationMutex;
 };
 } // namespace internal
 } // namespace ghost
@@ -16,6 +16,9 @@
 
 #include "ClientGRPC.hpp"
 
+#include "Compression.hpp"
+#include "ServerAddress.hpp"
+
 using namespace ghost::internal;
 
 ClientGRPC::ClientGRPC(const ghost::ConnectionConfiguration& config)
@@ -25,8 +28,10 @@ ClientGRPC::ClientGRPC(const ghost::ConnectionConfiguration& config)
 
 ClientGRPC::ClientGRPC(const ghost::NetworkConnectionConfiguration& config)
     : ghost::Client(config)
-    , _client(config.getServerIpAddress(), config.getServerPortNumber(), config.getThreadPoolSize())
+    , _client(getServerAddress(config), config.getThreadPoolSize())
 {
+	auto configuration = ghost::ConnectionConfigurationGRPC::initializeFrom(config);
+	_client.setCompression(getCompressionAlgorithm(configuration), configuration.getCompressionThreshold());
 	_client.setReaderSink(getReaderSink());
 	_client.setWriterSink(getWriterSink());
 }
@@ -45,3 +50,10 @@ bool ClientGRPC::isRunning() const
 {
 	return _client.isRunning();
 }
+
+ghost::ConnectionStatistics ClientGRPC::getTransportStatistics() const
+{
+	ghost::ConnectionStatistics statistics;
+	statistics.stateTransitions = _client.getStateTransitionsCount();
+	return statistics;
+}
@@ -40,6 +40,9 @@ public:
 	bool stop() override;
 	bool isRunning() const override;
 
+protected:
+	ghost::ConnectionStatistics getTransportStatistics() const override;
+
 private:
 	OutgoingRPC _client;
 };
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ClientHandlerExecutor.hpp"
+
+#include <algorithm>
+
+using namespace ghost::internal;
+
+namespace
+{
+/// Executor running the task of the current thread, if any.
+thread_local const ClientHandlerExecutor* currentExecutor = nullptr;
+} // namespace
+
+ClientHandlerExecutor::ClientHandlerExecutor() : _running(false), _maximumPending(0), _pendingPeak(0), _rejected(0)
+{
+}
+
+ClientHandlerExecutor::~ClientHandlerExecutor()
+{
+	stop();
+	joinThreads();
+}
+
+void ClientHandlerExecutor::start(size_t threadsCount, size_t maximumPending)
+{
+	joinThreads(); // a previous stop may have been called by one of the threads
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_running = true;
+	_maximumPending = maximumPending;
+	for (size_t i = 0; i < std::max<size_t>(threadsCount, 1); i++)
+		_threadPool.push_back(std::thread(&ClientHandlerExecutor::run, this));
+}
+
+void ClientHandlerExecutor::stop()
+{
+	std::deque<Task> discarded; // deleted without the lock, the tasks may own the last reference to a client
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_running = false;
+		discarded.swap(_tasks);
+	}
+	_tasksAvailable.notify_all();
+
+	// a task stopping the executor cannot join its own thread, which is kept to be joined later
+	std::list<std::thread> threads;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		threads.swap(_threadPool);
+	}
+	for (auto& t : threads)
+	{
+		if (t.get_id() == std::this_thread::get_id())
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_threadPool.push_back(std::move(t));
+		}
+		else if (t.joinable())
+			t.join();
+	}
+}
+
+bool ClientHandlerExecutor::submit(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (!_running || _tasks.size() >= _maximumPending)
+		{
+			_rejected++;
+			return false;
+		}
+
+		_tasks.push_back(Task{std::move(task), std::chrono::steady_clock::now()});
+		_pendingPeak = std::max(_pendingPeak, _tasks.size());
+	}
+	_tasksAvailable.notify_one();
+	return true;
+}
+
+bool ClientHandlerExecutor::isExecutorThread() const
+{
+	return currentExecutor == this;
+}
+
+ghost::ClientHandlerStatistics ClientHandlerExecutor::getStatistics() const
+{
+	ghost::ClientHandlerStatistics statistics;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		statistics.pendingClients = _tasks.size();
+		statistics.pendingClientsPeak = _pendingPeak;
+	}
+	statistics.rejectedClients = _rejected;
+	statistics.acceptToHandle = _acceptToHandle.getPercentiles();
+	return statistics;
+}
+
+void ClientHandlerExecutor::run()
+{
+	currentExecutor = this;
+	while (true)
+	{
+		Task task;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_tasksAvailable.wait(lock, [this] { return !_running || !_tasks.empty(); });
+			if (!_running) return;
+
+			task = std::move(_tasks.front());
+			_tasks.pop_front();
+		}
+
+		_acceptToHandle.record(std::chrono::steady_clock::now() - task.submitTime);
+		task.function();
+	}
+}
+
+void ClientHandlerExecutor::joinThreads()
+{
+	std::list<std::thread> threads;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		threads.swap(_threadPool);
+	}
+	for (auto& t : threads)
+	{
+		if (t.joinable()) t.join();
+	}
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_INTERNAL_NETWORK_CLIENTHANDLEREXECUTOR_HPP
+#define GHOST_INTERNAL_NETWORK_CLIENTHANDLEREXECUTOR_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <ghost/connection/ClientHandlerStatistics.hpp>
+#include <list>
+#include <mutex>
+#include <thread>
+
+#include "../connection/LatencyTracer.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Runs the client handlers of a server with a bounded pool of threads. The accepted clients wait in
+ * a bounded queue until a thread is available, and the time they waited is recorded.
+ */
+class ClientHandlerExecutor
+{
+public:
+	ClientHandlerExecutor();
+	~ClientHandlerExecutor();
+
+	/// Starts "threadsCount" threads, at least one, accepting at most "maximumPending" waiting tasks.
+	void start(size_t threadsCount, size_t maximumPending);
+	/**
+	 * Discards the waiting tasks and stops the threads once their current task is done.
+	 * May be called by a task: the thread running it is then joined by the next call to start or by the
+	 * destructor.
+	 */
+	void stop();
+
+	/// Queues a task, returns false if too many tasks are waiting or if the executor is stopped.
+	bool submit(std::function<void()> task);
+	/// @return true if the calling thread is one of the threads of this executor.
+	bool isExecutorThread() const;
+	ghost::ClientHandlerStatistics getStatistics() const;
+
+private:
+	struct Task
+	{
+		std::function<void()> function;
+		std::chrono::steady_clock::time_point submitTime;
+	};
+
+	void run();
+	void joinThreads();
+
+	mutable std::mutex _mutex;
+	std::condition_variable _tasksAvailable;
+	std::deque<Task> _tasks;
+	bool _running;
+	size_t _maximumPending;
+	std::list<std::thread> _threadPool;
+
+	size_t _pendingPeak;
+	std::atomic<size_t> _rejected;
+	LatencyHistogram _acceptToHandle;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_NETWORK_CLIENTHANDLEREXECUTOR_HPP
@@ -65,6 +65,14 @@ void ClientManager::stopClients()
 	for (auto it = allClients.begin(); it != allClients.end(); ++it) (*it)->stop();
 }
 
+ghost::ConnectionStatistics ClientManager::getStatistics() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	ghost::ConnectionStatistics statistics;
+	for (const auto& client : _allClients) statistics += client->getStatistics();
+	return statistics;
+}
+
 void ClientManager::deleteDisposableClients()
 {
 	std::list<std::shared_ptr<RemoteClientGRPC>> clientsToStop;
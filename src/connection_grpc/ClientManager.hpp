@@ -19,6 +19,7 @@
 
 #include <atomic>
 #include <deque>
+#include <ghost/connection/ConnectionStatistics.hpp>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -45,6 +46,8 @@ public:
 	void addClient(std::shared_ptr<RemoteClientGRPC> client);
 	/// Stops currently running clients.
 	void stopClients();
+	/// Sums the statistics of the managed clients, the clients that were deleted are not included.
+	ghost::ConnectionStatistics getStatistics() const;
 
 private:
 	/// dispose and delete clients that are in finished state and owned solely by this manager
@@ -56,7 +59,7 @@ private:
 
 	std::thread _clientManagerThread;
 	std::atomic<bool> _clientManagerThreadEnable;
-	std::mutex _mutex;
+	mutable std::mutex _mutex;
 	std::deque<std::shared_ptr<RemoteClientGRPC>> _allClients;
 };
 } // namespace internal
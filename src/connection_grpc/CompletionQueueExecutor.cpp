@@ -16,6 +16,13 @@
 
 #include "CompletionQueueExecutor.hpp"
 
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 using namespace ghost::internal;
 
 CompletionQueueExecutor::CompletionQueueExecutor()
@@ -41,11 +48,13 @@ grpc::CompletionQueue* CompletionQueueExecutor::getCompletionQueue()
 	return _completionQueue.get();
 }
 
-void CompletionQueueExecutor::start(size_t threadsCount)
+void CompletionQueueExecutor::start(size_t threadsCount, int firstCpu)
 {
-	for (size_t i = 0; i < 2; i++)
+	size_t cpusCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+	for (size_t i = 0; i < std::max<size_t>(threadsCount, 1); i++)
 	{
 		_threadPool.push_back(std::thread(&CompletionQueueExecutor::handleRpcs, this));
+		if (firstCpu >= 0) pinThread(_threadPool.back(), (static_cast<size_t>(firstCpu) + i) % cpusCount);
 	}
 }
 
@@ -57,6 +66,7 @@ void CompletionQueueExecutor::stop()
 	{
 		if (t.joinable()) t.join();
 	}
+	_threadPool.clear();
 }
 
 void CompletionQueueExecutor::handleRpcs()
@@ -78,3 +88,14 @@ void CompletionQueueExecutor::handleRpcs()
 		(*tag.processor)(tag.ok);
 	}
 }
+
+void CompletionQueueExecutor::pinThread(std::thread& thread, size_t cpu)
+{
+#ifdef __linux__
+	cpu_set_t cpus;
+	CPU_ZERO(&cpus);
+	CPU_SET(cpu, &cpus);
+	// a failure leaves the thread unpinned, which only costs performance
+	pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpus);
+#endif
+}
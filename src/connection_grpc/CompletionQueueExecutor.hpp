@@ -27,6 +27,9 @@ namespace ghost
 {
 namespace internal
 {
+/**
+ * Polls a gRPC completion queue with a pool of threads and calls the processors of the completed tags.
+ */
 class CompletionQueueExecutor
 {
 public:
@@ -37,11 +40,17 @@ public:
 	void setCompletionQueue(std::unique_ptr<grpc::CompletionQueue> completion);
 	grpc::CompletionQueue* getCompletionQueue();
 
-	void start(size_t threadsCount);
+	/**
+	 * Starts "threadsCount" threads polling the completion queue, at least one.
+	 * @param firstCpu	if not negative, the threads are pinned to the CPU cores following "firstCpu",
+	 * wrapping around the number of cores. Only supported on Linux, ignored elsewhere.
+	 */
+	void start(size_t threadsCount, int firstCpu = -1);
 	void stop();
 
 private:
 	void handleRpcs();
+	static void pinThread(std::thread& thread, size_t cpu);
 
 	std::unique_ptr<grpc::CompletionQueue> _completionQueue;
 
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_INTERNAL_NETWORK_COMPRESSION_HPP
+#define GHOST_INTERNAL_NETWORK_COMPRESSION_HPP
+
+#include <grpc/compression.h>
+
+#include <ghost/connection_grpc/ConnectionConfigurationGRPC.hpp>
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Returns the gRPC compression algorithm matching the compression of the configuration.
+ */
+inline grpc_compression_algorithm getCompressionAlgorithm(const ghost::ConnectionConfigurationGRPC& config)
+{
+	switch (config.getCompression())
+	{
+		case ghost::ConnectionConfigurationGRPC::Compression::DEFLATE:
+			return GRPC_COMPRESS_DEFLATE;
+		case ghost::ConnectionConfigurationGRPC::Compression::GZIP:
+			return GRPC_COMPRESS_GZIP;
+		default:
+			return GRPC_COMPRESS_NONE;
+	}
+}
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_NETWORK_COMPRESSION_HPP
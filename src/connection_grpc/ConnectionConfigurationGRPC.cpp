@@ -16,6 +16,8 @@
 
 #include <ghost/connection_grpc/ConnectionConfigurationGRPC.hpp>
 
+#include <algorithm>
+
 using namespace ghost;
 
 namespace ghost
@@ -23,13 +25,62 @@ namespace ghost
 namespace internal
 {
 static std::string CONNECTIONCONFIGURATIONGRPC_TECHNOLOGY = "CONNECTIONCONFIGURATIONGRPC_TECHNOLOGY";
-}
+static std::string CONNECTIONCONFIGURATIONGRPC_COMPRESSION = "CONNECTIONCONFIGURATIONGRPC_COMPRESSION";
+static std::string CONNECTIONCONFIGURATIONGRPC_COMPRESSIONTHRESHOLD =
+    "CONNECTIONCONFIGURATIONGRPC_COMPRESSIONTHRESHOLD";
+static std::string CONNECTIONCONFIGURATIONGRPC_COMPLETIONQUEUECOUNT =
+    "CONNECTIONCONFIGURATIONGRPC_COMPLETIONQUEUECOUNT";
+static std::string CONNECTIONCONFIGURATIONGRPC_CPUPINNING = "CONNECTIONCONFIGURATIONGRPC_CPUPINNING";
+static std::string CONNECTIONCONFIGURATIONGRPC_CLIENTHANDLERTHREADCOUNT =
+    "CONNECTIONCONFIGURATIONGRPC_CLIENTHANDLERTHREADCOUNT";
+static std::string CONNECTIONCONFIGURATIONGRPC_MAXIMUMPENDINGCLIENTS =
+    "CONNECTIONCONFIGURATIONGRPC_MAXIMUMPENDINGCLIENTS";
+static std::string CONNECTIONCONFIGURATIONGRPC_SUBSCRIBERLAGPOLICY = "CONNECTIONCONFIGURATIONGRPC_SUBSCRIBERLAGPOLICY";
+static std::string CONNECTIONCONFIGURATIONGRPC_MAXIMUMSUBSCRIBERLAG =
+    "CONNECTIONCONFIGURATIONGRPC_MAXIMUMSUBSCRIBERLAG";
+static std::string CONNECTIONCONFIGURATIONGRPC_MAXIMUMSUBSCRIBERLAGDURATION =
+    "CONNECTIONCONFIGURATIONGRPC_MAXIMUMSUBSCRIBERLAGDURATION";
+} // namespace internal
 } // namespace ghost
 
 ConnectionConfigurationGRPC::ConnectionConfigurationGRPC(const std::string& name) : NetworkConnectionConfiguration(name)
 {
 	ghost::ConfigurationValue techonologyAttribute;
 	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_TECHNOLOGY, techonologyAttribute);
+
+	ghost::ConfigurationValue defaultCompression;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_COMPRESSION, defaultCompression);
+
+	ghost::ConfigurationValue defaultCompressionThreshold;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_COMPRESSIONTHRESHOLD,
+				     defaultCompressionThreshold);
+
+	ghost::ConfigurationValue defaultCompletionQueueCount;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_COMPLETIONQUEUECOUNT,
+				     defaultCompletionQueueCount);
+
+	ghost::ConfigurationValue defaultCpuPinning;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_CPUPINNING, defaultCpuPinning);
+
+	ghost::ConfigurationValue defaultClientHandlerThreadCount;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_CLIENTHANDLERTHREADCOUNT,
+				     defaultClientHandlerThreadCount);
+
+	ghost::ConfigurationValue defaultMaximumPendingClients;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_MAXIMUMPENDINGCLIENTS,
+				     defaultMaximumPendingClients);
+
+	ghost::ConfigurationValue defaultSubscriberLagPolicy;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_SUBSCRIBERLAGPOLICY,
+				     defaultSubscriberLagPolicy);
+
+	ghost::ConfigurationValue defaultMaximumSubscriberLag;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_MAXIMUMSUBSCRIBERLAG,
+				     defaultMaximumSubscriberLag);
+
+	ghost::ConfigurationValue defaultMaximumSubscriberLagDuration;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_MAXIMUMSUBSCRIBERLAGDURATION,
+				     defaultMaximumSubscriberLagDuration);
 }
 
 ConnectionConfigurationGRPC::ConnectionConfigurationGRPC(const std::string& ip, int port)
@@ -38,3 +89,215 @@ ConnectionConfigurationGRPC::ConnectionConfigurationGRPC(const std::string& ip,
 	setServerIpAddress(ip);
 	setServerPortNumber(port);
 }
+
+ConnectionConfigurationGRPC ConnectionConfigurationGRPC::createForUnixSocket(const std::string& path)
+{
+	ConnectionConfigurationGRPC configuration;
+	configuration.setUnixSocketPath(path);
+	return configuration;
+}
+
+ConnectionConfigurationGRPC::Compression ConnectionConfigurationGRPC::getCompression() const
+{
+	int res = (int)Compression::NONE;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<int>((int)Compression::NONE);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATIONGRPC_COMPRESSION, value,
+				     defaultValue); // if the field was removed, returns NONE
+	value.read<int>(res);
+
+	return (Compression)res;
+}
+
+size_t ConnectionConfigurationGRPC::getCompressionThreshold() const
+{
+	size_t res = 1024;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<size_t>(res);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATIONGRPC_COMPRESSIONTHRESHOLD, value,
+				     defaultValue); // if the field was removed, returns 1024
+	value.read<size_t>(res);
+
+	return res;
+}
+
+size_t ConnectionConfigurationGRPC::getCompletionQueueCount() const
+{
+	size_t res = 1;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<size_t>(res);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATIONGRPC_COMPLETIONQUEUECOUNT, value,
+				     defaultValue); // if the field was removed, returns 1
+	value.read<size_t>(res);
+
+	return std::max<size_t>(res, 1);
+}
+
+bool ConnectionConfigurationGRPC::isCpuPinningEnabled() const
+{
+	bool res = false;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<bool>(res);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATIONGRPC_CPUPINNING, value,
+				     defaultValue); // if the field was removed, returns false
+	value.read<bool>(res);
+
+	return res;
+}
+
+size_t ConnectionConfigurationGRPC::getClientHandlerThreadCount() const
+{
+	size_t res = 8;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<size_t>(res);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATIONGRPC_CLIENTHANDLERTHREADCOUNT, value,
+				     defaultValue); // if the field was removed, returns 8
+	value.read<size_t>(res);
+
+	return std::max<size_t>(res, 1);
+}
+
+size_t ConnectionConfigurationGRPC::getMaximumPendingClients() const
+{
+	size_t res = 1024;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<size_t>(res);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATIONGRPC_MAXIMUMPENDINGCLIENTS, value,
+				     defaultValue); // if the field was removed, returns 1024
+	value.read<size_t>(res);
+
+	return res;
+}
+
+ConnectionConfigurationGRPC::SubscriberLagPolicy ConnectionConfigurationGRPC::getSubscriberLagPolicy() const
+{
+	int res = (int)SubscriberLagPolicy::DISCONNECT;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<int>(res);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATIONGRPC_SUBSCRIBERLAGPOLICY, value,
+				     defaultValue); // if the field was removed, returns DISCONNECT
+	value.read<int>(res);
+
+	return (SubscriberLagPolicy)res;
+}
+
+size_t ConnectionConfigurationGRPC::getMaximumSubscriberLag() const
+{
+	size_t res = 0;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<size_t>(res);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATIONGRPC_MAXIMUMSUBSCRIBERLAG, value,
+				     defaultValue); // if the field was removed, returns 0
+	value.read<size_t>(res);
+
+	return res;
+}
+
+std::chrono::milliseconds ConnectionConfigurationGRPC::getMaximumSubscriberLagDuration() const
+{
+	long long res = 0;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<long long>(res);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATIONGRPC_MAXIMUMSUBSCRIBERLAGDURATION, value,
+				     defaultValue); // if the field was removed, returns 0
+	value.read<long long>(res);
+
+	return std::chrono::milliseconds(res);
+}
+
+void ConnectionConfigurationGRPC::setCompression(Compression compression)
+{
+	ghost::ConfigurationValue value;
+	value.write<int>((int)compression);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_COMPRESSION, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfigurationGRPC::setCompressionThreshold(size_t threshold)
+{
+	ghost::ConfigurationValue value;
+	value.write<size_t>(threshold);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_COMPRESSIONTHRESHOLD, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfigurationGRPC::setCompletionQueueCount(size_t count)
+{
+	ghost::ConfigurationValue value;
+	value.write<size_t>(count);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_COMPLETIONQUEUECOUNT, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfigurationGRPC::setCpuPinningEnabled(bool enabled)
+{
+	ghost::ConfigurationValue value;
+	value.write<bool>(enabled);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_CPUPINNING, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfigurationGRPC::setClientHandlerThreadCount(size_t count)
+{
+	ghost::ConfigurationValue value;
+	value.write<size_t>(count);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_CLIENTHANDLERTHREADCOUNT, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfigurationGRPC::setMaximumPendingClients(size_t count)
+{
+	ghost::ConfigurationValue value;
+	value.write<size_t>(count);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_MAXIMUMPENDINGCLIENTS, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfigurationGRPC::setSubscriberLagPolicy(SubscriberLagPolicy policy)
+{
+	ghost::ConfigurationValue value;
+	value.write<int>((int)policy);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_SUBSCRIBERLAGPOLICY, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfigurationGRPC::setMaximumSubscriberLag(size_t messages)
+{
+	ghost::ConfigurationValue value;
+	value.write<size_t>(messages);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_MAXIMUMSUBSCRIBERLAG, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfigurationGRPC::setMaximumSubscriberLagDuration(std::chrono::milliseconds duration)
+{
+	ghost::ConfigurationValue value;
+	value.write<long long>(duration.count());
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONGRPC_MAXIMUMSUBSCRIBERLAGDURATION, value,
+				     true); // checks if the attribute is there as well
+}
+
+ConnectionConfigurationGRPC ConnectionConfigurationGRPC::initializeFrom(const ConnectionConfiguration& from)
+{
+	ConnectionConfigurationGRPC newconfig(from.getConfiguration()->getConfigurationName());
+	from.getConfiguration()->copy(*newconfig.getConfiguration());
+	return newconfig;
+}
@@ -16,8 +16,17 @@
 
 #include "PublisherClientHandler.hpp"
 
+#include "../connection/LatencyTracer.hpp"
+#include "RemoteClientGRPC.hpp"
+
 using namespace ghost::internal;
 
+PublisherClientHandler::PublisherClientHandler(const std::shared_ptr<const ConflationKeys>& conflationKeys,
+					       std::chrono::milliseconds maximumLag)
+    : _conflationKeys(conflationKeys), _maximumLag(maximumLag)
+{
+}
+
 PublisherClientHandler::~PublisherClientHandler()
 {
 	releaseClients();
@@ -27,48 +36,139 @@ bool PublisherClientHandler::handle(std::shared_ptr<ghost::Client> client, bool&
 {
 	keepClientAlive = true;
 
+	// the subscribers are the clients of the gRPC server, whose queues accept shared messages
+	auto remoteClient = std::dynamic_pointer_cast<RemoteClientGRPC>(client);
+	if (!remoteClient) return true;
+
 	std::lock_guard<std::mutex> lock(_subscribersMutex);
 
-	auto writer = client->getWriter<google::protobuf::Any>();
-	auto entry = std::make_pair(client, writer);
+	Subscriber subscriber;
+	subscriber.client = remoteClient;
+	subscriber.sink = std::static_pointer_cast<WriterSink>(remoteClient->getWriterSink());
+	subscriber.caughtUpTime = std::chrono::steady_clock::now();
 
-	_subscribers.push_back(entry);
+	// the messages waiting for a subscriber are conflated before the first one is written
+	if (_conflationKeys && !_conflationKeys->empty()) subscriber.sink->setConflationKeys(_conflationKeys);
+
+	_subscribers.push_back(subscriber);
 
 	return true;
 }
 
-bool PublisherClientHandler::send(const google::protobuf::Any& message)
+bool PublisherClientHandler::send(std::vector<google::protobuf::Any>& messages, ghost::MessagePriority priority)
 {
-	std::lock_guard<std::mutex> lock(_subscribersMutex);
+	if (countSubscribers() == 0) return true;
+
+	// the hand-off to the transport is stamped once, before the messages are serialized for all the subscribers,
+	// and their conflation keys are computed once as well
+	std::vector<std::shared_ptr<const SerializedMessage>> serialized;
+	serialized.reserve(messages.size());
+	for (auto& message : messages)
+	{
+		LatencyTracer::stampHandoff(message); // if the latency of the message is traced
+		serialized.push_back(std::make_shared<SerializedMessage>(message, _conflationKeys));
+	}
 
-	auto it = _subscribers.begin();
-	while (it != _subscribers.end())
+	// the queues of the subscribers do not block, and the released subscribers are not waited for: the lock
+	// is not held while waiting for a slow subscriber
+	std::vector<Subscriber> released;
 	{
-		if (!it->first->isRunning()	 // if the client is not running anymore, dont send anything
-		    || !it->second->write(message)) // if the write failed
+		std::lock_guard<std::mutex> lock(_subscribersMutex);
+		auto now = std::chrono::steady_clock::now();
+		auto it = _subscribers.begin();
+		while (it != _subscribers.end())
 		{
-			it->first->stop();
-			it = _subscribers.erase(it);
+			if (it->sink->getQueueDepth() == 0) it->caughtUpTime = now;
+
+			// the subscribers that are not running anymore, whose queue rejects the messages or which
+			// lag for too long are released
+			if (!it->client->isRunning() || !it->sink->pushSerialized(serialized, priority) ||
+			    isLagging(*it, now))
+			{
+				released.push_back(std::move(*it));
+				it = _subscribers.erase(it);
+			}
+			else
+				++it;
 		}
-		else
-			++it;
 	}
+	release(released);
 
 	return true;
 }
 
+void PublisherClientHandler::releaseLaggingSubscribers()
+{
+	std::vector<Subscriber> released;
+	{
+		std::lock_guard<std::mutex> lock(_subscribersMutex);
+		auto now = std::chrono::steady_clock::now();
+		auto it = _subscribers.begin();
+		while (it != _subscribers.end())
+		{
+			if (it->sink->getQueueDepth() == 0) it->caughtUpTime = now;
+
+			if (!it->client->isRunning() || isLagging(*it, now))
+			{
+				released.push_back(std::move(*it));
+				it = _subscribers.erase(it);
+			}
+			else
+				++it;
+		}
+	}
+	release(released);
+}
+
 size_t PublisherClientHandler::countSubscribers() const
 {
 	std::lock_guard<std::mutex> lock(_subscribersMutex);
 	return _subscribers.size();
 }
 
-void PublisherClientHandler::releaseClients()
+std::vector<ghost::SubscriberLag> PublisherClientHandler::getSubscriberLags() const
 {
 	std::lock_guard<std::mutex> lock(_subscribersMutex);
-	for (auto it = _subscribers.begin(); it != _subscribers.end(); ++it)
+	auto now = std::chrono::steady_clock::now();
+
+	std::vector<ghost::SubscriberLag> lags;
+	lags.reserve(_subscribers.size());
+	for (const auto& subscriber : _subscribers)
+	{
+		ghost::SubscriberLag lag;
+		lag.messages = subscriber.sink->getQueueDepth();
+		lag.duration = std::chrono::duration_cast<std::chrono::milliseconds>(getLagDuration(subscriber, now));
+		lag.droppedMessages = subscriber.sink->getDroppedMessagesCount();
+		lags.push_back(lag);
+	}
+	return lags;
+}
+
+void PublisherClientHandler::releaseClients()
+{
+	std::vector<Subscriber> released;
 	{
-		it->first->stop();
+		std::lock_guard<std::mutex> lock(_subscribersMutex);
+		released.assign(_subscribers.begin(), _subscribers.end());
+		_subscribers.clear();
 	}
-	_subscribers.clear();
+	release(released);
+}
+
+void PublisherClientHandler::release(const std::vector<Subscriber>& subscribers)
+{
+	// stopping a client waits for its pending write, which a stalled subscriber never completes
+	for (const auto& subscriber : subscribers) subscriber.client->getRPC()->cancel();
+}
+
+bool PublisherClientHandler::isLagging(const Subscriber& subscriber, std::chrono::steady_clock::time_point now) const
+{
+	return _maximumLag.count() > 0 && getLagDuration(subscriber, now) > _maximumLag;
+}
+
+std::chrono::steady_clock::duration PublisherClientHandler::getLagDuration(const Subscriber& subscriber,
+									   std::chrono::steady_clock::time_point now)
+{
+	if (subscriber.sink->getQueueDepth() == 0) return std::chrono::steady_clock::duration::zero();
+	return now - subscriber.caughtUpTime;
 }
@@ -17,34 +17,84 @@
 #ifndef GHOST_INTERNAL_NETWORK_PUBLISHERCLIENTHANDLER_HPP
 #define GHOST_INTERNAL_NETWORK_PUBLISHERCLIENTHANDLER_HPP
 
+#include <chrono>
 #include <deque>
 #include <ghost/connection/Client.hpp>
 #include <ghost/connection/ClientHandler.hpp>
-#include <ghost/connection/Writer.hpp>
+#include <ghost/connection/MessagePriority.hpp>
+#include <ghost/connection/SubscriberLag.hpp>
+#include <ghost/connection/internal/ConflationKeys.hpp>
+#include <memory>
 #include <mutex>
+#include <vector>
+
+#include "../connection/WriterSink.hpp"
 
 namespace ghost
 {
 namespace internal
 {
+class RemoteClientGRPC;
+
 /**
  *	This handler keeps the clients which connect to the server, and sends them the published data.
+ *	Every subscriber has its own bounded queue, whose overflow policy must not block: a subscriber
+ *	which does not keep up with the published messages only lags behind, without delaying the others.
  */
 class PublisherClientHandler : public ghost::ClientHandler
 {
 public:
+	/**
+	 *	@param conflationKeys	conflated message types of the publisher, set on the queues of the
+	 *	subscribers.
+	 *	@param maximumLag	time after which a subscriber which did not catch up is disconnected, zero to
+	 *	keep the lagging subscribers.
+	 */
+	PublisherClientHandler(const std::shared_ptr<const ConflationKeys>& conflationKeys = nullptr,
+			       std::chrono::milliseconds maximumLag = std::chrono::milliseconds(0));
 	~PublisherClientHandler();
 
 	bool handle(std::shared_ptr<ghost::Client> client, bool& keepClientAlive) override;
 
-	bool send(const google::protobuf::Any& message);
+	/**
+	 *	Sends the messages to every subscriber, in one batch per subscriber, with the given priority.
+	 *	The messages are moved out of "messages" and serialized once, for all the subscribers. The
+	 *	subscribers whose queue rejects the messages, or which lag for too long, are disconnected.
+	 */
+	bool send(std::vector<google::protobuf::Any>& messages,
+		  ghost::MessagePriority priority = ghost::MessagePriority::NORMAL);
+	/**
+	 *	Disconnects the subscribers which stopped or lag for too long, without sending them anything: a
+	 *	publisher which does not send messages calls it to still release its stalled subscribers.
+	 */
+	void releaseLaggingSubscribers();
 	void releaseClients();
 	size_t countSubscribers() const;
+	/// @return the lag of every subscriber, in the order in which they connected.
+	std::vector<ghost::SubscriberLag> getSubscriberLags() const;
 
 private:
+	struct Subscriber
+	{
+		std::shared_ptr<RemoteClientGRPC> client;
+		/// Queue of the client, which shares the messages with the other subscribers.
+		std::shared_ptr<WriterSink> sink;
+		/// Last time the queue of the client was found empty before messages were pushed into it.
+		std::chrono::steady_clock::time_point caughtUpTime;
+	};
+
+	/// Cancels the calls of the released subscribers, which are deleted by the server once they finished.
+	static void release(const std::vector<Subscriber>& subscribers);
+	/// @return true if "subscriber" lags for longer than the maximum lag.
+	bool isLagging(const Subscriber& subscriber, std::chrono::steady_clock::time_point now) const;
+	/// @return the time since "subscriber" caught up, zero if its queue is empty.
+	static std::chrono::steady_clock::duration getLagDuration(const Subscriber& subscriber,
+								  std::chrono::steady_clock::time_point now);
+
+	std::shared_ptr<const ConflationKeys> _conflationKeys;
+	std::chrono::milliseconds _maximumLag;
 	mutable std::mutex _subscribersMutex;
-	std::deque<std::pair<std::shared_ptr<ghost::Client>, std::shared_ptr<ghost::Writer<google::protobuf::Any>>>>
-	    _subscribers;
+	std::deque<Subscriber> _subscribers;
 };
 } // namespace internal
 } // namespace ghost
@@ -16,17 +16,57 @@
 
 #include "PublisherGRPC.hpp"
 
+#include <ghost/connection_grpc/ConnectionConfigurationGRPC.hpp>
+
+#include "../connection/WriterSink.hpp"
+
 using namespace ghost::internal;
 
+namespace
+{
+/// The queues of the subscribers are bounded by their maximum lag, and apply the lag policy instead of blocking.
+ghost::NetworkConnectionConfiguration createSubscribersConfiguration(
+    const ghost::NetworkConnectionConfiguration& config)
+{
+	using LagPolicy = ghost::ConnectionConfigurationGRPC::SubscriberLagPolicy;
+	using OverflowPolicy = ghost::ConnectionConfiguration::OverflowPolicy;
+
+	auto configuration = ghost::ConnectionConfigurationGRPC::initializeFrom(config);
+	if (configuration.getMaximumSubscriberLag() > 0)
+		configuration.setWriterQueueDepth(configuration.getMaximumSubscriberLag());
+
+	switch (configuration.getSubscriberLagPolicy())
+	{
+		case LagPolicy::DROP_NEWEST:
+			configuration.setWriterOverflowPolicy(OverflowPolicy::DROP_NEWEST);
+			break;
+		case LagPolicy::DROP_OLDEST:
+			configuration.setWriterOverflowPolicy(OverflowPolicy::DROP_OLDEST);
+			break;
+		default: // DISCONNECT
+			configuration.setWriterOverflowPolicy(OverflowPolicy::FAIL);
+			break;
+	}
+	return configuration;
+}
+} // namespace
+
 PublisherGRPC::PublisherGRPC(const ghost::ConnectionConfiguration& config)
     : PublisherGRPC(ghost::NetworkConnectionConfiguration::initializeFrom(config))
 {
 }
 
 PublisherGRPC::PublisherGRPC(const ghost::NetworkConnectionConfiguration& config)
-    : ghost::Publisher(config), _server(config), _writerThreadEnable(false)
+    : ghost::Publisher(config), _server(createSubscribersConfiguration(config)), _writerThreadEnable(false)
 {
-	_handler = std::make_shared<PublisherClientHandler>();
+	// only the disconnecting policy releases the subscribers which lag for too long
+	auto configuration = ghost::ConnectionConfigurationGRPC::initializeFrom(config);
+	auto maximumLag = std::chrono::milliseconds(0);
+	using LagPolicy = ghost::ConnectionConfigurationGRPC::SubscriberLagPolicy;
+	if (configuration.getSubscriberLagPolicy() == LagPolicy::DISCONNECT)
+		maximumLag = configuration.getMaximumSubscriberLagDuration();
+
+	_handler = std::make_shared<PublisherClientHandler>(getConflationKeys(), maximumLag);
 	_server.setClientHandler(_handler);
 }
 
@@ -40,11 +80,12 @@ bool PublisherGRPC::start()
 
 bool PublisherGRPC::stop()
 {
-	getWriterSink()->drain();
-
+	// the writer thread is the only consumer of the sink: it is stopped before the sink is drained
 	_writerThreadEnable = false;
 	if (_writerThread.joinable()) _writerThread.join();
 
+	getWriterSink()->drain();
+
 	_handler->releaseClients();
 	return _server.stop();
 }
@@ -61,16 +102,33 @@ size_t PublisherGRPC::countSubscribers() const
 
 void PublisherGRPC::writerThread()
 {
+	auto writer = std::static_pointer_cast<ghost::internal::WriterSink>(getWriterSink());
+	std::vector<google::protobuf::Any> messages;
+	ghost::MessagePriority priority;
 	while (_writerThreadEnable)
 	{
-		auto writer = getWriterSink();
-		google::protobuf::Any message;
-		bool getSuccess = writer->get(message, std::chrono::milliseconds(10));
+		// the batches do not mix priorities, so that the subscribers send them in their own lanes
+		messages.clear();
+		size_t count = writer->getBatch(messages, MAXIMUM_BATCH_SIZE, std::chrono::milliseconds(10), priority);
 
-		if (getSuccess)
+		if (count > 0)
 		{
-			_handler->send(message);
-			writer->pop();
+			_handler->send(messages, priority);
+			for (size_t i = 0; i < count; ++i) writer->pop();
 		}
+		else // the lag of the subscribers is also checked when nothing is published
+			_handler->releaseLaggingSubscribers();
 	}
 }
+
+std::vector<ghost::SubscriberLag> PublisherGRPC::getSubscriberLags() const
+{
+	return _handler->getSubscriberLags();
+}
+
+ghost::ConnectionStatistics PublisherGRPC::getTransportStatistics() const
+{
+	ghost::ConnectionStatistics statistics;
+	statistics.stateTransitions = _server.getStatistics().stateTransitions;
+	return statistics;
+}
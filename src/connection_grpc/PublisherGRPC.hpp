@@ -40,8 +40,16 @@ public:
 	bool isRunning() const override;
 
 	size_t countSubscribers() const;
+	std::vector<ghost::SubscriberLag> getSubscriberLags() const override;
+
+protected:
+	/// The transport of a publisher is the set of RPCs of its subscribers.
+	ghost::ConnectionStatistics getTransportStatistics() const override;
 
 private:
+	/// Maximum number of messages taken from the writer sink and forwarded to the subscribers at once.
+	static const size_t MAXIMUM_BATCH_SIZE = 64;
+
 	void writerThread(); // waits for the writer to be fed and sends the data to the handler
 
 	ServerGRPC _server;
@@ -26,11 +26,6 @@ RemoteClientGRPC::RemoteClientGRPC(const ghost::ConnectionConfiguration& configu
 {
 }
 
-RemoteClientGRPC::~RemoteClientGRPC()
-{
-	if (_executor.joinable()) _executor.join();
-}
-
 bool RemoteClientGRPC::start()
 {
 	return false; // it is supposed to be already started by the server
@@ -48,31 +43,27 @@ bool RemoteClientGRPC::isRunning() const
 
 void RemoteClientGRPC::execute()
 {
-	_executor = std::thread([this] {
-		_running = true;
+	_running = true;
 
-		if (_parentServer->getClientHandler())
-			_parentServer->getClientHandler()->configureClient(_rpc->getParent());
+	if (_parentServer->getClientHandler()) _parentServer->getClientHandler()->configureClient(_rpc->getParent());
 
-		_rpc->startReader(getReaderSink());
-		_rpc->startWriter(getWriterSink());
+	_rpc->startReader(getReaderSink());
+	_rpc->startWriter(getWriterSink());
 
-		// call the application code
-		bool continueExecution = true;
-		bool keepClientAlive = false;
+	// call the application code
+	bool continueExecution = true;
+	bool keepClientAlive = false;
 
-		if (_parentServer->getClientHandler())
-			continueExecution =
-			    _parentServer->getClientHandler()->handle(_rpc->getParent(), keepClientAlive);
+	if (_parentServer->getClientHandler())
+		continueExecution = _parentServer->getClientHandler()->handle(_rpc->getParent(), keepClientAlive);
 
-		// only stop the client if the user left "keepClientAlive" to false
-		if (!keepClientAlive) stop();
+	// only stop the client if the user left "keepClientAlive" to false
+	if (!keepClientAlive) stop();
 
-		// if continueExecution is false, stop the server
-		if (!continueExecution) _parentServer->stop();
+	// if continueExecution is false, stop the server
+	if (!continueExecution) _parentServer->stop();
 
-		_running = false;
-	});
+	_running = false;
 }
 
 std::shared_ptr<ghost::ReaderSink> RemoteClientGRPC::getReaderSink() const
@@ -89,3 +80,10 @@ const std::shared_ptr<IncomingRPC> RemoteClientGRPC::getRPC() const
 {
 	return _rpc;
 }
+
+ghost::ConnectionStatistics RemoteClientGRPC::getTransportStatistics() const
+{
+	ghost::ConnectionStatistics statistics;
+	statistics.stateTransitions = _rpc->getStateTransitionsCount();
+	return statistics;
+}
@@ -19,7 +19,6 @@
 
 #include <ghost/connection/Client.hpp>
 #include <memory>
-#include <thread>
 
 #include "rpc/IncomingRPC.hpp"
 
@@ -34,22 +33,24 @@ class RemoteClientGRPC : public ghost::Client
 public:
 	RemoteClientGRPC(const ghost::ConnectionConfiguration& configuration, const std::shared_ptr<IncomingRPC>& rpc,
 			 ServerGRPC* parentServer);
-	~RemoteClientGRPC();
 
 	bool start() override;
 	bool stop() override;
 	bool isRunning() const override;
 
+	/// Calls the client handler of the server, on the calling thread.
 	void execute();
 
 	std::shared_ptr<ghost::ReaderSink> getReaderSink() const;
 	std::shared_ptr<ghost::WriterSink> getWriterSink() const;
 	const std::shared_ptr<IncomingRPC> getRPC() const;
 
+protected:
+	ghost::ConnectionStatistics getTransportStatistics() const override;
+
 private:
 	std::shared_ptr<IncomingRPC> _rpc;
 	std::atomic_bool _running;
-	std::thread _executor;
 
 	ServerGRPC* _parentServer;
 };
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_INTERNAL_NETWORK_SERVERADDRESS_HPP
+#define GHOST_INTERNAL_NETWORK_SERVERADDRESS_HPP
+
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <string>
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Returns the address used by gRPC to reach the server described by the configuration:
+ *	"unix:<path>" if a Unix domain socket path is set, "<ip>:<port>" otherwise.
+ */
+inline std::string getServerAddress(const ghost::NetworkConnectionConfiguration& config)
+{
+	std::string socketPath = config.getUnixSocketPath();
+	if (!socketPath.empty()) return "unix:" + socketPath;
+
+	return config.getServerIpAddress() + ":" + std::to_string(config.getServerPortNumber());
+}
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_NETWORK_SERVERADDRESS_HPP
@@ -20,7 +20,11 @@
 #include <grpcpp/server.h>
 #include <grpcpp/server_builder.h>
 
+#include <algorithm>
+
+#include "Compression.hpp"
 #include "RemoteClientGRPC.hpp"
+#include "ServerAddress.hpp"
 #include "rpc/IncomingRPC.hpp"
 
 using namespace ghost::internal;
@@ -30,8 +34,18 @@ ServerGRPC::ServerGRPC(const ghost::ConnectionConfiguration& config)
 {
 }
 
-ServerGRPC::ServerGRPC(const ghost::NetworkConnectionConfiguration& config) : _configuration(config), _running(false)
+ServerGRPC::ServerGRPC(const ghost::NetworkConnectionConfiguration& config)
+    : _configuration(config)
+    , _running(false)
+    , _compressionThreshold(0)
+    , _nextCompletionQueue(0)
+{
+}
+
+ServerGRPC::~ServerGRPC()
 {
+	// waits for a stop initiated by a client handler to complete before the members are destroyed
+	stop();
 }
 
 bool ServerGRPC::start()
@@ -40,14 +54,18 @@ bool ServerGRPC::start()
 
 	_running = true;
 
-	std::string serverAddress =
-	    _configuration.getServerIpAddress() + ":" + std::to_string(_configuration.getServerPortNumber());
+	std::string serverAddress = getServerAddress(_configuration);
 
 	grpc::ServerBuilder builder;
 
-	// Prevents two servers from using the same port.
+	// Prevents two servers from using the same port. Note that gRPC replaces the file of an existing Unix socket.
 	builder.AddChannelArgument(GRPC_ARG_ALLOW_REUSEPORT, 0);
 
+	// Compresses the messages sent to the clients supporting the configured algorithm.
+	auto configuration = ghost::ConnectionConfigurationGRPC::initializeFrom(_configuration);
+	builder.SetDefaultCompressionAlgorithm(getCompressionAlgorithm(configuration));
+	_compressionThreshold = configuration.getCompressionThreshold();
+
 	// Listen on the given address without any authentication mechanism.
 	builder.AddListeningPort(serverAddress, ::grpc::InsecureServerCredentials());
 
@@ -55,9 +73,16 @@ bool ServerGRPC::start()
 	// clients. In this case it corresponds to an *asynchronous* service.
 	builder.RegisterService(&_service);
 
-	// Get hold of the completion queue used for the asynchronous communication
+	// Get hold of the completion queues used for the asynchronous communication
 	// with the gRPC runtime.
-	_completionQueueExecutor.setCompletionQueue(builder.AddCompletionQueue());
+	size_t completionQueueCount = configuration.getCompletionQueueCount();
+	_completionQueueExecutors.clear();
+	for (size_t i = 0; i < completionQueueCount; i++)
+	{
+		std::unique_ptr<CompletionQueueExecutor> executor(new CompletionQueueExecutor());
+		executor->setCompletionQueue(builder.AddCompletionQueue());
+		_completionQueueExecutors.push_back(std::move(executor));
+	}
 
 	// Finally assemble the server.
 	_grpcServer = builder.BuildAndStart();
@@ -67,20 +92,24 @@ bool ServerGRPC::start()
 		return false; // Starting the server failed
 	}
 
-	_completionQueueExecutor.start(_configuration.getThreadPoolSize());
-
-	auto callback = std::bind(&ServerGRPC::onClientConnected, this, std::placeholders::_1);
-
-	auto cq = static_cast<grpc::ServerCompletionQueue*>(_completionQueueExecutor.getCompletionQueue());
-	for (size_t i = 0; i < _configuration.getThreadPoolSize();
-	     i++) // start as many calls as there can be concurrent rpcs
+	// The thread pool is split between the completion queues, each of them getting at least one thread.
+	size_t threadPoolSize = _configuration.getThreadPoolSize();
+	bool cpuPinning = configuration.isCpuPinningEnabled();
+	size_t firstCpu = 0;
+	for (size_t i = 0; i < completionQueueCount; i++)
 	{
-		// Spawn a new CallData instance to serve new clients
-		auto client = std::make_shared<RemoteClientGRPC>(
-		    _configuration, std::make_shared<IncomingRPC>(&_service, cq, callback), this);
-		client->getRPC()->setParent(client);
-		_clientManager.addClient(client);
+		size_t threadsCount = threadPoolSize / completionQueueCount;
+		if (i < threadPoolSize % completionQueueCount) threadsCount++;
+		threadsCount = std::max<size_t>(threadsCount, 1);
+		_completionQueueExecutors[i]->start(threadsCount, cpuPinning ? static_cast<int>(firstCpu) : -1);
+		firstCpu += threadsCount;
 	}
+
+	// start as many calls as there can be concurrent rpcs, and at least one per completion queue
+	_nextCompletionQueue = 0;
+	for (size_t i = 0; i < std::max(threadPoolSize, completionQueueCount); i++) addIncomingClient();
+	_clientHandlerExecutor.start(configuration.getClientHandlerThreadCount(),
+				     configuration.getMaximumPendingClients());
 	_clientManager.start();
 
 	return true;
@@ -88,16 +117,28 @@ bool ServerGRPC::start()
 
 bool ServerGRPC::stop()
 {
+	// A client handler stopping the server while another thread stops it returns right away: the
+	// stopping thread waits for the client handlers to return, and would wait for this one forever.
+	std::unique_lock<std::mutex> lock(_stopMutex, std::defer_lock);
+	if (_clientHandlerExecutor.isExecutorThread())
+	{
+		if (!lock.try_lock()) return false;
+	}
+	else
+		lock.lock();
+
 	if (!_running) return false;
 
 	_running = false;
 
 	// Stop currently active clients so that shutting down the grpc server does not hang
 	_clientManager.stopClients();
+	// Wait for the running client handlers, the waiting ones are discarded
+	_clientHandlerExecutor.stop();
 	// Shut down the grpc server - this will wait until current RPCs are processed
 	if (_grpcServer) _grpcServer->Shutdown();
-	// Stop the completion queue, finishing the remaining open operations
-	_completionQueueExecutor.stop();
+	// Stop the completion queues, finishing the remaining open operations
+	for (auto& executor : _completionQueueExecutors) executor->stop();
 	// Stops not stopped clients and delete all objects.
 	_clientManager.stop();
 
@@ -125,19 +166,41 @@ const std::shared_ptr<ghost::ClientHandler> ServerGRPC::getClientHandler() const
 	return _clientHandler;
 }
 
+ghost::ConnectionStatistics ServerGRPC::getStatistics() const
+{
+	return _clientManager.getStatistics();
+}
+
+ghost::ClientHandlerStatistics ServerGRPC::getClientHandlerStatistics() const
+{
+	return _clientHandlerExecutor.getStatistics();
+}
+
 void ServerGRPC::onClientConnected(std::shared_ptr<RemoteClientGRPC> client)
 {
-	if (isRunning())
+	// restart the process of creating the request for the next client
+	if (isRunning()) addIncomingClient();
+
+	// Execute the application's code in the thread pool of the handlers. Clients accepted while too many
+	// are waiting are disconnected right away, without waiting since this runs in a completion queue thread
+	if (!_clientHandlerExecutor.submit([client] { client->execute(); }))
 	{
-		// restart the process of creating the request for the next client
-		auto cq = static_cast<grpc::ServerCompletionQueue*>(_completionQueueExecutor.getCompletionQueue());
-		auto callback = std::bind(&ServerGRPC::onClientConnected, this, std::placeholders::_1);
-		auto newClient = std::make_shared<RemoteClientGRPC>(
-		    _configuration, std::make_shared<IncomingRPC>(&_service, cq, callback), this);
-		newClient->getRPC()->setParent(newClient);
-		_clientManager.addClient(newClient);
+		grpc::Status status(grpc::StatusCode::RESOURCE_EXHAUSTED, "too many pending clients");
+		client->getRPC()->finish(status);
 	}
+}
+
+void ServerGRPC::addIncomingClient()
+{
+	// the calls are spread over the completion queues in turn
+	size_t index = _nextCompletionQueue.fetch_add(1) % _completionQueueExecutors.size();
+	auto cq = static_cast<grpc::ServerCompletionQueue*>(_completionQueueExecutors[index]->getCompletionQueue());
+	auto callback = std::bind(&ServerGRPC::onClientConnected, this, std::placeholders::_1);
 
-	// Execute the application's code in a separate thread
-	client->execute();
+	// Spawn a new CallData instance to serve new clients
+	auto rpc = std::make_shared<IncomingRPC>(&_service, cq, callback);
+	rpc->setCompressionThreshold(_compressionThreshold);
+	auto client = std::make_shared<RemoteClientGRPC>(_configuration, rpc, this);
+	client->getRPC()->setParent(client);
+	_clientManager.addClient(client);
 }
@@ -25,9 +25,13 @@
 #include <ghost/connection/NetworkConnectionConfiguration.hpp>
 #include <ghost/connection/Server.hpp>
 #include <memory>
+#include <mutex>
+#include <vector>
 
+#include "ClientHandlerExecutor.hpp"
 #include "ClientManager.hpp"
 #include "CompletionQueueExecutor.hpp"
+#include "rpc/ServerStream.hpp"
 
 namespace ghost
 {
@@ -46,6 +50,7 @@ class ServerGRPC : public ghost::Server
 public:
 	ServerGRPC(const ghost::ConnectionConfiguration& config);
 	ServerGRPC(const ghost::NetworkConnectionConfiguration& config);
+	~ServerGRPC();
 
 	bool start() override;
 	bool stop() override;
@@ -54,18 +59,29 @@ public:
 	void setClientHandler(std::shared_ptr<ClientHandler> handler) override;
 	const std::shared_ptr<ClientHandler> getClientHandler() const;
 
+	/// @return the sum of the statistics of the clients currently connected to this server.
+	ghost::ConnectionStatistics getStatistics() const override;
+	ghost::ClientHandlerStatistics getClientHandlerStatistics() const override;
+
 private:
 	void onClientConnected(std::shared_ptr<RemoteClientGRPC> client);
+	/// Creates a client waiting for the next incoming call, on the next completion queue.
+	void addIncomingClient();
 
 	ghost::NetworkConnectionConfiguration _configuration;
 	std::atomic<bool> _running;
+	std::mutex _stopMutex; // held while stopping, a client handler may stop the server concurrently to its owner
+	size_t _compressionThreshold;
 
-	ghost::protobuf::connectiongrpc::ServerClientService::AsyncService _service;
+	ServerClientAsyncService _service;
 	std::unique_ptr<grpc::Server> _grpcServer;
-	CompletionQueueExecutor _completionQueueExecutor;
+	std::vector<std::unique_ptr<CompletionQueueExecutor>> _completionQueueExecutors;
+	std::atomic<size_t> _nextCompletionQueue;
 
 	ClientManager _clientManager;
 	std::shared_ptr<ClientHandler> _clientHandler;
+	/// Declared last to be deleted first: joins the thread that may have stopped the server.
+	ClientHandlerExecutor _clientHandlerExecutor;
 };
 } // namespace internal
 } // namespace ghost
@@ -16,6 +16,9 @@
 
 #include "SubscriberGRPC.hpp"
 
+#include "Compression.hpp"
+#include "ServerAddress.hpp"
+
 using namespace ghost::internal;
 
 SubscriberGRPC::SubscriberGRPC(const ghost::ConnectionConfiguration& config)
@@ -25,8 +28,10 @@ SubscriberGRPC::SubscriberGRPC(const ghost::ConnectionConfiguration& config)
 
 SubscriberGRPC::SubscriberGRPC(const ghost::NetworkConnectionConfiguration& config)
     : ghost::Subscriber(config)
-    , _client(config.getServerIpAddress(), config.getServerPortNumber(), config.getThreadPoolSize())
+    , _client(getServerAddress(config), config.getThreadPoolSize())
 {
+	auto configuration = ghost::ConnectionConfigurationGRPC::initializeFrom(config);
+	_client.setCompression(getCompressionAlgorithm(configuration), configuration.getCompressionThreshold());
 	_client.setReaderSink(getReaderSink());
 }
 
@@ -44,3 +49,10 @@ bool SubscriberGRPC::isRunning() const
 {
 	return _client.isRunning();
 }
+
+ghost::ConnectionStatistics SubscriberGRPC::getTransportStatistics() const
+{
+	ghost::ConnectionStatistics statistics;
+	statistics.stateTransitions = _client.getStateTransitionsCount();
+	return statistics;
+}
@@ -36,6 +36,9 @@ public:
 	bool stop() override;
 	bool isRunning() const override;
 
+protected:
+	ghost::ConnectionStatistics getTransportStatistics() const override;
+
 private:
 	OutgoingRPC _client;
 };
@@ -20,10 +20,12 @@
 
 using namespace ghost::internal;
 
-IncomingRPC::IncomingRPC(ghost::protobuf::connectiongrpc::ServerClientService::AsyncService* service,
-			 grpc::ServerCompletionQueue* completionQueue,
+IncomingRPC::IncomingRPC(ServiceType* service, grpc::ServerCompletionQueue* completionQueue,
 			 const std::function<void(std::shared_ptr<RemoteClientGRPC>)>& clientConnectedCallback)
     : _serverCallback(clientConnectedCallback)
+    , _compressionThreshold(0)
+    , _stateTransitions(0)
+    , _completionQueue(completionQueue)
     , _rpc(std::make_shared<RPC<ReaderWriter, ContextType>>())
     , _requestOperation(std::make_shared<RPCRequest<ReaderWriter, ContextType, ServiceType>>(
 	  _rpc, service, completionQueue, completionQueue))
@@ -32,8 +34,7 @@ IncomingRPC::IncomingRPC(ghost::protobuf::connectiongrpc::ServerClientService::A
 	auto rpcCallback = std::bind(&IncomingRPC::onRPCConnected, this);
 	_requestOperation->setConnectionCallback(rpcCallback);
 
-	_rpc->setClient(std::make_unique<grpc::ServerAsyncReaderWriter<google::protobuf::Any, google::protobuf::Any>>(
-	    _rpc->getContext().get()));
+	_rpc->setClient(std::make_unique<ReaderWriter>(_rpc->getContext().get()));
 	_rpc->getStateMachine().setStateChangedCallback(
 	    std::bind(&IncomingRPC::onRPCStateChanged, this, std::placeholders::_1));
 
@@ -53,7 +54,21 @@ bool IncomingRPC::start()
 	return _requestOperation->start();
 }
 
+void IncomingRPC::setCompressionThreshold(size_t threshold)
+{
+	_compressionThreshold = threshold;
+}
+
 bool IncomingRPC::stop(const grpc::Status& status)
+{
+	if (!finish(status)) return false;
+
+	dispose();
+
+	return true;
+}
+
+bool IncomingRPC::finish(const grpc::Status& status)
 {
 	if (!_rpc->dispose()) return false;
 
@@ -64,19 +79,24 @@ bool IncomingRPC::stop(const grpc::Status& status)
 		_finishOperation->start();
 	}
 
-	dispose();
-
 	return true;
 }
 
+void IncomingRPC::cancel()
+{
+	// the notification of the end of the call finishes the RPC once the pending operations failed
+	if (!_rpc->isFinished() && _rpc->getContext()) _rpc->getContext()->TryCancel();
+}
+
 void IncomingRPC::startWriter(const std::shared_ptr<ghost::WriterSink>& sink)
 {
 	if (sink)
 	{
 		_writerSink = sink;
-		_writerOperation = std::make_shared<RPCWrite<ReaderWriter, ContextType, google::protobuf::Any>>(
-		    _rpc, true, true, sink);
-		_writerOperation->startAsync();
+		_writerOperation = std::make_shared<RPCWrite<ReaderWriter, ContextType, WriterSinkMessage>>(
+		    _rpc, sink, _completionQueue);
+		_writerOperation->setCompressionThreshold(_compressionThreshold);
+		_writerOperation->start();
 	}
 }
 
@@ -133,8 +153,14 @@ void IncomingRPC::onRPCConnected()
 		stop();
 }
 
+size_t IncomingRPC::getStateTransitionsCount() const
+{
+	return _stateTransitions.load(std::memory_order_relaxed);
+}
+
 void IncomingRPC::onRPCStateChanged(RPCStateMachine::State newState)
 {
+	_stateTransitions.fetch_add(1, std::memory_order_relaxed);
 	if (newState == RPCStateMachine::INACTIVE || newState == RPCStateMachine::FINISHED)
 	{
 		if (_readerSink) _readerSink->drain();
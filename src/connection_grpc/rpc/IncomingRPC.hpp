@@ -17,6 +17,7 @@
 #ifndef GHOST_INTERNAL_NETWORK_INCOMINGRPC_HPP
 #define GHOST_INTERNAL_NETWORK_INCOMINGRPC_HPP
 
+#include <atomic>
 #include <functional>
 #include <ghost/connection/ReaderSink.hpp>
 #include <ghost/connection/WriterSink.hpp>
@@ -28,6 +29,7 @@
 #include "RPCRequest.hpp"
 #include "RPCServerFinish.hpp"
 #include "RPCWrite.hpp"
+#include "ServerStream.hpp"
 
 namespace ghost
 {
@@ -38,19 +40,24 @@ class RemoteClientGRPC;
 class IncomingRPC
 {
 public:
-	using ReaderWriter = grpc::ServerAsyncReaderWriter<google::protobuf::Any, google::protobuf::Any>;
+	using ReaderWriter = ServerClientAsyncService::ServerStream;
 	using ContextType = grpc::ServerContext;
-	using ServiceType = ghost::protobuf::connectiongrpc::ServerClientService::AsyncService;
+	using ServiceType = ServerClientAsyncService;
 
-	IncomingRPC(ghost::protobuf::connectiongrpc::ServerClientService::AsyncService* service,
-		    grpc::ServerCompletionQueue* completionQueue,
+	IncomingRPC(ServiceType* service, grpc::ServerCompletionQueue* completionQueue,
 		    const std::function<void(std::shared_ptr<RemoteClientGRPC>)>& clientConnectedCallback);
 	~IncomingRPC();
 
 	bool start();
 	void startWriter(const std::shared_ptr<ghost::WriterSink>& sink);
 	void startReader(const std::shared_ptr<ghost::ReaderSink>& sink);
+	/// Messages smaller than "threshold" bytes are sent without compression, to be set before startWriter().
+	void setCompressionThreshold(size_t threshold);
 	bool stop(const grpc::Status& status = grpc::Status::OK);
+	/// Starts finishing the call with "status" without waiting for it, may be called by a completion queue thread.
+	bool finish(const grpc::Status& status);
+	/// Cancels the call without waiting for its pending operations, which then complete with an error.
+	void cancel();
 
 	void dispose();
 
@@ -59,6 +66,9 @@ public:
 	void setParent(std::weak_ptr<RemoteClientGRPC> parent);
 	std::shared_ptr<RemoteClientGRPC> getParent();
 
+	/// @return the number of state changes of the RPC.
+	size_t getStateTransitionsCount() const;
+
 private:
 	void onRPCConnected();
 	void onRPCStateChanged(RPCStateMachine::State newState);
@@ -66,10 +76,13 @@ private:
 
 	std::shared_ptr<ghost::ReaderSink> _readerSink;
 	std::shared_ptr<ghost::WriterSink> _writerSink;
+	size_t _compressionThreshold;
+	std::atomic<size_t> _stateTransitions;
+	grpc::ServerCompletionQueue* _completionQueue;
 
 	std::weak_ptr<RemoteClientGRPC> _parent;
 	std::shared_ptr<RPC<ReaderWriter, ContextType>> _rpc;
-	std::shared_ptr<RPCWrite<ReaderWriter, ContextType, google::protobuf::Any>> _writerOperation;
+	std::shared_ptr<RPCWrite<ReaderWriter, ContextType, WriterSinkMessage>> _writerOperation;
 	std::shared_ptr<RPCRead<ReaderWriter, ContextType, google::protobuf::Any>> _readerOperation;
 	std::shared_ptr<RPCRequest<ReaderWriter, ContextType, ServiceType>> _requestOperation;
 	std::shared_ptr<RPCServerFinish<ReaderWriter, ContextType>> _finishOperation;
@@ -26,10 +26,12 @@
 
 using namespace ghost::internal;
 
-OutgoingRPC::OutgoingRPC(const std::string& serverIp, int serverPort, size_t dedicatedThreads)
+OutgoingRPC::OutgoingRPC(const std::string& serverAddress, size_t dedicatedThreads)
     : _completionQueue(new grpc::CompletionQueue()) // Will be owned by the executor
-    , _serverIp(serverIp)
-    , _serverPort(serverPort)
+    , _serverAddress(serverAddress)
+    , _compressionAlgorithm(GRPC_COMPRESS_NONE)
+    , _compressionThreshold(0)
+    , _stateTransitions(0)
     , _rpc(std::make_shared<RPC<ReaderWriter, ContextType>>())
     , _executor(_completionQueue) // now owns the completion queue
 {
@@ -50,9 +52,9 @@ bool OutgoingRPC::start()
 {
 	if (!_rpc->initialize()) return false;
 
-	std::string serverAddress = _serverIp + ":" + std::to_string(_serverPort);
-
-	auto channel = grpc::CreateChannel(serverAddress, grpc::InsecureChannelCredentials());
+	grpc::ChannelArguments arguments;
+	arguments.SetCompressionAlgorithm(_compressionAlgorithm);
+	auto channel = grpc::CreateCustomChannel(_serverAddress, grpc::InsecureChannelCredentials(), arguments);
 	_stub = ghost::protobuf::connectiongrpc::ServerClientService::NewStub(channel);
 
 	RPCConnect<ReaderWriter, ContextType> connectOperation(_rpc, _stub, _completionQueue);
@@ -71,8 +73,9 @@ bool OutgoingRPC::start()
 	if (_writerSink)
 	{
 		_writerOperation = std::make_shared<RPCWrite<ReaderWriter, ContextType, google::protobuf::Any>>(
-		    _rpc, true, true, _writerSink);
-		_writerOperation->startAsync();
+		    _rpc, _writerSink, _completionQueue);
+		_writerOperation->setCompressionThreshold(_compressionThreshold);
+		_writerOperation->start();
 	}
 
 	return true;
@@ -113,8 +116,20 @@ void OutgoingRPC::setReaderSink(const std::shared_ptr<ghost::ReaderSink>& sink)
 	_readerSink = sink;
 }
 
+void OutgoingRPC::setCompression(grpc_compression_algorithm algorithm, size_t threshold)
+{
+	_compressionAlgorithm = algorithm;
+	_compressionThreshold = threshold;
+}
+
+size_t OutgoingRPC::getStateTransitionsCount() const
+{
+	return _stateTransitions.load(std::memory_order_relaxed);
+}
+
 void OutgoingRPC::onRPCStateChanged(RPCStateMachine::State newState)
 {
+	_stateTransitions.fetch_add(1, std::memory_order_relaxed);
 	if (newState == RPCStateMachine::INACTIVE || newState == RPCStateMachine::FINISHED)
 	{
 		if (_readerSink) _readerSink->drain();
@@ -17,8 +17,10 @@
 #ifndef GHOST_INTERNAL_NETWORK_OUTGOINGRPC_HPP
 #define GHOST_INTERNAL_NETWORK_OUTGOINGRPC_HPP
 
+#include <grpc/compression.h>
 #include <grpcpp/client_context.h>
 
+#include <atomic>
 #include <ghost/connection/ReaderSink.hpp>
 #include <ghost/connection/WriterSink.hpp>
 #include <memory>
@@ -41,7 +43,8 @@ public:
 	using ReaderWriter = grpc::ClientAsyncReaderWriter<google::protobuf::Any, google::protobuf::Any>;
 	using ContextType = grpc::ClientContext;
 
-	OutgoingRPC(const std::string& serverIp, int serverPort, size_t dedicatedThreads);
+	/// "serverAddress" is either "ip:port" or "unix:path", see ghost::internal::getServerAddress().
+	OutgoingRPC(const std::string& serverAddress, size_t dedicatedThreads);
 	~OutgoingRPC();
 
 	bool start();
@@ -51,6 +54,11 @@ public:
 	// configuration: set a writer sink or a reader sink to activate the feature
 	void setWriterSink(const std::shared_ptr<ghost::WriterSink>& sink);
 	void setReaderSink(const std::shared_ptr<ghost::ReaderSink>& sink);
+	/// Messages smaller than "threshold" bytes are sent without compression.
+	void setCompression(grpc_compression_algorithm algorithm, size_t threshold);
+
+	/// @return the number of state changes of the RPC.
+	size_t getStateTransitionsCount() const;
 
 private:
 	void onRPCStateChanged(RPCStateMachine::State newState);
@@ -59,10 +67,12 @@ private:
 	grpc::CompletionQueue* _completionQueue;
 	std::shared_ptr<ghost::protobuf::connectiongrpc::ServerClientService::Stub> _stub;
 
-	std::string _serverIp;
-	int _serverPort;
+	std::string _serverAddress;
 	std::shared_ptr<ghost::ReaderSink> _readerSink;
 	std::shared_ptr<ghost::WriterSink> _writerSink;
+	grpc_compression_algorithm _compressionAlgorithm;
+	size_t _compressionThreshold;
+	std::atomic<size_t> _stateTransitions;
 
 	std::shared_ptr<RPC<ReaderWriter, ContextType>> _rpc;
 	std::shared_ptr<RPCWrite<ReaderWriter, ContextType, google::protobuf::Any>> _writerOperation;
@@ -21,7 +21,6 @@
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <thread>
 
 #include "RPC.hpp"
 
@@ -55,9 +54,8 @@ public:
 		     bool accountAsRunningOperation = true);
 	virtual ~RPCOperation();
 
-	bool startAsync();
 	bool start();
-	void stop();
+	virtual void stop();
 
 	std::function<void(bool)> _operationCompletedCallback;
 
@@ -78,7 +76,6 @@ protected:
 	bool _autoRestart;
 	bool _blocking;
 	bool _accountAsRunningOperation;
-	std::thread _executor;
 	OperationProgress _state;
 	std::mutex _operationMutex;
 	std::condition_variable _operationCompletedConditionVariable;
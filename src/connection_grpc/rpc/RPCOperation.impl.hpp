@@ -32,13 +32,6 @@ RPCOperation<ReaderWriter, ContextType>::~RPCOperation()
 {
 }
 
-template <typename ReaderWriter, typename ContextType>
-bool RPCOperation<ReaderWriter, ContextType>::startAsync()
-{
-	_executor = std::thread([this] { start(); });
-	return true;
-}
-
 template <typename ReaderWriter, typename ContextType>
 bool RPCOperation<ReaderWriter, ContextType>::start()
 {
@@ -83,8 +76,6 @@ void RPCOperation<ReaderWriter, ContextType>::stop()
 			_operationCompletedConditionVariable.wait(lock,
 								  [this] { return _state == OperationProgress::IDLE; });
 	}
-
-	if (_executor.joinable()) _executor.join();
 }
 
 template <typename ReaderWriter, typename ContextType>
@@ -20,6 +20,7 @@
 #include <ghost/connection/ReaderSink.hpp>
 #include <memory>
 
+#include "../../connection/LatencyTracer.hpp"
 #include "RPCOperation.hpp"
 
 namespace ghost
@@ -40,6 +41,11 @@ protected:
 	void onOperationFailed(bool rpcFinished) override;
 
 private:
+	// takes over the content of the received message, which is reused by the next read
+	static void makeAny(google::protobuf::Any& target, google::protobuf::Any& incoming);
+	template <typename MessageType>
+	static void makeAny(google::protobuf::Any& target, const MessageType& incoming);
+
 	ReadMessageType _incomingMessage;
 	std::shared_ptr<ghost::ReaderSink> _readerSink;
 };
@@ -76,11 +82,24 @@ template <typename ReaderWriter, typename ContextType, typename ReadMessageType>
 void RPCRead<ReaderWriter, ContextType, ReadMessageType>::onOperationSucceeded(bool rpcFinished)
 {
 	google::protobuf::Any anyMessage;
-	if (_incomingMessage.GetTypeName() == anyMessage.descriptor()->full_name())
-		anyMessage = _incomingMessage;
-	else
-		anyMessage.PackFrom(_incomingMessage);
-	_readerSink->put(anyMessage);
+	makeAny(anyMessage, _incomingMessage);
+	LatencyTracer::stampReceipt(anyMessage); // if the latency of the message is traced
+	_readerSink->put(std::move(anyMessage));
+}
+
+template <typename ReaderWriter, typename ContextType, typename ReadMessageType>
+void RPCRead<ReaderWriter, ContextType, ReadMessageType>::makeAny(google::protobuf::Any& target,
+								  google::protobuf::Any& incoming)
+{
+	target.Swap(&incoming);
+}
+
+template <typename ReaderWriter, typename ContextType, typename ReadMessageType>
+template <typename MessageType>
+void RPCRead<ReaderWriter, ContextType, ReadMessageType>::makeAny(google::protobuf::Any& target,
+								  const MessageType& incoming)
+{
+	target.PackFrom(incoming);
 }
 
 template <typename ReaderWriter, typename ContextType, typename ReadMessageType>
@@ -17,83 +17,241 @@
 #ifndef GHOST_INTERNAL_NETWORK_RPCWRITE_HPP
 #define GHOST_INTERNAL_NETWORK_RPCWRITE_HPP
 
+#include <grpcpp/alarm.h>
+
+#include <condition_variable>
+#include <functional>
 #include <ghost/connection/WriterSink.hpp>
 #include <memory>
+#include <mutex>
+#include <vector>
 
+#include "../../connection/LatencyTracer.hpp"
+#include "../../connection/WriterSink.hpp"
 #include "RPCOperation.hpp"
 
 namespace ghost
 {
 namespace internal
 {
+/**
+ *	Writes the messages of a writer sink to the RPC. The operation is driven by events: it restarts when
+ *	a write completes, and the sink wakes it up through an alarm of the completion queue when messages
+ *	are pushed while it is idle. An idle writer therefore neither polls the sink nor owns a thread.
+ */
 template <typename ReaderWriter, typename ContextType, typename WriteMessageType>
 class RPCWrite : public RPCOperation<ReaderWriter, ContextType>
 {
 public:
-	RPCWrite(std::weak_ptr<RPC<ReaderWriter, ContextType>> parent, bool autoRestart, bool blocking,
-		 const std::shared_ptr<ghost::WriterSink>& writerSink);
+	RPCWrite(std::weak_ptr<RPC<ReaderWriter, ContextType>> parent,
+		 const std::shared_ptr<ghost::WriterSink>& writerSink, grpc::CompletionQueue* completionQueue);
 	~RPCWrite();
 
+	/// Messages smaller than "threshold" bytes are sent without compression, 0 compresses all of them.
+	void setCompressionThreshold(size_t threshold);
+	/// Stops the wake-ups of the sink, then waits for the write in progress.
+	void stop() override;
+
 protected:
 	bool initiateOperation() override;
 	void onOperationSucceeded(bool rpcFinished) override;
 	void onOperationFailed(bool rpcFinished) override;
 
 private:
-	std::shared_ptr<ghost::WriterSink> _writerSink;
+	/// Maximum number of messages taken from the writer sink at once.
+	static const size_t MAXIMUM_BATCH_SIZE = 64;
+
+	/**
+	 *	State of the alarm waking up the writer. It is shared with the callback of the sink, which
+	 *	may still be called by a writing thread while this operation is stopped.
+	 */
+	struct Wakeup
+	{
+		std::mutex mutex;
+		std::condition_variable idle;
+		grpc::Alarm alarm;
+		/// Tag of the alarm in the completion queue.
+		std::function<void(bool)> callback;
+		bool armed = false;
+		bool handling = false;
+		bool stopped = false;
+	};
+
+	/// Fills the batch from the writer sink, returns false if no message was available.
+	bool fetchBatch(const std::shared_ptr<RPC<ReaderWriter, ContextType>>& rpc);
+	/// Called by the completion queue when the alarm fires: starts writing the pushed messages.
+	void onWakeup(bool ok);
+
+	/**
+	 *	Moves the message to write out of "message" and stamps its hand-off.
+	 *	@param size	set to the serialized size of the message.
+	 *	@return false if "message" cannot be written as a "MessageType".
+	 */
+	template <typename MessageType>
+	static bool takeMessage(WriterSinkMessage& message, MessageType& msg, size_t& size);
+	/// The streams writing WriterSinkMessage write the shared messages without copying them.
+	static bool takeMessage(WriterSinkMessage& message, WriterSinkMessage& msg, size_t& size);
+
+	std::shared_ptr<WriterSink> _writerSink;
+	std::shared_ptr<Wakeup> _wakeup;
+	/// Messages taken from the writer sink and written back to back, starting at _batchPosition.
+	std::vector<WriterSinkMessage> _batch;
+	size_t _batchPosition;
+	size_t _compressionThreshold;
 };
 
 /////////////////////////// Template definition ///////////////////////////
 
 template <typename ReaderWriter, typename ContextType, typename WriteMessageType>
 RPCWrite<ReaderWriter, ContextType, WriteMessageType>::RPCWrite(std::weak_ptr<RPC<ReaderWriter, ContextType>> parent,
-								bool autoRestart, bool blocking,
-								const std::shared_ptr<ghost::WriterSink>& writerSink)
-    : RPCOperation<ReaderWriter, ContextType>(parent, autoRestart, blocking), _writerSink(writerSink)
+								const std::shared_ptr<ghost::WriterSink>& writerSink,
+								grpc::CompletionQueue* completionQueue)
+    : RPCOperation<ReaderWriter, ContextType>(parent, true, false) // restart = true, blocking = false
+    , _writerSink(std::static_pointer_cast<WriterSink>(writerSink))
+    , _wakeup(std::make_shared<Wakeup>())
+    , _batchPosition(0)
+    , _compressionThreshold(0)
 {
+	_wakeup->callback = std::bind(&RPCWrite::onWakeup, this, std::placeholders::_1);
+
+	// the alarm is set once per wake-up, no matter how many messages are pushed until it fires
+	auto wakeup = _wakeup;
+	_writerSink->setMessagesAvailableCallback([wakeup, completionQueue] {
+		std::lock_guard<std::mutex> lock(wakeup->mutex);
+		if (wakeup->stopped || wakeup->armed) return;
+
+		wakeup->armed = true;
+		wakeup->alarm.Set(completionQueue, gpr_now(GPR_CLOCK_MONOTONIC), &wakeup->callback);
+	});
 }
 
 template <typename ReaderWriter, typename ContextType, typename WriteMessageType>
 RPCWrite<ReaderWriter, ContextType, WriteMessageType>::~RPCWrite()
 {
+	stop();
+}
+
+template <typename ReaderWriter, typename ContextType, typename WriteMessageType>
+void RPCWrite<ReaderWriter, ContextType, WriteMessageType>::stop()
+{
+	{
+		// the alarm must not fire after this object is deleted
+		std::unique_lock<std::mutex> lock(_wakeup->mutex);
+		_wakeup->stopped = true;
+		if (_wakeup->armed) _wakeup->alarm.Cancel();
+		_wakeup->idle.wait(lock, [this] { return !_wakeup->armed && !_wakeup->handling; });
+	}
+	_writerSink->setMessagesAvailableCallback(nullptr);
+
 	RPCOperation<ReaderWriter, ContextType>::stop();
 }
 
+template <typename ReaderWriter, typename ContextType, typename WriteMessageType>
+void RPCWrite<ReaderWriter, ContextType, WriteMessageType>::setCompressionThreshold(size_t threshold)
+{
+	_compressionThreshold = threshold;
+}
+
 template <typename ReaderWriter, typename ContextType, typename WriteMessageType>
 bool RPCWrite<ReaderWriter, ContextType, WriteMessageType>::initiateOperation()
 {
 	auto rpc = RPCOperation<ReaderWriter, ContextType>::_rpc.lock();
 	if (!rpc) return false;
 
-	google::protobuf::Any message;
-	bool success = false;
+	WriteMessageType msg;
+	size_t size = 0;
+	while (true)
+	{
+		if (_batchPosition == _batch.size() && !fetchBatch(rpc)) return false;
+		if (takeMessage(_batch[_batchPosition++], msg, size)) break;
+
+		// the message cannot be sent: it is completed anyway to keep the order of the next ones, which
+		// are written right away since no other event may come to wake this operation up
+		_writerSink->pop();
+		msg = WriteMessageType();
+	}
+
+	// while the batch is not empty, gRPC may coalesce the writes instead of flushing each of them
+	grpc::WriteOptions options;
+	if (_batchPosition < _batch.size()) options.set_buffer_hint();
+	// the channel compression is not worth its CPU time for small messages
+	if (_compressionThreshold > 0 && size < _compressionThreshold) options.set_no_compression();
 
-	if (RPCOperation<ReaderWriter, ContextType>::_blocking)
+	rpc->getClient()->Write(msg, options, &(RPCOperation<ReaderWriter, ContextType>::_operationCompletedCallback));
+	return true;
+}
+
+template <typename ReaderWriter, typename ContextType, typename WriteMessageType>
+bool RPCWrite<ReaderWriter, ContextType, WriteMessageType>::fetchBatch(
+    const std::shared_ptr<RPC<ReaderWriter, ContextType>>& rpc)
+{
+	_batch.clear();
+	_batchPosition = 0;
+
+	// never waits for messages: the sink wakes this operation up when new ones are pushed
+	if (rpc->getStateMachine().getState() != RPCStateMachine::EXECUTING) return false;
+
+	return _writerSink->getBatch(_batch, MAXIMUM_BATCH_SIZE, std::chrono::milliseconds(0)) > 0;
+}
+
+template <typename ReaderWriter, typename ContextType, typename WriteMessageType>
+template <typename MessageType>
+bool RPCWrite<ReaderWriter, ContextType, WriteMessageType>::takeMessage(WriterSinkMessage& message,
+									MessageType& msg, size_t& size)
+{
+	// the streams of protobuf messages write a copy of the shared messages
+	if (message.serialized) message.message = message.serialized->getMessage();
+
+	if (msg.GetTypeName() == message.message.descriptor()->full_name()) // Don't unpack any to any, it fails
+		msg.Swap(&message.message);
+	else if (!message.message.UnpackTo(&msg))
+		return false;
+
+	size = msg.ByteSizeLong();
+	LatencyTracer::stampHandoff(msg); // if the latency of the message is traced
+	return true;
+}
+
+template <typename ReaderWriter, typename ContextType, typename WriteMessageType>
+bool RPCWrite<ReaderWriter, ContextType, WriteMessageType>::takeMessage(WriterSinkMessage& message,
+									WriterSinkMessage& msg, size_t& size)
+{
+	if (message.serialized)
 	{
-		while (!success && rpc->getStateMachine().getState() == RPCStateMachine::EXECUTING)
-		{
-			success = _writerSink->get(message, std::chrono::milliseconds(1));
-		}
+		// shared with the other streams and stamped before being serialized
+		size = message.serialized->bytes.size();
+		msg.serialized = std::move(message.serialized);
+		return true;
 	}
-	else // Non-blocking call - returns immediatly even if there is no messages in the queue
-		success = _writerSink->get(message, std::chrono::milliseconds(0));
 
-	if (success)
+	size = message.message.ByteSizeLong();
+	LatencyTracer::stampHandoff(message.message); // if the latency of the message is traced
+	msg.message.Swap(&message.message);
+	return true;
+}
+
+template <typename ReaderWriter, typename ContextType, typename WriteMessageType>
+void RPCWrite<ReaderWriter, ContextType, WriteMessageType>::onWakeup(bool ok)
+{
+	auto wakeup = _wakeup; // "this" may be deleted as soon as the state is idle again
 	{
-		WriteMessageType msg;
-		if (msg.GetTypeName() ==
-		    message.descriptor()->full_name()) // Don't unpack any to any because it will fail
-			msg = message;
-		else
+		std::lock_guard<std::mutex> lock(wakeup->mutex);
+		wakeup->armed = false;
+		if (!ok || wakeup->stopped) // the alarm was cancelled
 		{
-			bool unpackSuccess = message.UnpackTo(&msg);
-			if (!unpackSuccess) return false;
+			wakeup->idle.notify_all();
+			return;
 		}
-
-		rpc->getClient()->Write(msg, &(RPCOperation<ReaderWriter, ContextType>::_operationCompletedCallback));
+		wakeup->handling = true;
 	}
 
-	return success;
+	// messages pushed from now on set the alarm again. If a write is in progress, this does nothing:
+	// the next write starts when it completes
+	RPCOperation<ReaderWriter, ContextType>::start();
+
+	std::lock_guard<std::mutex> lock(wakeup->mutex);
+	wakeup->handling = false;
+	wakeup->idle.notify_all();
 }
 
 template <typename ReaderWriter, typename ContextType, typename WriteMessageType>
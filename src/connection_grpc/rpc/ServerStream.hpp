@@ -0,0 +1,94 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_INTERNAL_NETWORK_SERVERSTREAM_HPP
+#define GHOST_INTERNAL_NETWORK_SERVERSTREAM_HPP
+
+#include <ghost/connection_grpc/ServerClientService.grpc.pb.h>
+#include <grpcpp/impl/codegen/proto_utils.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
+
+#include <memory>
+
+#include "../../connection/WriterSink.hpp"
+
+namespace grpc
+{
+/**
+ *	Serializes the messages written by the servers. The messages shared by several streams were
+ *	serialized once: every stream writes a slice referencing their bytes instead of copying them.
+ */
+template <>
+class SerializationTraits<ghost::internal::WriterSinkMessage, void>
+{
+public:
+	static Status Serialize(const ghost::internal::WriterSinkMessage& message, ByteBuffer* buffer,
+				bool* ownBuffer)
+	{
+		if (!message.serialized) return AnyTraits::Serialize(message.message, buffer, ownBuffer);
+
+		// the slice keeps the message alive until gRPC is done with it
+		auto owner = new std::shared_ptr<const ghost::internal::SerializedMessage>(message.serialized);
+		Slice slice(const_cast<char*>((*owner)->bytes.data()), (*owner)->bytes.size(), &releaseMessage, owner);
+		*buffer = ByteBuffer(&slice, 1);
+		*ownBuffer = true;
+		return Status::OK;
+	}
+
+	static Status Deserialize(ByteBuffer* buffer, ghost::internal::WriterSinkMessage* message)
+	{
+		return AnyTraits::Deserialize(buffer, &message->message);
+	}
+
+private:
+	using AnyTraits = SerializationTraits<google::protobuf::Any>;
+
+	static void releaseMessage(void* owner)
+	{
+		delete static_cast<std::shared_ptr<const ghost::internal::SerializedMessage>*>(owner);
+	}
+};
+} // namespace grpc
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Service of the servers. Their streams write the messages taken from the writer sinks as they are,
+ *	which lets the shared messages be written without being copied nor serialized again.
+ */
+class ServerClientAsyncService : public ghost::protobuf::connectiongrpc::ServerClientService::AsyncService
+{
+public:
+	using ServerStream = grpc::ServerAsyncReaderWriter<WriterSinkMessage, google::protobuf::Any>;
+
+	/// Same as the generated method, for the streams writing WriterSinkMessage.
+	void Requestconnect(grpc::ServerContext* context, ServerStream* stream, grpc::CompletionQueue* newCallQueue,
+			    grpc::ServerCompletionQueue* notificationQueue, void* tag)
+	{
+		RequestAsyncBidiStreaming(CONNECT_METHOD_INDEX, context, stream, newCallQueue, notificationQueue, tag);
+	}
+
+private:
+	/// Index of "connect" among the methods of the service, which follow their order in ServerClientService.proto.
+	static constexpr int CONNECT_METHOD_INDEX = 0;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_NETWORK_SERVERSTREAM_HPP
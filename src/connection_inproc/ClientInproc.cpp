@@ -0,0 +1,47 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ClientInproc.hpp"
+
+using namespace ghost::internal;
+
+ClientInproc::ClientInproc(const ghost::ConnectionConfiguration& config)
+    : ClientInproc(ghost::NetworkConnectionConfiguration::initializeFrom(config))
+{
+}
+
+ClientInproc::ClientInproc(const ghost::NetworkConnectionConfiguration& config)
+    : ghost::Client(config), _connector(config)
+{
+	_connector.setReaderSink(getReaderSink());
+	_connector.setWriterSink(getWriterSink());
+}
+
+bool ClientInproc::start()
+{
+	return _connector.start();
+}
+
+bool ClientInproc::stop()
+{
+	return _connector.stop();
+}
+
+bool ClientInproc::isRunning() const
+{
+	return _connector.isRunning();
+}
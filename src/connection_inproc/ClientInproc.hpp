@@ -0,0 +1,46 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_INPROC_CLIENTINPROC_HPP
+#define GHOST_INTERNAL_INPROC_CLIENTINPROC_HPP
+
+#include <ghost/connection/Client.hpp>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+
+#include "InprocConnector.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+class ClientInproc : public ghost::Client
+{
+public:
+	ClientInproc(const ghost::ConnectionConfiguration& config);
+	ClientInproc(const ghost::NetworkConnectionConfiguration& config);
+
+	bool start() override;
+	bool stop() override;
+	bool isRunning() const override;
+
+private:
+	InprocConnector _connector;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_INPROC_CLIENTINPROC_HPP
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <ghost/connection_inproc/ConnectionConfigurationInproc.hpp>
+
+using namespace ghost;
+
+namespace ghost
+{
+namespace internal
+{
+static std::string CONNECTIONCONFIGURATIONINPROC_TECHNOLOGY = "CONNECTIONCONFIGURATIONINPROC_TECHNOLOGY";
+}
+} // namespace ghost
+
+ConnectionConfigurationInproc::ConnectionConfigurationInproc(const std::string& name)
+    : NetworkConnectionConfiguration(name)
+{
+	ghost::ConfigurationValue techonologyAttribute;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONINPROC_TECHNOLOGY, techonologyAttribute);
+}
+
+ConnectionConfigurationInproc::ConnectionConfigurationInproc(const std::string& ip, int port)
+    : ConnectionConfigurationInproc("")
+{
+	setServerIpAddress(ip);
+	setServerPortNumber(port);
+}
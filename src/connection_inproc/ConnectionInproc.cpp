@@ -0,0 +1,36 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <ghost/connection_inproc/ConnectionConfigurationInproc.hpp>
+#include <ghost/connection_inproc/ConnectionInproc.hpp>
+
+#include "ClientInproc.hpp"
+#include "PublisherInproc.hpp"
+#include "ServerInproc.hpp"
+#include "SubscriberInproc.hpp"
+
+using namespace ghost;
+
+void ConnectionInproc::initialize(const std::shared_ptr<ghost::ConnectionManager>& connectionManager,
+				  const ghost::NetworkConnectionConfiguration& minimumConfiguration)
+{
+	// Assign the in-process implementations to this configuration.
+	connectionManager->getConnectionFactory()->addServerRule<internal::ServerInproc>(minimumConfiguration);
+	connectionManager->getConnectionFactory()->addClientRule<internal::ClientInproc>(minimumConfiguration);
+	connectionManager->getConnectionFactory()->addPublisherRule<internal::PublisherInproc>(minimumConfiguration);
+	connectionManager->getConnectionFactory()->addSubscriberRule<internal::SubscriberInproc>(minimumConfiguration);
+}
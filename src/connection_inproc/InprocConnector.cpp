@@ -0,0 +1,79 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "InprocConnector.hpp"
+
+using namespace ghost::internal;
+
+InprocConnector::InprocConnector(const ghost::NetworkConnectionConfiguration& config)
+    : _address(InprocRegistry::getAddress(config))
+{
+}
+
+InprocConnector::~InprocConnector()
+{
+	stop();
+}
+
+void InprocConnector::setReaderSink(const std::shared_ptr<ghost::ReaderSink>& sink)
+{
+	_readerSink = sink;
+}
+
+void InprocConnector::setWriterSink(const std::shared_ptr<ghost::WriterSink>& sink)
+{
+	_writerSink = sink;
+}
+
+bool InprocConnector::start()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (_peer) return false;
+
+	auto endpoint = InprocRegistry::getInstance().find(_address);
+	if (!endpoint) return false;
+
+	auto peer = std::make_shared<InprocPeer>(_readerSink, _writerSink);
+	if (!endpoint->connect(peer)) return false;
+
+	_endpoint = endpoint;
+	_peer = peer;
+	return true;
+}
+
+bool InprocConnector::stop()
+{
+	std::shared_ptr<InprocEndpoint> endpoint;
+	std::shared_ptr<InprocPeer> peer;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (!_peer || !_peer->isConnected()) return false;
+
+		endpoint = _endpoint;
+		peer = _peer;
+	}
+
+	endpoint->disconnect(peer);
+	peer->close();
+	return true;
+}
+
+bool InprocConnector::isRunning() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _peer && _peer->isConnected();
+}
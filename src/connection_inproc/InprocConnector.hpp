@@ -0,0 +1,62 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_INPROC_INPROCCONNECTOR_HPP
+#define GHOST_INTERNAL_INPROC_INPROCCONNECTOR_HPP
+
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "InprocRegistry.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Connects the sinks of a client or of a subscriber to the endpoint bound to the configured address.
+ *	The connection stops when the endpoint stops or when the connector is stopped.
+ */
+class InprocConnector
+{
+public:
+	InprocConnector(const ghost::NetworkConnectionConfiguration& config);
+	~InprocConnector();
+
+	void setReaderSink(const std::shared_ptr<ghost::ReaderSink>& sink);
+	void setWriterSink(const std::shared_ptr<ghost::WriterSink>& sink);
+
+	/// Returns false if no endpoint is bound to the address or if the connector already started.
+	bool start();
+	bool stop();
+	bool isRunning() const;
+
+private:
+	std::string _address;
+	std::shared_ptr<ghost::ReaderSink> _readerSink;
+	std::shared_ptr<ghost::WriterSink> _writerSink;
+
+	mutable std::mutex _mutex;
+	std::shared_ptr<InprocEndpoint> _endpoint;
+	std::shared_ptr<InprocPeer> _peer;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_INPROC_INPROCCONNECTOR_HPP
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "InprocRegistry.hpp"
+
+using namespace ghost::internal;
+
+InprocPeer::InprocPeer(const std::shared_ptr<ghost::ReaderSink>& readerSink,
+		       const std::shared_ptr<ghost::WriterSink>& writerSink)
+    : _readerSink(readerSink), _writerSink(writerSink), _connected(true)
+{
+}
+
+const std::shared_ptr<ghost::ReaderSink>& InprocPeer::getReaderSink() const
+{
+	return _readerSink;
+}
+
+const std::shared_ptr<ghost::WriterSink>& InprocPeer::getWriterSink() const
+{
+	return _writerSink;
+}
+
+bool InprocPeer::isConnected() const
+{
+	return _connected;
+}
+
+bool InprocPeer::close()
+{
+	if (!_connected.exchange(false)) return false;
+
+	if (_readerSink) _readerSink->drain();
+	if (_writerSink) _writerSink->drain();
+	return true;
+}
+
+InprocRegistry& InprocRegistry::getInstance()
+{
+	static InprocRegistry instance;
+	return instance;
+}
+
+std::string InprocRegistry::getAddress(const ghost::NetworkConnectionConfiguration& configuration)
+{
+	return configuration.getServerIpAddress() + ":" + std::to_string(configuration.getServerPortNumber());
+}
+
+bool InprocRegistry::bind(const std::string& address, const std::shared_ptr<InprocEndpoint>& endpoint)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _endpoints.find(address);
+	if (it != _endpoints.end() && !it->second.expired()) return false;
+
+	_endpoints[address] = endpoint;
+	return true;
+}
+
+void InprocRegistry::unbind(const std::string& address, const std::shared_ptr<InprocEndpoint>& endpoint)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _endpoints.find(address);
+	if (it == _endpoints.end()) return;
+
+	auto bound = it->second.lock();
+	if (!bound || bound == endpoint) _endpoints.erase(it);
+}
+
+std::shared_ptr<InprocEndpoint> InprocRegistry::find(const std::string& address) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _endpoints.find(address);
+	if (it == _endpoints.end()) return nullptr;
+
+	return it->second.lock();
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_INPROC_INPROCREGISTRY_HPP
+#define GHOST_INTERNAL_INPROC_INPROCREGISTRY_HPP
+
+#include <atomic>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <ghost/connection/ReaderSink.hpp>
+#include <ghost/connection/WriterSink.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Connecting side of an in-process connection, i.e. the sinks of a client or of a subscriber.
+ *	A subscriber has no writer sink.
+ */
+class InprocPeer
+{
+public:
+	InprocPeer(const std::shared_ptr<ghost::ReaderSink>& readerSink,
+		   const std::shared_ptr<ghost::WriterSink>& writerSink);
+
+	const std::shared_ptr<ghost::ReaderSink>& getReaderSink() const;
+	const std::shared_ptr<ghost::WriterSink>& getWriterSink() const;
+
+	bool isConnected() const;
+	/// Terminates the connection: the sinks of the peer are drained. Returns false if it was already closed.
+	bool close();
+
+private:
+	std::shared_ptr<ghost::ReaderSink> _readerSink;
+	std::shared_ptr<ghost::WriterSink> _writerSink;
+	std::atomic_bool _connected;
+};
+
+/**
+ *	Bound side of an in-process connection, i.e. a server or a publisher, which peers connect to.
+ */
+class InprocEndpoint
+{
+public:
+	virtual ~InprocEndpoint() = default;
+
+	/// Accepts a new peer. Returns false if the endpoint does not accept connections anymore.
+	virtual bool connect(const std::shared_ptr<InprocPeer>& peer) = 0;
+	/// Called by a peer that stops.
+	virtual void disconnect(const std::shared_ptr<InprocPeer>& peer) = 0;
+};
+
+/**
+ *	Process-wide directory of the endpoints bound by in-process servers and publishers.
+ *	Like a port, an address can only be bound by one endpoint at a time.
+ */
+class InprocRegistry
+{
+public:
+	static InprocRegistry& getInstance();
+
+	/// Returns the address of the endpoint described by "configuration".
+	static std::string getAddress(const ghost::NetworkConnectionConfiguration& configuration);
+
+	/// Binds the endpoint to the address. Returns false if the address is already in use.
+	bool bind(const std::string& address, const std::shared_ptr<InprocEndpoint>& endpoint);
+	/// Releases the address if it is bound by this endpoint.
+	void unbind(const std::string& address, const std::shared_ptr<InprocEndpoint>& endpoint);
+	/// Returns the endpoint bound to the address, or nullptr.
+	std::shared_ptr<InprocEndpoint> find(const std::string& address) const;
+
+private:
+	InprocRegistry() = default;
+
+	mutable std::mutex _mutex;
+	std::map<std::string, std::weak_ptr<InprocEndpoint>> _endpoints;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_INPROC_INPROCREGISTRY_HPP
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "MessageForwarder.hpp"
+
+using namespace ghost::internal;
+
+MessageForwarder::State::State(const std::shared_ptr<ghost::WriterSink>& source, const Delivery& delivery)
+    : source(source), delivery(delivery), enable(false)
+{
+}
+
+MessageForwarder::MessageForwarder(const std::shared_ptr<ghost::WriterSink>& source, const Delivery& delivery)
+    : _state(std::make_shared<State>(source, delivery))
+{
+}
+
+MessageForwarder::~MessageForwarder()
+{
+	stop();
+	// destroyed by its own delivery function: the thread cannot join itself, it returns once the
+	// delivery is done and only uses the state it owns until then
+	if (_thread.joinable()) _thread.detach();
+}
+
+void MessageForwarder::start()
+{
+	if (_state->enable || _thread.joinable()) return;
+
+	_state->enable = true;
+	_thread = std::thread(&MessageForwarder::run, _state);
+}
+
+void MessageForwarder::stop()
+{
+	_state->enable = false;
+	if (_thread.joinable() && _thread.get_id() != std::this_thread::get_id()) _thread.join();
+}
+
+void MessageForwarder::run(const std::shared_ptr<State>& state)
+{
+	std::vector<google::protobuf::Any> messages;
+	while (state->enable)
+	{
+		messages.clear();
+		size_t count = state->source->getBatch(messages, MAXIMUM_BATCH_SIZE, std::chrono::milliseconds(10));
+
+		if (count > 0)
+		{
+			state->delivery(messages);
+			for (size_t i = 0; i < count; ++i) state->source->pop();
+		}
+	}
+}
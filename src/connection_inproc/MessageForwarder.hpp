@@ -0,0 +1,74 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_INPROC_MESSAGEFORWARDER_HPP
+#define GHOST_INTERNAL_INPROC_MESSAGEFORWARDER_HPP
+
+#include <google/protobuf/any.pb.h>
+
+#include <atomic>
+#include <functional>
+#include <ghost/connection/WriterSink.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Thread moving the messages written into a ghost::WriterSink to their destination.
+ *	Messages are taken by batches and passed to the delivery function, which may move them
+ *	out of the vector. They are completed in the writer sink once they were delivered.
+ *	The delivery function may release the connection owning the forwarder: the thread only uses
+ *	a state it shares with the forwarder, which stays alive until the thread returns.
+ */
+class MessageForwarder
+{
+public:
+	using Delivery = std::function<void(std::vector<google::protobuf::Any>& messages)>;
+
+	MessageForwarder(const std::shared_ptr<ghost::WriterSink>& source, const Delivery& delivery);
+	~MessageForwarder();
+
+	void start();
+	/// Stops the thread. Messages that were not taken from the writer sink yet are not delivered.
+	void stop();
+
+private:
+	/// Maximum number of messages taken from the writer sink and delivered at once.
+	static const size_t MAXIMUM_BATCH_SIZE = 64;
+
+	struct State
+	{
+		State(const std::shared_ptr<ghost::WriterSink>& source, const Delivery& delivery);
+
+		std::shared_ptr<ghost::WriterSink> source;
+		Delivery delivery;
+		std::atomic_bool enable;
+	};
+
+	static void run(const std::shared_ptr<State>& state);
+
+	std::shared_ptr<State> _state;
+	std::thread _thread;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_INPROC_MESSAGEFORWARDER_HPP
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PublisherInproc.hpp"
+
+#include <algorithm>
+
+using namespace ghost::internal;
+
+PublisherInproc::PublisherInproc(const ghost::ConnectionConfiguration& config)
+    : PublisherInproc(ghost::NetworkConnectionConfiguration::initializeFrom(config))
+{
+}
+
+PublisherInproc::PublisherInproc(const ghost::NetworkConnectionConfiguration& config)
+    : ghost::Publisher(config), _address(InprocRegistry::getAddress(config)), _running(false)
+{
+}
+
+PublisherInproc::~PublisherInproc()
+{
+	stop();
+}
+
+bool PublisherInproc::start()
+{
+	if (_running) return false;
+
+	auto endpoint = std::make_shared<Endpoint>();
+	if (!InprocRegistry::getInstance().bind(_address, endpoint)) return false;
+
+	_endpoint = endpoint;
+	_forwarder.reset(new MessageForwarder(
+	    getWriterSink(), [endpoint](std::vector<google::protobuf::Any>& messages) { endpoint->send(messages); }));
+	_forwarder->start();
+
+	_running = true;
+	return true;
+}
+
+bool PublisherInproc::stop()
+{
+	if (!_running) return false;
+
+	_running = false;
+
+	getWriterSink()->drain();
+	_forwarder->stop();
+
+	InprocRegistry::getInstance().unbind(_address, _endpoint);
+	_endpoint->close();
+	return true;
+}
+
+bool PublisherInproc::isRunning() const
+{
+	return _running;
+}
+
+size_t PublisherInproc::countSubscribers() const
+{
+	if (!_endpoint) return 0;
+
+	return _endpoint->countSubscribers();
+}
+
+bool PublisherInproc::Endpoint::connect(const std::shared_ptr<InprocPeer>& peer)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (_closed) return false;
+
+	_subscribers.push_back(peer);
+	return true;
+}
+
+void PublisherInproc::Endpoint::disconnect(const std::shared_ptr<InprocPeer>& peer)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_subscribers.erase(std::remove(_subscribers.begin(), _subscribers.end(), peer), _subscribers.end());
+}
+
+void PublisherInproc::Endpoint::close()
+{
+	std::vector<std::shared_ptr<InprocPeer>> subscribers;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_closed = true;
+		subscribers.swap(_subscribers);
+	}
+
+	for (const auto& subscriber : subscribers) subscriber->close();
+}
+
+void PublisherInproc::Endpoint::send(std::vector<google::protobuf::Any>& messages)
+{
+	std::vector<std::shared_ptr<InprocPeer>> subscribers;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		subscribers = _subscribers;
+	}
+
+	for (size_t i = 0; i < subscribers.size(); ++i)
+	{
+		const auto& sink = subscribers[i]->getReaderSink();
+		if (i + 1 < subscribers.size())
+			for (const auto& message : messages) sink->put(message);
+		else
+			for (auto& message : messages) sink->put(std::move(message));
+	}
+}
+
+size_t PublisherInproc::Endpoint::countSubscribers() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _subscribers.size();
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_INPROC_PUBLISHERINPROC_HPP
+#define GHOST_INTERNAL_INPROC_PUBLISHERINPROC_HPP
+
+#include <atomic>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <ghost/connection/Publisher.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "InprocRegistry.hpp"
+#include "MessageForwarder.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+class PublisherInproc : public ghost::Publisher
+{
+public:
+	PublisherInproc(const ghost::ConnectionConfiguration& config);
+	PublisherInproc(const ghost::NetworkConnectionConfiguration& config);
+	~PublisherInproc();
+
+	bool start() override;
+	bool stop() override;
+	bool isRunning() const override;
+
+	size_t countSubscribers() const;
+
+private:
+	/// Endpoint bound by the publisher, which keeps track of the connected subscribers.
+	class Endpoint : public InprocEndpoint
+	{
+	public:
+		bool connect(const std::shared_ptr<InprocPeer>& peer) override;
+		void disconnect(const std::shared_ptr<InprocPeer>& peer) override;
+
+		/// Stops accepting subscribers and disconnects the current ones.
+		void close();
+		/// Passes the messages to the subscribers: the last one takes them over, the others get copies.
+		void send(std::vector<google::protobuf::Any>& messages);
+		size_t countSubscribers() const;
+
+	private:
+		mutable std::mutex _mutex;
+		bool _closed = false;
+		std::vector<std::shared_ptr<InprocPeer>> _subscribers;
+	};
+
+	std::string _address;
+	std::shared_ptr<Endpoint> _endpoint;
+	std::unique_ptr<MessageForwarder> _forwarder;
+	std::atomic_bool _running;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_INPROC_PUBLISHERINPROC_HPP
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "RemoteClientInproc.hpp"
+
+#include "ServerInproc.hpp"
+
+using namespace ghost::internal;
+
+namespace
+{
+ghost::internal::MessageForwarder::Delivery deliverTo(const std::shared_ptr<ghost::ReaderSink>& sink)
+{
+	return [sink](std::vector<google::protobuf::Any>& messages) {
+		for (auto& message : messages) sink->put(std::move(message));
+	};
+}
+} // namespace
+
+RemoteClientInproc::RemoteClientInproc(const ghost::ConnectionConfiguration& configuration,
+				       const std::shared_ptr<InprocPeer>& peer, ServerInproc* parentServer)
+    : ghost::Client(configuration)
+    , _peer(peer)
+    , _toPeer(getWriterSink(), deliverTo(peer->getReaderSink()))
+    , _fromPeer(peer->getWriterSink(), deliverTo(getReaderSink()))
+    , _running(false)
+    , _parentServer(parentServer)
+{
+}
+
+RemoteClientInproc::~RemoteClientInproc()
+{
+	if (!_executor.joinable()) return;
+
+	if (_executor.get_id() == std::this_thread::get_id())
+		_executor.detach();
+	else
+		_executor.join();
+}
+
+void RemoteClientInproc::join()
+{
+	if (_executor.joinable() && _executor.get_id() != std::this_thread::get_id()) _executor.join();
+}
+
+bool RemoteClientInproc::start()
+{
+	return false; // it is supposed to be already started by the server
+}
+
+bool RemoteClientInproc::stop()
+{
+	if (!_peer->close()) return false;
+
+	getReaderSink()->drain();
+	getWriterSink()->drain();
+
+	_toPeer.stop();
+	_fromPeer.stop();
+	return true;
+}
+
+bool RemoteClientInproc::isRunning() const
+{
+	return _peer->isConnected() || _running;
+}
+
+void RemoteClientInproc::execute()
+{
+	_running = true;
+
+	_executor = std::thread([this] {
+		std::shared_ptr<ghost::Client> self = shared_from_this();
+
+		if (_parentServer->getClientHandler()) _parentServer->getClientHandler()->configureClient(self);
+
+		_toPeer.start();
+		_fromPeer.start();
+
+		// call the application code
+		bool continueExecution = true;
+		bool keepClientAlive = false;
+
+		if (_parentServer->getClientHandler())
+			continueExecution = _parentServer->getClientHandler()->handle(self, keepClientAlive);
+
+		// only stop the client if the user left "keepClientAlive" to false
+		if (!keepClientAlive) stop();
+
+		// if continueExecution is false, stop the server
+		if (!continueExecution) _parentServer->stop();
+
+		_running = false;
+		// the server may have released this object meanwhile, in which case it is deleted here
+		self.reset();
+	});
+}
+
+const std::shared_ptr<InprocPeer>& RemoteClientInproc::getPeer() const
+{
+	return _peer;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_INPROC_REMOTECLIENTINPROC_HPP
+#define GHOST_INTERNAL_INPROC_REMOTECLIENTINPROC_HPP
+
+#include <atomic>
+#include <ghost/connection/Client.hpp>
+#include <memory>
+#include <thread>
+
+#include "InprocRegistry.hpp"
+#include "MessageForwarder.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+class ServerInproc;
+
+/**
+ * Server side of a connection with an in-process client. The messages written on each side
+ * are moved into the reader sink of the other side.
+ */
+class RemoteClientInproc : public ghost::Client, public std::enable_shared_from_this<RemoteClientInproc>
+{
+public:
+	RemoteClientInproc(const ghost::ConnectionConfiguration& configuration, const std::shared_ptr<InprocPeer>& peer,
+			   ServerInproc* parentServer);
+	~RemoteClientInproc();
+
+	bool start() override;
+	bool stop() override;
+	bool isRunning() const override;
+
+	void execute();
+	/// Waits for the end of the client handler, unless it is called by the client handler itself.
+	void join();
+
+	const std::shared_ptr<InprocPeer>& getPeer() const;
+
+private:
+	std::shared_ptr<InprocPeer> _peer;
+	MessageForwarder _toPeer;
+	MessageForwarder _fromPeer;
+	std::atomic_bool _running;
+	std::thread _executor;
+
+	ServerInproc* _parentServer;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_INPROC_REMOTECLIENTINPROC_HPP
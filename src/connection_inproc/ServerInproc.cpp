@@ -0,0 +1,147 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ServerInproc.hpp"
+
+using namespace ghost::internal;
+
+ServerInproc::ServerInproc(const ghost::ConnectionConfiguration& config)
+    : ServerInproc(ghost::NetworkConnectionConfiguration::initializeFrom(config))
+{
+}
+
+ServerInproc::ServerInproc(const ghost::NetworkConnectionConfiguration& config)
+    : _configuration(config), _address(InprocRegistry::getAddress(config)), _running(false)
+{
+}
+
+ServerInproc::~ServerInproc()
+{
+	stop();
+
+	// the threads executing the client handler reference their client and this server until they return:
+	// join them outside of the lock, which the handler takes when it stops the server
+	std::list<std::shared_ptr<RemoteClientInproc>> clients;
+	{
+		std::lock_guard<std::mutex> lock(_clientsMutex);
+		clients.swap(_clients);
+	}
+	for (const auto& client : clients) client->join();
+}
+
+bool ServerInproc::start()
+{
+	if (_running) return false;
+
+	auto endpoint = std::make_shared<Endpoint>(this);
+	if (!InprocRegistry::getInstance().bind(_address, endpoint)) return false;
+
+	_endpoint = endpoint;
+	_running = true;
+	return true;
+}
+
+bool ServerInproc::stop()
+{
+	if (!_running) return false;
+
+	_running = false;
+
+	// Refuse new clients, then stop the connected ones
+	InprocRegistry::getInstance().unbind(_address, _endpoint);
+	_endpoint->close();
+
+	std::list<std::shared_ptr<RemoteClientInproc>> clients;
+	{
+		std::lock_guard<std::mutex> lock(_clientsMutex);
+		clients = _clients;
+	}
+
+	for (const auto& client : clients) client->stop();
+
+	return true;
+}
+
+bool ServerInproc::isRunning() const
+{
+	return _running;
+}
+
+void ServerInproc::setClientHandler(std::shared_ptr<ghost::ClientHandler> handler)
+{
+	_clientHandler = handler;
+}
+
+const std::shared_ptr<ghost::ClientHandler> ServerInproc::getClientHandler() const
+{
+	return _clientHandler;
+}
+
+bool ServerInproc::onClientConnected(const std::shared_ptr<InprocPeer>& peer)
+{
+	if (!isRunning()) return false;
+
+	auto client = std::make_shared<RemoteClientInproc>(_configuration, peer, this);
+	{
+		std::lock_guard<std::mutex> lock(_clientsMutex);
+		// delete the clients that finished their execution
+		_clients.remove_if([](const std::shared_ptr<RemoteClientInproc>& c) { return !c->isRunning(); });
+		_clients.push_back(client);
+	}
+
+	// Execute the application's code in a separate thread
+	client->execute();
+	return true;
+}
+
+void ServerInproc::onClientDisconnected(const std::shared_ptr<InprocPeer>& peer)
+{
+	std::shared_ptr<RemoteClientInproc> client;
+	{
+		std::lock_guard<std::mutex> lock(_clientsMutex);
+		for (const auto& c : _clients)
+		{
+			if (c->getPeer() == peer) client = c;
+		}
+	}
+
+	if (client) client->stop();
+}
+
+ServerInproc::Endpoint::Endpoint(ServerInproc* server) : _server(server)
+{
+}
+
+bool ServerInproc::Endpoint::connect(const std::shared_ptr<InprocPeer>& peer)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (!_server) return false;
+
+	return _server->onClientConnected(peer);
+}
+
+void ServerInproc::Endpoint::disconnect(const std::shared_ptr<InprocPeer>& peer)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (_server) _server->onClientDisconnected(peer);
+}
+
+void ServerInproc::Endpoint::close()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_server = nullptr;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_INPROC_SERVERINPROC_HPP
+#define GHOST_INTERNAL_INPROC_SERVERINPROC_HPP
+
+#include <atomic>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <ghost/connection/Server.hpp>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "InprocRegistry.hpp"
+#include "RemoteClientInproc.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Server accepting in-process clients. Each connected client is represented by a RemoteClientInproc
+ * which executes the client handler in its own thread, like the remote clients of ghost::internal::ServerGRPC.
+ */
+class ServerInproc : public ghost::Server
+{
+public:
+	ServerInproc(const ghost::ConnectionConfiguration& config);
+	ServerInproc(const ghost::NetworkConnectionConfiguration& config);
+	~ServerInproc();
+
+	bool start() override;
+	bool stop() override;
+	bool isRunning() const override;
+
+	void setClientHandler(std::shared_ptr<ClientHandler> handler) override;
+	const std::shared_ptr<ClientHandler> getClientHandler() const;
+
+private:
+	/// Endpoint bound by the server, which forwards the connections to it until it stops.
+	class Endpoint : public InprocEndpoint
+	{
+	public:
+		Endpoint(ServerInproc* server);
+
+		bool connect(const std::shared_ptr<InprocPeer>& peer) override;
+		void disconnect(const std::shared_ptr<InprocPeer>& peer) override;
+
+		void close();
+
+	private:
+		std::mutex _mutex;
+		ServerInproc* _server;
+	};
+
+	bool onClientConnected(const std::shared_ptr<InprocPeer>& peer);
+	void onClientDisconnected(const std::shared_ptr<InprocPeer>& peer);
+
+	ghost::NetworkConnectionConfiguration _configuration;
+	std::string _address;
+	std::atomic<bool> _running;
+	std::shared_ptr<Endpoint> _endpoint;
+
+	std::mutex _clientsMutex;
+	std::list<std::shared_ptr<RemoteClientInproc>> _clients;
+	std::shared_ptr<ClientHandler> _clientHandler;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_INPROC_SERVERINPROC_HPP
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "SubscriberInproc.hpp"
+
+using namespace ghost::internal;
+
+SubscriberInproc::SubscriberInproc(const ghost::ConnectionConfiguration& config)
+    : SubscriberInproc(ghost::NetworkConnectionConfiguration::initializeFrom(config))
+{
+}
+
+SubscriberInproc::SubscriberInproc(const ghost::NetworkConnectionConfiguration& config)
+    : ghost::Subscriber(config), _connector(config)
+{
+	_connector.setReaderSink(getReaderSink());
+}
+
+bool SubscriberInproc::start()
+{
+	return _connector.start();
+}
+
+bool SubscriberInproc::stop()
+{
+	return _connector.stop();
+}
+
+bool SubscriberInproc::isRunning() const
+{
+	return _connector.isRunning();
+}
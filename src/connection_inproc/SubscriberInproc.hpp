@@ -0,0 +1,46 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_INPROC_SUBSCRIBERINPROC_HPP
+#define GHOST_INTERNAL_INPROC_SUBSCRIBERINPROC_HPP
+
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <ghost/connection/Subscriber.hpp>
+
+#include "InprocConnector.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+class SubscriberInproc : public ghost::Subscriber
+{
+public:
+	SubscriberInproc(const ghost::ConnectionConfiguration& config);
+	SubscriberInproc(const ghost::NetworkConnectionConfiguration& config);
+
+	bool start() override;
+	bool stop() override;
+	bool isRunning() const override;
+
+private:
+	InprocConnector _connector;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_INPROC_SUBSCRIBERINPROC_HPP
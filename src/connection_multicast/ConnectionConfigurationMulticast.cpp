@@ -0,0 +1,154 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <ghost/connection_multicast/ConnectionConfigurationMulticast.hpp>
+
+using namespace ghost;
+
+namespace ghost
+{
+namespace internal
+{
+static std::string CONNECTIONCONFIGURATIONMULTICAST_TECHNOLOGY = "CONNECTIONCONFIGURATIONMULTICAST_TECHNOLOGY";
+static std::string CONNECTIONCONFIGURATIONMULTICAST_INTERFACE = "CONNECTIONCONFIGURATIONMULTICAST_INTERFACE";
+static std::string CONNECTIONCONFIGURATIONMULTICAST_TIMETOLIVE = "CONNECTIONCONFIGURATIONMULTICAST_TIMETOLIVE";
+static std::string CONNECTIONCONFIGURATIONMULTICAST_MAXIMUMDATAGRAMSIZE =
+    "CONNECTIONCONFIGURATIONMULTICAST_MAXIMUMDATAGRAMSIZE";
+static std::string CONNECTIONCONFIGURATIONMULTICAST_LOSSPOLICY = "CONNECTIONCONFIGURATIONMULTICAST_LOSSPOLICY";
+} // namespace internal
+} // namespace ghost
+
+ConnectionConfigurationMulticast::ConnectionConfigurationMulticast(const std::string& name)
+    : NetworkConnectionConfiguration(name)
+{
+	ghost::ConfigurationValue techonologyAttribute;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONMULTICAST_TECHNOLOGY, techonologyAttribute);
+
+	ghost::ConfigurationValue defaultInterface;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONMULTICAST_INTERFACE, defaultInterface);
+
+	ghost::ConfigurationValue defaultTimeToLive;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONMULTICAST_TIMETOLIVE, defaultTimeToLive);
+
+	ghost::ConfigurationValue defaultMaximumDatagramSize;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONMULTICAST_MAXIMUMDATAGRAMSIZE,
+				     defaultMaximumDatagramSize);
+
+	ghost::ConfigurationValue defaultLossPolicy;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONMULTICAST_LOSSPOLICY, defaultLossPolicy);
+}
+
+ConnectionConfigurationMulticast::ConnectionConfigurationMulticast(const std::string& ip, int port)
+    : ConnectionConfigurationMulticast("")
+{
+	setServerIpAddress(ip);
+	setServerPortNumber(port);
+}
+
+std::string ConnectionConfigurationMulticast::getInterfaceAddress() const
+{
+	std::string res;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue("");
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATIONMULTICAST_INTERFACE, value,
+				     defaultValue); // if the field was removed, returns ""
+	if (!value.read<std::string>(res)) defaultValue.read<std::string>(res);
+
+	return res;
+}
+
+int ConnectionConfigurationMulticast::getTimeToLive() const
+{
+	int res = 1;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<int>(res);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATIONMULTICAST_TIMETOLIVE, value,
+				     defaultValue); // if the field was removed, returns 1
+	value.read<int>(res);
+
+	return res;
+}
+
+size_t ConnectionConfigurationMulticast::getMaximumDatagramSize() const
+{
+	size_t res = 1472; // Ethernet MTU without the IP and UDP headers
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<size_t>(res);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATIONMULTICAST_MAXIMUMDATAGRAMSIZE, value,
+				     defaultValue); // if the field was removed, returns 1472
+	value.read<size_t>(res);
+
+	return res;
+}
+
+ConnectionConfigurationMulticast::LossPolicy ConnectionConfigurationMulticast::getLossPolicy() const
+{
+	int res = (int)LossPolicy::SKIP;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<int>((int)LossPolicy::SKIP);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATIONMULTICAST_LOSSPOLICY, value,
+				     defaultValue); // if the field was removed, returns SKIP
+	value.read<int>(res);
+
+	return (LossPolicy)res;
+}
+
+void ConnectionConfigurationMulticast::setInterfaceAddress(const std::string& address)
+{
+	ghost::ConfigurationValue value;
+	value.write<std::string>(address);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONMULTICAST_INTERFACE, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfigurationMulticast::setTimeToLive(int ttl)
+{
+	ghost::ConfigurationValue value;
+	value.write<int>(ttl);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONMULTICAST_TIMETOLIVE, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfigurationMulticast::setMaximumDatagramSize(size_t size)
+{
+	ghost::ConfigurationValue value;
+	value.write<size_t>(size);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONMULTICAST_MAXIMUMDATAGRAMSIZE, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfigurationMulticast::setLossPolicy(LossPolicy policy)
+{
+	ghost::ConfigurationValue value;
+	value.write<int>((int)policy);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONMULTICAST_LOSSPOLICY, value,
+				     true); // checks if the attribute is there as well
+}
+
+ConnectionConfigurationMulticast ConnectionConfigurationMulticast::initializeFrom(const ConnectionConfiguration& from)
+{
+	ConnectionConfigurationMulticast newconfig(from.getConfiguration()->getConfigurationName());
+	from.getConfiguration()->copy(*newconfig.getConfiguration());
+	return newconfig;
+}
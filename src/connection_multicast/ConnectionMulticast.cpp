@@ -0,0 +1,33 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <ghost/connection_multicast/ConnectionConfigurationMulticast.hpp>
+#include <ghost/connection_multicast/ConnectionMulticast.hpp>
+
+#include "PublisherMulticast.hpp"
+#include "SubscriberMulticast.hpp"
+
+using namespace ghost;
+
+void ConnectionMulticast::initialize(const std::shared_ptr<ghost::ConnectionManager>& connectionManager,
+				     const ghost::NetworkConnectionConfiguration& minimumConfiguration)
+{
+	// Assign the multicast implementations to this configuration. There is no server nor client.
+	auto factory = connectionManager->getConnectionFactory();
+	factory->addPublisherRule<internal::PublisherMulticast>(minimumConfiguration);
+	factory->addSubscriberRule<internal::SubscriberMulticast>(minimumConfiguration);
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "Datagram.hpp"
+
+#include <algorithm>
+
+using namespace ghost::internal;
+
+const uint32_t DatagramHeader::MAGIC;
+const size_t DatagramHeader::SIZE;
+const size_t DatagramBatch::MAXIMUM_FRAGMENTS;
+
+namespace
+{
+void writeInteger(uint8_t*& buffer, uint64_t value, size_t size)
+{
+	for (size_t i = 0; i < size; ++i) *buffer++ = static_cast<uint8_t>(value >> (8 * (size - 1 - i)));
+}
+
+uint64_t readInteger(const uint8_t*& buffer, size_t size)
+{
+	uint64_t value = 0;
+	for (size_t i = 0; i < size; ++i) value = (value << 8) | *buffer++;
+	return value;
+}
+} // namespace
+
+void DatagramHeader::write(uint8_t* buffer) const
+{
+	writeInteger(buffer, MAGIC, 4);
+	writeInteger(buffer, source, 8);
+	writeInteger(buffer, sequence, 8);
+	writeInteger(buffer, messageSize, 4);
+	writeInteger(buffer, fragmentOffset, 4);
+	writeInteger(buffer, fragmentIndex, 2);
+	writeInteger(buffer, fragmentCount, 2);
+}
+
+bool DatagramHeader::read(const uint8_t* buffer, size_t size)
+{
+	if (size < SIZE || readInteger(buffer, 4) != MAGIC) return false;
+
+	source = readInteger(buffer, 8);
+	sequence = readInteger(buffer, 8);
+	messageSize = static_cast<uint32_t>(readInteger(buffer, 4));
+	fragmentOffset = static_cast<uint32_t>(readInteger(buffer, 4));
+	fragmentIndex = static_cast<uint16_t>(readInteger(buffer, 2));
+	fragmentCount = static_cast<uint16_t>(readInteger(buffer, 2));
+
+	size_t payloadSize = size - SIZE;
+	return fragmentCount > 0 && fragmentIndex < fragmentCount && fragmentOffset <= messageSize &&
+	       payloadSize <= messageSize - fragmentOffset;
+}
+
+DatagramBatch::DatagramBatch(uint64_t source, size_t maximumDatagramSize)
+    : _source(source)
+    , _nextSequence(0)
+    , _maximumPayloadSize(maximumDatagramSize > DatagramHeader::SIZE ? maximumDatagramSize - DatagramHeader::SIZE : 1)
+{
+}
+
+bool DatagramBatch::add(const std::string& serializedMessage)
+{
+	size_t size = serializedMessage.size();
+	size_t fragmentCount = std::max<size_t>(1, (size + _maximumPayloadSize - 1) / _maximumPayloadSize);
+	if (fragmentCount > MAXIMUM_FRAGMENTS || size > UINT32_MAX) return false;
+
+	DatagramHeader header;
+	header.source = _source;
+	header.sequence = _nextSequence++;
+	header.messageSize = static_cast<uint32_t>(size);
+	header.fragmentCount = static_cast<uint16_t>(fragmentCount);
+
+	const uint8_t* data = reinterpret_cast<const uint8_t*>(serializedMessage.data());
+	for (size_t i = 0; i < fragmentCount; ++i)
+	{
+		size_t offset = i * _maximumPayloadSize;
+		header.fragmentIndex = static_cast<uint16_t>(i);
+		header.fragmentOffset = static_cast<uint32_t>(offset);
+
+		_headers.resize(_headers.size() + DatagramHeader::SIZE);
+		header.write(_headers.data() + _headers.size() - DatagramHeader::SIZE);
+		_fragments.push_back(Fragment{data + offset, std::min(_maximumPayloadSize, size - offset)});
+	}
+	return true;
+}
+
+void DatagramBatch::clear()
+{
+	_headers.clear();
+	_fragments.clear();
+}
+
+size_t DatagramBatch::size() const
+{
+	return _fragments.size();
+}
+
+const uint8_t* DatagramBatch::getHeader(size_t index) const
+{
+	return _headers.data() + index * DatagramHeader::SIZE;
+}
+
+const uint8_t* DatagramBatch::getPayload(size_t index) const
+{
+	return _fragments[index].payload;
+}
+
+size_t DatagramBatch::getPayloadSize(size_t index) const
+{
+	return _fragments[index].size;
+}
+
+uint64_t DatagramBatch::getNextSequence() const
+{
+	return _nextSequence;
+}
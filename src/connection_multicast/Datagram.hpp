@@ -0,0 +1,99 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_MULTICAST_DATAGRAM_HPP
+#define GHOST_INTERNAL_MULTICAST_DATAGRAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Header preceding the fragment of a serialized message in every datagram, written in network
+ *	byte order. Messages of a publisher are numbered from its start; "source" identifies the start
+ *	of a publisher, so that subscribers do not mistake a restarted publisher for lost messages.
+ */
+struct DatagramHeader
+{
+	static const uint32_t MAGIC = 0x47484D43; // "GHMC"
+	static const size_t SIZE = 32;
+
+	uint64_t source;
+	uint64_t sequence;
+	/// Size of the complete serialized message.
+	uint32_t messageSize;
+	/// Position of the fragment in the serialized message.
+	uint32_t fragmentOffset;
+	uint16_t fragmentIndex;
+	uint16_t fragmentCount;
+
+	void write(uint8_t* buffer) const;
+	/// Returns false if the datagram is not a valid datagram of a publisher.
+	bool read(const uint8_t* buffer, size_t size);
+};
+
+/**
+ *	Splits serialized messages into the datagrams sent by a publisher: the headers of all the
+ *	fragments are kept in a single buffer, and the fragments point into the serialized messages,
+ *	which are not copied.
+ */
+class DatagramBatch
+{
+public:
+	/// Maximum number of fragments of a message.
+	static const size_t MAXIMUM_FRAGMENTS = UINT16_MAX;
+
+	DatagramBatch(uint64_t source, size_t maximumDatagramSize);
+
+	/**
+	 *	Adds the datagrams of a message. The message must stay alive until the batch is cleared.
+	 *	@return false if the message is too large to be sent, in which case it does not consume
+	 *	any sequence number.
+	 */
+	bool add(const std::string& serializedMessage);
+	void clear();
+
+	size_t size() const;
+	/// Returns the header of the datagram "index".
+	const uint8_t* getHeader(size_t index) const;
+	const uint8_t* getPayload(size_t index) const;
+	size_t getPayloadSize(size_t index) const;
+
+	uint64_t getNextSequence() const;
+
+private:
+	struct Fragment
+	{
+		const uint8_t* payload;
+		size_t size;
+	};
+
+	uint64_t _source;
+	uint64_t _nextSequence;
+	size_t _maximumPayloadSize;
+	std::vector<uint8_t> _headers;
+	std::vector<Fragment> _fragments;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_MULTICAST_DATAGRAM_HPP
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "MessageAssembler.hpp"
+
+#include <algorithm>
+
+using namespace ghost::internal;
+
+const size_t MessageAssembler::MAXIMUM_MESSAGE_SIZE;
+const size_t MessageAssembler::MAXIMUM_PARTIAL_MESSAGES;
+const size_t MessageAssembler::MAXIMUM_SOURCES;
+
+MessageAssembler::MessageAssembler() : _activity(0), _lostCount(0)
+{
+}
+
+bool MessageAssembler::onDatagram(const uint8_t* datagram, size_t size, const Delivery& deliver)
+{
+	DatagramHeader header;
+	if (!header.read(datagram, size) || header.messageSize >= MAXIMUM_MESSAGE_SIZE) return false;
+
+	Source& source = getSource(header.source, header.sequence);
+	if (header.sequence < source.nextSequence) return true; // duplicated, or too late
+
+	const uint8_t* payload = datagram + DatagramHeader::SIZE;
+	size_t payloadSize = size - DatagramHeader::SIZE;
+	if (header.fragmentCount == 1)
+	{
+		if (payloadSize != header.messageSize) return false;
+
+		this->deliver(source, header.sequence, payload, payloadSize, deliver);
+		return true;
+	}
+
+	auto it = source.partialMessages.find(header.sequence);
+	if (it == source.partialMessages.end())
+	{
+		if (source.partialMessages.size() == MAXIMUM_PARTIAL_MESSAGES)
+			source.partialMessages.erase(source.partialMessages.begin());
+
+		PartialMessage message;
+		message.data.resize(header.messageSize);
+		message.received.assign(header.fragmentCount, false);
+		message.missing = header.fragmentCount;
+		it = source.partialMessages.emplace(header.sequence, std::move(message)).first;
+	}
+
+	PartialMessage& message = it->second;
+	if (message.data.size() != header.messageSize || message.received.size() != header.fragmentCount) return false;
+	if (message.received[header.fragmentIndex]) return true; // duplicated
+
+	std::copy(payload, payload + payloadSize, &message.data[0] + header.fragmentOffset);
+	message.received[header.fragmentIndex] = true;
+	if (--message.missing > 0) return true;
+
+	std::string data = std::move(message.data);
+	this->deliver(source, header.sequence, reinterpret_cast<const uint8_t*>(data.data()), data.size(), deliver);
+	return true;
+}
+
+uint64_t MessageAssembler::getLostCount() const
+{
+	return _lostCount;
+}
+
+MessageAssembler::Source& MessageAssembler::getSource(uint64_t id, uint64_t sequence)
+{
+	auto it = _sources.find(id);
+	if (it == _sources.end())
+	{
+		if (_sources.size() == MAXIMUM_SOURCES)
+		{
+			auto oldest =
+			    std::min_element(_sources.begin(), _sources.end(), [](const auto& a, const auto& b) {
+				    return a.second.lastActivity < b.second.lastActivity;
+			    });
+			_sources.erase(oldest);
+		}
+
+		// the messages published before this subscriber joined are not lost
+		Source source;
+		source.nextSequence = sequence;
+		it = _sources.emplace(id, std::move(source)).first;
+	}
+
+	it->second.lastActivity = ++_activity;
+	return it->second;
+}
+
+void MessageAssembler::deliver(Source& source, uint64_t sequence, const uint8_t* data, size_t size,
+			       const Delivery& deliver)
+{
+	_lostCount += sequence - source.nextSequence;
+	source.nextSequence = sequence + 1;
+
+	// the partial messages preceding this one will not be delivered anymore
+	source.partialMessages.erase(source.partialMessages.begin(), source.partialMessages.upper_bound(sequence));
+
+	deliver(data, size);
+}
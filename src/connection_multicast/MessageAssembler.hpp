@@ -0,0 +1,86 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_MULTICAST_MESSAGEASSEMBLER_HPP
+#define GHOST_INTERNAL_MULTICAST_MESSAGEASSEMBLER_HPP
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Datagram.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Rebuilds the messages of the publishers from the datagrams received by a subscriber.
+ *	Messages of a publisher are delivered in order: duplicated and late messages are ignored, and
+ *	the messages skipped by a delivered message are counted as lost, including the ones that were
+ *	only partially received. The first message received from a publisher starts its sequence.
+ */
+class MessageAssembler
+{
+public:
+	/// Receives a complete serialized message.
+	using Delivery = std::function<void(const uint8_t* data, size_t size)>;
+
+	/// Messages of this size or larger are considered as corrupted.
+	static const size_t MAXIMUM_MESSAGE_SIZE = 64 * 1024 * 1024;
+	/// Maximum number of partially received messages per publisher; the oldest ones are abandoned first.
+	static const size_t MAXIMUM_PARTIAL_MESSAGES = 16;
+	/// Maximum number of publishers followed at once; the least recently active ones are forgotten.
+	static const size_t MAXIMUM_SOURCES = 64;
+
+	MessageAssembler();
+
+	/// Processes a datagram of a publisher. Returns false if the datagram is invalid.
+	bool onDatagram(const uint8_t* datagram, size_t size, const Delivery& deliver);
+
+	/// Returns the number of messages that were lost since the creation of the assembler.
+	uint64_t getLostCount() const;
+
+private:
+	struct PartialMessage
+	{
+		std::string data;
+		std::vector<bool> received;
+		size_t missing;
+	};
+
+	struct Source
+	{
+		uint64_t nextSequence;
+		uint64_t lastActivity;
+		std::map<uint64_t, PartialMessage> partialMessages;
+	};
+
+	Source& getSource(uint64_t id, uint64_t sequence);
+	void deliver(Source& source, uint64_t sequence, const uint8_t* data, size_t size, const Delivery& deliver);
+
+	std::unordered_map<uint64_t, Source> _sources;
+	uint64_t _activity;
+	uint64_t _lostCount;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_MULTICAST_MESSAGEASSEMBLER_HPP
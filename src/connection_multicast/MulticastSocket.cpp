@@ -0,0 +1,105 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "MulticastSocket.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+
+using namespace ghost::internal;
+
+const int MulticastSocket::BUFFER_SIZE;
+
+namespace
+{
+bool getGroupAddress(const ghost::ConnectionConfigurationMulticast& config, sockaddr_in& address)
+{
+	std::memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_port = htons(static_cast<uint16_t>(config.getServerPortNumber()));
+	return inet_pton(AF_INET, config.getServerIpAddress().c_str(), &address.sin_addr) == 1 &&
+	       IN_MULTICAST(ntohl(address.sin_addr.s_addr));
+}
+
+bool getInterfaceAddress(const ghost::ConnectionConfigurationMulticast& config, in_addr& address)
+{
+	std::string interface = config.getInterfaceAddress();
+	if (interface.empty())
+	{
+		address.s_addr = htonl(INADDR_ANY);
+		return true;
+	}
+
+	return inet_pton(AF_INET, interface.c_str(), &address) == 1;
+}
+} // namespace
+
+int MulticastSocket::openSender(const ghost::ConnectionConfigurationMulticast& config)
+{
+	sockaddr_in group;
+	in_addr interface;
+	if (!getGroupAddress(config, group) || !getInterfaceAddress(config, interface)) return -1;
+
+	int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+	if (fd < 0) return -1;
+
+	int ttl = config.getTimeToLive();
+	unsigned char loop = 1; // subscribers of the same host receive the messages as well
+	int bufferSize = BUFFER_SIZE;
+	setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(bufferSize));
+	if (setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) != 0 ||
+	    setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) != 0 ||
+	    (interface.s_addr != htonl(INADDR_ANY) &&
+	     setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &interface, sizeof(interface)) != 0) ||
+	    ::connect(fd, reinterpret_cast<sockaddr*>(&group), sizeof(group)) != 0)
+	{
+		::close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+int MulticastSocket::openReceiver(const ghost::ConnectionConfigurationMulticast& config)
+{
+	sockaddr_in group;
+	ip_mreq membership;
+	if (!getGroupAddress(config, group) || !getInterfaceAddress(config, membership.imr_interface)) return -1;
+
+	membership.imr_multiaddr = group.sin_addr;
+
+	int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd < 0) return -1;
+
+	// several subscribers of the same host can join the group, and bind to its address to only receive it
+	int enable = 1;
+	int bufferSize = BUFFER_SIZE;
+	setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+	if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) != 0 ||
+	    ::bind(fd, reinterpret_cast<sockaddr*>(&group), sizeof(group)) != 0 ||
+	    setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0)
+	{
+		::close(fd);
+		return -1;
+	}
+
+	return fd;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_MULTICAST_MULTICASTSOCKET_HPP
+#define GHOST_INTERNAL_MULTICAST_MULTICASTSOCKET_HPP
+
+#include <ghost/connection_multicast/ConnectionConfigurationMulticast.hpp>
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Creates the IPv4 UDP sockets of the multicast connections. The methods return -1 on failure.
+ */
+class MulticastSocket
+{
+public:
+	/// Creates a socket sending to the group of the configuration.
+	static int openSender(const ghost::ConnectionConfigurationMulticast& config);
+	/// Creates a non-blocking socket which joined the group of the configuration.
+	static int openReceiver(const ghost::ConnectionConfigurationMulticast& config);
+
+private:
+	/// Socket buffers are enlarged to absorb the bursts of fragments.
+	static const int BUFFER_SIZE = 4 * 1024 * 1024;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_MULTICAST_MULTICASTSOCKET_HPP
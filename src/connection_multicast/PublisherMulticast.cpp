@@ -0,0 +1,139 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PublisherMulticast.hpp"
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Datagram.hpp"
+#include "MulticastSocket.hpp"
+
+using namespace ghost::internal;
+
+const size_t PublisherMulticast::MAXIMUM_BATCH_SIZE;
+const size_t PublisherMulticast::MAXIMUM_DATAGRAMS_PER_CALL;
+
+PublisherMulticast::PublisherMulticast(const ghost::ConnectionConfiguration& config)
+    : PublisherMulticast(ghost::ConnectionConfigurationMulticast::initializeFrom(config))
+{
+}
+
+PublisherMulticast::PublisherMulticast(const ghost::ConnectionConfigurationMulticast& config)
+    : ghost::Publisher(config), _configuration(config), _fd(-1), _running(false), _droppedCount(0)
+{
+}
+
+PublisherMulticast::~PublisherMulticast()
+{
+	stop();
+}
+
+bool PublisherMulticast::start()
+{
+	if (_running) return false;
+
+	_fd = MulticastSocket::openSender(_configuration);
+	if (_fd < 0) return false;
+
+	// subscribers recognize a new start of the publisher with a new source identifier
+	std::random_device random;
+	uint64_t source = (static_cast<uint64_t>(random()) << 32) | random();
+
+	_running = true;
+	_writerThread = std::thread(&PublisherMulticast::writerThread, this, source);
+	return true;
+}
+
+bool PublisherMulticast::stop()
+{
+	if (!_running.exchange(false)) return false;
+
+	getWriterSink()->drain();
+	if (_writerThread.joinable()) _writerThread.join();
+
+	::close(_fd);
+	_fd = -1;
+	return true;
+}
+
+bool PublisherMulticast::isRunning() const
+{
+	return _running;
+}
+
+uint64_t PublisherMulticast::getDroppedCount() const
+{
+	return _droppedCount;
+}
+
+void PublisherMulticast::writerThread(uint64_t source)
+{
+	auto writerSink = getWriterSink();
+	DatagramBatch batch(source, _configuration.getMaximumDatagramSize());
+	std::vector<google::protobuf::Any> messages;
+	std::vector<std::string> serializedMessages(MAXIMUM_BATCH_SIZE);
+
+	iovec buffers[MAXIMUM_DATAGRAMS_PER_CALL][2];
+	mmsghdr datagrams[MAXIMUM_DATAGRAMS_PER_CALL];
+
+	while (_running)
+	{
+		messages.clear();
+		size_t count = writerSink->getBatch(messages, MAXIMUM_BATCH_SIZE, std::chrono::milliseconds(100));
+		if (count == 0) continue;
+
+		// every message is serialized once, its fragments point into the serialized message
+		batch.clear();
+		for (size_t i = 0; i < count; ++i)
+		{
+			messages[i].SerializeToString(&serializedMessages[i]);
+			if (!batch.add(serializedMessages[i])) _droppedCount++;
+		}
+
+		size_t sent = 0;
+		while (sent < batch.size())
+		{
+			size_t datagramCount = std::min(batch.size() - sent, MAXIMUM_DATAGRAMS_PER_CALL);
+			for (size_t i = 0; i < datagramCount; ++i)
+			{
+				buffers[i][0].iov_base = const_cast<uint8_t*>(batch.getHeader(sent + i));
+				buffers[i][0].iov_len = DatagramHeader::SIZE;
+				buffers[i][1].iov_base = const_cast<uint8_t*>(batch.getPayload(sent + i));
+				buffers[i][1].iov_len = batch.getPayloadSize(sent + i);
+
+				datagrams[i] = mmsghdr{};
+				datagrams[i].msg_hdr.msg_iov = buffers[i];
+				datagrams[i].msg_hdr.msg_iovlen = 2;
+			}
+
+			int result = ::sendmmsg(_fd, datagrams, static_cast<unsigned int>(datagramCount), 0);
+			if (result > 0)
+				sent += result;
+			else if (errno != EINTR)
+				sent++; // skip the datagram that cannot be sent, the subscribers will detect its loss
+		}
+
+		for (size_t i = 0; i < count; ++i) writerSink->pop();
+	}
+}
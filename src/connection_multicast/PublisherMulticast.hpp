@@ -0,0 +1,65 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_MULTICAST_PUBLISHERMULTICAST_HPP
+#define GHOST_INTERNAL_MULTICAST_PUBLISHERMULTICAST_HPP
+
+#include <atomic>
+#include <ghost/connection/Publisher.hpp>
+#include <ghost/connection_multicast/ConnectionConfigurationMulticast.hpp>
+#include <thread>
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Publisher sending its messages to a multicast group: every message is serialized and sent once,
+ * whatever the number of subscribers. Messages larger than a datagram are fragmented.
+ */
+class PublisherMulticast : public ghost::Publisher
+{
+public:
+	PublisherMulticast(const ghost::ConnectionConfiguration& config);
+	PublisherMulticast(const ghost::ConnectionConfigurationMulticast& config);
+	~PublisherMulticast();
+
+	bool start() override;
+	bool stop() override;
+	bool isRunning() const override;
+
+	/// Returns the number of messages that were too large to be sent.
+	uint64_t getDroppedCount() const;
+
+private:
+	/// Maximum number of messages taken from the writer sink at once.
+	static const size_t MAXIMUM_BATCH_SIZE = 64;
+	/// Maximum number of datagrams passed to the socket at once.
+	static const size_t MAXIMUM_DATAGRAMS_PER_CALL = 64;
+
+	void writerThread(uint64_t source);
+
+	ghost::ConnectionConfigurationMulticast _configuration;
+	int _fd;
+	std::atomic_bool _running;
+	std::atomic<uint64_t> _droppedCount;
+	std::thread _writerThread;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_MULTICAST_PUBLISHERMULTICAST_HPP
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "SubscriberMulticast.hpp"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "MessageAssembler.hpp"
+#include "MulticastSocket.hpp"
+
+using namespace ghost::internal;
+
+const size_t SubscriberMulticast::RECEIVE_BATCH_SIZE;
+const size_t SubscriberMulticast::MAXIMUM_DATAGRAM_SIZE;
+
+SubscriberMulticast::SubscriberMulticast(const ghost::ConnectionConfiguration& config)
+    : SubscriberMulticast(ghost::ConnectionConfigurationMulticast::initializeFrom(config))
+{
+}
+
+SubscriberMulticast::SubscriberMulticast(const ghost::ConnectionConfigurationMulticast& config)
+    : ghost::Subscriber(config), _configuration(config), _fd(-1), _wakeUpFd(-1), _running(false), _lostCount(0)
+{
+}
+
+SubscriberMulticast::~SubscriberMulticast()
+{
+	stop();
+	release();
+}
+
+bool SubscriberMulticast::start()
+{
+	if (_running) return false;
+
+	release(); // the subscriber may have stopped itself after a loss
+	_fd = MulticastSocket::openReceiver(_configuration);
+	if (_fd < 0) return false;
+
+	_wakeUpFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	_running = true;
+	_readerThread = std::thread(&SubscriberMulticast::readerThread, this);
+	return true;
+}
+
+bool SubscriberMulticast::stop()
+{
+	if (!_running.exchange(false)) return false;
+
+	uint64_t value = 1;
+	ssize_t written = ::write(_wakeUpFd, &value, sizeof(value));
+	(void)written; // the reader thread checks "_running" at least after every datagram anyway
+
+	getReaderSink()->drain();
+	release();
+	return true;
+}
+
+bool SubscriberMulticast::isRunning() const
+{
+	return _running;
+}
+
+uint64_t SubscriberMulticast::getLostCount() const
+{
+	return _lostCount;
+}
+
+void SubscriberMulticast::readerThread()
+{
+	auto readerSink = getReaderSink();
+	bool stopOnLoss = _configuration.getLossPolicy() == ghost::ConnectionConfigurationMulticast::LossPolicy::STOP;
+	MessageAssembler assembler;
+	auto deliver = [&](const uint8_t* data, size_t size) {
+		// with the "STOP" policy, the messages following a loss are not delivered
+		if (stopOnLoss && assembler.getLostCount() > 0) return;
+
+		google::protobuf::Any message;
+		if (message.ParseFromArray(data, static_cast<int>(size))) readerSink->put(std::move(message));
+	};
+
+	std::vector<uint8_t> memory(RECEIVE_BATCH_SIZE * MAXIMUM_DATAGRAM_SIZE);
+	iovec buffers[RECEIVE_BATCH_SIZE];
+	mmsghdr datagrams[RECEIVE_BATCH_SIZE];
+
+	while (_running)
+	{
+		pollfd fds[2] = {{_fd, POLLIN, 0}, {_wakeUpFd, POLLIN, 0}};
+		if (::poll(fds, 2, -1) <= 0 || !_running) continue;
+
+		for (size_t i = 0; i < RECEIVE_BATCH_SIZE; ++i)
+		{
+			buffers[i].iov_base = memory.data() + i * MAXIMUM_DATAGRAM_SIZE;
+			buffers[i].iov_len = MAXIMUM_DATAGRAM_SIZE;
+			datagrams[i] = mmsghdr{};
+			datagrams[i].msg_hdr.msg_iov = &buffers[i];
+			datagrams[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		int count = ::recvmmsg(_fd, datagrams, RECEIVE_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+		for (int i = 0; i < count; ++i)
+		{
+			if (datagrams[i].msg_hdr.msg_flags & MSG_TRUNC) continue; // not a datagram of a publisher
+
+			const uint8_t* datagram = static_cast<const uint8_t*>(buffers[i].iov_base);
+			assembler.onDatagram(datagram, datagrams[i].msg_len, deliver);
+		}
+
+		_lostCount = assembler.getLostCount();
+		if (stopOnLoss && _lostCount > 0 && _running.exchange(false))
+		{
+			// the readers waiting for messages are released
+			readerSink->drain();
+			return;
+		}
+	}
+}
+
+void SubscriberMulticast::release()
+{
+	if (_readerThread.joinable()) _readerThread.join();
+
+	if (_fd >= 0) ::close(_fd);
+	if (_wakeUpFd >= 0) ::close(_wakeUpFd);
+	_fd = -1;
+	_wakeUpFd = -1;
+}
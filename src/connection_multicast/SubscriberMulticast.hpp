@@ -0,0 +1,67 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_MULTICAST_SUBSCRIBERMULTICAST_HPP
+#define GHOST_INTERNAL_MULTICAST_SUBSCRIBERMULTICAST_HPP
+
+#include <atomic>
+#include <ghost/connection/Subscriber.hpp>
+#include <ghost/connection_multicast/ConnectionConfigurationMulticast.hpp>
+#include <thread>
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Subscriber receiving the messages sent to a multicast group. Lost messages are counted, and stop
+ * the subscriber if its loss policy requires it.
+ */
+class SubscriberMulticast : public ghost::Subscriber
+{
+public:
+	SubscriberMulticast(const ghost::ConnectionConfiguration& config);
+	SubscriberMulticast(const ghost::ConnectionConfigurationMulticast& config);
+	~SubscriberMulticast();
+
+	bool start() override;
+	bool stop() override;
+	bool isRunning() const override;
+
+	/// Returns the number of messages of the publishers that this subscriber did not receive.
+	uint64_t getLostCount() const;
+
+private:
+	/// Maximum number of datagrams read from the socket at once.
+	static const size_t RECEIVE_BATCH_SIZE = 16;
+	static const size_t MAXIMUM_DATAGRAM_SIZE = 65536;
+
+	void readerThread();
+	/// Joins the reader thread and closes the sockets.
+	void release();
+
+	ghost::ConnectionConfigurationMulticast _configuration;
+	int _fd;
+	int _wakeUpFd;
+	std::atomic_bool _running;
+	std::atomic<uint64_t> _lostCount;
+	std::thread _readerThread;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_MULTICAST_SUBSCRIBERMULTICAST_HPP
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ClientSHM.hpp"
+
+#include <thread>
+
+using namespace ghost::internal;
+
+const std::chrono::milliseconds ClientSHM::CONNECTION_TIMEOUT = std::chrono::milliseconds(1000);
+
+ClientSHM::ClientSHM(const ghost::ConnectionConfiguration& config)
+    : ClientSHM(ghost::ConnectionConfigurationSHM::initializeFrom(config))
+{
+}
+
+ClientSHM::ClientSHM(const ghost::ConnectionConfigurationSHM& config) : ghost::Client(config), _configuration(config)
+{
+}
+
+bool ClientSHM::start()
+{
+	if (_channel) return false;
+
+	auto segment = std::shared_ptr<SharedMemorySegment>(
+	    SharedMemorySegment::open(SharedMemorySegment::getName(_configuration)));
+	if (!segment || !SharedMemorySegment::isOwnerAlive(segment->getHeader())) return false;
+
+	for (size_t i = 0; i < segment->getHeader()->slotCount; ++i)
+	{
+		std::unique_ptr<ShmClientSlot> slot(new ShmClientSlot(segment, i));
+		if (!slot->claim()) continue;
+
+		if (!connect(*slot)) return false;
+
+		_slot = std::move(slot);
+		ShmClientSlot* connected = _slot.get();
+		auto header = segment->getHeader();
+		_channel.reset(new ShmChannel(
+		    [connected, header] {
+			    return connected->getState() != ShmClientSlot::CLOSED &&
+				   SharedMemorySegment::isOwnerAlive(header);
+		    },
+		    [connected] {
+			    connected->setState(ShmClientSlot::CLOSED);
+			    connected->detach();
+		    }));
+		_channel->setOutgoing(_slot->getClientRing(), true, getWriterSink());
+		_channel->setIncoming(_slot->getServerRing(), true, getReaderSink());
+		_channel->start();
+		return true;
+	}
+
+	return false; // the server accepts no more clients
+}
+
+bool ClientSHM::stop()
+{
+	if (!_channel) return false;
+
+	return _channel->close();
+}
+
+bool ClientSHM::isRunning() const
+{
+	return _channel && _channel->isOpen();
+}
+
+bool ClientSHM::connect(ShmClientSlot& slot)
+{
+	auto header = slot.getSegment()->getHeader();
+	auto deadline = std::chrono::steady_clock::now() + CONNECTION_TIMEOUT;
+	while (slot.getState() == ShmClientSlot::CONNECTING && SharedMemorySegment::isOwnerAlive(header) &&
+	       std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+	// the server may already have closed the connection it accepted
+	if (slot.cancel()) return false;
+
+	return true;
+}
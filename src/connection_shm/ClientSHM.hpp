@@ -0,0 +1,59 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_SHM_CLIENTSHM_HPP
+#define GHOST_INTERNAL_SHM_CLIENTSHM_HPP
+
+#include <ghost/connection/Client.hpp>
+#include <ghost/connection_shm/ConnectionConfigurationSHM.hpp>
+#include <memory>
+
+#include "ShmChannel.hpp"
+#include "ShmClientSlot.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Client connecting to a server of another process by claiming one of the slots of its segment.
+ * The client stops when the server closes the connection, stops or dies.
+ */
+class ClientSHM : public ghost::Client
+{
+public:
+	ClientSHM(const ghost::ConnectionConfiguration& config);
+	ClientSHM(const ghost::ConnectionConfigurationSHM& config);
+
+	bool start() override;
+	bool stop() override;
+	bool isRunning() const override;
+
+private:
+	/// How long a client waits for the server to accept it.
+	static const std::chrono::milliseconds CONNECTION_TIMEOUT;
+
+	bool connect(ShmClientSlot& slot);
+
+	ghost::ConnectionConfigurationSHM _configuration;
+	std::unique_ptr<ShmClientSlot> _slot;
+	std::unique_ptr<ShmChannel> _channel;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_SHM_CLIENTSHM_HPP
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <ghost/connection_shm/ConnectionConfigurationSHM.hpp>
+
+using namespace ghost;
+
+namespace ghost
+{
+namespace internal
+{
+static std::string CONNECTIONCONFIGURATIONSHM_TECHNOLOGY = "CONNECTIONCONFIGURATIONSHM_TECHNOLOGY";
+static std::string CONNECTIONCONFIGURATIONSHM_RINGSIZE = "CONNECTIONCONFIGURATIONSHM_RINGSIZE";
+static std::string CONNECTIONCONFIGURATIONSHM_MAXIMUMCLIENTS = "CONNECTIONCONFIGURATIONSHM_MAXIMUMCLIENTS";
+} // namespace internal
+} // namespace ghost
+
+ConnectionConfigurationSHM::ConnectionConfigurationSHM(const std::string& name) : NetworkConnectionConfiguration(name)
+{
+	ghost::ConfigurationValue techonologyAttribute;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONSHM_TECHNOLOGY, techonologyAttribute);
+
+	ghost::ConfigurationValue defaultRingSize;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONSHM_RINGSIZE, defaultRingSize);
+
+	ghost::ConfigurationValue defaultMaximumClients;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONSHM_MAXIMUMCLIENTS, defaultMaximumClients);
+}
+
+ConnectionConfigurationSHM::ConnectionConfigurationSHM(const std::string& ip, int port)
+    : ConnectionConfigurationSHM("")
+{
+	setServerIpAddress(ip);
+	setServerPortNumber(port);
+}
+
+size_t ConnectionConfigurationSHM::getRingSize() const
+{
+	size_t res = 1024 * 1024;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<size_t>(res);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATIONSHM_RINGSIZE, value,
+				     defaultValue); // if the field was removed, returns 1 MB
+	value.read<size_t>(res);
+
+	return res;
+}
+
+size_t ConnectionConfigurationSHM::getMaximumClients() const
+{
+	size_t res = 8;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<size_t>(8);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATIONSHM_MAXIMUMCLIENTS, value,
+				     defaultValue); // if the field was removed, returns 8
+	value.read<size_t>(res);
+
+	return res;
+}
+
+void ConnectionConfigurationSHM::setRingSize(size_t size)
+{
+	ghost::ConfigurationValue value;
+	value.write<size_t>(size);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONSHM_RINGSIZE, value,
+				     true); // checks if the attribute is there as well
+}
+
+void ConnectionConfigurationSHM::setMaximumClients(size_t count)
+{
+	ghost::ConfigurationValue value;
+	value.write<size_t>(count);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONSHM_MAXIMUMCLIENTS, value,
+				     true); // checks if the attribute is there as well
+}
+
+ConnectionConfigurationSHM ConnectionConfigurationSHM::initializeFrom(const ConnectionConfiguration& from)
+{
+	ConnectionConfigurationSHM newconfig(from.getConfiguration()->getConfigurationName());
+	from.getConfiguration()->copy(*newconfig.getConfiguration());
+	return newconfig;
+}
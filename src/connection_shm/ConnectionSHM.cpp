@@ -0,0 +1,36 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <ghost/connection_shm/ConnectionConfigurationSHM.hpp>
+#include <ghost/connection_shm/ConnectionSHM.hpp>
+
+#include "ClientSHM.hpp"
+#include "PublisherSHM.hpp"
+#include "ServerSHM.hpp"
+#include "SubscriberSHM.hpp"
+
+using namespace ghost;
+
+void ConnectionSHM::initialize(const std::shared_ptr<ghost::ConnectionManager>& connectionManager,
+			       const ghost::NetworkConnectionConfiguration& minimumConfiguration)
+{
+	// Assign the shared memory implementations to this configuration.
+	connectionManager->getConnectionFactory()->addServerRule<internal::ServerSHM>(minimumConfiguration);
+	connectionManager->getConnectionFactory()->addClientRule<internal::ClientSHM>(minimumConfiguration);
+	connectionManager->getConnectionFactory()->addPublisherRule<internal::PublisherSHM>(minimumConfiguration);
+	connectionManager->getConnectionFactory()->addSubscriberRule<internal::SubscriberSHM>(minimumConfiguration);
+}
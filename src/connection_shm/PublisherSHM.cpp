@@ -0,0 +1,73 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PublisherSHM.hpp"
+
+using namespace ghost::internal;
+
+PublisherSHM::PublisherSHM(const ghost::ConnectionConfiguration& config)
+    : PublisherSHM(ghost::ConnectionConfigurationSHM::initializeFrom(config))
+{
+}
+
+PublisherSHM::PublisherSHM(const ghost::ConnectionConfigurationSHM& config)
+    : ghost::Publisher(config), _configuration(config)
+{
+}
+
+PublisherSHM::~PublisherSHM()
+{
+	stop();
+}
+
+bool PublisherSHM::start()
+{
+	if (_channel) return false;
+
+	size_t ringSize = ShmRing::getCapacity(_configuration.getRingSize());
+	_segment = SharedMemorySegment::create(SharedMemorySegment::getName(_configuration),
+					       SharedMemorySegment::HEADER_SIZE + ShmRing::getSize(ringSize));
+	if (!_segment) return false;
+
+	uint8_t* ringAddress = _segment->getAddress() + SharedMemorySegment::HEADER_SIZE;
+	ShmRing::initialize(ringAddress, ringSize);
+
+	auto header = _segment->getHeader();
+	header->ringCapacity = ringSize;
+	header->magic = SharedMemorySegment::MAGIC;
+
+	// subscribers are not tracked: there is no peer to check
+	_channel.reset(new ShmChannel([] { return true; }, nullptr));
+	_channel->setOutgoing(ShmRing(ringAddress), false, getWriterSink());
+	_channel->start();
+	return true;
+}
+
+bool PublisherSHM::stop()
+{
+	if (!_channel || !_channel->isOpen()) return false;
+
+	_segment->getHeader()->closed = 1;
+	_channel->close();
+	_segment->unlink();
+	return true;
+}
+
+bool PublisherSHM::isRunning() const
+{
+	return _channel && _channel->isOpen();
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_SHM_PUBLISHERSHM_HPP
+#define GHOST_INTERNAL_SHM_PUBLISHERSHM_HPP
+
+#include <ghost/connection/Publisher.hpp>
+#include <ghost/connection_shm/ConnectionConfigurationSHM.hpp>
+#include <memory>
+
+#include "SharedMemorySegment.hpp"
+#include "ShmChannel.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Publisher writing its messages into a ring of its own segment, which all the subscribers read.
+ * The publisher never waits for the subscribers: a subscriber that is too slow loses the messages
+ * that were overwritten, without slowing down the others.
+ */
+class PublisherSHM : public ghost::Publisher
+{
+public:
+	PublisherSHM(const ghost::ConnectionConfiguration& config);
+	PublisherSHM(const ghost::ConnectionConfigurationSHM& config);
+	~PublisherSHM();
+
+	bool start() override;
+	bool stop() override;
+	bool isRunning() const override;
+
+private:
+	ghost::ConnectionConfigurationSHM _configuration;
+	std::shared_ptr<SharedMemorySegment> _segment;
+	std::unique_ptr<ShmChannel> _channel;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_SHM_PUBLISHERSHM_HPP
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "RemoteClientSHM.hpp"
+
+#include "ServerSHM.hpp"
+
+using namespace ghost::internal;
+
+RemoteClientSHM::RemoteClientSHM(const ghost::ConnectionConfiguration& configuration, const ShmClientSlot& slot,
+				 ServerSHM* parentServer)
+    : ghost::Client(configuration)
+    , _slot(slot)
+    , _channel(
+	  [this] { return _slot.getState() != ShmClientSlot::CLOSED && _slot.isClientAlive(); },
+	  [this] {
+		  _slot.setState(ShmClientSlot::CLOSED);
+		  SharedMemorySegment::notify(_slot.getSegment()->getHeader());
+	  })
+    , _running(false)
+    , _parentServer(parentServer)
+{
+	_channel.setOutgoing(_slot.getServerRing(), true, getWriterSink());
+	_channel.setIncoming(_slot.getClientRing(), true, getReaderSink());
+}
+
+RemoteClientSHM::~RemoteClientSHM()
+{
+	if (!_executor.joinable()) return;
+
+	if (_executor.get_id() == std::this_thread::get_id())
+		_executor.detach();
+	else
+		_executor.join();
+}
+
+void RemoteClientSHM::join()
+{
+	if (_executor.joinable() && _executor.get_id() != std::this_thread::get_id()) _executor.join();
+}
+
+bool RemoteClientSHM::start()
+{
+	return false; // it is supposed to be already started by the server
+}
+
+bool RemoteClientSHM::stop()
+{
+	return _channel.close();
+}
+
+bool RemoteClientSHM::isRunning() const
+{
+	return !_channel.isClosed() || _running;
+}
+
+bool RemoteClientSHM::isFinished() const
+{
+	return _channel.isClosed() && !_running;
+}
+
+void RemoteClientSHM::execute()
+{
+	_running = true;
+
+	_executor = std::thread([this] {
+		std::shared_ptr<ghost::Client> self = shared_from_this();
+
+		if (_parentServer->getClientHandler()) _parentServer->getClientHandler()->configureClient(self);
+
+		_channel.start();
+
+		// call the application code
+		bool continueExecution = true;
+		bool keepClientAlive = false;
+
+		if (_parentServer->getClientHandler())
+			continueExecution = _parentServer->getClientHandler()->handle(self, keepClientAlive);
+
+		// only stop the client if the user left "keepClientAlive" to false
+		if (!keepClientAlive) stop();
+
+		// if continueExecution is false, stop the server
+		if (!continueExecution) _parentServer->stop();
+
+		_running = false;
+		// the server may have released this object meanwhile, in which case it is deleted here
+		self.reset();
+	});
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_SHM_REMOTECLIENTSHM_HPP
+#define GHOST_INTERNAL_SHM_REMOTECLIENTSHM_HPP
+
+#include <atomic>
+#include <ghost/connection/Client.hpp>
+#include <memory>
+#include <thread>
+
+#include "ShmChannel.hpp"
+#include "ShmClientSlot.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+class ServerSHM;
+
+/**
+ * Server side of a connection with a client of another process, exchanging the messages through
+ * the rings of the client's slot.
+ */
+class RemoteClientSHM : public ghost::Client, public std::enable_shared_from_this<RemoteClientSHM>
+{
+public:
+	RemoteClientSHM(const ghost::ConnectionConfiguration& configuration, const ShmClientSlot& slot,
+			ServerSHM* parentServer);
+	~RemoteClientSHM();
+
+	bool start() override;
+	bool stop() override;
+	bool isRunning() const override;
+
+	void execute();
+	/// Waits for the end of the client handler, unless it is called by the client handler itself.
+	void join();
+
+	/// Returns true once the connection stopped and the slot is not accessed anymore by this side.
+	bool isFinished() const;
+
+private:
+	ShmClientSlot _slot;
+	ShmChannel _channel;
+	std::atomic_bool _running;
+	std::thread _executor;
+
+	ServerSHM* _parentServer;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_SHM_REMOTECLIENTSHM_HPP
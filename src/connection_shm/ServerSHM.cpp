@@ -0,0 +1,177 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ServerSHM.hpp"
+
+#include <algorithm>
+
+using namespace ghost::internal;
+
+ServerSHM::ServerSHM(const ghost::ConnectionConfiguration& config)
+    : ServerSHM(ghost::ConnectionConfigurationSHM::initializeFrom(config))
+{
+}
+
+ServerSHM::ServerSHM(const ghost::ConnectionConfigurationSHM& config) : _configuration(config), _running(false)
+{
+}
+
+ServerSHM::~ServerSHM()
+{
+	stop();
+
+	// the threads executing the client handler reference their client and this server until they return:
+	// join them outside of the lock, which the handler takes when it stops the server
+	std::vector<std::shared_ptr<RemoteClientSHM>> clients;
+	{
+		std::lock_guard<std::mutex> lock(_clientsMutex);
+		clients.swap(_clients);
+	}
+	for (const auto& client : clients)
+	{
+		if (client) client->join();
+	}
+}
+
+bool ServerSHM::start()
+{
+	if (_running) return false;
+
+	size_t ringSize = ShmRing::getCapacity(_configuration.getRingSize());
+	size_t slotCount = std::max<size_t>(_configuration.getMaximumClients(), 1);
+	_segment = SharedMemorySegment::create(SharedMemorySegment::getName(_configuration),
+					       ShmClientSlot::getSegmentSize(ringSize, slotCount));
+	if (!_segment) return false;
+
+	auto header = _segment->getHeader();
+	header->ringCapacity = ringSize;
+	header->slotCount = slotCount;
+	header->magic = SharedMemorySegment::MAGIC;
+
+	{
+		std::lock_guard<std::mutex> lock(_clientsMutex);
+		_clients.clear();
+		_clients.resize(slotCount);
+	}
+
+	_running = true;
+	_acceptorThread = std::thread(&ServerSHM::acceptorThread, this);
+	return true;
+}
+
+bool ServerSHM::stop()
+{
+	if (!_running) return false;
+
+	_running = false;
+
+	// Refuse new clients, then stop the connected ones
+	_segment->getHeader()->closed = 1;
+	SharedMemorySegment::notify(_segment->getHeader());
+	if (_acceptorThread.joinable() && _acceptorThread.get_id() != std::this_thread::get_id())
+		_acceptorThread.join();
+	_segment->unlink();
+
+	std::vector<std::shared_ptr<RemoteClientSHM>> clients;
+	{
+		std::lock_guard<std::mutex> lock(_clientsMutex);
+		clients = _clients;
+	}
+
+	for (const auto& client : clients)
+	{
+		if (client) client->stop();
+	}
+
+	return true;
+}
+
+bool ServerSHM::isRunning() const
+{
+	return _running;
+}
+
+void ServerSHM::setClientHandler(std::shared_ptr<ghost::ClientHandler> handler)
+{
+	_clientHandler = handler;
+}
+
+const std::shared_ptr<ghost::ClientHandler> ServerSHM::getClientHandler() const
+{
+	return _clientHandler;
+}
+
+void ServerSHM::acceptorThread()
+{
+	auto header = _segment->getHeader();
+	while (_running)
+	{
+		header->waiters.fetch_add(1);
+		uint32_t notification = header->notification.load();
+
+		for (size_t i = 0; i < header->slotCount && _running; ++i) updateSlot(i);
+
+		if (_running)
+			SharedMemorySegment::wait(header->notification, notification, std::chrono::milliseconds(100));
+		header->waiters.fetch_sub(1);
+	}
+}
+
+void ServerSHM::updateSlot(size_t index)
+{
+	ShmClientSlot slot(_segment, index);
+	auto state = slot.getState();
+	if (state == ShmClientSlot::FREE) return;
+
+	std::shared_ptr<RemoteClientSHM> client;
+	{
+		std::lock_guard<std::mutex> lock(_clientsMutex);
+		client = _clients[index];
+	}
+
+	if (state == ShmClientSlot::CONNECTING && !client)
+	{
+		client = std::make_shared<RemoteClientSHM>(_configuration, slot, this);
+		{
+			std::lock_guard<std::mutex> lock(_clientsMutex);
+			_clients[index] = client;
+		}
+		// Execute the application's code in a separate thread
+		if (slot.accept())
+			client->execute();
+		else
+			client->stop();
+		return;
+	}
+
+	// a client that died does not close its slot itself
+	if (state != ShmClientSlot::CLOSED && !slot.isClientAlive())
+	{
+		slot.setState(ShmClientSlot::CLOSED);
+		state = ShmClientSlot::CLOSED;
+	}
+
+	if (state == ShmClientSlot::CLOSED && (!slot.isClientAttached() || !slot.isClientAlive()) &&
+	    (!client || client->isFinished()))
+	{
+		{
+			std::lock_guard<std::mutex> lock(_clientsMutex);
+			_clients[index].reset();
+		}
+		slot.release();
+	}
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_SHM_SERVERSHM_HPP
+#define GHOST_INTERNAL_SHM_SERVERSHM_HPP
+
+#include <atomic>
+#include <ghost/connection/Server.hpp>
+#include <ghost/connection_shm/ConnectionConfigurationSHM.hpp>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "RemoteClientSHM.hpp"
+#include "SharedMemorySegment.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Server owning a segment with a fixed number of client slots. An acceptor thread accepts the clients that
+ * claimed a slot, executes the client handler for them, and frees the slots of clients that left or died.
+ */
+class ServerSHM : public ghost::Server
+{
+public:
+	ServerSHM(const ghost::ConnectionConfiguration& config);
+	ServerSHM(const ghost::ConnectionConfigurationSHM& config);
+	~ServerSHM();
+
+	bool start() override;
+	bool stop() override;
+	bool isRunning() const override;
+
+	void setClientHandler(std::shared_ptr<ClientHandler> handler) override;
+	const std::shared_ptr<ClientHandler> getClientHandler() const;
+
+private:
+	void acceptorThread();
+	void updateSlot(size_t index);
+
+	ghost::ConnectionConfigurationSHM _configuration;
+	std::atomic<bool> _running;
+	std::shared_ptr<SharedMemorySegment> _segment;
+	std::thread _acceptorThread;
+
+	std::mutex _clientsMutex;
+	/// Remote client of each slot, if any.
+	std::vector<std::shared_ptr<RemoteClientSHM>> _clients;
+	std::shared_ptr<ClientHandler> _clientHandler;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_SHM_SERVERSHM_HPP
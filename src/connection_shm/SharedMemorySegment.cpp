@@ -0,0 +1,192 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "SharedMemorySegment.hpp"
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cerrno>
+
+using namespace ghost::internal;
+
+namespace
+{
+void* map(int fd, size_t size)
+{
+	void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	return address == MAP_FAILED ? nullptr : address;
+}
+
+// Returns true if the existing segment was abandoned by its owner.
+bool isAbandoned(const std::string& name)
+{
+	int fd = shm_open(name.c_str(), O_RDWR, 0);
+	if (fd < 0) return errno == ENOENT;
+
+	struct stat status;
+	bool abandoned = false;
+	if (fstat(fd, &status) == 0 && (size_t)status.st_size >= sizeof(ShmSegmentHeader))
+	{
+		auto header = static_cast<ShmSegmentHeader*>(map(fd, sizeof(ShmSegmentHeader)));
+		if (header)
+		{
+			// a segment without owner is being initialized
+			int32_t owner = header->ownerPid;
+			abandoned = owner != 0 && !SharedMemorySegment::isProcessAlive(owner);
+			munmap(header, sizeof(ShmSegmentHeader));
+		}
+	}
+	close(fd);
+	return abandoned;
+}
+} // namespace
+
+std::unique_ptr<SharedMemorySegment> SharedMemorySegment::create(const std::string& name, size_t size)
+{
+	int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (fd < 0 && errno == EEXIST && isAbandoned(name))
+	{
+		shm_unlink(name.c_str());
+		fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	}
+	if (fd < 0) return nullptr;
+
+	void* address = nullptr;
+	if (ftruncate(fd, size) == 0) address = map(fd, size);
+	if (!address)
+	{
+		close(fd);
+		shm_unlink(name.c_str());
+		return nullptr;
+	}
+
+	auto header = static_cast<ShmSegmentHeader*>(address);
+	header->ownerPid = getpid();
+
+	return std::unique_ptr<SharedMemorySegment>(new SharedMemorySegment(name, fd, address, size, true));
+}
+
+std::unique_ptr<SharedMemorySegment> SharedMemorySegment::open(const std::string& name)
+{
+	int fd = shm_open(name.c_str(), O_RDWR, 0);
+	if (fd < 0) return nullptr;
+
+	struct stat status;
+	void* address = nullptr;
+	if (fstat(fd, &status) == 0 && (size_t)status.st_size >= sizeof(ShmSegmentHeader))
+		address = map(fd, status.st_size);
+
+	if (!address || static_cast<ShmSegmentHeader*>(address)->magic != MAGIC)
+	{
+		if (address) munmap(address, status.st_size);
+		close(fd);
+		return nullptr;
+	}
+
+	return std::unique_ptr<SharedMemorySegment>(
+	    new SharedMemorySegment(name, fd, address, status.st_size, false));
+}
+
+std::string SharedMemorySegment::getName(const ghost::NetworkConnectionConfiguration& configuration)
+{
+	std::string name = "/ghost_" + configuration.getServerIpAddress() + "_" +
+			   std::to_string(configuration.getServerPortNumber());
+	for (size_t i = 1; i < name.size(); ++i)
+	{
+		if (!std::isalnum((unsigned char)name[i])) name[i] = '_';
+	}
+	return name;
+}
+
+bool SharedMemorySegment::isProcessAlive(int32_t pid)
+{
+	return pid > 0 && (kill(pid, 0) == 0 || errno == EPERM);
+}
+
+bool SharedMemorySegment::isOwnerAlive(const ShmSegmentHeader* header)
+{
+	return !header->closed && isProcessAlive(header->ownerPid);
+}
+
+void SharedMemorySegment::wait(std::atomic<uint32_t>& word, uint32_t expected, std::chrono::milliseconds timeout)
+{
+	struct timespec time;
+	time.tv_sec = timeout.count() / 1000;
+	time.tv_nsec = (timeout.count() % 1000) * 1000000;
+	// not a private futex: the word is shared between processes
+	syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &time, nullptr, 0);
+}
+
+void SharedMemorySegment::wake(std::atomic<uint32_t>& word)
+{
+	syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+void SharedMemorySegment::notify(ShmSegmentHeader* header)
+{
+	header->notification.fetch_add(1);
+	if (header->waiters.load() > 0) wake(header->notification);
+}
+
+SharedMemorySegment::SharedMemorySegment(const std::string& name, int fd, void* address, size_t size, bool owner)
+    : _name(name), _fd(fd), _address(address), _size(size), _owner(owner)
+{
+}
+
+SharedMemorySegment::~SharedMemorySegment()
+{
+	unlink();
+	munmap(_address, _size);
+	close(_fd);
+}
+
+void SharedMemorySegment::unlink()
+{
+	if (!_owner) return;
+
+	_owner = false;
+	// only remove the name if it still designates this segment
+	struct stat own, current;
+	int fd = shm_open(_name.c_str(), O_RDONLY, 0);
+	if (fd < 0) return;
+
+	if (fstat(_fd, &own) == 0 && fstat(fd, &current) == 0 && own.st_ino == current.st_ino)
+		shm_unlink(_name.c_str());
+	close(fd);
+}
+
+ShmSegmentHeader* SharedMemorySegment::getHeader() const
+{
+	return static_cast<ShmSegmentHeader*>(_address);
+}
+
+uint8_t* SharedMemorySegment::getAddress() const
+{
+	return static_cast<uint8_t*>(_address);
+}
+
+size_t SharedMemorySegment::getSize() const
+{
+	return _size;
+}
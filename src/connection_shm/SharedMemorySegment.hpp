@@ -0,0 +1,109 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_SHM_SHAREDMEMORYSEGMENT_HPP
+#define GHOST_INTERNAL_SHM_SHAREDMEMORYSEGMENT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <memory>
+#include <string>
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Header placed at the beginning of every segment. Its content is shared between processes:
+ *	it is only made of fixed size types and lock-free atomics.
+ */
+struct ShmSegmentHeader
+{
+	/// Set last by the owner, once the segment is initialized.
+	std::atomic<uint32_t> magic;
+	/// Process that created the segment: the segment is abandoned when it died.
+	std::atomic<int32_t> ownerPid;
+	/// Set when the owner stops.
+	std::atomic<uint32_t> closed;
+	/// Futex word incremented when the owner must look at the segment, e.g. a client connects.
+	std::atomic<uint32_t> notification;
+	std::atomic<uint32_t> waiters;
+	uint32_t slotCount;
+	uint64_t ringCapacity;
+};
+
+/**
+ *	POSIX shared memory segment mapped in the address space of this process. The creator of
+ *	the segment owns its name and removes it when it is deleted.
+ */
+class SharedMemorySegment
+{
+public:
+	static const uint32_t MAGIC = 0x67687331; // "ghs1"
+	/// Space reserved for the ghost::internal::ShmSegmentHeader at the beginning of the segment.
+	static const size_t HEADER_SIZE = 64;
+
+	/**
+	 *	Creates and maps a new segment of "size" bytes, which is filled with zeros.
+	 *	A segment with the same name that was left by a process that died is replaced.
+	 *	@return the segment, or nullptr if the name is already in use.
+	 */
+	static std::unique_ptr<SharedMemorySegment> create(const std::string& name, size_t size);
+	/**
+	 *	Maps an existing segment.
+	 *	@return the segment, or nullptr if it does not exist or is not initialized yet.
+	 */
+	static std::unique_ptr<SharedMemorySegment> open(const std::string& name);
+
+	/// Returns the name of the segment used by the server or publisher of this configuration.
+	static std::string getName(const ghost::NetworkConnectionConfiguration& configuration);
+	static bool isProcessAlive(int32_t pid);
+	/// Returns true if the owner of the segment is still running and did not close it.
+	static bool isOwnerAlive(const ShmSegmentHeader* header);
+
+	/// Sleeps until "word" is woken up by another thread or process, if it still has the value "expected".
+	static void wait(std::atomic<uint32_t>& word, uint32_t expected, std::chrono::milliseconds timeout);
+	static void wake(std::atomic<uint32_t>& word);
+	/// Increments the notification counter of the header and wakes up its waiters.
+	static void notify(ShmSegmentHeader* header);
+
+	~SharedMemorySegment();
+
+	/// Removes the name of a segment created by this process. It stays mapped until it is deleted.
+	void unlink();
+
+	ShmSegmentHeader* getHeader() const;
+	uint8_t* getAddress() const;
+	size_t getSize() const;
+
+private:
+	SharedMemorySegment(const std::string& name, int fd, void* address, size_t size, bool owner);
+
+	std::string _name;
+	int _fd;
+	void* _address;
+	size_t _size;
+	bool _owner;
+};
+
+static_assert(sizeof(ShmSegmentHeader) <= SharedMemorySegment::HEADER_SIZE, "segment header too large");
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_SHM_SHAREDMEMORYSEGMENT_HPP
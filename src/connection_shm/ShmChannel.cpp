@@ -0,0 +1,169 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ShmChannel.hpp"
+
+#include <vector>
+
+using namespace ghost::internal;
+
+constexpr std::chrono::milliseconds ShmChannel::PEER_CHECK_PERIOD;
+
+ShmChannel::ShmChannel(const std::function<bool()>& isPeerAlive, const std::function<void()>& onClosed)
+    : _isPeerAlive(isPeerAlive)
+    , _onClosed(onClosed)
+    , _flowControl(false)
+    , _lostCount(0)
+    , _open(false)
+    , _closing(false)
+    , _closed(false)
+{
+}
+
+ShmChannel::~ShmChannel()
+{
+	close();
+	// the writer thread was joined by close(), the reader thread may still be closing the channel
+	join(_readerThread);
+}
+
+void ShmChannel::setOutgoing(const ShmRing& ring, bool flowControl, const std::shared_ptr<ghost::WriterSink>& sink)
+{
+	_outgoing.reset(new ShmRing(ring));
+	_flowControl = flowControl;
+	_writerSink = sink;
+}
+
+void ShmChannel::setIncoming(const ShmRing& ring, bool singleConsumer,
+			     const std::shared_ptr<ghost::ReaderSink>& sink)
+{
+	_incoming.reset(new ShmRingReader(ring, singleConsumer));
+	_readerSink = sink;
+}
+
+void ShmChannel::start()
+{
+	if (_open || _closing) return;
+
+	_open = true;
+	std::lock_guard<std::mutex> lock(_threadsMutex);
+	if (_outgoing) _writerThread = std::thread(&ShmChannel::writerThread, this);
+	if (_incoming) _readerThread = std::thread(&ShmChannel::readerThread, this);
+}
+
+bool ShmChannel::close()
+{
+	if (_closing.exchange(true)) return false;
+
+	_open = false;
+	if (_outgoing) _outgoing->close();
+	if (_writerSink) _writerSink->drain();
+	if (_readerSink) _readerSink->drain();
+
+	// the reader thread may be the one closing the channel, it does not access the rings anymore
+	std::thread::id writerId, readerId;
+	{
+		std::lock_guard<std::mutex> lock(_threadsMutex);
+		writerId = _writerThread.get_id();
+		readerId = _readerThread.get_id();
+	}
+	if (writerId != std::this_thread::get_id()) join(_writerThread);
+	if (readerId != std::this_thread::get_id()) join(_readerThread);
+
+	if (_onClosed) _onClosed();
+	_closed = true;
+	return true;
+}
+
+bool ShmChannel::isOpen() const
+{
+	return _open;
+}
+
+bool ShmChannel::isClosed() const
+{
+	return _closed;
+}
+
+uint64_t ShmChannel::getLostCount() const
+{
+	return _lostCount;
+}
+
+void ShmChannel::writerThread()
+{
+	auto canWait = [this] { return _open && _isPeerAlive(); };
+
+	std::vector<google::protobuf::Any> messages;
+	while (_open)
+	{
+		messages.clear();
+		size_t count = _writerSink->getBatch(messages, MAXIMUM_BATCH_SIZE, std::chrono::milliseconds(100));
+
+		for (const auto& message : messages)
+		{
+			// messages too large for the ring are dropped, otherwise a failure means the peer is gone
+			if (!_outgoing->write(message, _flowControl ? canWait : std::function<bool()>()) &&
+			    message.ByteSizeLong() <= _outgoing->getMaximumMessageSize())
+				break;
+		}
+		for (size_t i = 0; i < count; ++i) _writerSink->pop();
+	}
+}
+
+void ShmChannel::readerThread()
+{
+	auto nextPeerCheck = std::chrono::steady_clock::now();
+
+	google::protobuf::Any message;
+	while (_open)
+	{
+		auto result = _incoming->read(message);
+		if (result == ShmRingReader::Result::MESSAGE)
+		{
+			_readerSink->put(std::move(message));
+			continue;
+		}
+
+		if (result == ShmRingReader::Result::LOST)
+		{
+			_lostCount = _incoming->getLostCount();
+			continue;
+		}
+
+		// nothing left to read: the peer may be gone
+		auto now = std::chrono::steady_clock::now();
+		if (_incoming->isClosed() || (now >= nextPeerCheck && !_isPeerAlive()))
+		{
+			close();
+			break;
+		}
+		if (now >= nextPeerCheck) nextPeerCheck = now + PEER_CHECK_PERIOD;
+
+		_incoming->wait(PEER_CHECK_PERIOD);
+	}
+}
+
+void ShmChannel::join(std::thread& thread)
+{
+	if (!thread.joinable()) return;
+
+	if (thread.get_id() == std::this_thread::get_id())
+		thread.detach();
+	else
+		thread.join();
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_SHM_SHMCHANNEL_HPP
+#define GHOST_INTERNAL_SHM_SHMCHANNEL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <ghost/connection/ReaderSink.hpp>
+#include <ghost/connection/WriterSink.hpp>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "ShmRing.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Moves the messages of a connection between its sinks and the rings shared with the other process:
+ *	a writer thread copies the messages of the writer sink into the outgoing ring, and a reader thread
+ *	passes the messages of the incoming ring to the reader sink.
+ *	The channel closes itself when the incoming ring is closed or when "isPeerAlive" returns false,
+ *	which the reader checks periodically while there is nothing to read.
+ */
+class ShmChannel
+{
+public:
+	ShmChannel(const std::function<bool()>& isPeerAlive, const std::function<void()>& onClosed);
+	~ShmChannel();
+
+	/// The writer waits for the peer to read the messages if "flowControl" is set, otherwise it overwrites them.
+	void setOutgoing(const ShmRing& ring, bool flowControl, const std::shared_ptr<ghost::WriterSink>& sink);
+	/// The reader maintains the read position of the ring for the writer if "singleConsumer" is set.
+	void setIncoming(const ShmRing& ring, bool singleConsumer, const std::shared_ptr<ghost::ReaderSink>& sink);
+
+	void start();
+	/// Closes the channel: the outgoing ring is closed and the sinks are drained. Returns false if it was closed.
+	/// A channel cannot be started again once closed.
+	bool close();
+	bool isOpen() const;
+	/// Returns true once the channel was closed and its threads do not access the rings anymore.
+	bool isClosed() const;
+
+	/// Returns the number of times messages of the incoming ring were lost because they were overwritten.
+	uint64_t getLostCount() const;
+
+private:
+	/// Maximum number of messages taken from the writer sink at once.
+	static const size_t MAXIMUM_BATCH_SIZE = 64;
+	/// Period of the checks of the peer's state by the reader thread.
+	static constexpr std::chrono::milliseconds PEER_CHECK_PERIOD = std::chrono::milliseconds(100);
+
+	void writerThread();
+	void readerThread();
+	void join(std::thread& thread);
+
+	std::function<bool()> _isPeerAlive;
+	std::function<void()> _onClosed;
+
+	std::unique_ptr<ShmRing> _outgoing;
+	bool _flowControl;
+	std::shared_ptr<ghost::WriterSink> _writerSink;
+
+	std::unique_ptr<ShmRingReader> _incoming;
+	std::shared_ptr<ghost::ReaderSink> _readerSink;
+	std::atomic<uint64_t> _lostCount;
+
+	std::atomic_bool _open;
+	std::atomic_bool _closing;
+	std::atomic_bool _closed;
+	/// Guards the thread objects, which a thread closing the channel may read before start() assigned them.
+	std::mutex _threadsMutex;
+	std::thread _writerThread;
+	std::thread _readerThread;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_SHM_SHMCHANNEL_HPP
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ShmClientSlot.hpp"
+
+#include <unistd.h>
+
+#include <cstring>
+
+using namespace ghost::internal;
+
+namespace
+{
+const size_t SLOT_HEADER_SIZE = 64;
+static_assert(sizeof(ShmClientSlot::Header) <= SLOT_HEADER_SIZE, "slot header too large");
+} // namespace
+
+size_t ShmClientSlot::getSegmentSize(size_t ringCapacity, size_t slotCount)
+{
+	return SharedMemorySegment::HEADER_SIZE + slotCount * getSlotSize(ringCapacity);
+}
+
+size_t ShmClientSlot::getSlotSize(size_t ringCapacity)
+{
+	return SLOT_HEADER_SIZE + 2 * ShmRing::getSize(ringCapacity);
+}
+
+ShmClientSlot::ShmClientSlot(const std::shared_ptr<SharedMemorySegment>& segment, size_t index)
+    : _segment(segment), _ringCapacity(segment->getHeader()->ringCapacity)
+{
+	uint8_t* slot = segment->getAddress() + SharedMemorySegment::HEADER_SIZE + index * getSlotSize(_ringCapacity);
+	_header = reinterpret_cast<Header*>(slot);
+	_rings = slot + SLOT_HEADER_SIZE;
+}
+
+ShmClientSlot::Header* ShmClientSlot::getHeader() const
+{
+	return _header;
+}
+
+ShmClientSlot::State ShmClientSlot::getState() const
+{
+	return (State)_header->state.load();
+}
+
+void ShmClientSlot::setState(State state)
+{
+	_header->state = state;
+}
+
+bool ShmClientSlot::claim()
+{
+	uint32_t expected = FREE;
+	if (!_header->state.compare_exchange_strong(expected, CLAIMED)) return false;
+
+	_header->clientPid = getpid();
+	_header->clientAttached = 1;
+
+	size_t ringSize = ShmRing::getSize(_ringCapacity);
+	std::memset(_rings, 0, sizeof(ShmRingHeader));
+	std::memset(_rings + ringSize, 0, sizeof(ShmRingHeader));
+	ShmRing::initialize(_rings, _ringCapacity);
+	ShmRing::initialize(_rings + ringSize, _ringCapacity);
+
+	_header->state = CONNECTING;
+	SharedMemorySegment::notify(_segment->getHeader());
+	return true;
+}
+
+bool ShmClientSlot::cancel()
+{
+	uint32_t expected = CONNECTING;
+	if (!_header->state.compare_exchange_strong(expected, CLOSED)) return false;
+
+	detach();
+	return true;
+}
+
+void ShmClientSlot::detach()
+{
+	_header->clientAttached = 0;
+	SharedMemorySegment::notify(_segment->getHeader());
+}
+
+bool ShmClientSlot::accept()
+{
+	uint32_t expected = CONNECTING;
+	return _header->state.compare_exchange_strong(expected, CONNECTED);
+}
+
+void ShmClientSlot::release()
+{
+	_header->clientPid = 0;
+	_header->clientAttached = 0;
+	_header->state = FREE;
+}
+
+bool ShmClientSlot::isClientAlive() const
+{
+	// a client that is claiming the slot did not register its process yet
+	int32_t pid = _header->clientPid;
+	return pid == 0 || SharedMemorySegment::isProcessAlive(pid);
+}
+
+bool ShmClientSlot::isClientAttached() const
+{
+	return _header->clientAttached != 0;
+}
+
+ShmRing ShmClientSlot::getClientRing() const
+{
+	return ShmRing(_rings);
+}
+
+ShmRing ShmClientSlot::getServerRing() const
+{
+	return ShmRing(_rings + ShmRing::getSize(_ringCapacity));
+}
+
+const std::shared_ptr<SharedMemorySegment>& ShmClientSlot::getSegment() const
+{
+	return _segment;
+}
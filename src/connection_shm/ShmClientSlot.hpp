@@ -0,0 +1,98 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_SHM_SHMCLIENTSLOT_HPP
+#define GHOST_INTERNAL_SHM_SHMCLIENTSLOT_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "SharedMemorySegment.hpp"
+#include "ShmRing.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Place for one client connection in the segment of a server. A slot contains a ring for each direction.
+ *	Clients claim free slots, the server accepts them and frees the slots once both sides left.
+ */
+class ShmClientSlot
+{
+public:
+	enum State : uint32_t
+	{
+		FREE,
+		CLAIMED,
+		CONNECTING,
+		CONNECTED,
+		CLOSED
+	};
+
+	/// Beginning of the slot in the shared memory.
+	struct Header
+	{
+		std::atomic<uint32_t> state;
+		std::atomic<int32_t> clientPid;
+		/// Cleared by the client once it does not access the slot anymore.
+		std::atomic<uint32_t> clientAttached;
+	};
+
+	/// Returns the size of a server segment with "slotCount" slots.
+	static size_t getSegmentSize(size_t ringCapacity, size_t slotCount);
+
+	ShmClientSlot(const std::shared_ptr<SharedMemorySegment>& segment, size_t index);
+
+	Header* getHeader() const;
+	State getState() const;
+	void setState(State state);
+
+	/// Client side: takes the slot if it is free, initializes its rings and asks the server to accept it.
+	bool claim();
+	/// Client side: gives up a connection that the server did not accept yet. Returns false if it was accepted.
+	bool cancel();
+	/// Client side: signals that the client left the slot.
+	void detach();
+	/// Server side: marks a connecting client as connected. Returns false if the client gave up meanwhile.
+	bool accept();
+	/// Server side: makes a closed slot available for new clients.
+	void release();
+
+	bool isClientAlive() const;
+	bool isClientAttached() const;
+
+	/// Ring written by the client and read by the server.
+	ShmRing getClientRing() const;
+	/// Ring written by the server and read by the client.
+	ShmRing getServerRing() const;
+
+	const std::shared_ptr<SharedMemorySegment>& getSegment() const;
+
+private:
+	static size_t getSlotSize(size_t ringCapacity);
+
+	std::shared_ptr<SharedMemorySegment> _segment;
+	Header* _header;
+	uint8_t* _rings;
+	size_t _ringCapacity;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_SHM_SHMCLIENTSLOT_HPP
@@ -0,0 +1,235 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ShmRing.hpp"
+
+#include <cstring>
+#include <thread>
+
+#include "SharedMemorySegment.hpp"
+
+using namespace ghost::internal;
+
+namespace
+{
+// Records start with their length and are aligned on 8 bytes.
+const size_t RECORD_HEADER_SIZE = 8;
+// Length of the record telling the consumer to continue at the beginning of the data.
+const uint32_t WRAP_RECORD = 0xFFFFFFFF;
+// How long a consumer spins before sleeping on the futex.
+const std::chrono::microseconds SPIN_DURATION(50);
+
+size_t align(size_t size)
+{
+	return (size + 7) & ~size_t(7);
+}
+} // namespace
+
+size_t ShmRing::getCapacity(size_t capacity)
+{
+	return align(capacity);
+}
+
+size_t ShmRing::getSize(size_t capacity)
+{
+	return align(sizeof(ShmRingHeader)) + align(capacity);
+}
+
+void ShmRing::initialize(void* memory, size_t capacity)
+{
+	auto header = static_cast<ShmRingHeader*>(memory);
+	header->capacity = align(capacity);
+}
+
+ShmRing::ShmRing(void* memory)
+    : _header(static_cast<ShmRingHeader*>(memory))
+    , _data(static_cast<uint8_t*>(memory) + align(sizeof(ShmRingHeader)))
+{
+}
+
+size_t ShmRing::getMaximumMessageSize() const
+{
+	return _header->capacity / 2 - RECORD_HEADER_SIZE;
+}
+
+bool ShmRing::write(const google::protobuf::Any& message, const std::function<bool()>& canWait)
+{
+	size_t size = message.ByteSizeLong();
+	if (size > getMaximumMessageSize()) return false;
+
+	uint64_t capacity = _header->capacity;
+	uint64_t position = _header->writePosition.load(std::memory_order_relaxed);
+	uint64_t offset = position % capacity;
+	uint64_t recordSize = align(RECORD_HEADER_SIZE + size);
+	// records are contiguous: skip the end of the data if the record does not fit
+	uint64_t padding = offset + recordSize > capacity ? capacity - offset : 0;
+	uint64_t end = position + padding + recordSize;
+
+	if (canWait)
+	{
+		while (end - _header->readPosition.load(std::memory_order_acquire) > capacity)
+		{
+			if (!canWait()) return false;
+			std::this_thread::sleep_for(std::chrono::microseconds(20));
+		}
+	}
+
+	// announce the overwritten area before modifying it, see ShmRingReader::wasOverwritten()
+	_header->reservePosition.store(end, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	if (padding > 0)
+	{
+		std::memcpy(_data + offset, &WRAP_RECORD, sizeof(WRAP_RECORD));
+		offset = 0;
+	}
+
+	uint32_t length = size;
+	std::memcpy(_data + offset, &length, sizeof(length));
+	message.SerializeWithCachedSizesToArray(_data + offset + RECORD_HEADER_SIZE);
+
+	_header->writePosition.store(end, std::memory_order_release);
+	notify();
+	return true;
+}
+
+void ShmRing::close()
+{
+	_header->closed = 1;
+	notify();
+}
+
+bool ShmRing::isClosed() const
+{
+	return _header->closed != 0;
+}
+
+ShmRingHeader* ShmRing::getHeader() const
+{
+	return _header;
+}
+
+const uint8_t* ShmRing::getData() const
+{
+	return _data;
+}
+
+void ShmRing::notify()
+{
+	_header->notification.fetch_add(1);
+	if (_header->waiters.load() > 0) SharedMemorySegment::wake(_header->notification);
+}
+
+ShmRingReader::ShmRingReader(const ShmRing& ring, bool singleConsumer)
+    : _ring(ring), _singleConsumer(singleConsumer), _lostCount(0)
+{
+	// a single consumer continues where the previous one stopped
+	if (_singleConsumer)
+		_position = _ring.getHeader()->readPosition.load(std::memory_order_acquire);
+	else
+		_position = _ring.getHeader()->writePosition.load(std::memory_order_acquire);
+}
+
+ShmRingReader::Result ShmRingReader::read(google::protobuf::Any& message)
+{
+	auto header = _ring.getHeader();
+	uint64_t capacity = header->capacity;
+
+	while (true)
+	{
+		uint64_t writePosition = header->writePosition.load(std::memory_order_acquire);
+		if (_position == writePosition) return Result::EMPTY;
+
+		if (writePosition - _position > capacity)
+		{
+			skipToEnd();
+			return Result::LOST;
+		}
+
+		uint64_t offset = _position % capacity;
+		uint32_t length;
+		std::memcpy(&length, _ring.getData() + offset, sizeof(length));
+
+		if (length == WRAP_RECORD)
+		{
+			if (wasOverwritten())
+			{
+				skipToEnd();
+				return Result::LOST;
+			}
+			_position += capacity - offset;
+			continue;
+		}
+
+		bool parsed = length <= capacity - offset - RECORD_HEADER_SIZE &&
+			      message.ParseFromArray(_ring.getData() + offset + RECORD_HEADER_SIZE, length);
+		if (!parsed || wasOverwritten())
+		{
+			skipToEnd();
+			return Result::LOST;
+		}
+
+		_position += align(RECORD_HEADER_SIZE + length);
+		if (_singleConsumer) header->readPosition.store(_position, std::memory_order_release);
+		return Result::MESSAGE;
+	}
+}
+
+void ShmRingReader::wait(std::chrono::milliseconds timeout)
+{
+	auto header = _ring.getHeader();
+	auto hasData = [&] {
+		return header->writePosition.load(std::memory_order_acquire) != _position || header->closed;
+	};
+
+	auto spinEnd = std::chrono::steady_clock::now() + SPIN_DURATION;
+	while (std::chrono::steady_clock::now() < spinEnd)
+	{
+		if (hasData()) return;
+	}
+
+	header->waiters.fetch_add(1);
+	uint32_t notification = header->notification.load();
+	if (!hasData()) SharedMemorySegment::wait(header->notification, notification, timeout);
+	header->waiters.fetch_sub(1);
+}
+
+uint64_t ShmRingReader::getLostCount() const
+{
+	return _lostCount;
+}
+
+bool ShmRingReader::isClosed() const
+{
+	return _ring.isClosed();
+}
+
+bool ShmRingReader::wasOverwritten() const
+{
+	// pairs with the release fence of the writer: if any byte read was overwritten,
+	// the reservation that preceded it is visible
+	std::atomic_thread_fence(std::memory_order_acquire);
+	uint64_t reserved = _ring.getHeader()->reservePosition.load(std::memory_order_relaxed);
+	return reserved > _position + _ring.getHeader()->capacity;
+}
+
+void ShmRingReader::skipToEnd()
+{
+	_position = _ring.getHeader()->writePosition.load(std::memory_order_acquire);
+	if (_singleConsumer) _ring.getHeader()->readPosition.store(_position, std::memory_order_release);
+	++_lostCount;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_SHM_SHMRING_HPP
+#define GHOST_INTERNAL_SHM_SHMRING_HPP
+
+#include <google/protobuf/any.pb.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Header of a ring buffer placed in shared memory, followed by the data of the ring.
+ *	Positions are byte counters that never wrap: the offset in the data is the position modulo
+ *	the capacity.
+ */
+struct ShmRingHeader
+{
+	/// End of the record being written: the data before "reservePosition - capacity" may be overwritten.
+	std::atomic<uint64_t> reservePosition;
+	/// End of the last record that was completely written.
+	std::atomic<uint64_t> writePosition;
+	/// Position of the consumer, maintained only when the ring has a single consumer.
+	std::atomic<uint64_t> readPosition;
+	/// Futex word incremented by every write.
+	std::atomic<uint32_t> notification;
+	/// Number of consumers sleeping on "notification".
+	std::atomic<uint32_t> waiters;
+	std::atomic<uint32_t> closed;
+	uint32_t padding;
+	uint64_t capacity;
+};
+
+/**
+ *	Ring buffer of serialized google::protobuf::Any messages, written by one producer.
+ *	With several consumers, the producer never waits: consumers that are too slow lose
+ *	the messages that were overwritten and continue with the most recent ones.
+ *	With a single consumer, the producer can wait for the consumer to make room.
+ */
+class ShmRing
+{
+public:
+	/// Returns the capacity of a ring created with this requested capacity, i.e. rounded to a multiple of 8.
+	static size_t getCapacity(size_t capacity);
+	/// Returns the memory required by a ring of this capacity.
+	static size_t getSize(size_t capacity);
+	/// Initializes a ring in zero-filled memory of getSize(capacity) bytes.
+	static void initialize(void* memory, size_t capacity);
+
+	ShmRing(void* memory);
+
+	/// Messages larger than this size cannot be written.
+	size_t getMaximumMessageSize() const;
+
+	/**
+	 *	Writes the message into the ring. If "canWait" is set, the writer waits for the single consumer
+	 *	to make room as long as the function returns true. Otherwise, the oldest messages are overwritten.
+	 *	@return false if the message is too large or if there was no room for it.
+	 */
+	bool write(const google::protobuf::Any& message, const std::function<bool()>& canWait = nullptr);
+
+	/// Marks the ring as closed and wakes up the consumers.
+	void close();
+	bool isClosed() const;
+
+	ShmRingHeader* getHeader() const;
+	const uint8_t* getData() const;
+
+private:
+	void notify();
+
+	ShmRingHeader* _header;
+	uint8_t* _data;
+};
+
+/**
+ *	Consumer of a ghost::internal::ShmRing. With several consumers, only the messages written after the
+ *	creation of the reader are read. A single consumer reads all the messages it did not read yet.
+ */
+class ShmRingReader
+{
+public:
+	enum class Result
+	{
+		MESSAGE,
+		EMPTY,
+		/// Messages were overwritten before they could be read.
+		LOST
+	};
+
+	ShmRingReader(const ShmRing& ring, bool singleConsumer);
+
+	Result read(google::protobuf::Any& message);
+	/**
+	 *	Waits until a message is available or the ring is closed, for at most "timeout".
+	 *	The reader spins for a short time before sleeping, to keep the latency low under load.
+	 */
+	void wait(std::chrono::milliseconds timeout);
+	/// Returns the number of times messages were lost by this reader.
+	uint64_t getLostCount() const;
+	bool isClosed() const;
+
+private:
+	/// Returns true if the data at the current position may have been overwritten while it was read.
+	bool wasOverwritten() const;
+	void skipToEnd();
+
+	ShmRing _ring;
+	bool _singleConsumer;
+	uint64_t _position;
+	uint64_t _lostCount;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_SHM_SHMRING_HPP
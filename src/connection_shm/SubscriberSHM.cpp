@@ -0,0 +1,66 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "SubscriberSHM.hpp"
+
+using namespace ghost::internal;
+
+SubscriberSHM::SubscriberSHM(const ghost::ConnectionConfiguration& config)
+    : SubscriberSHM(ghost::ConnectionConfigurationSHM::initializeFrom(config))
+{
+}
+
+SubscriberSHM::SubscriberSHM(const ghost::ConnectionConfigurationSHM& config)
+    : ghost::Subscriber(config), _configuration(config)
+{
+}
+
+bool SubscriberSHM::start()
+{
+	if (_channel) return false;
+
+	auto segment = std::shared_ptr<SharedMemorySegment>(
+	    SharedMemorySegment::open(SharedMemorySegment::getName(_configuration)));
+	if (!segment || segment->getHeader()->slotCount != 0 ||
+	    !SharedMemorySegment::isOwnerAlive(segment->getHeader()))
+		return false;
+
+	_segment = segment;
+	auto header = segment->getHeader();
+	_channel.reset(new ShmChannel([header] { return SharedMemorySegment::isOwnerAlive(header); }, nullptr));
+	_channel->setIncoming(ShmRing(segment->getAddress() + SharedMemorySegment::HEADER_SIZE), false,
+			      getReaderSink());
+	_channel->start();
+	return true;
+}
+
+bool SubscriberSHM::stop()
+{
+	if (!_channel) return false;
+
+	return _channel->close();
+}
+
+bool SubscriberSHM::isRunning() const
+{
+	return _channel && _channel->isOpen();
+}
+
+uint64_t SubscriberSHM::getLostCount() const
+{
+	return _channel ? _channel->getLostCount() : 0;
+}
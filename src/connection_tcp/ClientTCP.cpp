@@ -0,0 +1,62 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ClientTCP.hpp"
+
+#include "TcpSocket.hpp"
+
+using namespace ghost::internal;
+
+const std::chrono::milliseconds ClientTCP::CONNECTION_TIMEOUT = std::chrono::milliseconds(1000);
+
+ClientTCP::ClientTCP(const ghost::ConnectionConfiguration& config)
+    : ClientTCP(ghost::ConnectionConfigurationTCP::initializeFrom(config))
+{
+}
+
+ClientTCP::ClientTCP(const ghost::ConnectionConfigurationTCP& config) : ghost::Client(config), _configuration(config)
+{
+}
+
+ClientTCP::~ClientTCP()
+{
+	stop();
+}
+
+bool ClientTCP::start()
+{
+	if (_connection) return false;
+
+	int fd = TcpSocket::connect(_configuration, CONNECTION_TIMEOUT);
+	if (fd < 0) return false;
+
+	auto& loop = EventLoopPool::getInstance(_configuration.getIOThreadCount()).next();
+	_connection = std::make_shared<TcpConnection>(fd, loop, getReaderSink(), getWriterSink());
+	return _connection->start();
+}
+
+bool ClientTCP::stop()
+{
+	if (!_connection) return false;
+
+	return _connection->close();
+}
+
+bool ClientTCP::isRunning() const
+{
+	return _connection && _connection->isOpen();
+}
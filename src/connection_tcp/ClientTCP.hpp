@@ -0,0 +1,56 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_TCP_CLIENTTCP_HPP
+#define GHOST_INTERNAL_TCP_CLIENTTCP_HPP
+
+#include <ghost/connection/Client.hpp>
+#include <ghost/connection_tcp/ConnectionConfigurationTCP.hpp>
+#include <memory>
+
+#include "TcpConnection.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Client connected to a server with a socket served by one of the I/O threads.
+ * The client stops when the server closes the connection, stops or dies.
+ */
+class ClientTCP : public ghost::Client
+{
+public:
+	ClientTCP(const ghost::ConnectionConfiguration& config);
+	ClientTCP(const ghost::ConnectionConfigurationTCP& config);
+	~ClientTCP();
+
+	bool start() override;
+	bool stop() override;
+	bool isRunning() const override;
+
+private:
+	/// How long a client waits for the connection to be established.
+	static const std::chrono::milliseconds CONNECTION_TIMEOUT;
+
+	ghost::ConnectionConfigurationTCP _configuration;
+	std::shared_ptr<TcpConnection> _connection;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_TCP_CLIENTTCP_HPP
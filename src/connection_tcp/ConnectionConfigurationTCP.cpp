@@ -0,0 +1,74 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <ghost/connection_tcp/ConnectionConfigurationTCP.hpp>
+
+using namespace ghost;
+
+namespace ghost
+{
+namespace internal
+{
+static std::string CONNECTIONCONFIGURATIONTCP_TECHNOLOGY = "CONNECTIONCONFIGURATIONTCP_TECHNOLOGY";
+static std::string CONNECTIONCONFIGURATIONTCP_IOTHREADCOUNT = "CONNECTIONCONFIGURATIONTCP_IOTHREADCOUNT";
+} // namespace internal
+} // namespace ghost
+
+ConnectionConfigurationTCP::ConnectionConfigurationTCP(const std::string& name) : NetworkConnectionConfiguration(name)
+{
+	ghost::ConfigurationValue techonologyAttribute;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONTCP_TECHNOLOGY, techonologyAttribute);
+
+	ghost::ConfigurationValue defaultIOThreadCount;
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONTCP_IOTHREADCOUNT, defaultIOThreadCount);
+}
+
+ConnectionConfigurationTCP::ConnectionConfigurationTCP(const std::string& ip, int port)
+    : ConnectionConfigurationTCP("")
+{
+	setServerIpAddress(ip);
+	setServerPortNumber(port);
+}
+
+size_t ConnectionConfigurationTCP::getIOThreadCount() const
+{
+	size_t res = 2;
+	ConfigurationValue value;
+	ConfigurationValue defaultValue;
+	defaultValue.write<size_t>(res);
+
+	_configuration->getAttribute(internal::CONNECTIONCONFIGURATIONTCP_IOTHREADCOUNT, value,
+				     defaultValue); // if the field was removed, returns 2
+	value.read<size_t>(res);
+
+	return res;
+}
+
+void ConnectionConfigurationTCP::setIOThreadCount(size_t count)
+{
+	ghost::ConfigurationValue value;
+	value.write<size_t>(count);
+	_configuration->addAttribute(internal::CONNECTIONCONFIGURATIONTCP_IOTHREADCOUNT, value,
+				     true); // checks if the attribute is there as well
+}
+
+ConnectionConfigurationTCP ConnectionConfigurationTCP::initializeFrom(const ConnectionConfiguration& from)
+{
+	ConnectionConfigurationTCP newconfig(from.getConfiguration()->getConfigurationName());
+	from.getConfiguration()->copy(*newconfig.getConfiguration());
+	return newconfig;
+}
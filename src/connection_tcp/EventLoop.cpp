@@ -0,0 +1,226 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "EventLoop.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <future>
+
+using namespace ghost::internal;
+
+namespace
+{
+/// Identifier of the eventfd of the loop in the epoll set.
+const uint64_t WAKE_UP_ID = 0;
+} // namespace
+
+EventLoop::EventLoop()
+    : _epollFd(epoll_create1(EPOLL_CLOEXEC))
+    , _wakeUpFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    , _running(false)
+    , _nextId(WAKE_UP_ID + 1)
+{
+	epoll_event event{};
+	event.events = EPOLLIN;
+	event.data.u64 = WAKE_UP_ID;
+	epoll_ctl(_epollFd, EPOLL_CTL_ADD, _wakeUpFd, &event);
+}
+
+EventLoop::~EventLoop()
+{
+	stop();
+	::close(_wakeUpFd);
+	::close(_epollFd);
+}
+
+bool EventLoop::start()
+{
+	if (_running || _epollFd < 0 || _wakeUpFd < 0) return false;
+
+	_running = true;
+	_thread = std::thread(&EventLoop::run, this);
+	return true;
+}
+
+void EventLoop::stop()
+{
+	if (!_running) return;
+
+	_running = false;
+	wakeUp();
+	if (_thread.joinable()) _thread.join();
+}
+
+bool EventLoop::add(int fd, uint32_t events, const std::shared_ptr<Handler>& handler, uint64_t& id)
+{
+	// the loop resolves the handlers under the same lock, after which the handler may read its id
+	std::lock_guard<std::mutex> lock(_mutex);
+	id = _nextId++;
+	_handlers[id] = handler;
+
+	epoll_event event{};
+	event.events = events;
+	event.data.u64 = id;
+	if (epoll_ctl(_epollFd, EPOLL_CTL_ADD, fd, &event) == 0) return true;
+
+	_handlers.erase(id);
+	id = 0;
+	return false;
+}
+
+bool EventLoop::modify(int fd, uint64_t id, uint32_t events)
+{
+	epoll_event event{};
+	event.events = events;
+	event.data.u64 = id;
+	return epoll_ctl(_epollFd, EPOLL_CTL_MOD, fd, &event) == 0;
+}
+
+void EventLoop::remove(int fd, uint64_t id)
+{
+	epoll_ctl(_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+
+	std::shared_ptr<Handler> handler; // released after the lock, in case it was the last reference
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _handlers.find(id);
+	if (it == _handlers.end()) return;
+
+	handler = std::move(it->second);
+	_handlers.erase(it);
+}
+
+void EventLoop::post(const std::function<void()>& task)
+{
+	bool wasEmpty;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		wasEmpty = _tasks.empty();
+		_tasks.push_back(task);
+	}
+
+	// the loop is already woken up if other tasks are pending
+	if (wasEmpty) wakeUp();
+}
+
+void EventLoop::runInLoop(const std::function<void()>& task)
+{
+	if (isInLoopThread() || !_running)
+	{
+		task();
+		return;
+	}
+
+	std::promise<void> done;
+	post([&] {
+		task();
+		done.set_value();
+	});
+	done.get_future().wait();
+}
+
+bool EventLoop::isInLoopThread() const
+{
+	return std::this_thread::get_id() == _thread.get_id();
+}
+
+void EventLoop::run()
+{
+	epoll_event events[MAXIMUM_EVENTS];
+	std::vector<std::shared_ptr<Handler>> handlers;
+
+	while (_running)
+	{
+		int count = epoll_wait(_epollFd, events, MAXIMUM_EVENTS, -1);
+		if (count < 0 && errno != EINTR) break;
+
+		// resolve the handlers first: a handler may remove the others
+		handlers.assign(count > 0 ? count : 0, nullptr);
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			for (int i = 0; i < count; ++i)
+			{
+				auto it = _handlers.find(events[i].data.u64);
+				if (it != _handlers.end()) handlers[i] = it->second;
+			}
+		}
+
+		for (int i = 0; i < count; ++i)
+		{
+			if (events[i].data.u64 == WAKE_UP_ID)
+			{
+				uint64_t value;
+				while (::read(_wakeUpFd, &value, sizeof(value)) > 0)
+					;
+				runTasks();
+			}
+			else if (handlers[i])
+				handlers[i]->onEvents(events[i].events);
+		}
+		handlers.clear();
+	}
+
+	runTasks();
+}
+
+void EventLoop::wakeUp()
+{
+	uint64_t value = 1;
+	ssize_t written = ::write(_wakeUpFd, &value, sizeof(value));
+	(void)written; // the counter is saturated if it failed, in which case the loop is woken up anyway
+}
+
+void EventLoop::runTasks()
+{
+	std::vector<std::function<void()>> tasks;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		tasks.swap(_tasks);
+	}
+
+	for (auto& task : tasks) task();
+}
+
+EventLoopPool& EventLoopPool::getInstance(size_t threadCount)
+{
+	// never deleted: connections may be released by static destructors after the loops would be gone
+	static EventLoopPool* instance = new EventLoopPool(threadCount);
+	return *instance;
+}
+
+EventLoopPool::EventLoopPool(size_t threadCount) : _next(0)
+{
+	for (size_t i = 0; i < std::max<size_t>(threadCount, 1); ++i)
+	{
+		_loops.emplace_back(new EventLoop());
+		_loops.back()->start();
+	}
+}
+
+EventLoop& EventLoopPool::next()
+{
+	return *_loops[_next++ % _loops.size()];
+}
+
+size_t EventLoopPool::size() const
+{
+	return _loops.size();
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_TCP_EVENTLOOP_HPP
+#define GHOST_INTERNAL_TCP_EVENTLOOP_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Thread waiting for the events of many file descriptors with epoll and executing their handlers.
+ *	Tasks can be posted to the loop from any thread: they are executed by the thread of the loop,
+ *	which serializes them with the handlers.
+ */
+class EventLoop
+{
+public:
+	/// Reacts to the events of a file descriptor. Called by the thread of the loop.
+	class Handler
+	{
+	public:
+		virtual ~Handler() = default;
+		virtual void onEvents(uint32_t events) = 0;
+	};
+
+	EventLoop();
+	~EventLoop();
+
+	bool start();
+	void stop();
+
+	/**
+	 *	Registers the file descriptor and its handler, which is kept alive until the descriptor is removed.
+	 *	The identifier of the registration is written to id before the first event can reach the handler.
+	 *	@return false if the descriptor could not be registered.
+	 */
+	bool add(int fd, uint32_t events, const std::shared_ptr<Handler>& handler, uint64_t& id);
+	bool modify(int fd, uint64_t id, uint32_t events);
+	void remove(int fd, uint64_t id);
+
+	void post(const std::function<void()>& task);
+	/// Executes the task in the thread of the loop and waits for its completion.
+	void runInLoop(const std::function<void()>& task);
+	bool isInLoopThread() const;
+
+private:
+	static const int MAXIMUM_EVENTS = 64;
+
+	void run();
+	void wakeUp();
+	void runTasks();
+
+	int _epollFd;
+	int _wakeUpFd;
+	std::atomic_bool _running;
+	std::thread _thread;
+
+	std::mutex _mutex;
+	uint64_t _nextId;
+	std::unordered_map<uint64_t, std::shared_ptr<Handler>> _handlers;
+	std::vector<std::function<void()>> _tasks;
+};
+
+/**
+ *	Fixed set of event loops shared by all the TCP connections of the process.
+ *	The loops are created with the first connection and never stopped.
+ */
+class EventLoopPool
+{
+public:
+	/// Returns the pool, which is created with "threadCount" loops by the first call.
+	static EventLoopPool& getInstance(size_t threadCount);
+
+	/// Returns the next loop to use for a new connection.
+	EventLoop& next();
+	size_t size() const;
+
+private:
+	EventLoopPool(size_t threadCount);
+
+	std::vector<std::unique_ptr<EventLoop>> _loops;
+	std::atomic<size_t> _next;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_TCP_EVENTLOOP_HPP
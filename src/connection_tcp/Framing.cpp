@@ -0,0 +1,107 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "Framing.hpp"
+
+using namespace ghost::internal;
+
+const size_t Framing::MAXIMUM_FRAME_SIZE;
+const size_t Framing::MAXIMUM_HEADER_SIZE;
+
+std::shared_ptr<const std::string> Framing::encode(const google::protobuf::Any& message)
+{
+	size_t messageSize = message.ByteSizeLong();
+
+	uint8_t header[MAXIMUM_HEADER_SIZE];
+	size_t headerSize = encodeVarint(messageSize, header);
+
+	auto frame = std::make_shared<std::string>(headerSize + messageSize, '\0');
+	uint8_t* data = reinterpret_cast<uint8_t*>(&(*frame)[0]);
+	std::copy(header, header + headerSize, data);
+	message.SerializeWithCachedSizesToArray(data + headerSize);
+	return frame;
+}
+
+size_t Framing::encodeVarint(uint64_t value, uint8_t* buffer)
+{
+	size_t size = 0;
+	while (value >= 0x80)
+	{
+		buffer[size++] = static_cast<uint8_t>(value | 0x80);
+		value >>= 7;
+	}
+	buffer[size++] = static_cast<uint8_t>(value);
+	return size;
+}
+
+int Framing::decodeVarint(const uint8_t* buffer, size_t size, uint64_t& value)
+{
+	value = 0;
+	for (size_t i = 0; i < size; ++i)
+	{
+		if (i == MAXIMUM_HEADER_SIZE) return -1;
+
+		value |= static_cast<uint64_t>(buffer[i] & 0x7F) << (7 * i);
+		if ((buffer[i] & 0x80) == 0) return static_cast<int>(i + 1);
+	}
+	return size < MAXIMUM_HEADER_SIZE ? 0 : -1;
+}
+
+FrameDecoder::FrameDecoder(size_t maximumFrameSize) : _maximumFrameSize(maximumFrameSize)
+{
+}
+
+bool FrameDecoder::feed(const uint8_t* data, size_t size, const Consumer& consumer)
+{
+	if (_buffer.empty())
+	{
+		// most reads contain complete frames: decode them directly from the data
+		long consumed = consume(data, size, consumer);
+		if (consumed < 0) return false;
+
+		_buffer.assign(reinterpret_cast<const char*>(data) + consumed, size - consumed);
+		return true;
+	}
+
+	_buffer.append(reinterpret_cast<const char*>(data), size);
+	long consumed = consume(reinterpret_cast<const uint8_t*>(_buffer.data()), _buffer.size(), consumer);
+	if (consumed < 0) return false;
+
+	_buffer.erase(0, consumed);
+	return true;
+}
+
+size_t FrameDecoder::getBufferedSize() const
+{
+	return _buffer.size();
+}
+
+long FrameDecoder::consume(const uint8_t* data, size_t size, const Consumer& consumer)
+{
+	size_t position = 0;
+	while (position < size)
+	{
+		uint64_t frameSize;
+		int headerSize = Framing::decodeVarint(data + position, size - position, frameSize);
+		if (headerSize < 0 || frameSize > _maximumFrameSize) return -1;
+		if (headerSize == 0 || size - position - headerSize < frameSize) break; // incomplete frame
+
+		consumer(data + position + headerSize, frameSize);
+		position += headerSize + frameSize;
+	}
+	return static_cast<long>(position);
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_TCP_FRAMING_HPP
+#define GHOST_INTERNAL_TCP_FRAMING_HPP
+
+#include <google/protobuf/any.pb.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Frames exchanged by TCP connections: the size of the serialized google::protobuf::Any message
+ *	encoded as a varint, followed by the serialized message.
+ */
+class Framing
+{
+public:
+	/// Frames larger than this size are refused by the decoder, which protects it against corrupted streams.
+	static const size_t MAXIMUM_FRAME_SIZE = 64 * 1024 * 1024;
+	/// Maximum number of bytes of an encoded frame size.
+	static const size_t MAXIMUM_HEADER_SIZE = 10;
+
+	/// Serializes the message into a new frame. The frame is shared by all the connections sending it.
+	static std::shared_ptr<const std::string> encode(const google::protobuf::Any& message);
+
+	/// Writes "value" as a varint into "buffer", which must hold MAXIMUM_HEADER_SIZE bytes.
+	/// Returns the number of bytes written.
+	static size_t encodeVarint(uint64_t value, uint8_t* buffer);
+	/**
+	 *	Reads a varint from "buffer".
+	 *	@return the number of bytes read, 0 if more bytes are required, or -1 if the varint is invalid.
+	 */
+	static int decodeVarint(const uint8_t* buffer, size_t size, uint64_t& value);
+};
+
+/**
+ *	Splits a stream of bytes into frames. Complete frames contained in the data are passed to the
+ *	consumer without being copied, the incomplete ones are kept until the rest of the data arrives.
+ */
+class FrameDecoder
+{
+public:
+	/// Receives the payload of a frame, i.e. a serialized message.
+	using Consumer = std::function<void(const uint8_t* payload, size_t size)>;
+
+	FrameDecoder(size_t maximumFrameSize = Framing::MAXIMUM_FRAME_SIZE);
+
+	/// Decodes the data. Returns false if the stream contains an invalid or too large frame.
+	bool feed(const uint8_t* data, size_t size, const Consumer& consumer);
+
+	/// Returns the number of bytes kept until their frame is complete.
+	size_t getBufferedSize() const;
+
+private:
+	/// Passes the complete frames of the data to the consumer and returns the number of bytes consumed or -1.
+	long consume(const uint8_t* data, size_t size, const Consumer& consumer);
+
+	size_t _maximumFrameSize;
+	std::string _buffer;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_TCP_FRAMING_HPP
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PublisherTCP.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "../connection/WriterSink.hpp"
+#include "Framing.hpp"
+#include "TcpSocket.hpp"
+
+using namespace ghost::internal;
+
+const size_t PublisherTCP::Broadcaster::MAXIMUM_BATCH_SIZE;
+const size_t PublisherTCP::Broadcaster::MAXIMUM_ROUNDS;
+
+PublisherTCP::PublisherTCP(const ghost::ConnectionConfiguration& config)
+    : PublisherTCP(ghost::ConnectionConfigurationTCP::initializeFrom(config))
+{
+}
+
+PublisherTCP::PublisherTCP(const ghost::ConnectionConfigurationTCP& config)
+    : ghost::Publisher(config), _configuration(config), _running(false)
+{
+}
+
+PublisherTCP::~PublisherTCP()
+{
+	stop();
+}
+
+bool PublisherTCP::start()
+{
+	if (_running) return false;
+
+	int fd = TcpSocket::listen(_configuration);
+	if (fd < 0) return false;
+
+	auto& pool = EventLoopPool::getInstance(_configuration.getIOThreadCount());
+	auto broadcaster = std::make_shared<Broadcaster>(getWriterSink(), pool.next());
+	auto& acceptorLoop = pool.next();
+	auto onAccepted = [broadcaster, &pool](int subscriber) {
+		auto connection = std::make_shared<TcpConnection>(subscriber, pool.next(), nullptr, nullptr);
+		if (connection->start()) broadcaster->addSubscriber(connection);
+	};
+	_acceptor = std::make_shared<TcpAcceptor>(fd, _configuration, acceptorLoop, onAccepted);
+	if (!_acceptor->start()) return false;
+
+	_broadcaster = broadcaster;
+	_broadcaster->start();
+	_running = true;
+	return true;
+}
+
+bool PublisherTCP::stop()
+{
+	if (!_running.exchange(false)) return false;
+
+	// Refuse new subscribers, then disconnect the connected ones
+	_acceptor->close();
+	_broadcaster->stop();
+	getWriterSink()->drain();
+	return true;
+}
+
+bool PublisherTCP::isRunning() const
+{
+	return _running;
+}
+
+size_t PublisherTCP::countSubscribers() const
+{
+	return _broadcaster ? _broadcaster->countSubscribers() : 0;
+}
+
+PublisherTCP::Broadcaster::Broadcaster(const std::shared_ptr<ghost::WriterSink>& writerSink, EventLoop& loop)
+    : _writerSink(writerSink), _loop(loop), _scheduled(false), _stopped(false)
+{
+}
+
+void PublisherTCP::Broadcaster::start()
+{
+	std::weak_ptr<Broadcaster> self = shared_from_this();
+	std::static_pointer_cast<ghost::internal::WriterSink>(_writerSink)->setMessagesAvailableCallback([self] {
+		auto broadcaster = self.lock();
+		if (broadcaster) broadcaster->schedule();
+	});
+	schedule(); // sends the messages written before the start
+}
+
+void PublisherTCP::Broadcaster::stop()
+{
+	std::static_pointer_cast<ghost::internal::WriterSink>(_writerSink)->setMessagesAvailableCallback(nullptr);
+
+	auto self = shared_from_this();
+	_loop.runInLoop([self] { self->_stopped = true; });
+
+	std::list<std::shared_ptr<TcpConnection>> subscribers;
+	{
+		std::lock_guard<std::mutex> lock(_subscribersMutex);
+		subscribers.swap(_subscribers);
+	}
+
+	for (const auto& subscriber : subscribers) subscriber->close();
+}
+
+void PublisherTCP::Broadcaster::addSubscriber(const std::shared_ptr<TcpConnection>& subscriber)
+{
+	std::lock_guard<std::mutex> lock(_subscribersMutex);
+	// forget the subscribers that disconnected
+	_subscribers.remove_if([](const std::shared_ptr<TcpConnection>& s) { return !s->isOpen(); });
+	_subscribers.push_back(subscriber);
+}
+
+size_t PublisherTCP::Broadcaster::countSubscribers() const
+{
+	std::lock_guard<std::mutex> lock(_subscribersMutex);
+	return std::count_if(_subscribers.begin(), _subscribers.end(),
+			     [](const std::shared_ptr<TcpConnection>& s) { return s->isOpen(); });
+}
+
+void PublisherTCP::Broadcaster::schedule()
+{
+	if (_scheduled.exchange(true)) return;
+
+	auto self = shared_from_this();
+	_loop.post([self] { self->broadcast(); });
+}
+
+void PublisherTCP::Broadcaster::broadcast()
+{
+	_scheduled = false;
+
+	std::vector<google::protobuf::Any> messages;
+	std::vector<std::shared_ptr<TcpConnection>> subscribers;
+	for (size_t round = 0; round < MAXIMUM_ROUNDS; ++round)
+	{
+		if (_stopped) return;
+
+		messages.clear();
+		if (_writerSink->getBatch(messages, MAXIMUM_BATCH_SIZE, std::chrono::milliseconds(0)) == 0) return;
+
+		{
+			std::lock_guard<std::mutex> lock(_subscribersMutex);
+			subscribers.assign(_subscribers.begin(), _subscribers.end());
+		}
+
+		for (const auto& message : messages)
+		{
+			// the frame is serialized once and shared by all the subscribers
+			auto frame = Framing::encode(message);
+			for (const auto& subscriber : subscribers) subscriber->send(frame);
+
+			_writerSink->pop();
+		}
+	}
+
+	// continue later to let the other connections of the loop progress
+	schedule();
+}
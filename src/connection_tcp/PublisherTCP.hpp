@@ -0,0 +1,96 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_TCP_PUBLISHERTCP_HPP
+#define GHOST_INTERNAL_TCP_PUBLISHERTCP_HPP
+
+#include <atomic>
+#include <ghost/connection/Publisher.hpp>
+#include <ghost/connection_tcp/ConnectionConfigurationTCP.hpp>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "TcpAcceptor.hpp"
+#include "TcpConnection.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Publisher listening on a socket for subscribers. Every message is serialized once, and the same
+ * frame is queued on the connections of all the subscribers.
+ * A subscriber that is too slow loses the messages that do not fit in its queue, without slowing
+ * down the others.
+ */
+class PublisherTCP : public ghost::Publisher
+{
+public:
+	PublisherTCP(const ghost::ConnectionConfiguration& config);
+	PublisherTCP(const ghost::ConnectionConfigurationTCP& config);
+	~PublisherTCP();
+
+	bool start() override;
+	bool stop() override;
+	bool isRunning() const override;
+
+	/// Returns the number of connected subscribers.
+	size_t countSubscribers() const;
+
+private:
+	/// Sends the messages of the writer sink to the subscribers, in an event loop.
+	class Broadcaster : public std::enable_shared_from_this<Broadcaster>
+	{
+	public:
+		Broadcaster(const std::shared_ptr<ghost::WriterSink>& writerSink, EventLoop& loop);
+
+		void start();
+		/// Closes the connections of the subscribers.
+		/// The writer sink is not read anymore once this method returns.
+		void stop();
+
+		void addSubscriber(const std::shared_ptr<TcpConnection>& subscriber);
+		size_t countSubscribers() const;
+
+	private:
+		/// Maximum number of messages taken from the writer sink at once.
+		static const size_t MAXIMUM_BATCH_SIZE = 64;
+		/// Maximum number of batches sent per execution, to let the other connections of the loop progress.
+		static const size_t MAXIMUM_ROUNDS = 16;
+
+		void schedule();
+		void broadcast();
+
+		std::shared_ptr<ghost::WriterSink> _writerSink;
+		EventLoop& _loop;
+		std::atomic_bool _scheduled;
+		bool _stopped;
+
+		mutable std::mutex _subscribersMutex;
+		std::list<std::shared_ptr<TcpConnection>> _subscribers;
+	};
+
+	ghost::ConnectionConfigurationTCP _configuration;
+	std::atomic<bool> _running;
+	std::shared_ptr<TcpAcceptor> _acceptor;
+	std::shared_ptr<Broadcaster> _broadcaster;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_TCP_PUBLISHERTCP_HPP
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "RemoteClientTCP.hpp"
+
+#include "ServerTCP.hpp"
+
+using namespace ghost::internal;
+
+RemoteClientTCP::RemoteClientTCP(const ghost::ConnectionConfiguration& configuration, int fd, EventLoop& loop,
+				 ServerTCP* parentServer)
+    : ghost::Client(configuration)
+    , _connection(std::make_shared<TcpConnection>(fd, loop, getReaderSink(), getWriterSink()))
+    , _running(false)
+    , _parentServer(parentServer)
+{
+}
+
+RemoteClientTCP::~RemoteClientTCP()
+{
+	stop();
+
+	if (!_executor.joinable()) return;
+
+	if (_executor.get_id() == std::this_thread::get_id())
+		_executor.detach();
+	else
+		_executor.join();
+}
+
+void RemoteClientTCP::join()
+{
+	if (_executor.joinable() && _executor.get_id() != std::this_thread::get_id()) _executor.join();
+}
+
+bool RemoteClientTCP::start()
+{
+	return false; // it is supposed to be already started by the server
+}
+
+bool RemoteClientTCP::stop()
+{
+	return _connection->close();
+}
+
+bool RemoteClientTCP::isRunning() const
+{
+	return _connection->isOpen() || _running;
+}
+
+void RemoteClientTCP::execute()
+{
+	_running = true;
+
+	_executor = std::thread([this] {
+		std::shared_ptr<ghost::Client> self = shared_from_this();
+
+		if (_parentServer->getClientHandler()) _parentServer->getClientHandler()->configureClient(self);
+
+		// messages are read once the client is configured
+		_connection->start();
+
+		// call the application code
+		bool continueExecution = true;
+		bool keepClientAlive = false;
+
+		if (_parentServer->getClientHandler())
+			continueExecution = _parentServer->getClientHandler()->handle(self, keepClientAlive);
+
+		// only stop the client if the user left "keepClientAlive" to false
+		if (!keepClientAlive) stop();
+
+		// if continueExecution is false, stop the server
+		if (!continueExecution) _parentServer->stop();
+
+		_running = false;
+		// the server may have released this object meanwhile, in which case it is deleted here
+		self.reset();
+	});
+}
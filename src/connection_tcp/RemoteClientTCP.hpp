@@ -0,0 +1,63 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_TCP_REMOTECLIENTTCP_HPP
+#define GHOST_INTERNAL_TCP_REMOTECLIENTTCP_HPP
+
+#include <atomic>
+#include <ghost/connection/Client.hpp>
+#include <memory>
+#include <thread>
+
+#include "TcpConnection.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+class ServerTCP;
+
+/**
+ * Server side of a connection accepted by a ghost::internal::ServerTCP. The client handler of the
+ * server is executed in a dedicated thread, while the messages are exchanged by an I/O thread.
+ */
+class RemoteClientTCP : public ghost::Client, public std::enable_shared_from_this<RemoteClientTCP>
+{
+public:
+	RemoteClientTCP(const ghost::ConnectionConfiguration& configuration, int fd, EventLoop& loop,
+			ServerTCP* parentServer);
+	~RemoteClientTCP();
+
+	bool start() override;
+	bool stop() override;
+	bool isRunning() const override;
+
+	void execute();
+	/// Waits for the end of the client handler, unless it is called by the client handler itself.
+	void join();
+
+private:
+	std::shared_ptr<TcpConnection> _connection;
+	std::atomic_bool _running;
+	std::thread _executor;
+
+	ServerTCP* _parentServer;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_TCP_REMOTECLIENTTCP_HPP
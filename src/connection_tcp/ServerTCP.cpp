@@ -0,0 +1,109 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ServerTCP.hpp"
+
+#include "TcpSocket.hpp"
+
+using namespace ghost::internal;
+
+ServerTCP::ServerTCP(const ghost::ConnectionConfiguration& config)
+    : ServerTCP(ghost::ConnectionConfigurationTCP::initializeFrom(config))
+{
+}
+
+ServerTCP::ServerTCP(const ghost::ConnectionConfigurationTCP& config) : _configuration(config), _running(false)
+{
+}
+
+ServerTCP::~ServerTCP()
+{
+	stop();
+
+	// the threads executing the client handler reference their client and this server until they return:
+	// join them outside of the lock, which the handler takes when it stops the server
+	std::list<std::shared_ptr<RemoteClientTCP>> clients;
+	{
+		std::lock_guard<std::mutex> lock(_clientsMutex);
+		clients.swap(_clients);
+	}
+	for (const auto& client : clients) client->join();
+}
+
+bool ServerTCP::start()
+{
+	if (_running) return false;
+
+	int fd = TcpSocket::listen(_configuration);
+	if (fd < 0) return false;
+
+	auto& loop = EventLoopPool::getInstance(_configuration.getIOThreadCount()).next();
+	_acceptor =
+	    std::make_shared<TcpAcceptor>(fd, _configuration, loop, [this](int client) { onClientConnected(client); });
+	if (!_acceptor->start()) return false;
+
+	_running = true;
+	return true;
+}
+
+bool ServerTCP::stop()
+{
+	if (!_running.exchange(false)) return false;
+
+	// Refuse new clients, then stop the connected ones
+	_acceptor->close();
+
+	std::list<std::shared_ptr<RemoteClientTCP>> clients;
+	{
+		std::lock_guard<std::mutex> lock(_clientsMutex);
+		clients = _clients;
+	}
+
+	for (const auto& client : clients) client->stop();
+
+	return true;
+}
+
+bool ServerTCP::isRunning() const
+{
+	return _running;
+}
+
+void ServerTCP::setClientHandler(std::shared_ptr<ghost::ClientHandler> handler)
+{
+	_clientHandler = handler;
+}
+
+const std::shared_ptr<ghost::ClientHandler> ServerTCP::getClientHandler() const
+{
+	return _clientHandler;
+}
+
+void ServerTCP::onClientConnected(int fd)
+{
+	auto& loop = EventLoopPool::getInstance(_configuration.getIOThreadCount()).next();
+	auto client = std::make_shared<RemoteClientTCP>(_configuration, fd, loop, this);
+	{
+		std::lock_guard<std::mutex> lock(_clientsMutex);
+		// delete the clients that finished their execution
+		_clients.remove_if([](const std::shared_ptr<RemoteClientTCP>& c) { return !c->isRunning(); });
+		_clients.push_back(client);
+	}
+
+	// Execute the application's code in a separate thread
+	client->execute();
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_TCP_SERVERTCP_HPP
+#define GHOST_INTERNAL_TCP_SERVERTCP_HPP
+
+#include <atomic>
+#include <ghost/connection/Server.hpp>
+#include <ghost/connection_tcp/ConnectionConfigurationTCP.hpp>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "RemoteClientTCP.hpp"
+#include "TcpAcceptor.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Server listening on a socket. The accepted connections are distributed over the I/O threads.
+ */
+class ServerTCP : public ghost::Server
+{
+public:
+	ServerTCP(const ghost::ConnectionConfiguration& config);
+	ServerTCP(const ghost::ConnectionConfigurationTCP& config);
+	~ServerTCP();
+
+	bool start() override;
+	bool stop() override;
+	bool isRunning() const override;
+
+	void setClientHandler(std::shared_ptr<ClientHandler> handler) override;
+	const std::shared_ptr<ClientHandler> getClientHandler() const;
+
+private:
+	void onClientConnected(int fd);
+
+	ghost::ConnectionConfigurationTCP _configuration;
+	std::atomic<bool> _running;
+	std::shared_ptr<TcpAcceptor> _acceptor;
+
+	std::mutex _clientsMutex;
+	std::list<std::shared_ptr<RemoteClientTCP>> _clients;
+	std::shared_ptr<ClientHandler> _clientHandler;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_TCP_SERVERTCP_HPP
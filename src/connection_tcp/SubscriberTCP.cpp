@@ -0,0 +1,63 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "SubscriberTCP.hpp"
+
+#include "TcpSocket.hpp"
+
+using namespace ghost::internal;
+
+const std::chrono::milliseconds SubscriberTCP::CONNECTION_TIMEOUT = std::chrono::milliseconds(1000);
+
+SubscriberTCP::SubscriberTCP(const ghost::ConnectionConfiguration& config)
+    : SubscriberTCP(ghost::ConnectionConfigurationTCP::initializeFrom(config))
+{
+}
+
+SubscriberTCP::SubscriberTCP(const ghost::ConnectionConfigurationTCP& config)
+    : ghost::Subscriber(config), _configuration(config)
+{
+}
+
+SubscriberTCP::~SubscriberTCP()
+{
+	stop();
+}
+
+bool SubscriberTCP::start()
+{
+	if (_connection) return false;
+
+	int fd = TcpSocket::connect(_configuration, CONNECTION_TIMEOUT);
+	if (fd < 0) return false;
+
+	auto& loop = EventLoopPool::getInstance(_configuration.getIOThreadCount()).next();
+	_connection = std::make_shared<TcpConnection>(fd, loop, getReaderSink(), nullptr);
+	return _connection->start();
+}
+
+bool SubscriberTCP::stop()
+{
+	if (!_connection) return false;
+
+	return _connection->close();
+}
+
+bool SubscriberTCP::isRunning() const
+{
+	return _connection && _connection->isOpen();
+}
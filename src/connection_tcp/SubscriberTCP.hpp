@@ -0,0 +1,56 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_TCP_SUBSCRIBERTCP_HPP
+#define GHOST_INTERNAL_TCP_SUBSCRIBERTCP_HPP
+
+#include <ghost/connection/Subscriber.hpp>
+#include <ghost/connection_tcp/ConnectionConfigurationTCP.hpp>
+#include <memory>
+
+#include "TcpConnection.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ * Subscriber connected to a publisher with a socket served by one of the I/O threads.
+ * It stops when the publisher stops or dies.
+ */
+class SubscriberTCP : public ghost::Subscriber
+{
+public:
+	SubscriberTCP(const ghost::ConnectionConfiguration& config);
+	SubscriberTCP(const ghost::ConnectionConfigurationTCP& config);
+	~SubscriberTCP();
+
+	bool start() override;
+	bool stop() override;
+	bool isRunning() const override;
+
+private:
+	/// How long a subscriber waits for the connection to be established.
+	static const std::chrono::milliseconds CONNECTION_TIMEOUT;
+
+	ghost::ConnectionConfigurationTCP _configuration;
+	std::shared_ptr<TcpConnection> _connection;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_TCP_SUBSCRIBERTCP_HPP
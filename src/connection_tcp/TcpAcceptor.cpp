@@ -0,0 +1,70 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "TcpAcceptor.hpp"
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+#include "TcpSocket.hpp"
+
+using namespace ghost::internal;
+
+TcpAcceptor::TcpAcceptor(int listeningFd, const ghost::NetworkConnectionConfiguration& configuration,
+			 EventLoop& loop, const Callback& onAccepted)
+    : _fd(listeningFd), _configuration(configuration), _loop(loop), _id(0), _onAccepted(onAccepted), _closed(false)
+{
+}
+
+bool TcpAcceptor::start()
+{
+	if (_loop.add(_fd, EPOLLIN, shared_from_this(), _id)) return true;
+
+	_closed = true;
+	TcpSocket::closeListening(_fd, _configuration);
+	return false;
+}
+
+void TcpAcceptor::close()
+{
+	auto self = shared_from_this();
+	_loop.runInLoop([self] { self->closeInLoop(); });
+}
+
+void TcpAcceptor::onEvents(uint32_t events)
+{
+	while (!_closed)
+	{
+		int fd = TcpSocket::accept(_fd);
+		if (fd >= 0)
+			_onAccepted(fd);
+		else if (errno != EINTR && errno != ECONNABORTED)
+			return; // no more pending connections, or no more descriptors available
+	}
+}
+
+void TcpAcceptor::closeInLoop()
+{
+	if (_closed) return;
+
+	_closed = true;
+	_loop.remove(_fd, _id);
+	TcpSocket::closeListening(_fd, _configuration);
+	_onAccepted = nullptr;
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_TCP_TCPACCEPTOR_HPP
+#define GHOST_INTERNAL_TCP_TCPACCEPTOR_HPP
+
+#include <functional>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <memory>
+
+#include "EventLoop.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Accepts the connections of a listening socket in an event loop and passes the new sockets
+ *	to a callback, which owns them afterwards.
+ */
+class TcpAcceptor : public EventLoop::Handler, public std::enable_shared_from_this<TcpAcceptor>
+{
+public:
+	using Callback = std::function<void(int fd)>;
+
+	/// Takes the ownership of the listening socket.
+	TcpAcceptor(int listeningFd, const ghost::NetworkConnectionConfiguration& configuration, EventLoop& loop,
+		    const Callback& onAccepted);
+
+	bool start();
+	/// Stops listening. The callback is not called anymore once this method returns.
+	void close();
+
+	void onEvents(uint32_t events) override;
+
+private:
+	void closeInLoop();
+
+	int _fd;
+	ghost::NetworkConnectionConfiguration _configuration;
+	EventLoop& _loop;
+	uint64_t _id;
+	Callback _onAccepted;
+	bool _closed;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_TCP_TCPACCEPTOR_HPP
@@ -0,0 +1,301 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "TcpConnection.hpp"
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <vector>
+
+#include "../connection/WriterSink.hpp"
+
+using namespace ghost::internal;
+
+const size_t TcpConnection::MAXIMUM_BATCH_SIZE;
+const size_t TcpConnection::MAXIMUM_PENDING_FRAMES;
+const size_t TcpConnection::MAXIMUM_ROUNDS;
+const size_t TcpConnection::READ_BUFFER_SIZE;
+
+TcpConnection::TcpConnection(int fd, EventLoop& loop, const std::shared_ptr<ghost::ReaderSink>& readerSink,
+			     const std::shared_ptr<ghost::WriterSink>& writerSink,
+			     const std::function<void()>& onClosed)
+    : _fd(fd)
+    , _loop(loop)
+    , _id(0)
+    , _readerSink(readerSink)
+    , _writerSink(writerSink)
+    , _onClosed(onClosed)
+    , _started(false)
+    , _open(false)
+    , _closeRequested(false)
+    , _closed(false)
+    , _flushScheduled(false)
+    , _writeInterest(false)
+    , _outgoingOffset(0)
+{
+}
+
+TcpConnection::~TcpConnection()
+{
+	// a started connection is referenced by its loop until it is closed
+	if (!_started) ::close(_fd);
+}
+
+bool TcpConnection::start()
+{
+	if (_started.exchange(true)) return false;
+
+	_open = true;
+	if (!_loop.add(_fd, EPOLLIN | EPOLLRDHUP, shared_from_this(), _id))
+	{
+		_open = false;
+		_closeRequested = true;
+		_closed = true;
+		::close(_fd);
+		return false;
+	}
+
+	if (_writerSink)
+	{
+		std::weak_ptr<TcpConnection> self = shared_from_this();
+		auto writerSink = std::static_pointer_cast<ghost::internal::WriterSink>(_writerSink);
+		writerSink->setMessagesAvailableCallback([self] {
+			auto connection = self.lock();
+			if (connection) connection->scheduleFlush();
+		});
+		scheduleFlush(); // sends the messages written before the start
+	}
+	return true;
+}
+
+bool TcpConnection::close()
+{
+	if (_closeRequested.exchange(true)) return false;
+
+	if (!_started)
+	{
+		_started = true;
+		::close(_fd);
+		return true;
+	}
+
+	auto self = shared_from_this();
+	_loop.runInLoop([self] { self->closeInLoop(); });
+	return true;
+}
+
+bool TcpConnection::isOpen() const
+{
+	return _open;
+}
+
+bool TcpConnection::send(const std::shared_ptr<const std::string>& frame)
+{
+	{
+		std::lock_guard<std::mutex> lock(_outgoingMutex);
+		if (!_open || _outgoing.size() >= MAXIMUM_PENDING_FRAMES) return false;
+
+		_outgoing.push_back(OutgoingFrame{frame, false});
+	}
+
+	scheduleFlush();
+	return true;
+}
+
+void TcpConnection::onEvents(uint32_t events)
+{
+	if (_closed) return;
+
+	if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) read();
+
+	if (!_closed && (events & EPOLLOUT)) flush();
+}
+
+void TcpConnection::scheduleFlush()
+{
+	// a single flush is pending at any time: it sends everything available when it executes
+	if (_flushScheduled.exchange(true)) return;
+
+	auto self = shared_from_this();
+	_loop.post([self] { self->flush(); });
+}
+
+void TcpConnection::flush()
+{
+	_flushScheduled = false;
+
+	for (size_t round = 0; round < MAXIMUM_ROUNDS; ++round)
+	{
+		if (_closed) return;
+
+		pullMessages();
+
+		size_t completed = 0;
+		WriteResult result = write(completed);
+		for (size_t i = 0; i < completed; ++i) _writerSink->pop();
+
+		if (result == WriteResult::FAILED) closeInLoop();
+		if (result != WriteResult::PENDING) return;
+	}
+
+	// continue later to let the other connections of the loop progress
+	scheduleFlush();
+}
+
+void TcpConnection::pullMessages()
+{
+	if (!_writerSink) return;
+
+	size_t room;
+	{
+		std::lock_guard<std::mutex> lock(_outgoingMutex);
+		if (_outgoing.size() >= MAXIMUM_BATCH_SIZE) return;
+
+		room = MAXIMUM_BATCH_SIZE - _outgoing.size();
+	}
+
+	std::vector<google::protobuf::Any> messages;
+	if (_writerSink->getBatch(messages, room, std::chrono::milliseconds(0)) == 0) return;
+
+	std::vector<OutgoingFrame> frames;
+	frames.reserve(messages.size());
+	for (const auto& message : messages) frames.push_back(OutgoingFrame{Framing::encode(message), true});
+
+	std::lock_guard<std::mutex> lock(_outgoingMutex);
+	_outgoing.insert(_outgoing.end(), frames.begin(), frames.end());
+}
+
+TcpConnection::WriteResult TcpConnection::write(size_t& completedFromSink)
+{
+	std::lock_guard<std::mutex> lock(_outgoingMutex);
+	if (_outgoing.empty())
+	{
+		setWriteInterest(false);
+		return WriteResult::EMPTY;
+	}
+
+	iovec buffers[MAXIMUM_BATCH_SIZE];
+	size_t count = 0;
+	for (auto it = _outgoing.begin(); it != _outgoing.end() && count < MAXIMUM_BATCH_SIZE; ++it, ++count)
+	{
+		size_t offset = count == 0 ? _outgoingOffset : 0;
+		buffers[count].iov_base = const_cast<char*>(it->data->data()) + offset;
+		buffers[count].iov_len = it->data->size() - offset;
+	}
+
+	msghdr header{};
+	header.msg_iov = buffers;
+	header.msg_iovlen = count;
+	ssize_t written = ::sendmsg(_fd, &header, MSG_NOSIGNAL);
+	if (written < 0)
+	{
+		if (errno == EINTR) return WriteResult::PENDING;
+		if (errno != EAGAIN && errno != EWOULDBLOCK) return WriteResult::FAILED;
+
+		// wait for the peer to read
+		setWriteInterest(true);
+		return WriteResult::BLOCKED;
+	}
+
+	size_t remaining = static_cast<size_t>(written);
+	while (!_outgoing.empty() && remaining > 0)
+	{
+		size_t frameRemaining = _outgoing.front().data->size() - _outgoingOffset;
+		if (remaining < frameRemaining)
+		{
+			_outgoingOffset += remaining;
+			break;
+		}
+
+		remaining -= frameRemaining;
+		if (_outgoing.front().fromSink) completedFromSink++;
+		_outgoing.pop_front();
+		_outgoingOffset = 0;
+	}
+
+	return WriteResult::PENDING;
+}
+
+void TcpConnection::read()
+{
+	uint8_t buffer[READ_BUFFER_SIZE];
+	bool valid = true;
+	auto consumer = [this, &valid](const uint8_t* payload, size_t size) {
+		google::protobuf::Any message;
+		if (!message.ParseFromArray(payload, static_cast<int>(size)))
+			valid = false;
+		else if (valid && _readerSink)
+			_readerSink->put(std::move(message));
+	};
+
+	for (size_t round = 0; round < MAXIMUM_ROUNDS; ++round)
+	{
+		ssize_t received = ::recv(_fd, buffer, sizeof(buffer), 0);
+		if (received < 0 && errno == EINTR) continue;
+		if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+
+		// the peer closed the connection, or it failed
+		if (received <= 0 || !_decoder.feed(buffer, static_cast<size_t>(received), consumer) || !valid)
+		{
+			closeInLoop();
+			return;
+		}
+
+		if (static_cast<size_t>(received) < sizeof(buffer)) return; // the socket is empty
+	}
+}
+
+void TcpConnection::setWriteInterest(bool enabled)
+{
+	if (_writeInterest == enabled) return;
+
+	_writeInterest = enabled;
+	uint32_t events = EPOLLIN | EPOLLRDHUP;
+	if (enabled) events |= EPOLLOUT;
+	_loop.modify(_fd, _id, events);
+}
+
+void TcpConnection::closeInLoop()
+{
+	if (_closed) return;
+
+	auto self = shared_from_this(); // the loop releases its reference below
+	_closed = true;
+	_closeRequested = true;
+	{
+		std::lock_guard<std::mutex> lock(_outgoingMutex);
+		_open = false;
+		_outgoing.clear();
+	}
+
+	_loop.remove(_fd, _id);
+	::close(_fd);
+
+	if (_writerSink)
+	{
+		auto writerSink = std::static_pointer_cast<ghost::internal::WriterSink>(_writerSink);
+		writerSink->setMessagesAvailableCallback(nullptr);
+		writerSink->drain();
+	}
+	if (_readerSink) _readerSink->drain();
+
+	if (_onClosed) _onClosed();
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_TCP_TCPCONNECTION_HPP
+#define GHOST_INTERNAL_TCP_TCPCONNECTION_HPP
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <ghost/connection/ReaderSink.hpp>
+#include <ghost/connection/WriterSink.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "EventLoop.hpp"
+#include "Framing.hpp"
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Exchanges the frames of a connected socket in an event loop.
+ *	The messages read are passed to the reader sink. When the writer sink signals new messages,
+ *	all the available messages are framed and sent together with a single system call; they are
+ *	completed once the socket accepted them completely.
+ *	The connection closes itself when the peer closes the socket or sends an invalid frame.
+ */
+class TcpConnection : public EventLoop::Handler, public std::enable_shared_from_this<TcpConnection>
+{
+public:
+	/// Takes the ownership of the socket. The sinks are optional.
+	TcpConnection(int fd, EventLoop& loop, const std::shared_ptr<ghost::ReaderSink>& readerSink,
+		      const std::shared_ptr<ghost::WriterSink>& writerSink,
+		      const std::function<void()>& onClosed = nullptr);
+	~TcpConnection();
+
+	bool start();
+	/// Closes the socket and drains the sinks. Returns false if it was closed.
+	/// A connection cannot be started again once closed.
+	bool close();
+	bool isOpen() const;
+
+	/**
+	 *	Sends a frame that is not taken from the writer sink, e.g. a frame shared by several connections.
+	 *	@return false if the connection is closed or if too many frames wait to be sent, in which case
+	 *	the frame is dropped.
+	 */
+	bool send(const std::shared_ptr<const std::string>& frame);
+
+	void onEvents(uint32_t events) override;
+
+private:
+	/// Maximum number of messages taken from the writer sink at once, and of frames passed to the socket at once.
+	static const size_t MAXIMUM_BATCH_SIZE = 64;
+	/// Maximum number of frames waiting to be sent, beyond which frames passed to send() are dropped.
+	static const size_t MAXIMUM_PENDING_FRAMES = 4096;
+	/// Maximum number of socket operations performed per event, to let the other connections of the loop progress.
+	static const size_t MAXIMUM_ROUNDS = 16;
+	static const size_t READ_BUFFER_SIZE = 64 * 1024;
+
+	struct OutgoingFrame
+	{
+		std::shared_ptr<const std::string> data;
+		/// The frame contains a message of the writer sink, which is completed once sent.
+		bool fromSink;
+	};
+
+	enum class WriteResult
+	{
+		EMPTY,
+		PENDING,
+		BLOCKED,
+		FAILED
+	};
+
+	void scheduleFlush();
+	void flush();
+	/// Takes the messages of the writer sink if there is room for them.
+	void pullMessages();
+	/// Writes the pending frames into the socket and returns the number of frames of the sink fully written.
+	WriteResult write(size_t& completedFromSink);
+	void read();
+	void setWriteInterest(bool enabled);
+	void closeInLoop();
+
+	int _fd;
+	EventLoop& _loop;
+	uint64_t _id;
+	std::shared_ptr<ghost::ReaderSink> _readerSink;
+	std::shared_ptr<ghost::WriterSink> _writerSink;
+	std::function<void()> _onClosed;
+
+	std::atomic_bool _started;
+	std::atomic_bool _open;
+	std::atomic_bool _closeRequested;
+	bool _closed;
+	std::atomic_bool _flushScheduled;
+	bool _writeInterest;
+
+	FrameDecoder _decoder;
+	std::mutex _outgoingMutex;
+	std::deque<OutgoingFrame> _outgoing;
+	/// Number of bytes of the first frame already written.
+	size_t _outgoingOffset;
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_TCP_TCPCONNECTION_HPP
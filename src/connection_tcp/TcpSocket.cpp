@@ -0,0 +1,170 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "TcpSocket.hpp"
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+using namespace ghost::internal;
+
+namespace
+{
+struct Address
+{
+	sockaddr_storage storage;
+	socklen_t length;
+};
+
+bool resolve(const ghost::NetworkConnectionConfiguration& config, bool passive, Address& address)
+{
+	std::memset(&address.storage, 0, sizeof(address.storage));
+
+	std::string path = config.getUnixSocketPath();
+	if (!path.empty())
+	{
+		auto unixAddress = reinterpret_cast<sockaddr_un*>(&address.storage);
+		if (path.size() >= sizeof(unixAddress->sun_path)) return false;
+
+		unixAddress->sun_family = AF_UNIX;
+		std::strncpy(unixAddress->sun_path, path.c_str(), sizeof(unixAddress->sun_path) - 1);
+		address.length = sizeof(sockaddr_un);
+		return true;
+	}
+
+	addrinfo hints{};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = AI_NUMERICSERV | (passive ? AI_PASSIVE : 0);
+
+	std::string ip = config.getServerIpAddress();
+	addrinfo* result = nullptr;
+	if (getaddrinfo(ip.empty() ? nullptr : ip.c_str(), std::to_string(config.getServerPortNumber()).c_str(),
+			&hints, &result) != 0)
+		return false;
+
+	std::memcpy(&address.storage, result->ai_addr, result->ai_addrlen);
+	address.length = result->ai_addrlen;
+	freeaddrinfo(result);
+	return true;
+}
+
+void configure(int fd)
+{
+	sockaddr_storage address;
+	socklen_t length = sizeof(address);
+	if (getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0 || address.ss_family == AF_UNIX)
+		return;
+
+	// frames are sent as soon as they are written: the batching is done by the connections
+	int enable = 1;
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+}
+} // namespace
+
+int TcpSocket::listen(const ghost::NetworkConnectionConfiguration& config)
+{
+	Address address;
+	if (!resolve(config, true, address)) return -1;
+
+	int fd = ::socket(address.storage.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd < 0) return -1;
+
+	if (address.storage.ss_family != AF_UNIX)
+	{
+		int enable = 1;
+		setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+	}
+
+	int bound = ::bind(fd, reinterpret_cast<sockaddr*>(&address.storage), address.length);
+	if (bound != 0 && errno == EADDRINUSE && address.storage.ss_family == AF_UNIX)
+	{
+		// remove the file left by a process that did not stop properly, unless a server still listens there
+		int probe = connect(config, std::chrono::milliseconds(0));
+		if (probe >= 0)
+			::close(probe);
+		else
+		{
+			::unlink(reinterpret_cast<sockaddr_un*>(&address.storage)->sun_path);
+			bound = ::bind(fd, reinterpret_cast<sockaddr*>(&address.storage), address.length);
+		}
+	}
+
+	if (bound != 0 || ::listen(fd, SOMAXCONN) != 0)
+	{
+		::close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+int TcpSocket::connect(const ghost::NetworkConnectionConfiguration& config, std::chrono::milliseconds timeout)
+{
+	Address address;
+	if (!resolve(config, false, address)) return -1;
+
+	int fd = ::socket(address.storage.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd < 0) return -1;
+
+	if (::connect(fd, reinterpret_cast<sockaddr*>(&address.storage), address.length) != 0)
+	{
+		if (errno != EINPROGRESS && errno != EAGAIN)
+		{
+			::close(fd);
+			return -1;
+		}
+
+		pollfd pending{fd, POLLOUT, 0};
+		int error = 0;
+		socklen_t length = sizeof(error);
+		if (::poll(&pending, 1, static_cast<int>(timeout.count())) != 1 ||
+		    getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) != 0 || error != 0)
+		{
+			::close(fd);
+			return -1;
+		}
+	}
+
+	configure(fd);
+	return fd;
+}
+
+int TcpSocket::accept(int listeningFd)
+{
+	int fd = ::accept4(listeningFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+	if (fd >= 0) configure(fd);
+
+	return fd;
+}
+
+void TcpSocket::closeListening(int listeningFd, const ghost::NetworkConnectionConfiguration& config)
+{
+	::close(listeningFd);
+
+	std::string path = config.getUnixSocketPath();
+	if (!path.empty()) ::unlink(path.c_str());
+}
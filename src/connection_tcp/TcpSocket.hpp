@@ -0,0 +1,49 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_INTERNAL_TCP_TCPSOCKET_HPP
+#define GHOST_INTERNAL_TCP_TCPSOCKET_HPP
+
+#include <chrono>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <string>
+
+namespace ghost
+{
+namespace internal
+{
+/**
+ *	Creates the non-blocking sockets of the TCP connections. The sockets use the unix socket path of
+ *	the configuration if it is set, its IP address and port number otherwise.
+ *	The methods return -1 on failure.
+ */
+class TcpSocket
+{
+public:
+	/// Creates a socket listening on the address of the configuration.
+	static int listen(const ghost::NetworkConnectionConfiguration& config);
+	/// Connects a socket to the address of the configuration, waiting at most "timeout" for the connection.
+	static int connect(const ghost::NetworkConnectionConfiguration& config, std::chrono::milliseconds timeout);
+	/// Accepts a pending connection of the listening socket.
+	static int accept(int listeningFd);
+	/// Closes the listening socket and removes its unix socket file if it has one.
+	static void closeListening(int listeningFd, const ghost::NetworkConnectionConfiguration& config);
+};
+} // namespace internal
+} // namespace ghost
+
+#endif // GHOST_INTERNAL_TCP_TCPSOCKET_HPP
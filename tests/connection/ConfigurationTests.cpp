@@ -225,10 +225,89 @@ TEST_F(ConfigurationTests, test_connectionConfiguration_threadPoolSize)
 	ASSERT_TRUE(configuration.getThreadPoolSize() == TEST_CONFIGURATION_VALUE_INT);
 }
 
+TEST_F(ConfigurationTests, test_connectionConfiguration_queueType)
+{
+	ghost::ConnectionConfiguration configuration;
+	ASSERT_TRUE(configuration.getQueueType() == ghost::ConnectionConfiguration::QueueType::BLOCKING_QUEUE);
+	configuration.setQueueType(ghost::ConnectionConfiguration::QueueType::MPSC_RING_BUFFER);
+	ASSERT_TRUE(configuration.getQueueType() == ghost::ConnectionConfiguration::QueueType::MPSC_RING_BUFFER);
+}
+
+TEST_F(ConfigurationTests, test_connectionConfiguration_queueCapacity)
+{
+	ghost::ConnectionConfiguration configuration;
+	ASSERT_TRUE(configuration.getQueueCapacity() == 1024);
+	configuration.setQueueCapacity(TEST_CONFIGURATION_VALUE_INT);
+	ASSERT_TRUE(configuration.getQueueCapacity() == TEST_CONFIGURATION_VALUE_INT);
+}
+
+TEST_F(ConfigurationTests, test_connectionConfiguration_queueDepth)
+{
+	ghost::ConnectionConfiguration configuration;
+	ASSERT_TRUE(configuration.getReaderQueueDepth() == 0);
+	ASSERT_TRUE(configuration.getWriterQueueDepth() == 0);
+	configuration.setReaderQueueDepth(TEST_CONFIGURATION_VALUE_INT);
+	configuration.setWriterQueueDepth(TEST_CONFIGURATION_VALUE_INT + 1);
+	ASSERT_TRUE(configuration.getReaderQueueDepth() == TEST_CONFIGURATION_VALUE_INT);
+	ASSERT_TRUE(configuration.getWriterQueueDepth() == TEST_CONFIGURATION_VALUE_INT + 1);
+}
+
+TEST_F(ConfigurationTests, test_connectionConfiguration_overflowPolicy)
+{
+	ghost::ConnectionConfiguration configuration;
+	ASSERT_TRUE(configuration.getReaderOverflowPolicy() == ghost::ConnectionConfiguration::OverflowPolicy::BLOCK);
+	ASSERT_TRUE(configuration.getWriterOverflowPolicy() == ghost::ConnectionConfiguration::OverflowPolicy::BLOCK);
+	configuration.setReaderOverflowPolicy(ghost::ConnectionConfiguration::OverflowPolicy::DROP_OLDEST);
+	configuration.setWriterOverflowPolicy(ghost::ConnectionConfiguration::OverflowPolicy::FAIL);
+	ASSERT_TRUE(configuration.getReaderOverflowPolicy() ==
+		    ghost::ConnectionConfiguration::OverflowPolicy::DROP_OLDEST);
+	ASSERT_TRUE(configuration.getWriterOverflowPolicy() == ghost::ConnectionConfiguration::OverflowPolicy::FAIL);
+}
+
+TEST_F(ConfigurationTests, test_connectionConfiguration_overflowTimeout)
+{
+	ghost::ConnectionConfiguration configuration;
+	ASSERT_TRUE(configuration.getOverflowTimeout() == std::chrono::milliseconds(-1));
+	configuration.setOverflowTimeout(std::chrono::milliseconds(TEST_CONFIGURATION_VALUE_INT));
+	ASSERT_TRUE(configuration.getOverflowTimeout() == std::chrono::milliseconds(TEST_CONFIGURATION_VALUE_INT));
+}
+
+TEST_F(ConfigurationTests, test_connectionConfiguration_messageArenaSize)
+{
+	ghost::ConnectionConfiguration configuration;
+	ASSERT_TRUE(configuration.getMessageArenaSize() == 0);
+	configuration.setMessageArenaSize(TEST_CONFIGURATION_VALUE_INT);
+	ASSERT_TRUE(configuration.getMessageArenaSize() == TEST_CONFIGURATION_VALUE_INT);
+}
+
+TEST_F(ConfigurationTests, test_connectionConfiguration_handlerThreadCount)
+{
+	ghost::ConnectionConfiguration configuration;
+	ASSERT_TRUE(configuration.getHandlerThreadCount() == 0);
+	configuration.setHandlerThreadCount(TEST_CONFIGURATION_VALUE_INT);
+	ASSERT_TRUE(configuration.getHandlerThreadCount() == TEST_CONFIGURATION_VALUE_INT);
+}
+
+TEST_F(ConfigurationTests, test_connectionConfiguration_latencyTracing)
+{
+	ghost::ConnectionConfiguration configuration;
+	ASSERT_FALSE(configuration.isLatencyTracingEnabled());
+	configuration.setLatencyTracingEnabled(true);
+	ASSERT_TRUE(configuration.isLatencyTracingEnabled());
+}
+
+TEST_F(ConfigurationTests, test_connectionConfiguration_priorityWeight)
+{
+	ghost::ConnectionConfiguration configuration;
+	ASSERT_TRUE(configuration.getPriorityWeight() == 8);
+	configuration.setPriorityWeight(0);
+	ASSERT_TRUE(configuration.getPriorityWeight() == 0);
+}
+
 TEST_F(ConfigurationTests, test_connectionConfiguration_configurationIsUpdateable)
 {
 	ghost::ConnectionConfiguration configuration;
-	ASSERT_TRUE(configuration.getConfiguration()->getAttributes().size() == 3);
+	ASSERT_TRUE(configuration.getConfiguration()->getAttributes().size() == 14);
 	configuration.getConfiguration()->addAttribute(TEST_CONFIGURATION_FIELD,
 						       ghost::ConfigurationValue(TEST_CONFIGURATION_VALUE));
 	ASSERT_TRUE(configuration.getConfiguration()->hasAttribute(TEST_CONFIGURATION_FIELD));
@@ -249,3 +328,11 @@ TEST_F(ConfigurationTests, test_networkconnectionConfiguration_port)
 	configuration.setServerPortNumber(TEST_CONFIGURATION_VALUE_INT);
 	ASSERT_TRUE(configuration.getServerPortNumber() == TEST_CONFIGURATION_VALUE_INT);
 }
+
+TEST_F(ConfigurationTests, test_networkconnectionConfiguration_unixSocketPath)
+{
+	ghost::NetworkConnectionConfiguration configuration;
+	ASSERT_TRUE(configuration.getUnixSocketPath().empty());
+	configuration.setUnixSocketPath(TEST_CONFIGURATION_VALUE);
+	ASSERT_TRUE(configuration.getUnixSocketPath() == TEST_CONFIGURATION_VALUE);
+}
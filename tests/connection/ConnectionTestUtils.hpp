@@ -18,16 +18,26 @@
 #define GHOST_TESTS_CONNECTIONTESTUTILS_HPP
 
 #include <gmock/gmock.h>
+#include <google/protobuf/wrappers.pb.h>
+#include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <ghost/connection/Client.hpp>
 #include <ghost/connection/ClientHandler.hpp>
 #include <ghost/connection/ConnectionManager.hpp>
 #include <ghost/connection/Message.hpp>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
 #include <ghost/connection/Publisher.hpp>
 #include <ghost/connection/ReadableConnection.hpp>
 #include <ghost/connection/Server.hpp>
 #include <ghost/connection/Subscriber.hpp>
 #include <ghost/connection/WritableConnection.hpp>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 class ServerMock : public ghost::Server
 {
@@ -100,6 +110,7 @@ public:
 	MOCK_METHOD1(createSubscriber,
 		     std::shared_ptr<ghost::Subscriber>(const ghost::ConnectionConfiguration& config));
 	MOCK_METHOD0(getConnectionFactory, std::shared_ptr<ghost::ConnectionFactory>());
+	MOCK_CONST_METHOD0(getStatistics, ghost::ConnectionStatistics());
 };
 
 class MessageMock : public ghost::Message
@@ -169,4 +180,204 @@ public:
 	}
 };
 
+/**
+ *	Utility class to access the internal writer sink from the ghost::Publisher.
+ */
+class PublisherWithSink : public ghost::Publisher
+{
+public:
+	PublisherWithSink(const ghost::ConnectionConfiguration& config) : ghost::Publisher(config)
+	{
+	}
+
+	bool start() override
+	{
+		return true;
+	}
+
+	bool stop() override
+	{
+		return true;
+	}
+
+	bool isRunning() const override
+	{
+		return true;
+	}
+
+	std::shared_ptr<ghost::WriterSink> getSink() const
+	{
+		return getWriterSink();
+	}
+
+	std::shared_ptr<const ghost::internal::ConflationKeys> getKeys() const
+	{
+		return getConflationKeys();
+	}
+};
+
+/**
+ *	Fixture of the tests shared by the transports, see TransportConnectionTests.hpp. "Transport"
+ *	describes the transport under test:
+ *	- Configuration: its configuration type
+ *	- PORT: the port of its connections
+ *	- initialize(connectionManager, configuration): adds its rules to the connection manager
+ *	- hasSubscribers(publisher, count): true once the publisher knows of "count" subscribers
+ */
+template <typename Transport>
+class TransportConnectionTests : public testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		_connectionManager = ghost::ConnectionManager::create();
+		Transport::initialize(_connectionManager, _config);
+
+		_config.setServerPortNumber(Transport::PORT);
+
+		_doubleValueMessageWasHandledCounter = 0;
+		_doubleValueMessageWasHandledMap.clear();
+
+		_clientsHandledCount = 0;
+		_clientsHandledExpected = 0;
+	}
+
+	void TearDown() override
+	{
+		_connectionManager.reset();
+	}
+
+	void createServer(const ghost::NetworkConnectionConfiguration& config)
+	{
+		_server = _connectionManager->createServer(config);
+		ASSERT_TRUE(_server);
+		ASSERT_FALSE(_server->isRunning());
+		_clientHandlerMock = std::make_shared<ClientHandlerMock>();
+		_server->setClientHandler(_clientHandlerMock);
+	}
+
+	void startServer()
+	{
+		bool startResult = _server->start();
+		ASSERT_TRUE(startResult);
+		ASSERT_TRUE(_server->isRunning());
+	}
+
+	void startClients(const ghost::NetworkConnectionConfiguration config, size_t count,
+			  bool standardExpectations = true)
+	{
+		_clientsHandledExpected = count;
+
+		if (standardExpectations)
+		{
+			EXPECT_CALL(*_clientHandlerMock, configureClient(testing::_)).Times(count);
+			EXPECT_CALL(*_clientHandlerMock, handle(testing::_, testing::_))
+			    .Times(count)
+			    .WillRepeatedly([&](std::shared_ptr<ghost::Client>, bool&) {
+				    _clientsHandledCount++;
+				    return true;
+			    });
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			auto client = _connectionManager->createClient(config);
+			ASSERT_TRUE(client);
+			bool startResult = client->start();
+			ASSERT_TRUE(startResult);
+			_clients.push_back(client);
+		}
+	}
+
+	void waitForClientsHandled()
+	{
+		waitUntil([&] { return _clientsHandledCount >= _clientsHandledExpected; });
+		ASSERT_TRUE(_clientsHandledCount == _clientsHandledExpected);
+	}
+
+	void createPublisher(const ghost::NetworkConnectionConfiguration& config)
+	{
+		_publisher = _connectionManager->createPublisher(config);
+		ASSERT_TRUE(_publisher);
+		ASSERT_FALSE(_publisher->isRunning());
+		bool startResult = _publisher->start();
+		ASSERT_TRUE(startResult);
+		ASSERT_TRUE(_publisher->isRunning());
+	}
+
+	void startSubscribers(const ghost::NetworkConnectionConfiguration config, int count)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			auto subscriber = _connectionManager->createSubscriber(config);
+			ASSERT_TRUE(subscriber);
+			auto handler = subscriber->addMessageHandler();
+			handler->addHandler<google::protobuf::DoubleValue>(
+			    [this, i](const google::protobuf::DoubleValue& message) {
+				    doubleMessageMassHandler(i, message);
+			    });
+
+			bool startResult = subscriber->start();
+			ASSERT_TRUE(startResult);
+			ASSERT_TRUE(subscriber->isRunning());
+			_subscribers.push_back(subscriber);
+		}
+
+		// the publisher may register the subscribers once it accepted their connections
+		waitUntil([&] { return Transport::hasSubscribers(_publisher, _subscribers.size()); });
+		ASSERT_TRUE(Transport::hasSubscribers(_publisher, _subscribers.size()));
+	}
+
+	void checkSubscribersReceivedMessages(int count, int expectedMessages)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			waitUntil([&] { return countHandledMessages(i) >= expectedMessages; });
+			ASSERT_TRUE(countHandledMessages(i) == expectedMessages);
+		}
+	}
+
+	void waitUntil(const std::function<bool()>& condition)
+	{
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+		while (!condition() && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	int countHandledMessages(int id)
+	{
+		std::lock_guard<std::mutex> lock(_doubleValueMessageWasHandledMutex);
+		auto it = _doubleValueMessageWasHandledMap.find(id);
+		return it == _doubleValueMessageWasHandledMap.end() ? 0 : it->second;
+	}
+
+	std::shared_ptr<ghost::ConnectionManager> _connectionManager;
+	typename Transport::Configuration _config;
+
+	std::shared_ptr<ghost::Server> _server;
+	std::vector<std::shared_ptr<ghost::Client>> _clients;
+	std::shared_ptr<ClientHandlerMock> _clientHandlerMock;
+	std::atomic_int _clientsHandledCount;
+	int _clientsHandledExpected;
+
+	std::shared_ptr<ghost::Publisher> _publisher;
+	std::vector<std::shared_ptr<ghost::Subscriber>> _subscribers;
+
+	std::atomic_int _doubleValueMessageWasHandledCounter;
+	std::mutex _doubleValueMessageWasHandledMutex;
+	std::map<int, int> _doubleValueMessageWasHandledMap;
+
+public:
+	void doubleMessageHandler(const google::protobuf::DoubleValue& message)
+	{
+		_doubleValueMessageWasHandledCounter++;
+	}
+
+	void doubleMessageMassHandler(int id, const google::protobuf::DoubleValue& message)
+	{
+		std::lock_guard<std::mutex> lock(_doubleValueMessageWasHandledMutex);
+		_doubleValueMessageWasHandledMap[id]++;
+	}
+};
+
 #endif // GHOST_TESTS_CONNECTIONTESTUTILS_HPP
@@ -148,3 +148,29 @@ TEST_F(ConnectionTests, test_ConnectionManager_closesConnection_When_destructorI
 
 	_connectionManager.reset();
 }
+
+TEST_F(ConnectionTests, test_ConnectionManager_aggregatesStatistics_When_connectionsReceiveMessages)
+{
+	registerMockFactories(_connectionConfiguration);
+	auto client1 =
+	    std::dynamic_pointer_cast<ClientMock>(_connectionManager->createClient(_connectionConfiguration));
+	auto client2 =
+	    std::dynamic_pointer_cast<ClientMock>(_connectionManager->createClient(_connectionConfiguration));
+	auto server = _connectionManager->createServer(_connectionConfiguration);
+	ASSERT_TRUE(client1 && client2 && server);
+
+	google::protobuf::Any message;
+	message.set_value("payload");
+	client1->pushMessage(message);
+	client2->pushMessage(message);
+	client2->pushMessage(message);
+
+	ASSERT_TRUE(client1->getStatistics().messagesIn == 1);
+	ASSERT_TRUE(server->getStatistics().messagesIn == 0);
+
+	auto statistics = _connectionManager->getStatistics();
+	ASSERT_TRUE(statistics.messagesIn == 3);
+	ASSERT_TRUE(statistics.bytesIn == 3 * message.value().size());
+	ASSERT_TRUE(statistics.readerQueueDepth == 3);
+	ASSERT_TRUE(statistics.readerQueuePeakDepth == 2);
+}
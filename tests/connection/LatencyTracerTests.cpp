@@ -0,0 +1,218 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <google/protobuf/wrappers.pb.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "../../protobuf/ghost/connection/GenericMessage.pb.h"
+#include "../src/connection/LatencyTracer.hpp"
+#include "../src/connection/ReaderSink.hpp"
+#include "../src/connection/WriterSink.hpp"
+
+/**
+ *	This test class groups the following test categories:
+ *	- LatencyHistogram percentiles
+ *	- Header of the traced messages
+ *	- Latency tracing of the sinks
+ */
+
+class LatencyTracerTests : public testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		google::protobuf::DoubleValue value;
+		value.set_value(TEST_DOUBLE_VALUE);
+		_message.PackFrom(value);
+
+		_config.setLatencyTracingEnabled(true);
+	}
+
+	void TearDown() override
+	{
+	}
+
+	// checks that "actual" is within the precision of the histogram
+	static bool isNear(std::chrono::nanoseconds actual, std::chrono::nanoseconds expected)
+	{
+		return std::abs((double)actual.count() - (double)expected.count()) <= 0.04 * expected.count();
+	}
+
+	google::protobuf::Any _message;
+	ghost::ConnectionConfiguration _config;
+
+	static const double TEST_DOUBLE_VALUE;
+};
+
+const double LatencyTracerTests::TEST_DOUBLE_VALUE = 42.0;
+
+TEST_F(LatencyTracerTests, test_LatencyHistogram_returnsZero_When_nothingWasRecorded)
+{
+	ghost::internal::LatencyHistogram histogram;
+	auto percentiles = histogram.getPercentiles();
+
+	ASSERT_TRUE(percentiles.samples == 0);
+	ASSERT_TRUE(percentiles.p50 == std::chrono::nanoseconds(0));
+	ASSERT_TRUE(percentiles.p999 == std::chrono::nanoseconds(0));
+}
+
+TEST_F(LatencyTracerTests, test_LatencyHistogram_returnsPercentiles_When_durationsAreRecorded)
+{
+	ghost::internal::LatencyHistogram histogram;
+	for (int i = 1; i <= 1000; ++i) histogram.record(std::chrono::microseconds(i));
+
+	auto percentiles = histogram.getPercentiles();
+	ASSERT_TRUE(percentiles.samples == 1000);
+	ASSERT_TRUE(isNear(percentiles.p50, std::chrono::microseconds(500)));
+	ASSERT_TRUE(isNear(percentiles.p99, std::chrono::microseconds(990)));
+	ASSERT_TRUE(isNear(percentiles.p999, std::chrono::microseconds(999)));
+}
+
+TEST_F(LatencyTracerTests, test_LatencyHistogram_recordsZero_When_durationIsNegative)
+{
+	ghost::internal::LatencyHistogram histogram;
+	histogram.record(std::chrono::nanoseconds(-100));
+
+	auto percentiles = histogram.getPercentiles();
+	ASSERT_TRUE(percentiles.samples == 1);
+	ASSERT_TRUE(percentiles.p50 == std::chrono::nanoseconds(0));
+}
+
+TEST_F(LatencyTracerTests, test_LatencyTracer_keepsFirstWriteTime_When_messageIsStampedTwice)
+{
+	ghost::internal::LatencyTracer::stampWrite(_message);
+	ghost::protobuf::connection::GenericMessageHeader header;
+	ASSERT_TRUE(ghost::internal::LatencyTracer::getHeader(_message, header));
+	ASSERT_TRUE(header.write_time() > 0);
+	ASSERT_TRUE(header.timestamp() == header.write_time() / 1000000);
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	ghost::internal::LatencyTracer::stampWrite(_message);
+	ghost::protobuf::connection::GenericMessageHeader secondHeader;
+	ASSERT_TRUE(ghost::internal::LatencyTracer::getHeader(_message, secondHeader));
+	ASSERT_TRUE(secondHeader.write_time() == header.write_time());
+}
+
+TEST_F(LatencyTracerTests, test_LatencyTracer_doesNotAddHeader_When_messageIsNotTraced)
+{
+	ghost::internal::LatencyTracer::stampHandoff(_message);
+	ghost::internal::LatencyTracer::stampReceipt(_message);
+
+	ghost::protobuf::connection::GenericMessageHeader header;
+	ASSERT_FALSE(ghost::internal::LatencyTracer::getHeader(_message, header));
+	ASSERT_TRUE(_message.GetReflection()->GetUnknownFields(_message).empty());
+}
+
+TEST_F(LatencyTracerTests, test_LatencyTracer_headerTravelsWithPayload_When_messageIsSerialized)
+{
+	ghost::internal::LatencyTracer::stampWrite(_message);
+	ghost::internal::LatencyTracer::stampHandoff(_message);
+
+	google::protobuf::Any received;
+	ASSERT_TRUE(received.ParseFromString(_message.SerializeAsString()));
+	ghost::internal::LatencyTracer::stampReceipt(received);
+
+	ghost::protobuf::connection::GenericMessageHeader header;
+	ASSERT_TRUE(ghost::internal::LatencyTracer::getHeader(received, header));
+	ASSERT_TRUE(header.write_time() > 0);
+	ASSERT_TRUE(header.handoff_time() >= header.write_time());
+	ASSERT_TRUE(header.receipt_time() >= header.handoff_time());
+
+	google::protobuf::DoubleValue value;
+	ASSERT_TRUE(received.UnpackTo(&value));
+	ASSERT_TRUE(value.value() == TEST_DOUBLE_VALUE);
+}
+
+TEST_F(LatencyTracerTests, test_LatencyTracer_recordsAllStages_When_messageWasStampedByEveryStage)
+{
+	ghost::internal::LatencyTracer::stampWrite(_message);
+	ghost::internal::LatencyTracer::stampHandoff(_message);
+	ghost::internal::LatencyTracer::stampReceipt(_message);
+
+	ghost::internal::LatencyTracer tracer;
+	auto start = std::chrono::system_clock::now();
+	tracer.record(_message, start, start + std::chrono::microseconds(10));
+
+	auto statistics = tracer.getStatistics();
+	ASSERT_TRUE(statistics.writerQueue.samples == 1);
+	ASSERT_TRUE(statistics.network.samples == 1);
+	ASSERT_TRUE(statistics.readerQueue.samples == 1);
+	ASSERT_TRUE(statistics.handler.samples == 1);
+	ASSERT_TRUE(isNear(statistics.handler.p50, std::chrono::microseconds(10)));
+	ASSERT_TRUE(statistics.endToEnd.samples == 1);
+	ASSERT_TRUE(statistics.endToEnd.p50 >= statistics.handler.p50);
+}
+
+TEST_F(LatencyTracerTests, test_LatencyTracer_onlyRecordsHandler_When_messageIsNotTraced)
+{
+	ghost::internal::LatencyTracer tracer;
+	auto start = std::chrono::system_clock::now();
+	tracer.record(_message, start, start);
+
+	auto statistics = tracer.getStatistics();
+	ASSERT_TRUE(statistics.handler.samples == 1);
+	ASSERT_TRUE(statistics.writerQueue.samples == 0);
+	ASSERT_TRUE(statistics.network.samples == 0);
+	ASSERT_TRUE(statistics.readerQueue.samples == 0);
+	ASSERT_TRUE(statistics.endToEnd.samples == 0);
+}
+
+TEST_F(LatencyTracerTests, test_WriterSink_stampsMessages_When_latencyTracingIsEnabled)
+{
+	ghost::internal::WriterSink tracingSink(_config);
+	ghost::internal::WriterSink sink;
+	ASSERT_TRUE(tracingSink.push(_message, false));
+	ASSERT_TRUE(sink.push(_message, false));
+
+	std::vector<google::protobuf::Any> messages;
+	ASSERT_TRUE(tracingSink.getBatch(messages, 1, std::chrono::milliseconds(0)) == 1);
+	ASSERT_TRUE(sink.getBatch(messages, 1, std::chrono::milliseconds(0)) == 1);
+
+	ghost::protobuf::connection::GenericMessageHeader header;
+	ASSERT_TRUE(ghost::internal::LatencyTracer::getHeader(messages[0], header));
+	ASSERT_FALSE(ghost::internal::LatencyTracer::getHeader(messages[1], header));
+}
+
+TEST_F(LatencyTracerTests, test_ReaderSink_measuresHandler_When_latencyTracingIsEnabled)
+{
+	ghost::internal::ReaderSink sink(_config);
+	auto handler = sink.addMessageHandler();
+	handler->addHandler<google::protobuf::DoubleValue>([](const google::protobuf::DoubleValue& message) {});
+
+	ghost::internal::LatencyTracer::stampWrite(_message);
+	ASSERT_TRUE(sink.put(_message));
+
+	auto statistics = sink.getLatencyStatistics();
+	ASSERT_TRUE(statistics.handler.samples == 1);
+	ASSERT_TRUE(statistics.endToEnd.samples == 1);
+}
+
+TEST_F(LatencyTracerTests, test_ReaderSink_returnsNoStatistics_When_latencyTracingIsDisabled)
+{
+	ghost::internal::ReaderSink sink;
+	auto handler = sink.addMessageHandler();
+	handler->addHandler<google::protobuf::DoubleValue>([](const google::protobuf::DoubleValue& message) {});
+
+	ghost::internal::LatencyTracer::stampWrite(_message);
+	ASSERT_TRUE(sink.put(_message));
+
+	auto statistics = sink.getLatencyStatistics();
+	ASSERT_TRUE(statistics.handler.samples == 0);
+	ASSERT_TRUE(statistics.endToEnd.samples == 0);
+}
@@ -0,0 +1,371 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <google/protobuf/wrappers.pb.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../src/connection/BlockingMessageQueue.hpp"
+#include "../src/connection/MPSCRingBuffer.hpp"
+#include "../src/connection/SPSCRingBuffer.hpp"
+#include "../src/connection/WriterSink.hpp"
+
+/**
+ *	This test class groups the following test categories:
+ *	- BlockingMessageQueue, SPSCRingBuffer and MPSCRingBuffer
+ *	- Selection of the queue backend of the sinks
+ */
+
+class MessageQueueTests : public testing::Test
+{
+protected:
+	void SetUp() override
+	{
+	}
+
+	void TearDown() override
+	{
+	}
+
+	// pushes "count" values from each of "producers" threads and checks that every value is received once
+	void checkConcurrentProducers(ghost::internal::MessageQueue<int>& queue, int producers, int count)
+	{
+		std::vector<std::thread> threads;
+		for (int p = 0; p < producers; ++p)
+		{
+			threads.emplace_back([&queue, p, count]() {
+				for (int i = 0; i < count; ++i) queue.push(p * count + i);
+			});
+		}
+
+		std::vector<int> lastReceived(producers, -1);
+		for (int i = 0; i < producers * count; ++i)
+		{
+			int value;
+			queue.get(value);
+			queue.pop();
+
+			int producer = value / count;
+			ASSERT_TRUE(value % count == lastReceived[producer] + 1); // order is kept per producer
+			lastReceived[producer] = value % count;
+		}
+
+		for (auto& thread : threads) thread.join();
+		ASSERT_TRUE(queue.size() == 0);
+	}
+
+	static const int TEST_CAPACITY;
+	static const int TEST_COUNT;
+};
+
+const int MessageQueueTests::TEST_CAPACITY = 8;
+const int MessageQueueTests::TEST_COUNT = 10000;
+
+TEST_F(MessageQueueTests, test_RingBuffer_capacityIsRoundedUpToPowerOfTwo)
+{
+	ghost::internal::SPSCRingBuffer<int> spsc(5);
+	ASSERT_TRUE(spsc.capacity() == 8);
+	ghost::internal::MPSCRingBuffer<int> mpsc(TEST_CAPACITY);
+	ASSERT_TRUE(mpsc.capacity() == TEST_CAPACITY);
+}
+
+TEST_F(MessageQueueTests, test_SPSCRingBuffer_elementsAreReadInOrder_When_pushedByOneProducer)
+{
+	ghost::internal::SPSCRingBuffer<int> queue(TEST_CAPACITY);
+	checkConcurrentProducers(queue, 1, TEST_COUNT);
+}
+
+TEST_F(MessageQueueTests, test_MPSCRingBuffer_allElementsAreReceived_When_pushedByConcurrentProducers)
+{
+	ghost::internal::MPSCRingBuffer<int> queue(TEST_CAPACITY);
+	checkConcurrentProducers(queue, 4, TEST_COUNT);
+}
+
+TEST_F(MessageQueueTests, test_RingBuffer_getDoesNotRemoveElement_When_popIsNotCalled)
+{
+	ghost::internal::MPSCRingBuffer<int> queue(TEST_CAPACITY);
+	queue.push(42);
+	int value;
+	queue.get(value);
+	ASSERT_TRUE(value == 42);
+	ASSERT_TRUE(queue.size() == 1);
+	queue.pop();
+	ASSERT_TRUE(queue.size() == 0);
+}
+
+TEST_F(MessageQueueTests, test_RingBuffer_tryGetFails_When_bufferIsEmpty)
+{
+	ghost::internal::SPSCRingBuffer<int> spsc(TEST_CAPACITY);
+	ghost::internal::MPSCRingBuffer<int> mpsc(TEST_CAPACITY);
+	int value;
+
+	ASSERT_FALSE(spsc.tryGet(std::chrono::milliseconds(0), value));
+	ASSERT_FALSE(mpsc.tryGet(std::chrono::milliseconds(0), value));
+	ASSERT_FALSE(spsc.tryGet(std::chrono::milliseconds(10), value));
+	ASSERT_FALSE(mpsc.tryGet(std::chrono::milliseconds(10), value));
+}
+
+TEST_F(MessageQueueTests, test_MessageQueue_tryPopMovesHeadOut_When_elementIsAvailable)
+{
+	ghost::internal::BlockingMessageQueue<std::string> blocking;
+	ghost::internal::SPSCRingBuffer<std::string> spsc(TEST_CAPACITY);
+	ghost::internal::MPSCRingBuffer<std::string> mpsc(TEST_CAPACITY);
+
+	for (ghost::internal::MessageQueue<std::string>* queue :
+	     std::vector<ghost::internal::MessageQueue<std::string>*>{&blocking, &spsc, &mpsc})
+	{
+		std::string value;
+		ASSERT_FALSE(queue->tryPop(std::chrono::milliseconds(0), value));
+
+		queue->push("first");
+		queue->push("second");
+		ASSERT_TRUE(queue->tryPop(std::chrono::milliseconds(0), value));
+		ASSERT_TRUE(value == "first");
+		ASSERT_TRUE(queue->tryPop(std::chrono::milliseconds(10), value));
+		ASSERT_TRUE(value == "second");
+		ASSERT_TRUE(queue->size() == 0);
+	}
+}
+
+TEST_F(MessageQueueTests, test_MessageQueue_tryPopBatchMovesAvailableElements_When_maximumIsNotReached)
+{
+	ghost::internal::BlockingMessageQueue<int> blocking;
+	ghost::internal::SPSCRingBuffer<int> spsc(TEST_CAPACITY);
+	ghost::internal::MPSCRingBuffer<int> mpsc(TEST_CAPACITY);
+
+	for (ghost::internal::MessageQueue<int>* queue :
+	     std::vector<ghost::internal::MessageQueue<int>*>{&blocking, &spsc, &mpsc})
+	{
+		std::vector<int> values;
+		ASSERT_TRUE(queue->tryPopBatch(std::chrono::milliseconds(0), values, 4) == 0);
+
+		for (int i = 0; i < 6; ++i) queue->push(i);
+		ASSERT_TRUE(queue->tryPopBatch(std::chrono::milliseconds(0), values, 4) == 4);
+		ASSERT_TRUE(queue->tryPopBatch(std::chrono::milliseconds(10), values, 4) == 2);
+		ASSERT_TRUE(values == std::vector<int>({0, 1, 2, 3, 4, 5}));
+		ASSERT_TRUE(queue->size() == 0);
+	}
+}
+
+TEST_F(MessageQueueTests, test_RingBuffer_pushBlocks_When_bufferIsFull)
+{
+	ghost::internal::MPSCRingBuffer<int> queue(TEST_CAPACITY);
+	for (int i = 0; i < TEST_CAPACITY; ++i) queue.push(i);
+
+	std::atomic_bool pushed(false);
+	std::thread producer([&]() {
+		queue.push(TEST_CAPACITY);
+		pushed = true;
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	ASSERT_FALSE(pushed);
+	queue.pop();
+	producer.join();
+	ASSERT_TRUE(pushed);
+	ASSERT_TRUE(queue.size() == (size_t)TEST_CAPACITY);
+}
+
+TEST_F(MessageQueueTests, test_MessageQueue_tryPushFails_When_maximumSizeIsReached)
+{
+	ghost::internal::BlockingMessageQueue<int> blocking;
+	ghost::internal::SPSCRingBuffer<int> spsc(TEST_CAPACITY);
+	ghost::internal::MPSCRingBuffer<int> mpsc(TEST_CAPACITY);
+
+	for (ghost::internal::MessageQueue<int>* queue :
+	     std::vector<ghost::internal::MessageQueue<int>*>{&blocking, &spsc, &mpsc})
+	{
+		ASSERT_TRUE(queue->tryPush(0, 2, std::chrono::milliseconds(0)));
+		ASSERT_TRUE(queue->tryPush(1, 2, std::chrono::milliseconds(0)));
+		ASSERT_FALSE(queue->tryPush(2, 2, std::chrono::milliseconds(0)));
+		ASSERT_FALSE(queue->tryPush(2, 2, std::chrono::milliseconds(10)));
+		ASSERT_TRUE(queue->size() == 2);
+	}
+}
+
+TEST_F(MessageQueueTests, test_MessageQueue_tryPushBatchAddsAllOrNothing_When_maximumSizeIsReached)
+{
+	ghost::internal::BlockingMessageQueue<int> blocking;
+	ghost::internal::SPSCRingBuffer<int> spsc(TEST_CAPACITY);
+	ghost::internal::MPSCRingBuffer<int> mpsc(TEST_CAPACITY);
+
+	for (ghost::internal::MessageQueue<int>* queue :
+	     std::vector<ghost::internal::MessageQueue<int>*>{&blocking, &spsc, &mpsc})
+	{
+		ASSERT_TRUE(queue->tryPushBatch(std::vector<int>{0, 1, 2}, 4, std::chrono::milliseconds(0)));
+		std::vector<int> rejected{3, 4};
+		ASSERT_FALSE(queue->tryPushBatch(std::move(rejected), 4, std::chrono::milliseconds(10)));
+		ASSERT_TRUE(rejected == std::vector<int>({3, 4})); // left unchanged
+		ASSERT_TRUE(queue->size() == 3);
+
+		std::vector<int> values;
+		ASSERT_TRUE(queue->tryPopBatch(std::chrono::milliseconds(0), values, 10) == 3);
+		ASSERT_TRUE(queue->tryPushBatch(std::move(rejected), 4, std::chrono::milliseconds(0)));
+		ASSERT_TRUE(queue->tryPopBatch(std::chrono::milliseconds(0), values, 10) == 2);
+		ASSERT_TRUE(values == std::vector<int>({0, 1, 2, 3, 4}));
+	}
+}
+
+TEST_F(MessageQueueTests, test_MessageQueue_peakSizeIsKept_When_elementsArePopped)
+{
+	ghost::internal::BlockingMessageQueue<int> blocking;
+	ghost::internal::SPSCRingBuffer<int> spsc(TEST_CAPACITY);
+	ghost::internal::MPSCRingBuffer<int> mpsc(TEST_CAPACITY);
+
+	for (ghost::internal::MessageQueue<int>* queue :
+	     std::vector<ghost::internal::MessageQueue<int>*>{&blocking, &spsc, &mpsc})
+	{
+		ASSERT_TRUE(queue->peakSize() == 0);
+		ASSERT_TRUE(queue->tryPush(0, 0, std::chrono::milliseconds(0)));
+		ASSERT_TRUE(queue->tryPushBatch(std::vector<int>{1, 2}, 0, std::chrono::milliseconds(0)));
+		ASSERT_TRUE(queue->peakSize() == 3);
+
+		std::vector<int> values;
+		ASSERT_TRUE(queue->tryPopBatch(std::chrono::milliseconds(0), values, 10) == 3);
+		queue->push(3);
+		ASSERT_TRUE(queue->size() == 1);
+		ASSERT_TRUE(queue->peakSize() == 3);
+	}
+}
+
+TEST_F(MessageQueueTests, test_MPSCRingBuffer_batchesAreNotInterleaved_When_pushedByConcurrentProducers)
+{
+	ghost::internal::MPSCRingBuffer<int> queue(TEST_CAPACITY);
+	const int batchSize = 4;
+	std::vector<std::thread> threads;
+	for (int p = 0; p < 2; ++p)
+	{
+		threads.emplace_back([&queue, p]() {
+			for (int i = 0; i < TEST_COUNT; i += batchSize)
+			{
+				std::vector<int> batch;
+				for (int j = 0; j < batchSize; ++j) batch.push_back(p * TEST_COUNT + i + j);
+				queue.tryPushBatch(std::move(batch), 0, std::chrono::milliseconds(-1));
+			}
+		});
+	}
+
+	for (int i = 0; i < 2 * TEST_COUNT; i += batchSize)
+	{
+		std::vector<int> values;
+		while (values.size() < batchSize)
+			queue.tryPopBatch(std::chrono::milliseconds(-1), values, batchSize - values.size());
+		for (int j = 1; j < batchSize; ++j) ASSERT_TRUE(values[j] == values[0] + j);
+	}
+
+	for (auto& thread : threads) thread.join();
+	ASSERT_TRUE(queue.size() == 0);
+}
+
+TEST_F(MessageQueueTests, test_RingBuffer_tryPushFails_When_capacityIsReached)
+{
+	ghost::internal::MPSCRingBuffer<int> queue(TEST_CAPACITY);
+	for (int i = 0; i < TEST_CAPACITY; ++i) ASSERT_TRUE(queue.tryPush(int(i), 0, std::chrono::milliseconds(0)));
+	ASSERT_FALSE(queue.tryPush(int(TEST_CAPACITY), 0, std::chrono::milliseconds(0)));
+	int value;
+	ASSERT_FALSE(queue.dropOldest(value));
+}
+
+TEST_F(MessageQueueTests, test_BlockingMessageQueue_dropOldestKeepsHead_When_headIsBeingRead)
+{
+	ghost::internal::BlockingMessageQueue<int> queue;
+	queue.push(0);
+	queue.push(1);
+	queue.push(2);
+
+	int value;
+	ASSERT_TRUE(queue.dropOldest(value));
+	ASSERT_TRUE(value == 0);
+	queue.get(value);
+	ASSERT_TRUE(value == 1);
+
+	ASSERT_TRUE(queue.dropOldest(value)); // 1 is being read
+	ASSERT_TRUE(value == 2);
+	ASSERT_FALSE(queue.dropOldest(value));
+	ASSERT_TRUE(queue.pop(value));
+	ASSERT_TRUE(value == 1);
+	ASSERT_TRUE(queue.size() == 0);
+}
+
+TEST_F(MessageQueueTests, test_WriterSink_messagesGoThroughRingBuffer_When_queueTypeIsConfigured)
+{
+	ghost::ConnectionConfiguration config;
+	config.setQueueType(ghost::ConnectionConfiguration::QueueType::SPSC_RING_BUFFER);
+	config.setQueueCapacity(TEST_CAPACITY);
+	ghost::internal::WriterSink sink(config);
+
+	google::protobuf::StringValue value;
+	google::protobuf::Any any;
+	for (int i = 0; i < TEST_CAPACITY; ++i)
+	{
+		value.set_value(std::to_string(i));
+		any.PackFrom(value);
+		ASSERT_TRUE(sink.push(any, false));
+	}
+
+	for (int i = 0; i < TEST_CAPACITY; ++i)
+	{
+		ASSERT_TRUE(sink.get(any, std::chrono::milliseconds(0)));
+		sink.pop();
+		ASSERT_TRUE(any.UnpackTo(&value));
+		ASSERT_TRUE(value.value() == std::to_string(i));
+	}
+	ASSERT_FALSE(sink.get(any, std::chrono::milliseconds(0)));
+}
+
+TEST_F(MessageQueueTests, test_WriterSink_receivesEveryMessage_When_severalWritersUseSpscConfiguration)
+{
+	const int producers = 4;
+	const int count = 2000;
+	ghost::ConnectionConfiguration config;
+	config.setQueueType(ghost::ConnectionConfiguration::QueueType::SPSC_RING_BUFFER);
+	config.setQueueCapacity(TEST_CAPACITY);
+	ghost::internal::WriterSink sink(config);
+
+	// the writers may write from several threads: the sink does not use the SPSC ring buffer
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; ++p)
+	{
+		threads.emplace_back([&sink, p]() {
+			google::protobuf::Int32Value value;
+			google::protobuf::Any any;
+			for (int i = 0; i < count; ++i)
+			{
+				value.set_value(p * count + i);
+				any.PackFrom(value);
+				sink.push(any, false);
+			}
+		});
+	}
+
+	std::vector<int> lastReceived(producers, -1);
+	google::protobuf::Int32Value value;
+	google::protobuf::Any any;
+	for (int i = 0; i < producers * count; ++i)
+	{
+		ASSERT_TRUE(sink.get(any, std::chrono::seconds(5)));
+		sink.pop();
+		ASSERT_TRUE(any.UnpackTo(&value));
+		int producer = value.value() / count;
+		ASSERT_TRUE(value.value() % count == lastReceived[producer] + 1);
+		lastReceived[producer] = value.value() % count;
+	}
+	for (auto& thread : threads) thread.join();
+	ASSERT_FALSE(sink.get(any, std::chrono::milliseconds(0)));
+}
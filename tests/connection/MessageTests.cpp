@@ -21,6 +21,7 @@
 #include <ghost/connection/internal/ProtobufMessage.hpp>
 #include <iostream>
 
+#include "../../protobuf/ghost/connection/GenericMessage.pb.h"
 #include "ConnectionTestUtils.hpp"
 
 using testing::_;
@@ -218,3 +219,66 @@ TEST_F(MessageTests, test_GenericMessageConverter_parseToGhostMessageFails_When_
 	bool parsingSuccess = ghost::internal::GenericMessageConverter::parse(_any, *_ghostMessage2);
 	ASSERT_FALSE(parsingSuccess);
 }
+
+TEST_F(MessageTests, test_GenericMessageConverter_createProducesGenericMessage_When_customGhostMessageIsGiven)
+{
+	bool creationSuccess = ghost::internal::GenericMessageConverter::create(_any, *_ghostMessage);
+	ASSERT_TRUE(creationSuccess);
+
+	ghost::protobuf::connection::GenericMessage expected;
+	expected.set_serial(TEST_GHOST_MESSAGE_CUSTOM_SERIALIZED);
+	expected.set_format(TEST_GHOST_MESSAGE_CUSTOM_FORMAT);
+	expected.set_name(TEST_GHOST_MESSAGE_CUSTOM_TYPE_NAME);
+	google::protobuf::Any expectedAny;
+	expectedAny.PackFrom(expected);
+
+	ASSERT_TRUE(_any.type_url() == expectedAny.type_url());
+	ASSERT_TRUE(_any.value() == expectedAny.value());
+}
+
+TEST_F(MessageTests, test_GenericMessageConverter_parseEnvelopeReferencesTheFields_When_anyFromGhostMessageIsGiven)
+{
+	bool creationSuccess = ghost::internal::GenericMessageConverter::create(_any, *_ghostMessage);
+	ASSERT_TRUE(creationSuccess);
+
+	ghost::internal::GenericMessageEnvelope envelope;
+	bool parsingSuccess = ghost::internal::GenericMessageConverter::parseEnvelope(_any, envelope);
+	ASSERT_TRUE(parsingSuccess);
+	ASSERT_TRUE(envelope.format == TEST_GHOST_MESSAGE_CUSTOM_FORMAT);
+	ASSERT_TRUE(envelope.name == TEST_GHOST_MESSAGE_CUSTOM_TYPE_NAME);
+	ASSERT_TRUE(envelope.serial == TEST_GHOST_MESSAGE_CUSTOM_SERIALIZED);
+	ASSERT_TRUE(envelope.serial.data >= _any.value().data());
+	ASSERT_TRUE(envelope.serial.data + envelope.serial.size <= _any.value().data() + _any.value().size());
+}
+
+TEST_F(MessageTests, test_GenericMessageConverter_parseEnvelopeFails_When_anyFromProtobufIsGiven)
+{
+	bool creationSuccess = ghost::internal::GenericMessageConverter::create(_any, *_message);
+	ASSERT_TRUE(creationSuccess);
+
+	ghost::internal::GenericMessageEnvelope envelope;
+	bool parsingSuccess = ghost::internal::GenericMessageConverter::parseEnvelope(_any, envelope);
+	ASSERT_FALSE(parsingSuccess);
+}
+
+TEST_F(MessageTests, test_GenericMessageConverter_parseToGhostMessageSucceeds_When_serializedMessageIsBinary)
+{
+	const std::string binary("\0\xFF\x80serial\0", 10);
+	setGhostMessageExpectations(_ghostMessage.get(), TEST_GHOST_MESSAGE_CUSTOM_TYPE_NAME, binary);
+	EXPECT_CALL(*_ghostMessage2, deserialize(binary)).Times(1).WillOnce(testing::Return(true));
+
+	bool creationSuccess = ghost::internal::GenericMessageConverter::create(_any, *_ghostMessage);
+	ASSERT_TRUE(creationSuccess);
+	bool parsingSuccess = ghost::internal::GenericMessageConverter::parse(_any, *_ghostMessage2);
+	ASSERT_TRUE(parsingSuccess);
+}
+
+TEST_F(MessageTests, test_GenericMessageConverter_parseToProtobufFails_When_anyFromGhostMessageIsParsedDirectly)
+{
+	bool creationSuccess = ghost::internal::GenericMessageConverter::create(_any, *_ghostMessage);
+	ASSERT_TRUE(creationSuccess);
+
+	google::protobuf::DoubleValue value;
+	bool parsingSuccess = ghost::internal::GenericMessageConverter::parse(_any, value);
+	ASSERT_FALSE(parsingSuccess);
+}
@@ -17,8 +17,11 @@
 #include <google/protobuf/wrappers.pb.h>
 #include <gtest/gtest.h>
 
+#include <future>
 #include <ghost/connection/ReadableConnection.hpp>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 #include "../src/connection/ReaderSink.hpp"
 #include "../src/connection/WriterSink.hpp"
@@ -63,6 +66,32 @@ protected:
 		ASSERT_TRUE(_writerSink);
 	}
 
+	/// Replaces the writable connection by a publisher conflating the string values by their first character.
+	void setupConflatingPublisher()
+	{
+		auto publisher = std::make_shared<PublisherWithSink>(_config);
+		publisher->setConflationKey<google::protobuf::StringValue>(
+		    [](const google::protobuf::StringValue& message) { return message.value().substr(0, 1); });
+		_writable = publisher;
+		_writerSink = std::dynamic_pointer_cast<ghost::internal::WriterSink>(publisher->getSink());
+		_conflationKeys = publisher->getKeys();
+		ASSERT_TRUE(_writerSink);
+	}
+
+	static google::protobuf::StringValue makeString(const std::string& value)
+	{
+		google::protobuf::StringValue message;
+		message.set_value(value);
+		return message;
+	}
+
+	static std::string unpackString(const google::protobuf::Any& any)
+	{
+		google::protobuf::StringValue message;
+		EXPECT_TRUE(any.UnpackTo(&message));
+		return message.value();
+	}
+
 	void getFromWriterSink(bool expected = true)
 	{
 		google::protobuf::Any any;
@@ -104,6 +133,7 @@ protected:
 
 	std::shared_ptr<ghost::WritableConnection> _writable;
 	std::shared_ptr<ghost::internal::WriterSink> _writerSink;
+	std::shared_ptr<const ghost::internal::ConflationKeys> _conflationKeys;
 
 	google::protobuf::DoubleValue _doubleValue;
 	static const double TEST_DOUBLE_VALUE;
@@ -153,6 +183,76 @@ TEST_F(ReaderWriterTests, test_Reader_lastMessageIsAvailable_When_ghostMessageIs
 	ASSERT_TRUE(readLastResult);
 }
 
+TEST_F(ReaderWriterTests, test_Reader_readsMessagesInOrder_When_messagesAreMovedIntoSink)
+{
+	for (int i = 0; i < 3; ++i)
+	{
+		google::protobuf::DoubleValue value;
+		value.set_value(i);
+		google::protobuf::Any any;
+		any.PackFrom(value);
+		ASSERT_TRUE(_readerSink->put(std::move(any)));
+	}
+	auto reader = makeReader<google::protobuf::DoubleValue>();
+
+	google::protobuf::DoubleValue read, readLast;
+	for (int i = 0; i < 3; ++i)
+	{
+		ASSERT_TRUE(reader->read(read));
+		ASSERT_TRUE(read.value() == i);
+		ASSERT_TRUE(reader->lastRead(readLast));
+		ASSERT_TRUE(readLast.value() == i);
+	}
+}
+
+TEST_F(ReaderWriterTests, test_Reader_readBatchReturnsAtMostMaximum_When_moreMessagesAreAvailable)
+{
+	for (int i = 0; i < 5; ++i) putToReadersink(_doubleValue);
+	auto reader = makeReader<google::protobuf::DoubleValue>();
+
+	std::vector<google::protobuf::DoubleValue> read;
+	ASSERT_TRUE(reader->readBatch(read, 3, std::chrono::milliseconds(0)));
+	ASSERT_TRUE(read.size() == 3);
+	ASSERT_TRUE(reader->readBatch(read, 3, std::chrono::milliseconds(0)));
+	ASSERT_TRUE(read.size() == 5);
+	for (const auto& message : read) ASSERT_TRUE(message.value() == TEST_DOUBLE_VALUE);
+
+	google::protobuf::DoubleValue readLast;
+	ASSERT_TRUE(reader->lastRead(readLast));
+	ASSERT_TRUE(readLast.value() == TEST_DOUBLE_VALUE);
+}
+
+TEST_F(ReaderWriterTests, test_Reader_readBatchSkipsMessages_When_typeIsWrong)
+{
+	google::protobuf::Int32Value otherValue;
+	putToReadersink(_doubleValue);
+	putToReadersink(otherValue);
+	putToReadersink(_doubleValue);
+	auto reader = makeReader<google::protobuf::DoubleValue>();
+
+	std::vector<google::protobuf::DoubleValue> read;
+	ASSERT_TRUE(reader->readBatch(read, 10, std::chrono::milliseconds(0)));
+	ASSERT_TRUE(read.size() == 2);
+}
+
+TEST_F(ReaderWriterTests, test_Reader_readBatchFails_When_connectionWasNonBlockingAndNoMessageWasAvailable)
+{
+	_config.setOperationBlocking(false);
+	setupReader();
+
+	auto reader = makeReader<google::protobuf::DoubleValue>();
+	std::vector<google::protobuf::DoubleValue> read;
+	ASSERT_FALSE(reader->readBatch(read, 10, std::chrono::seconds(10)));
+	ASSERT_TRUE(read.empty());
+}
+
+TEST_F(ReaderWriterTests, test_Reader_readBatchTimesOut_When_noMessageIsAvailable)
+{
+	auto reader = makeReader<google::protobuf::DoubleValue>();
+	std::vector<google::protobuf::DoubleValue> read;
+	ASSERT_FALSE(reader->readBatch(read, 10, std::chrono::milliseconds(10)));
+}
+
 TEST_F(ReaderWriterTests, test_Reader_readFails_When_passedProtobufMessageTypeIsWrong)
 {
 	putToReadersink(_doubleValue);
@@ -236,6 +336,23 @@ TEST_F(ReaderWriterTests,
 	ASSERT_TRUE(handlerCount == 1);
 }
 
+TEST_F(ReaderWriterTests, test_ReaderSink_countsReceivedMessages_When_messagesArePut)
+{
+	putToReadersink(_doubleValue);
+	putToReadersink(_doubleValue);
+	auto reader = makeReader<google::protobuf::DoubleValue>();
+	google::protobuf::DoubleValue read;
+	ASSERT_TRUE(reader->read(read));
+
+	ghost::ConnectionStatistics statistics;
+	_readerSink->addStatistics(statistics);
+	ASSERT_TRUE(statistics.messagesIn == 2);
+	ASSERT_TRUE(statistics.bytesIn == 2 * _doubleValue.ByteSizeLong());
+	ASSERT_TRUE(statistics.readerQueueDepth == 1);
+	ASSERT_TRUE(statistics.readerQueuePeakDepth == 2);
+	ASSERT_TRUE(statistics.messagesOut == 0);
+}
+
 TEST_F(ReaderWriterTests, test_ReaderSink_messageHandlerDoesNotHandleMessage_When_noCorrespondingHandlerExists)
 {
 	auto messageHandler = _readable->addMessageHandler();
@@ -247,6 +364,164 @@ TEST_F(ReaderWriterTests, test_ReaderSink_messageHandlerDoesNotHandleMessage_Whe
 	ASSERT_TRUE(handlerCount == 0);
 }
 
+TEST_F(ReaderWriterTests, test_ReaderSink_messageHandlerDoesNotHandleGhostMessage_When_typeNameIsDifferent)
+{
+	auto messageHandler = _readable->addMessageHandler();
+	int handlerCount = 0;
+	messageHandler->addHandler<MessageMock>([&](const MessageMock& value) { handlerCount++; });
+
+	putToReadersink(*_otherTypeGhostMessage);
+	ASSERT_TRUE(handlerCount == 0);
+}
+
+TEST_F(ReaderWriterTests, test_ReaderSink_messageHandlerHandlesProtobufMessage_When_typeUrlHasAnotherPrefix)
+{
+	auto messageHandler = _readable->addMessageHandler();
+	int handlerCount = 0;
+	messageHandler->addHandler<google::protobuf::DoubleValue>(
+	    [&](const google::protobuf::DoubleValue& value) { handlerCount += value.value() == TEST_DOUBLE_VALUE; });
+
+	google::protobuf::Any any;
+	any.PackFrom(_doubleValue, "ghost.test/prefix");
+	ASSERT_TRUE(_readerSink->put(any));
+	ASSERT_TRUE(handlerCount == 1);
+}
+
+TEST_F(ReaderWriterTests, test_ReaderSink_messageHandlerUsesLastHandler_When_handlerIsReplaced)
+{
+	auto messageHandler = _readable->addMessageHandler();
+	int firstCount = 0, secondCount = 0;
+	messageHandler->addHandler<google::protobuf::DoubleValue>(
+	    [&](const google::protobuf::DoubleValue& value) { firstCount++; });
+	messageHandler->addHandler<google::protobuf::DoubleValue>(
+	    [&](const google::protobuf::DoubleValue& value) { secondCount++; });
+
+	putToReadersink(_doubleValue);
+	ASSERT_TRUE(firstCount == 0);
+	ASSERT_TRUE(secondCount == 1);
+}
+
+TEST_F(ReaderWriterTests, test_ReaderSink_messageHandlerParsesMessagesInArena_When_messageArenaSizeIsConfigured)
+{
+	_config.setMessageArenaSize(1024);
+	setupReader();
+	auto messageHandler = _readable->addMessageHandler();
+	int handlerCount = 0;
+	google::protobuf::Arena* firstArena = nullptr;
+	messageHandler->addHandler<google::protobuf::DoubleValue>([&](const google::protobuf::DoubleValue& value) {
+		ASSERT_TRUE(value.GetArena() != nullptr);
+		ASSERT_TRUE(value.value() == TEST_DOUBLE_VALUE);
+		if (!firstArena) firstArena = value.GetArena();
+		handlerCount += value.GetArena() == firstArena; // the arena is recycled
+	});
+
+	putToReadersink(_doubleValue);
+	putToReadersink(_doubleValue);
+	ASSERT_TRUE(handlerCount == 2);
+}
+
+TEST_F(ReaderWriterTests, test_ReaderSink_messageHandlerParsesBatchInOneArena_When_handlerThreadsAreConfigured)
+{
+	_config.setMessageArenaSize(1024);
+	_config.setHandlerThreadCount(1);
+	setupReader();
+	auto messageHandler = _readable->addMessageHandler();
+	std::promise<void> entered;
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future().share();
+	std::promise<void> done;
+	std::vector<google::protobuf::Arena*> arenas;
+	std::vector<uint64_t> spaceUsed;
+	messageHandler->addHandler<google::protobuf::DoubleValue>([&](const google::protobuf::DoubleValue& value) {
+		arenas.push_back(value.GetArena());
+		spaceUsed.push_back(value.GetArena()->SpaceUsed());
+		if (arenas.size() == 1)
+		{
+			entered.set_value();
+			released.wait();
+		}
+		if (arenas.size() == 4) done.set_value();
+	});
+
+	// the next messages are queued while the handler thread processes the first one: they form one batch
+	putToReadersink(_doubleValue);
+	entered.get_future().wait();
+	for (int i = 0; i < 3; ++i) putToReadersink(_doubleValue);
+	release.set_value();
+
+	ASSERT_TRUE(done.get_future().wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+	ASSERT_TRUE(arenas[1] != nullptr);
+	ASSERT_TRUE(arenas[2] == arenas[1] && arenas[3] == arenas[1]);
+	// the arena is not reset between the messages of the batch
+	ASSERT_TRUE(spaceUsed[1] < spaceUsed[2] && spaceUsed[2] < spaceUsed[3]);
+}
+
+TEST_F(ReaderWriterTests, test_ReaderSink_messageHandlerHandlesMessagesInOrder_When_handlerThreadsAreConfigured)
+{
+	_config.setHandlerThreadCount(2);
+	setupReader();
+	auto messageHandler = _readable->addMessageHandler();
+	std::mutex mutex;
+	std::vector<double> handled;
+	std::promise<void> done;
+	std::thread::id callerId = std::this_thread::get_id();
+	messageHandler->addHandler<google::protobuf::DoubleValue>([&](const google::protobuf::DoubleValue& value) {
+		std::lock_guard<std::mutex> lock(mutex);
+		EXPECT_TRUE(std::this_thread::get_id() != callerId);
+		handled.push_back(value.value());
+		if (handled.size() == 100) done.set_value();
+	});
+
+	google::protobuf::DoubleValue message;
+	for (int i = 0; i < 100; ++i)
+	{
+		message.set_value(i);
+		putToReadersink(message);
+	}
+
+	ASSERT_TRUE(done.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+	std::lock_guard<std::mutex> lock(mutex);
+	for (int i = 0; i < 100; ++i) ASSERT_TRUE(handled[i] == i);
+}
+
+TEST_F(ReaderWriterTests, test_ReaderSink_messageHandlerHandlesKeysInParallel_When_handlerThreadsAreConfigured)
+{
+	_config.setHandlerThreadCount(2);
+	setupReader();
+	auto messageHandler = _readable->addMessageHandler();
+	messageHandler->setOrderingKey([](const google::protobuf::Any& message) {
+		return message.Is<google::protobuf::DoubleValue>() ? 0 : 1;
+	});
+
+	std::promise<void> otherHandled;
+	std::shared_future<void> otherHandledFuture = otherHandled.get_future().share();
+	std::promise<bool> blockedHandled;
+	messageHandler->addHandler<google::protobuf::DoubleValue>([&](const google::protobuf::DoubleValue& value) {
+		// this handler only returns once the message of the other key was handled
+		blockedHandled.set_value(otherHandledFuture.wait_for(std::chrono::seconds(5)) ==
+					 std::future_status::ready);
+	});
+	messageHandler->addHandler<google::protobuf::Int32Value>(
+	    [&](const google::protobuf::Int32Value& value) { otherHandled.set_value(); });
+
+	putToReadersink(_doubleValue);
+	putToReadersink(google::protobuf::Int32Value());
+	ASSERT_TRUE(blockedHandled.get_future().get());
+
+	// the metrics are updated once the handlers returned
+	auto metrics = messageHandler->getDispatchMetrics();
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (metrics.handledMessages < 2 && std::chrono::steady_clock::now() < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		metrics = messageHandler->getDispatchMetrics();
+	}
+	ASSERT_TRUE(metrics.handledMessages == 2);
+	ASSERT_TRUE(metrics.backlog == 0);
+	ASSERT_TRUE(metrics.maximumHandlerTime > std::chrono::nanoseconds(0));
+	ASSERT_TRUE(metrics.totalHandlerTime >= metrics.maximumHandlerTime);
+}
+
 /* Writer - WriterSink - WritableConnection */
 
 TEST_F(ReaderWriterTests, test_WritableConnection_messageGoesToSink_When_protobufMessageOfProperTypeIsPassedToWriter)
@@ -323,4 +598,529 @@ TEST_F(ReaderWriterTests, test_WriterSink_getFromSinkFails_When_sinkWasDrained)
 
 	_writerSink->drain();
 	getFromWriterSink(false);
-}
\ No newline at end of file
+}
+TEST_F(ReaderWriterTests, test_WriterSink_writeFails_When_queueIsFullAndPolicyIsFail)
+{
+	_config.setOperationBlocking(false);
+	_config.setWriterQueueDepth(1);
+	_config.setWriterOverflowPolicy(ghost::ConnectionConfiguration::OverflowPolicy::FAIL);
+	setupWriter();
+	auto writer = _writable->getWriter<google::protobuf::DoubleValue>();
+
+	ASSERT_TRUE(writer->write(_doubleValue));
+	ASSERT_FALSE(writer->write(_doubleValue));
+	ASSERT_TRUE(_writable->getDroppedWriteMessagesCount() == 1);
+
+	getFromWriterSink();
+	ASSERT_TRUE(writer->write(_doubleValue));
+}
+
+TEST_F(ReaderWriterTests, test_WriterSink_writeFails_When_queueIsFullAndBlockTimedOut)
+{
+	_config.setOperationBlocking(false);
+	_config.setWriterQueueDepth(1);
+	_config.setOverflowTimeout(std::chrono::milliseconds(10));
+	setupWriter();
+	auto writer = _writable->getWriter<google::protobuf::DoubleValue>();
+
+	ASSERT_TRUE(writer->write(_doubleValue));
+	ASSERT_FALSE(writer->write(_doubleValue));
+	ASSERT_TRUE(_writable->getDroppedWriteMessagesCount() == 1);
+}
+
+TEST_F(ReaderWriterTests, test_WriterSink_newMessageIsDropped_When_queueIsFullAndPolicyIsDropNewest)
+{
+	_config.setOperationBlocking(false);
+	_config.setWriterQueueDepth(1);
+	_config.setWriterOverflowPolicy(ghost::ConnectionConfiguration::OverflowPolicy::DROP_NEWEST);
+	setupWriter();
+	auto writer = _writable->getWriter<google::protobuf::DoubleValue>();
+
+	ASSERT_TRUE(writer->write(_doubleValue));
+	ASSERT_TRUE(writer->write(_doubleValue));
+	ASSERT_TRUE(_writable->getDroppedWriteMessagesCount() == 1);
+
+	getFromWriterSink();
+	getFromWriterSink(false);
+}
+
+TEST_F(ReaderWriterTests, test_ReaderSink_oldestMessageIsDropped_When_queueIsFullAndPolicyIsDropOldest)
+{
+	_config.setOperationBlocking(false);
+	_config.setReaderQueueDepth(2);
+	_config.setReaderOverflowPolicy(ghost::ConnectionConfiguration::OverflowPolicy::DROP_OLDEST);
+	setupReader();
+
+	for (int i = 0; i < 3; ++i)
+	{
+		_doubleValue.set_value(i);
+		putToReadersink(_doubleValue);
+	}
+	ASSERT_TRUE(_readable->getDroppedReadMessagesCount() == 1);
+
+	auto reader = makeReader<google::protobuf::DoubleValue>();
+	ASSERT_TRUE(reader->read(_doubleValue));
+	ASSERT_TRUE(_doubleValue.value() == 1);
+	ASSERT_TRUE(reader->read(_doubleValue));
+	ASSERT_TRUE(_doubleValue.value() == 2);
+	ASSERT_FALSE(reader->read(_doubleValue));
+}
+
+TEST_F(ReaderWriterTests, test_WriterSink_countsSentAndFailedMessages_When_sinkIsDrained)
+{
+	_config.setOperationBlocking(false);
+	setupWriter();
+	auto writer = _writable->getWriter<google::protobuf::DoubleValue>();
+	ASSERT_TRUE(writer->write(_doubleValue));
+	ASSERT_TRUE(writer->write(_doubleValue));
+	ASSERT_TRUE(writer->write(_doubleValue));
+
+	getFromWriterSink();
+	std::vector<google::protobuf::Any> anys;
+	ASSERT_TRUE(_writerSink->getBatch(anys, 1, std::chrono::milliseconds(0)) == 1);
+	_writerSink->pop();
+
+	ghost::ConnectionStatistics statistics;
+	_writerSink->addStatistics(statistics);
+	ASSERT_TRUE(statistics.messagesOut == 2);
+	ASSERT_TRUE(statistics.bytesOut == 2 * _doubleValue.ByteSizeLong());
+	ASSERT_TRUE(statistics.writerQueueDepth == 1);
+	ASSERT_TRUE(statistics.writerQueuePeakDepth == 3);
+
+	// the remaining message and the following writes are never sent
+	_writerSink->drain();
+	ASSERT_FALSE(writer->write(_doubleValue));
+	statistics = ghost::ConnectionStatistics();
+	_writerSink->addStatistics(statistics);
+	ASSERT_TRUE(statistics.messagesOut == 2);
+	ASSERT_TRUE(statistics.writeFailures == 2);
+	ASSERT_TRUE(statistics.writerQueueDepth == 0);
+}
+
+TEST_F(ReaderWriterTests, test_Writer_writeAsyncCompletes_When_messageIsPoppedFromSink)
+{
+	auto writer = _writable->getWriter<google::protobuf::DoubleValue>();
+	auto result = writer->writeAsync(_doubleValue);
+	ASSERT_TRUE(result.wait_for(std::chrono::milliseconds(0)) == std::future_status::timeout);
+
+	getFromWriterSink();
+	ASSERT_TRUE(result.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+	ASSERT_TRUE(result.get());
+}
+
+TEST_F(ReaderWriterTests, test_Writer_writeAsyncFails_When_sinkIsDrainedBeforeTheMessageIsSent)
+{
+	auto writer = _writable->getWriter<google::protobuf::DoubleValue>();
+	auto result = writer->writeAsync(_doubleValue);
+
+	_writerSink->drain();
+	ASSERT_TRUE(result.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+	ASSERT_FALSE(result.get());
+}
+
+TEST_F(ReaderWriterTests, test_Writer_blockingWriteFails_When_sinkIsDrainedWhileWaiting)
+{
+	auto writer = _writable->getWriter<google::protobuf::DoubleValue>();
+	std::atomic_bool writeResult(true);
+	std::thread t([&]() { writeResult = writer->write(_doubleValue); });
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	_writerSink->drain();
+	t.join();
+	ASSERT_FALSE(writeResult);
+}
+
+TEST_F(ReaderWriterTests, test_Writer_writeAsyncCompletesOnce_When_sinkIsDrainedWhileWritersAndConnectionRun)
+{
+	_config.setQueueType(ghost::ConnectionConfiguration::QueueType::MPSC_RING_BUFFER);
+	setupWriter();
+	auto writer = _writable->getWriter<google::protobuf::DoubleValue>();
+
+	// the connection consumes the sink while it is drained, the writers find it drained at any point
+	std::atomic_bool consuming(true);
+	std::thread connection([&]() {
+		std::vector<google::protobuf::Any> anys;
+		while (consuming)
+		{
+			anys.clear();
+			size_t count = _writerSink->getBatch(anys, 8, std::chrono::milliseconds(1));
+			for (size_t i = 0; i < count; ++i) _writerSink->pop();
+		}
+	});
+
+	std::vector<std::vector<std::future<bool>>> results(4);
+	std::vector<std::thread> writers;
+	for (auto& writerResults : results)
+	{
+		writers.emplace_back([&]() {
+			for (int i = 0; i < 1000; ++i) writerResults.push_back(writer->writeAsync(_doubleValue));
+		});
+	}
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	_writerSink->drain();
+	for (auto& t : writers) t.join();
+	consuming = false;
+	connection.join();
+
+	for (auto& writerResults : results)
+	{
+		for (auto& result : writerResults)
+			ASSERT_TRUE(result.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+	}
+}
+
+TEST_F(ReaderWriterTests, test_Writer_writeAsyncFails_When_messageIsDropped)
+{
+	_config.setWriterQueueDepth(1);
+	_config.setWriterOverflowPolicy(ghost::ConnectionConfiguration::OverflowPolicy::DROP_OLDEST);
+	setupWriter();
+	auto writer = _writable->getWriter<google::protobuf::DoubleValue>();
+
+	auto first = writer->writeAsync(_doubleValue);
+	auto second = writer->writeAsync(_doubleValue);
+	ASSERT_FALSE(first.get());
+
+	getFromWriterSink();
+	ASSERT_TRUE(second.get());
+}
+
+TEST_F(ReaderWriterTests, test_Writer_writeBatchAddsMessagesInOrder_When_connectionIsNonBlocking)
+{
+	_config.setOperationBlocking(false);
+	setupWriter();
+	auto writer = _writable->getWriter<google::protobuf::DoubleValue>();
+
+	std::vector<google::protobuf::DoubleValue> messages(3);
+	for (size_t i = 0; i < messages.size(); ++i) messages[i].set_value(i);
+	ASSERT_TRUE(writer->writeBatch(messages));
+	ASSERT_TRUE(writer->writeBatch(messages.begin(), messages.begin() + 1));
+
+	std::vector<google::protobuf::Any> anys;
+	ASSERT_TRUE(_writerSink->getBatch(anys, 10, std::chrono::milliseconds(0)) == 4);
+	for (size_t i = 0; i < anys.size(); ++i)
+	{
+		google::protobuf::DoubleValue value;
+		ASSERT_TRUE(anys[i].UnpackTo(&value));
+		ASSERT_TRUE(value.value() == i % 3);
+		_writerSink->pop();
+	}
+}
+
+TEST_F(ReaderWriterTests, test_Writer_writeBatchFails_When_batchDoesNotFitInQueue)
+{
+	_config.setOperationBlocking(false);
+	_config.setWriterQueueDepth(2);
+	_config.setWriterOverflowPolicy(ghost::ConnectionConfiguration::OverflowPolicy::FAIL);
+	setupWriter();
+	auto writer = _writable->getWriter<google::protobuf::DoubleValue>();
+
+	std::vector<google::protobuf::DoubleValue> messages(3, _doubleValue);
+	ASSERT_FALSE(writer->writeBatch(messages));
+	ASSERT_TRUE(_writable->getDroppedWriteMessagesCount() == 3);
+	getFromWriterSink(false);
+}
+
+TEST_F(ReaderWriterTests, test_Writer_blockingWriteBatchCompletes_When_lastMessageIsPoppedFromSink)
+{
+	auto writer = _writable->getWriter<google::protobuf::DoubleValue>();
+	std::vector<google::protobuf::DoubleValue> messages(2, _doubleValue);
+	std::atomic_bool writeResult(false);
+	std::thread t([&]() { writeResult = writer->writeBatch(messages); });
+
+	std::vector<google::protobuf::Any> anys;
+	ASSERT_TRUE(_writerSink->getBatch(anys, 10, std::chrono::seconds(1)) == 2);
+	_writerSink->pop();
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	ASSERT_FALSE(writeResult);
+
+	_writerSink->pop();
+	t.join();
+	ASSERT_TRUE(writeResult);
+}
+
+TEST_F(ReaderWriterTests, test_WriterSink_getsHigherPrioritiesFirst_When_priorityIsStrict)
+{
+	_config.setOperationBlocking(false);
+	_config.setPriorityWeight(0);
+	setupWriter();
+	auto low = _writable->getWriter<google::protobuf::DoubleValue>(ghost::MessagePriority::LOW);
+	auto normal = _writable->getWriter<google::protobuf::DoubleValue>();
+	auto high = _writable->getWriter<google::protobuf::DoubleValue>(ghost::MessagePriority::HIGH);
+
+	for (int i = 0; i < 2; ++i)
+	{
+		google::protobuf::DoubleValue message;
+		message.set_value(i);
+		ASSERT_TRUE(low->write(message));
+		message.set_value(10 + i);
+		ASSERT_TRUE(normal->write(message));
+		message.set_value(20 + i);
+		ASSERT_TRUE(high->write(message));
+	}
+
+	std::vector<google::protobuf::Any> anys;
+	ASSERT_TRUE(_writerSink->getBatch(anys, 10, std::chrono::milliseconds(0)) == 6);
+	std::vector<double> expected{20, 21, 10, 11, 0, 1};
+	for (size_t i = 0; i < anys.size(); ++i)
+	{
+		google::protobuf::DoubleValue value;
+		ASSERT_TRUE(anys[i].UnpackTo(&value));
+		ASSERT_TRUE(value.value() == expected[i]);
+		_writerSink->pop();
+	}
+}
+
+TEST_F(ReaderWriterTests, test_WriterSink_lowerPriorityIsNotStarved_When_priorityWeightIsSet)
+{
+	_config.setOperationBlocking(false);
+	_config.setPriorityWeight(3);
+	setupWriter();
+	auto low = _writable->getWriter<google::protobuf::DoubleValue>(ghost::MessagePriority::LOW);
+	auto normal = _writable->getWriter<google::protobuf::DoubleValue>();
+	for (int i = 0; i < 8; ++i)
+	{
+		ASSERT_TRUE(low->write(_doubleValue));
+		ASSERT_TRUE(normal->write(_doubleValue));
+	}
+
+	// the normal lane lets one low priority message through every 3 messages
+	std::vector<size_t> expected{3, 1, 3, 1};
+	for (size_t count : expected)
+	{
+		std::vector<google::protobuf::Any> anys;
+		ghost::MessagePriority priority;
+		ASSERT_TRUE(_writerSink->getBatch(anys, 10, std::chrono::milliseconds(0), priority) == count);
+		ASSERT_TRUE(priority == (count == 3 ? ghost::MessagePriority::NORMAL : ghost::MessagePriority::LOW));
+		for (size_t i = 0; i < count; ++i) _writerSink->pop();
+	}
+
+	std::vector<google::protobuf::Any> anys;
+	ASSERT_TRUE(_writerSink->getBatch(anys, 10, std::chrono::milliseconds(0)) == 8);
+}
+
+TEST_F(ReaderWriterTests, test_WriterSink_popRemovesGottenMessage_When_higherPriorityIsWrittenInBetween)
+{
+	_config.setOperationBlocking(false);
+	setupWriter();
+	auto normal = _writable->getWriter<google::protobuf::DoubleValue>();
+	auto high = _writable->getWriter<google::protobuf::DoubleValue>(ghost::MessagePriority::HIGH);
+	ASSERT_TRUE(normal->write(_doubleValue));
+
+	google::protobuf::Any any;
+	ASSERT_TRUE(_writerSink->get(any, std::chrono::milliseconds(0)));
+	google::protobuf::DoubleValue highValue;
+	highValue.set_value(1);
+	ASSERT_TRUE(high->write(highValue));
+	_writerSink->pop();
+
+	google::protobuf::DoubleValue value;
+	ASSERT_TRUE(_writerSink->get(any, std::chrono::milliseconds(0)));
+	ASSERT_TRUE(any.UnpackTo(&value));
+	ASSERT_TRUE(value.value() == 1);
+	_writerSink->pop();
+	ASSERT_FALSE(_writerSink->get(any, std::chrono::milliseconds(0)));
+}
+
+TEST_F(ReaderWriterTests, test_WriterSink_getBatchWakesUp_When_messageIsWrittenInAnotherLane)
+{
+	_config.setOperationBlocking(false);
+	setupWriter();
+	auto normal = _writable->getWriter<google::protobuf::DoubleValue>();
+	auto high = _writable->getWriter<google::protobuf::DoubleValue>(ghost::MessagePriority::HIGH);
+	ASSERT_TRUE(normal->write(_doubleValue));
+	std::vector<google::protobuf::Any> anys;
+	ASSERT_TRUE(_writerSink->getBatch(anys, 10, std::chrono::milliseconds(0)) == 1);
+	_writerSink->pop();
+
+	std::thread t([&]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		high->write(_doubleValue);
+	});
+	anys.clear();
+	ASSERT_TRUE(_writerSink->getBatch(anys, 10, std::chrono::seconds(5)) == 1);
+	t.join();
+}
+
+TEST_F(ReaderWriterTests, test_WriterSink_callsMessagesAvailableCallback_When_messagesAreWritten)
+{
+	_config.setOperationBlocking(false);
+	setupWriter();
+	int notifications = 0;
+	_writerSink->setMessagesAvailableCallback([&] { notifications++; });
+
+	auto writer = _writable->getWriter<google::protobuf::DoubleValue>();
+	ASSERT_TRUE(writer->write(_doubleValue));
+	ASSERT_TRUE(notifications == 1);
+	std::vector<google::protobuf::DoubleValue> messages(2, _doubleValue);
+	ASSERT_TRUE(writer->writeBatch(messages));
+	ASSERT_TRUE(notifications == 2);
+
+	// a drained sink refuses the messages and does not notify
+	_writerSink->drain();
+	ASSERT_FALSE(writer->write(_doubleValue));
+	ASSERT_TRUE(notifications == 2);
+}
+
+TEST_F(ReaderWriterTests, test_WriterSink_keepsLastMessagePerKey_When_publisherHasConflationKey)
+{
+	_config.setOperationBlocking(false);
+	setupConflatingPublisher();
+	auto writer = _writable->getWriter<google::protobuf::StringValue>();
+	auto doubleWriter = _writable->getWriter<google::protobuf::DoubleValue>();
+	for (const char* value : {"a1", "b1", "a2", "c1", "a3"}) ASSERT_TRUE(writer->write(makeString(value)));
+	// the other types are not conflated
+	ASSERT_TRUE(doubleWriter->write(_doubleValue));
+	ASSERT_TRUE(doubleWriter->write(_doubleValue));
+	ASSERT_TRUE(_writerSink->getQueueDepth() == 5);
+
+	// the last value of "a" took the place of the first one
+	std::vector<google::protobuf::Any> anys;
+	ASSERT_TRUE(_writerSink->getBatch(anys, 10, std::chrono::milliseconds(0)) == 5);
+	std::vector<std::string> expected{"a3", "b1", "c1"};
+	for (size_t i = 0; i < expected.size(); ++i) ASSERT_TRUE(unpackString(anys[i]) == expected[i]);
+	ASSERT_TRUE(anys[3].Is<google::protobuf::DoubleValue>() && anys[4].Is<google::protobuf::DoubleValue>());
+	for (size_t i = 0; i < anys.size(); ++i) _writerSink->pop();
+
+	ghost::ConnectionStatistics statistics;
+	_writerSink->addStatistics(statistics);
+	ASSERT_TRUE(statistics.messagesOut == 5);
+	ASSERT_TRUE(statistics.conflatedMessages == 2);
+
+	// once sent, a key is queued again
+	ASSERT_TRUE(writer->write(makeString("a4")));
+	anys.clear();
+	ASSERT_TRUE(_writerSink->getBatch(anys, 10, std::chrono::milliseconds(0)) == 1);
+	ASSERT_TRUE(unpackString(anys[0]) == "a4");
+}
+
+TEST_F(ReaderWriterTests, test_WriterSink_keepsPendingMessage_When_conflatedBatchIsRejected)
+{
+	_config.setOperationBlocking(false);
+	_config.setWriterQueueDepth(1);
+	_config.setWriterOverflowPolicy(ghost::ConnectionConfiguration::OverflowPolicy::FAIL);
+	setupConflatingPublisher();
+	auto writer = _writable->getWriter<google::protobuf::StringValue>();
+	ASSERT_TRUE(writer->write(makeString("a1")));
+
+	// "b1" does not fit in the queue: the whole batch is rejected, "a2" included
+	std::vector<google::protobuf::StringValue> batch{makeString("a2"), makeString("b1")};
+	ASSERT_FALSE(writer->writeBatch(batch));
+
+	std::vector<google::protobuf::Any> anys;
+	ASSERT_TRUE(_writerSink->getBatch(anys, 10, std::chrono::milliseconds(0)) == 1);
+	ASSERT_TRUE(unpackString(anys[0]) == "a1");
+
+	ghost::ConnectionStatistics statistics;
+	_writerSink->addStatistics(statistics);
+	ASSERT_TRUE(statistics.conflatedMessages == 0);
+}
+
+TEST_F(ReaderWriterTests, test_Writer_writeAsyncFails_When_messageIsReplacedByConflation)
+{
+	setupConflatingPublisher();
+	auto writer = _writable->getWriter<google::protobuf::StringValue>();
+	auto replaced = writer->writeAsync(makeString("a1"));
+	auto replacing = writer->writeAsync(makeString("a2"));
+	ASSERT_TRUE(replaced.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+	ASSERT_FALSE(replaced.get());
+
+	getFromWriterSink();
+	ASSERT_TRUE(replacing.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+	ASSERT_TRUE(replacing.get());
+}
+
+TEST_F(ReaderWriterTests, test_WriterSink_getReturnsGottenMessageAgain_When_keyIsWrittenBeforePop)
+{
+	_config.setOperationBlocking(false);
+	setupConflatingPublisher();
+	auto writer = _writable->getWriter<google::protobuf::StringValue>();
+	ASSERT_TRUE(writer->write(makeString("a1")));
+
+	google::protobuf::Any any;
+	ASSERT_TRUE(_writerSink->get(any, std::chrono::milliseconds(0)));
+	ASSERT_TRUE(unpackString(any) == "a1");
+	// the gotten message left the conflation: the new one is queued behind it
+	ASSERT_TRUE(writer->write(makeString("a2")));
+	ASSERT_TRUE(_writerSink->get(any, std::chrono::milliseconds(0)));
+	ASSERT_TRUE(unpackString(any) == "a1");
+	_writerSink->pop();
+
+	ASSERT_TRUE(_writerSink->get(any, std::chrono::milliseconds(0)));
+	ASSERT_TRUE(unpackString(any) == "a2");
+	_writerSink->pop();
+	ASSERT_FALSE(_writerSink->get(any, std::chrono::milliseconds(0)));
+}
+
+TEST_F(ReaderWriterTests, test_Writer_writeAsyncFails_When_conflatedMessageIsDrained)
+{
+	setupConflatingPublisher();
+	auto writer = _writable->getWriter<google::protobuf::StringValue>();
+	auto pending = writer->writeAsync(makeString("a1"));
+	auto other = writer->writeAsync(makeString("b1"));
+	google::protobuf::Any any;
+	ASSERT_TRUE(_writerSink->get(any, std::chrono::milliseconds(0)));
+
+	_writerSink->drain();
+	ASSERT_TRUE(pending.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+	ASSERT_FALSE(pending.get());
+	ASSERT_TRUE(other.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+	ASSERT_FALSE(other.get());
+	ghost::ConnectionStatistics statistics;
+	_writerSink->addStatistics(statistics);
+	ASSERT_TRUE(statistics.writeFailures == 2);
+}
+
+TEST_F(ReaderWriterTests, test_WriterSink_sharesSerializedMessages_When_theyArePushedToSeveralSinks)
+{
+	auto otherSink = std::dynamic_pointer_cast<ghost::internal::WriterSink>(
+	    std::make_shared<WritableConnectionWithSink>(_config)->getSink());
+	ASSERT_TRUE(otherSink);
+
+	std::vector<std::shared_ptr<const ghost::internal::SerializedMessage>> serialized;
+	for (const char* value : {"a1", "b1"})
+	{
+		google::protobuf::Any any;
+		any.PackFrom(makeString(value));
+		serialized.push_back(std::make_shared<ghost::internal::SerializedMessage>(any));
+	}
+	ASSERT_TRUE(_writerSink->pushSerialized(serialized, ghost::MessagePriority::HIGH));
+	ASSERT_TRUE(otherSink->pushSerialized(serialized));
+
+	// the connections writing the serialized messages get the shared ones
+	std::vector<ghost::internal::WriterSinkMessage> messages;
+	ASSERT_TRUE(_writerSink->getBatch(messages, 10, std::chrono::milliseconds(0)) == 2);
+	for (size_t i = 0; i < serialized.size(); ++i) ASSERT_TRUE(messages[i].serialized == serialized[i]);
+	google::protobuf::Any parsed;
+	ASSERT_TRUE(parsed.ParseFromString(messages[0].serialized->bytes));
+	ASSERT_TRUE(unpackString(parsed) == "a1");
+
+	// the others get a copy of the message
+	std::vector<google::protobuf::Any> anys;
+	ASSERT_TRUE(otherSink->getBatch(anys, 10, std::chrono::milliseconds(0)) == 2);
+	ASSERT_TRUE(unpackString(anys[1]) == "b1");
+
+	ghost::ConnectionStatistics statistics;
+	_writerSink->addStatistics(statistics);
+	ASSERT_TRUE(statistics.messagesOut == 2);
+	ASSERT_TRUE(statistics.bytesOut == serialized[0]->payloadSize * 2);
+}
+
+TEST_F(ReaderWriterTests, test_WriterSink_keepsLastSerializedMessagePerKey_When_publisherHasConflationKey)
+{
+	setupConflatingPublisher();
+	std::vector<std::shared_ptr<const ghost::internal::SerializedMessage>> serialized;
+	for (const char* value : {"a1", "b1", "a2"})
+	{
+		google::protobuf::Any any;
+		any.PackFrom(makeString(value));
+		serialized.push_back(std::make_shared<ghost::internal::SerializedMessage>(any, _conflationKeys));
+	}
+	ASSERT_TRUE(_writerSink->pushSerialized(serialized));
+	ASSERT_TRUE(_writerSink->getQueueDepth() == 2);
+
+	std::vector<ghost::internal::WriterSinkMessage> messages;
+	ASSERT_TRUE(_writerSink->getBatch(messages, 10, std::chrono::milliseconds(0)) == 2);
+	ASSERT_TRUE(messages[0].serialized == serialized[2]);
+	ASSERT_TRUE(messages[1].serialized == serialized[1]);
+}
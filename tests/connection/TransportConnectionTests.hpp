@@ -0,0 +1,300 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_TESTS_TRANSPORTCONNECTIONTESTS_HPP
+#define GHOST_TESTS_TRANSPORTCONNECTIONTESTS_HPP
+
+#include <google/protobuf/wrappers.pb.h>
+#include <gtest/gtest.h>
+
+#include <mutex>
+
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <ghost/connection/Reader.hpp>
+#include <ghost/connection/Writer.hpp>
+
+#include "ConnectionTestUtils.hpp"
+
+/**
+ *	Tests shared by the transports, included once by the tests of each transport which instantiate
+ *	them with INSTANTIATE_TYPED_TEST_CASE_P. They group the following test categories:
+ *	- connection factory configuration (API works)
+ *	- Connectivity server-client, subscriber-publisher wrt the connection API
+ *	- Write/Read operations are possible
+ */
+TYPED_TEST_CASE_P(TransportConnectionTests);
+
+TYPED_TEST_P(TransportConnectionTests, test_Connection_populatesConnectionManagerWithRules)
+{
+	ASSERT_TRUE(this->_connectionManager->createServer(this->_config));
+	ASSERT_TRUE(this->_connectionManager->createClient(this->_config));
+	ASSERT_TRUE(this->_connectionManager->createPublisher(this->_config));
+	ASSERT_TRUE(this->_connectionManager->createSubscriber(this->_config));
+}
+
+TYPED_TEST_P(TransportConnectionTests, test_Connection_doesNotCreateConnections_When_configurationIsOfOtherTransport)
+{
+	ghost::NetworkConnectionConfiguration config;
+	ASSERT_FALSE(this->_connectionManager->createServer(config));
+	ASSERT_FALSE(this->_connectionManager->createSubscriber(config));
+}
+
+TYPED_TEST_P(TransportConnectionTests, test_Server_startsAndStop)
+{
+	auto server = this->_connectionManager->createServer(this->_config);
+	ASSERT_TRUE(server->start());
+	ASSERT_TRUE(server->stop());
+	ASSERT_FALSE(server->isRunning());
+	// the address is released
+	ASSERT_TRUE(server->start());
+}
+
+TYPED_TEST_P(TransportConnectionTests, test_Client_doesNotStart_When_noServer)
+{
+	auto client = this->_connectionManager->createClient(this->_config);
+	bool startResult = client->start();
+	ASSERT_FALSE(startResult);
+	ASSERT_FALSE(client->isRunning());
+}
+
+TYPED_TEST_P(TransportConnectionTests, test_Subscriber_doesNotStart_When_noPublisher)
+{
+	auto subscriber = this->_connectionManager->createSubscriber(this->_config);
+	bool startResult = subscriber->start();
+	ASSERT_FALSE(startResult);
+	ASSERT_FALSE(subscriber->isRunning());
+}
+
+TYPED_TEST_P(TransportConnectionTests, test_Server_doesNotStart_When_addressIsAlreadyUsed)
+{
+	auto server = this->_connectionManager->createServer(this->_config);
+	ASSERT_TRUE(server->start());
+	auto publisher = this->_connectionManager->createPublisher(this->_config);
+	ASSERT_FALSE(publisher->start());
+}
+
+/* Client / Server connections */
+
+TYPED_TEST_P(TransportConnectionTests, test_Server_supportsMultipleClients)
+{
+	this->createServer(this->_config);
+	this->startServer();
+
+	this->startClients(this->_config, 5);
+	this->waitForClientsHandled();
+}
+
+TYPED_TEST_P(TransportConnectionTests, test_Client_stops_When_clientIsNotKeptAlive)
+{
+	this->createServer(this->_config);
+	this->startServer();
+
+	this->startClients(this->_config, 1);
+	this->waitForClientsHandled();
+	this->waitUntil([&] { return !this->_clients[0]->isRunning(); });
+	ASSERT_FALSE(this->_clients[0]->isRunning());
+}
+
+TYPED_TEST_P(TransportConnectionTests, test_Server_allowsConfigurationBeforeClientHandling)
+{
+	this->createServer(this->_config);
+	this->startServer();
+
+	EXPECT_CALL(*this->_clientHandlerMock, configureClient(testing::_))
+	    .Times(1)
+	    .WillRepeatedly([&](const std::shared_ptr<ghost::Client>& client) {
+		    auto handler = client->addMessageHandler();
+		    handler->addHandler<google::protobuf::DoubleValue>(
+			[this](const google::protobuf::DoubleValue& message) { this->doubleMessageHandler(message); });
+	    });
+	EXPECT_CALL(*this->_clientHandlerMock, handle(testing::_, testing::_))
+	    .Times(1)
+	    .WillRepeatedly([&](std::shared_ptr<ghost::Client> client, bool& keepClientAlive) {
+		    keepClientAlive = true;
+		    this->_clientsHandledCount++;
+		    return true;
+	    });
+
+	this->startClients(this->_config, 1, false);
+	this->_clients[0]->template getWriter<google::protobuf::DoubleValue>()->write(
+	    google::protobuf::DoubleValue::default_instance());
+	this->waitForClientsHandled();
+	this->waitUntil([&] { return this->_doubleValueMessageWasHandledCounter == 1; });
+	ASSERT_TRUE(this->_doubleValueMessageWasHandledCounter == 1);
+}
+
+TYPED_TEST_P(TransportConnectionTests, test_Client_receivesMessages_When_remoteClientWrites)
+{
+	this->createServer(this->_config);
+	this->startServer();
+
+	EXPECT_CALL(*this->_clientHandlerMock, configureClient(testing::_)).Times(1);
+	EXPECT_CALL(*this->_clientHandlerMock, handle(testing::_, testing::_))
+	    .Times(1)
+	    .WillRepeatedly([&](std::shared_ptr<ghost::Client> client, bool& keepClientAlive) {
+		    google::protobuf::DoubleValue message;
+		    message.set_value(42.0);
+		    client->getWriter<google::protobuf::DoubleValue>()->write(message);
+		    keepClientAlive = true;
+		    return true;
+	    });
+
+	this->startClients(this->_config, 1, false);
+	auto reader = this->_clients[0]->template getReader<google::protobuf::DoubleValue>();
+	std::vector<google::protobuf::DoubleValue> messages;
+	bool readResult = reader->readBatch(messages, 1, std::chrono::seconds(1));
+	ASSERT_TRUE(readResult);
+	ASSERT_TRUE(messages.size() == 1);
+	ASSERT_TRUE(messages[0].value() == 42.0);
+}
+
+TYPED_TEST_P(TransportConnectionTests, test_Server_stops_When_clientHandlerReturnsFalse)
+{
+	this->createServer(this->_config);
+	this->startServer();
+
+	EXPECT_CALL(*this->_clientHandlerMock, configureClient(testing::_)).Times(1);
+	EXPECT_CALL(*this->_clientHandlerMock, handle(testing::_, testing::_))
+	    .Times(1)
+	    .WillOnce(testing::Return(false));
+
+	this->startClients(this->_config, 1, false);
+	this->waitUntil([&] { return !this->_server->isRunning() && !this->_clients[0]->isRunning(); });
+	ASSERT_FALSE(this->_server->isRunning());
+	ASSERT_FALSE(this->_clients[0]->isRunning());
+}
+
+TYPED_TEST_P(TransportConnectionTests, test_Client_stops_When_serverStops)
+{
+	this->createServer(this->_config);
+	this->startServer();
+
+	// the remote client is saved on the server thread and read by the test thread
+	std::mutex remoteMutex;
+	std::shared_ptr<ghost::Client> remote;
+	EXPECT_CALL(*this->_clientHandlerMock, configureClient(testing::_)).Times(1);
+	EXPECT_CALL(*this->_clientHandlerMock, handle(testing::_, testing::_))
+	    .Times(1)
+	    .WillRepeatedly([&](std::shared_ptr<ghost::Client> client, bool& keepClientAlive) {
+		    std::lock_guard<std::mutex> lock(remoteMutex);
+		    remote = client;
+		    keepClientAlive = true;
+		    return true;
+	    });
+
+	this->startClients(this->_config, 1, false);
+	this->waitUntil([&] {
+		std::lock_guard<std::mutex> lock(remoteMutex);
+		return remote != nullptr;
+	});
+	ASSERT_TRUE(this->_clients[0]->isRunning());
+
+	ASSERT_TRUE(this->_server->stop());
+	this->waitUntil([&] { return !this->_clients[0]->isRunning(); });
+	ASSERT_FALSE(this->_clients[0]->isRunning());
+	this->waitUntil([&] { return !remote->isRunning(); });
+	ASSERT_FALSE(remote->isRunning());
+}
+
+/* Subscriber / Publisher connections */
+
+TYPED_TEST_P(TransportConnectionTests, test_Publisher_supportsMultipleSubscribers)
+{
+	this->createPublisher(this->_config);
+
+	int subscribersCount = 10;
+	this->startSubscribers(this->_config, subscribersCount);
+
+	auto writer = this->_publisher->template getWriter<google::protobuf::DoubleValue>();
+	for (int i = 0; i < 3; ++i)
+	{
+		bool writeResult = writer->write(google::protobuf::DoubleValue::default_instance());
+		ASSERT_TRUE(writeResult);
+	}
+
+	this->checkSubscribersReceivedMessages(subscribersCount, 3);
+}
+
+TYPED_TEST_P(TransportConnectionTests, test_Publisher_continuesOperation_When_subscriberStops)
+{
+	this->createPublisher(this->_config);
+
+	int subscribersCount = 2;
+	this->startSubscribers(this->_config, subscribersCount);
+
+	auto writer = this->_publisher->template getWriter<google::protobuf::DoubleValue>();
+	bool writeResult = writer->write(google::protobuf::DoubleValue::default_instance());
+	ASSERT_TRUE(writeResult);
+	this->checkSubscribersReceivedMessages(subscribersCount, 1);
+
+	bool stopResult = this->_subscribers[1]->stop();
+	ASSERT_TRUE(stopResult);
+	ASSERT_FALSE(this->_subscribers[1]->isRunning());
+
+	writeResult = writer->write(google::protobuf::DoubleValue::default_instance());
+	ASSERT_TRUE(writeResult);
+	this->checkSubscribersReceivedMessages(1, 2);
+	ASSERT_TRUE(this->countHandledMessages(1) == 1);
+}
+
+TYPED_TEST_P(TransportConnectionTests, test_Subscriber_stops_When_publisherStops)
+{
+	this->createPublisher(this->_config);
+	this->startSubscribers(this->_config, 1);
+
+	bool stopResult = this->_publisher->stop();
+	ASSERT_TRUE(stopResult);
+	this->waitUntil([&] { return !this->_subscribers[0]->isRunning(); });
+	ASSERT_FALSE(this->_subscribers[0]->isRunning());
+}
+
+/* Latency tracing */
+
+TYPED_TEST_P(TransportConnectionTests, test_Subscriber_measuresLatency_When_latencyTracingIsEnabled)
+{
+	// the header of the latency tracing travels with the envelope of the message through the transport
+	this->_config.setLatencyTracingEnabled(true);
+	this->createPublisher(this->_config);
+	this->startSubscribers(this->_config, 1);
+
+	auto writer = this->_publisher->template getWriter<google::protobuf::DoubleValue>();
+	bool writeResult = writer->write(google::protobuf::DoubleValue::default_instance());
+	ASSERT_TRUE(writeResult);
+	this->checkSubscribersReceivedMessages(1, 1);
+
+	// the latency is recorded once the handler returned
+	this->waitUntil([&] { return this->_subscribers[0]->getLatencyStatistics().endToEnd.samples == 1; });
+	auto statistics = this->_subscribers[0]->getLatencyStatistics();
+	ASSERT_TRUE(statistics.handler.samples == 1);
+	ASSERT_TRUE(statistics.endToEnd.samples == 1);
+	ASSERT_TRUE(statistics.endToEnd.p50 > std::chrono::nanoseconds(0));
+}
+
+REGISTER_TYPED_TEST_CASE_P(TransportConnectionTests, test_Connection_populatesConnectionManagerWithRules,
+			   test_Connection_doesNotCreateConnections_When_configurationIsOfOtherTransport,
+			   test_Server_startsAndStop, test_Client_doesNotStart_When_noServer,
+			   test_Subscriber_doesNotStart_When_noPublisher,
+			   test_Server_doesNotStart_When_addressIsAlreadyUsed, test_Server_supportsMultipleClients,
+			   test_Client_stops_When_clientIsNotKeptAlive,
+			   test_Server_allowsConfigurationBeforeClientHandling,
+			   test_Client_receivesMessages_When_remoteClientWrites,
+			   test_Server_stops_When_clientHandlerReturnsFalse, test_Client_stops_When_serverStops,
+			   test_Publisher_supportsMultipleSubscribers,
+			   test_Publisher_continuesOperation_When_subscriberStops,
+			   test_Subscriber_stops_When_publisherStops,
+			   test_Subscriber_measuresLatency_When_latencyTracingIsEnabled);
+
+#endif // GHOST_TESTS_TRANSPORTCONNECTIONTESTS_HPP
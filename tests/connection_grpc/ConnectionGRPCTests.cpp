@@ -17,6 +17,9 @@
 #include <google/protobuf/wrappers.pb.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <future>
 #include <ghost/connection/ConnectionManager.hpp>
 #include <ghost/connection/NetworkConnectionConfiguration.hpp>
 #include <ghost/connection/Writer.hpp>
@@ -215,6 +218,7 @@ protected:
 	std::map<int, int> _doubleValueMessageWasHandledMap;
 
 	static const int TEST_PORT;
+	static const std::string TEST_SOCKET_PATH;
 
 public:
 	void doubleMessageHandler(const google::protobuf::DoubleValue& message)
@@ -232,6 +236,7 @@ public:
 };
 
 const int ConnectionGRPCTests::TEST_PORT = 5678;
+const std::string ConnectionGRPCTests::TEST_SOCKET_PATH = "/tmp/ghost_connection_grpc_tests.sock";
 
 TEST_F(ConnectionGRPCTests, test_ConnectionGRPC_populatesConnectionManagerWithServerRule)
 {
@@ -319,6 +324,18 @@ TEST_F(ConnectionGRPCTests, test_ServerGRPC_supportsMultipleClients)
 	waitForClientsHandled();
 }
 
+TEST_F(ConnectionGRPCTests, test_ServerGRPC_supportsMultipleClients_When_severalCompletionQueuesAreUsed)
+{
+	_config.setThreadPoolSize(3);
+	_config.setCompletionQueueCount(4); // more queues than threads: every queue still gets one
+	_config.setCpuPinningEnabled(true);
+	createServer(_config);
+	startServer();
+
+	startClients(_config, 8);
+	waitForClientsHandled();
+}
+
 TEST_F(ConnectionGRPCTests, test_ServerGRPC_allowsConfigurationBeforeClientHandling)
 {
 	createServer(_config);
@@ -388,6 +405,91 @@ TEST_F(ConnectionGRPCTests, test_ServerGRPC_stops_When_clientHandlerReturnsFalse
 	ASSERT_FALSE(_server->isRunning());
 }
 
+TEST_F(ConnectionGRPCTests, test_ServerGRPC_disconnectsClients_When_tooManyClientsArePending)
+{
+	_config.setClientHandlerThreadCount(1);
+	_config.setMaximumPendingClients(1);
+	createServer(_config);
+	startServer();
+
+	// the only thread of the client handler is busy until the end of the test
+	std::atomic<bool> released(false);
+	EXPECT_CALL(*_clientHandlerMock, configureClient(_)).Times(2);
+	EXPECT_CALL(*_clientHandlerMock, handle(_, _))
+	    .Times(2)
+	    .WillRepeatedly([&](std::shared_ptr<ghost::Client>, bool&) {
+		    while (!released) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		    _clientsHandledCount++;
+		    return true;
+	    });
+
+	startClients(_config, 3, false);
+	_clientsHandledExpected = 2;
+
+	auto now = std::chrono::steady_clock::now();
+	auto deadline = now + std::chrono::seconds(1);
+	while (_server->getClientHandlerStatistics().rejectedClients == 0 && now < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		now = std::chrono::steady_clock::now();
+	}
+
+	auto statistics = _server->getClientHandlerStatistics();
+	released = true;
+	ASSERT_TRUE(statistics.rejectedClients == 1);
+	ASSERT_TRUE(statistics.pendingClients == 1);
+	ASSERT_TRUE(statistics.pendingClientsPeak == 1);
+
+	waitForClientsHandled();
+	ASSERT_TRUE(_clientsHandledCount == 2);
+	ASSERT_TRUE(_server->getClientHandlerStatistics().acceptToHandle.samples == 2);
+}
+
+TEST_F(ConnectionGRPCTests, test_ServerGRPC_handlesAsManyLongLivedClientsAsThreads_When_moreClientsConnect)
+{
+	_config.setClientHandlerThreadCount(2);
+	_config.setMaximumPendingClients(1);
+	createServer(_config);
+	startServer();
+
+	// the handlers do not return until the test releases them, in the order in which they were called
+	std::atomic<size_t> handled(0);
+	std::atomic<size_t> released(0);
+	EXPECT_CALL(*_clientHandlerMock, configureClient(_)).Times(3);
+	EXPECT_CALL(*_clientHandlerMock, handle(_, _))
+	    .Times(3)
+	    .WillRepeatedly([&](std::shared_ptr<ghost::Client>, bool&) {
+		    size_t index = handled++;
+		    while (released <= index) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		    return true;
+	    });
+
+	// two clients are handled, one waits for a thread and the last one is rejected
+	startClients(_config, 4, false);
+	auto now = std::chrono::steady_clock::now();
+	auto deadline = now + std::chrono::seconds(2);
+	while ((handled < 2 || _server->getClientHandlerStatistics().rejectedClients == 0) && now < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		now = std::chrono::steady_clock::now();
+	}
+	auto statistics = _server->getClientHandlerStatistics();
+	size_t handledBeforeRelease = handled;
+
+	// the waiting client is handled once a handler returns
+	released = 1;
+	deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+	while (handled < 3 && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	size_t handledAfterRelease = handled;
+	released = 3;
+
+	ASSERT_TRUE(handledBeforeRelease == 2);
+	ASSERT_TRUE(statistics.pendingClients == 1);
+	ASSERT_TRUE(statistics.rejectedClients == 1);
+	ASSERT_TRUE(handledAfterRelease == 3);
+}
+
 /* Subscriber / Publisher connections */
 
 TEST_F(ConnectionGRPCTests, test_SubscriberGRPC_connectsToPublisherGRPC)
@@ -454,12 +556,289 @@ TEST_F(ConnectionGRPCTests, test_PublisherGRPC_continuesOperation_When_subscribe
 	ASSERT_FALSE(_subscribers[1]->isRunning());
 }
 
+TEST_F(ConnectionGRPCTests, test_ClientGRPC_connectsToServerGRPC_When_unixSocketIsUsed)
+{
+	auto config = ghost::ConnectionConfigurationGRPC::createForUnixSocket(TEST_SOCKET_PATH);
+	config.setServerPortNumber(TEST_PORT); // the port is part of the minimum configuration of the fixture
+	createServer(config);
+	startServer();
+
+	startClients(config, 1);
+	waitForClientsHandled();
+}
+
+TEST_F(ConnectionGRPCTests, test_SubscriberGRPC_connectsToPublisherGRPC_When_unixSocketIsUsed)
+{
+	auto config = ghost::ConnectionConfigurationGRPC::createForUnixSocket(TEST_SOCKET_PATH);
+	config.setServerPortNumber(TEST_PORT); // the port is part of the minimum configuration of the fixture
+	createPublisher(config);
+	startPublisher();
+
+	int subscribersCount = 2;
+	startSubscribers(config, subscribersCount);
+	setupSubscribers(subscribersCount);
+	waitForSubscribers(subscribersCount);
+
+	auto writer = _publisher->getWriter<google::protobuf::DoubleValue>();
+	bool writeResult = writer->write(google::protobuf::DoubleValue::default_instance());
+	ASSERT_TRUE(writeResult);
+
+	checkSubscribersReceivedMessages(subscribersCount);
+}
+
+/* Compression */
+
+TEST_F(ConnectionGRPCTests, test_ConnectionConfigurationGRPC_returnsCompressionSettings_When_theyAreSet)
+{
+	ghost::ConnectionConfigurationGRPC config;
+	ASSERT_TRUE(config.getCompression() == ghost::ConnectionConfigurationGRPC::Compression::NONE);
+	ASSERT_TRUE(config.getCompressionThreshold() == 1024);
+
+	config.setCompression(ghost::ConnectionConfigurationGRPC::Compression::GZIP);
+	config.setCompressionThreshold(64);
+
+	auto copy = ghost::ConnectionConfigurationGRPC::initializeFrom(config);
+	ASSERT_TRUE(copy.getCompression() == ghost::ConnectionConfigurationGRPC::Compression::GZIP);
+	ASSERT_TRUE(copy.getCompressionThreshold() == 64);
+}
+
+TEST_F(ConnectionGRPCTests, test_ConnectionConfigurationGRPC_returnsCompletionQueueSettings_When_theyAreSet)
+{
+	ghost::ConnectionConfigurationGRPC config;
+	ASSERT_TRUE(config.getCompletionQueueCount() == 1);
+	ASSERT_FALSE(config.isCpuPinningEnabled());
+
+	config.setCompletionQueueCount(8);
+	config.setCpuPinningEnabled(true);
+
+	auto copy = ghost::ConnectionConfigurationGRPC::initializeFrom(config);
+	ASSERT_TRUE(copy.getCompletionQueueCount() == 8);
+	ASSERT_TRUE(copy.isCpuPinningEnabled());
+
+	// a server needs at least one completion queue
+	copy.setCompletionQueueCount(0);
+	ASSERT_TRUE(copy.getCompletionQueueCount() == 1);
+}
+
+TEST_F(ConnectionGRPCTests, test_ConnectionConfigurationGRPC_returnsClientHandlerSettings_When_theyAreSet)
+{
+	ghost::ConnectionConfigurationGRPC config;
+	ASSERT_TRUE(config.getClientHandlerThreadCount() == 8);
+	ASSERT_TRUE(config.getMaximumPendingClients() == 1024);
+
+	config.setClientHandlerThreadCount(2);
+	config.setMaximumPendingClients(16);
+
+	auto copy = ghost::ConnectionConfigurationGRPC::initializeFrom(config);
+	ASSERT_TRUE(copy.getClientHandlerThreadCount() == 2);
+	ASSERT_TRUE(copy.getMaximumPendingClients() == 16);
+
+	// the client handler needs at least one thread
+	copy.setClientHandlerThreadCount(0);
+	ASSERT_TRUE(copy.getClientHandlerThreadCount() == 1);
+}
+
+TEST_F(ConnectionGRPCTests, test_ConnectionConfigurationGRPC_returnsSubscriberLagSettings_When_theyAreSet)
+{
+	using LagPolicy = ghost::ConnectionConfigurationGRPC::SubscriberLagPolicy;
+	ghost::ConnectionConfigurationGRPC config;
+	ASSERT_TRUE(config.getSubscriberLagPolicy() == LagPolicy::DISCONNECT);
+	ASSERT_TRUE(config.getMaximumSubscriberLag() == 0);
+	ASSERT_TRUE(config.getMaximumSubscriberLagDuration() == std::chrono::milliseconds(0));
+
+	config.setSubscriberLagPolicy(LagPolicy::DROP_OLDEST);
+	config.setMaximumSubscriberLag(64);
+	config.setMaximumSubscriberLagDuration(std::chrono::seconds(5));
+
+	auto copy = ghost::ConnectionConfigurationGRPC::initializeFrom(config);
+	ASSERT_TRUE(copy.getSubscriberLagPolicy() == LagPolicy::DROP_OLDEST);
+	ASSERT_TRUE(copy.getMaximumSubscriberLag() == 64);
+	ASSERT_TRUE(copy.getMaximumSubscriberLagDuration() == std::chrono::seconds(5));
+}
+
+TEST_F(ConnectionGRPCTests, test_SubscriberGRPC_receivesMessages_When_compressionIsUsed)
+{
+	ghost::ConnectionConfigurationGRPC config;
+	config.setServerPortNumber(TEST_PORT);
+	config.setCompression(ghost::ConnectionConfigurationGRPC::Compression::GZIP);
+	config.setCompressionThreshold(0); // all the messages are compressed
+	createPublisher(config);
+	startPublisher();
+
+	int subscribersCount = 2;
+	startSubscribers(config, subscribersCount);
+	setupSubscribers(subscribersCount);
+	waitForSubscribers(subscribersCount);
+
+	auto writer = _publisher->getWriter<google::protobuf::DoubleValue>();
+	bool writeResult = writer->write(google::protobuf::DoubleValue::default_instance());
+	ASSERT_TRUE(writeResult);
+
+	checkSubscribersReceivedMessages(subscribersCount);
+}
+
+TEST_F(ConnectionGRPCTests, test_SubscriberGRPC_receivesMessages_When_messagesAreBelowTheCompressionThreshold)
+{
+	ghost::ConnectionConfigurationGRPC config;
+	config.setServerPortNumber(TEST_PORT);
+	config.setCompression(ghost::ConnectionConfigurationGRPC::Compression::DEFLATE);
+	createPublisher(config);
+	startPublisher();
+
+	int subscribersCount = 1;
+	startSubscribers(config, subscribersCount);
+	setupSubscribers(subscribersCount);
+	waitForSubscribers(subscribersCount);
+
+	auto writer = _publisher->getWriter<google::protobuf::DoubleValue>();
+	bool writeResult = writer->write(google::protobuf::DoubleValue::default_instance());
+	ASSERT_TRUE(writeResult);
+
+	checkSubscribersReceivedMessages(subscribersCount);
+}
+
+/* Latency tracing */
+
+TEST_F(ConnectionGRPCTests, test_SubscriberGRPC_measuresEveryStage_When_latencyTracingIsEnabled)
+{
+	ghost::ConnectionConfigurationGRPC config;
+	config.setServerPortNumber(TEST_PORT);
+	config.setLatencyTracingEnabled(true);
+	createPublisher(config);
+	startPublisher();
+
+	int subscribersCount = 1;
+	startSubscribers(config, subscribersCount);
+	setupSubscribers(subscribersCount);
+	waitForSubscribers(subscribersCount);
+
+	auto writer = _publisher->getWriter<google::protobuf::DoubleValue>();
+	bool writeResult = writer->write(google::protobuf::DoubleValue::default_instance());
+	ASSERT_TRUE(writeResult);
+
+	checkSubscribersReceivedMessages(subscribersCount);
+
+	// the latency is recorded once the handler returned
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+	while (_subscribers[0]->getLatencyStatistics().endToEnd.samples == 0 &&
+	       std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	auto statistics = _subscribers[0]->getLatencyStatistics();
+	ASSERT_TRUE(statistics.writerQueue.samples == 1);
+	ASSERT_TRUE(statistics.network.samples == 1);
+	ASSERT_TRUE(statistics.readerQueue.samples == 1);
+	ASSERT_TRUE(statistics.handler.samples == 1);
+	ASSERT_TRUE(statistics.endToEnd.samples == 1);
+	ASSERT_TRUE(statistics.endToEnd.p50 > std::chrono::nanoseconds(0));
+}
+
+TEST_F(ConnectionGRPCTests, test_PublisherGRPC_reportsStatistics_When_messageIsPublished)
+{
+	createPublisher(_config);
+	startPublisher();
+
+	int subscribersCount = 1;
+	startSubscribers(_config, subscribersCount);
+	setupSubscribers(subscribersCount);
+	waitForSubscribers(subscribersCount);
+
+	google::protobuf::DoubleValue message;
+	message.set_value(42);
+	auto writer = _publisher->getWriter<google::protobuf::DoubleValue>();
+	ASSERT_TRUE(writer->write(message));
+
+	checkSubscribersReceivedMessages(subscribersCount);
+
+	auto publisherStatistics = _publisher->getStatistics();
+	ASSERT_TRUE(publisherStatistics.messagesOut == 1);
+	ASSERT_TRUE(publisherStatistics.bytesOut == message.ByteSizeLong());
+	ASSERT_TRUE(publisherStatistics.stateTransitions > 0);
+
+	auto subscriberStatistics = _subscribers[0]->getStatistics();
+	ASSERT_TRUE(subscriberStatistics.messagesIn == 1);
+	ASSERT_TRUE(subscriberStatistics.bytesIn == message.ByteSizeLong());
+	ASSERT_TRUE(subscriberStatistics.stateTransitions > 0);
+}
+
+TEST_F(ConnectionGRPCTests, test_PublisherGRPC_reportsSubscriberLags_When_subscribersCaughtUp)
+{
+	_config.setSubscriberLagPolicy(ghost::ConnectionConfigurationGRPC::SubscriberLagPolicy::DROP_NEWEST);
+	_config.setMaximumSubscriberLag(16);
+	createPublisher(_config);
+	startPublisher();
+
+	int subscribersCount = 2;
+	startSubscribers(_config, subscribersCount);
+	setupSubscribers(subscribersCount);
+	waitForSubscribers(subscribersCount);
+
+	auto writer = _publisher->getWriter<google::protobuf::DoubleValue>();
+	ASSERT_TRUE(writer->write(google::protobuf::DoubleValue::default_instance()));
+	checkSubscribersReceivedMessages(subscribersCount);
+
+	// the queue of a subscriber is emptied once the message is written to its stream
+	auto isCaughtUp = [](const ghost::SubscriberLag& lag) { return lag.messages == 0; };
+	auto lags = _publisher->getSubscriberLags();
+	auto now = std::chrono::steady_clock::now();
+	auto deadline = now + std::chrono::seconds(1);
+	while (!std::all_of(lags.begin(), lags.end(), isCaughtUp) && now < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		lags = _publisher->getSubscriberLags();
+		now = std::chrono::steady_clock::now();
+	}
+
+	ASSERT_TRUE(lags.size() == 2);
+	for (const auto& lag : lags)
+	{
+		ASSERT_TRUE(lag.messages == 0);
+		ASSERT_TRUE(lag.duration == std::chrono::milliseconds(0));
+		ASSERT_TRUE(lag.droppedMessages == 0);
+	}
+}
+
+TEST_F(ConnectionGRPCTests, test_PublisherGRPC_disconnectsLaggingSubscriber_When_publisherStopsSending)
+{
+	_config.setSubscriberLagPolicy(ghost::ConnectionConfigurationGRPC::SubscriberLagPolicy::DISCONNECT);
+	_config.setMaximumSubscriberLagDuration(std::chrono::milliseconds(200));
+	createPublisher(_config);
+	startPublisher();
+
+	// the subscriber stops reading its stream until the end of the test
+	startSubscribers(_config, 1);
+	std::promise<void> resume;
+	std::shared_future<void> resumed = resume.get_future().share();
+	auto handler = _subscribers[0]->addMessageHandler();
+	handler->addHandler<google::protobuf::StringValue>(
+	    [resumed](const google::protobuf::StringValue&) { resumed.wait(); });
+	waitForSubscribers(1);
+
+	// fill the flow control windows of the stream, after which the queue of the subscriber is not emptied
+	google::protobuf::StringValue message;
+	message.set_value(std::string(64 * 1024, 'x'));
+	auto writer = _publisher->getWriter<google::protobuf::StringValue>();
+	for (int i = 0; i < 512; ++i) ASSERT_TRUE(writer->write(message));
+
+	// nothing is published anymore, the lagging subscriber is disconnected anyway
+	auto now = std::chrono::steady_clock::now();
+	auto deadline = now + std::chrono::seconds(5);
+	while (getSubscribersCount() > 0 && now < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		now = std::chrono::steady_clock::now();
+	}
+
+	resume.set_value();
+	ASSERT_TRUE(getSubscribersCount() == 0);
+}
+
 TEST_F(ConnectionGRPCTests, test_ServerGRPC_doesNotHang_When_remoteClientIsAddedWhileStopIsCalled)
 {
 	createServer(_config);
 	startServer();
-	startClients(_config, 1, false);
 
+	// the expectations are set before the client connects, or the handler may stop the server first
 	EXPECT_CALL(*_clientHandlerMock, configureClient(_)).Times(testing::AnyNumber());
 	EXPECT_CALL(*_clientHandlerMock, handle(_, _))
 	    .Times(testing::AnyNumber())
@@ -468,6 +847,8 @@ TEST_F(ConnectionGRPCTests, test_ServerGRPC_doesNotHang_When_remoteClientIsAdded
 		    return true;
 	    });
 
+	startClients(_config, 1, false);
+
 	bool stopResult = _server->stop();
 	ASSERT_TRUE(stopResult);
 }
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <ghost/connection/ConnectionManager.hpp>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <ghost/connection_inproc/ConnectionConfigurationInproc.hpp>
+#include <ghost/connection_inproc/ConnectionInproc.hpp>
+#include <memory>
+
+#include "../../src/connection_inproc/PublisherInproc.hpp"
+#include "../connection/TransportConnectionTests.hpp"
+
+/**
+ *	The in-process connections run the tests shared by the transports, see TransportConnectionTests.hpp.
+ */
+struct InprocTransport
+{
+	using Configuration = ghost::ConnectionConfigurationInproc;
+
+	static const int PORT = 5679;
+
+	static void initialize(const std::shared_ptr<ghost::ConnectionManager>& connectionManager,
+			       const ghost::NetworkConnectionConfiguration& configuration)
+	{
+		ghost::ConnectionInproc::initialize(connectionManager, configuration);
+	}
+
+	static bool hasSubscribers(const std::shared_ptr<ghost::Publisher>& publisher, size_t count)
+	{
+		auto internalPublisher = std::dynamic_pointer_cast<ghost::internal::PublisherInproc>(publisher);
+		return internalPublisher && internalPublisher->countSubscribers() == count;
+	}
+};
+
+INSTANTIATE_TYPED_TEST_CASE_P(Inproc, TransportConnectionTests, InprocTransport);
+
+/**
+ *	This test class groups the tests specific to the in-process connections, the other ones are shared
+ *	by the transports:
+ *	- Release of the connections by the threads forwarding their messages
+ */
+class ConnectionInprocTests : public TransportConnectionTests<InprocTransport>
+{
+};
+
+TEST_F(ConnectionInprocTests, test_PublisherInproc_isReleased_When_deliveryStopsAndReleasesIt)
+{
+	// the writer does not wait for the delivery, which drains the writer sink when it stops the publisher
+	_config.setOperationBlocking(false);
+	// not created by the connection manager, which would keep it alive
+	std::shared_ptr<ghost::Publisher> publisher = std::make_shared<ghost::internal::PublisherInproc>(_config);
+	ASSERT_TRUE(publisher->start());
+	std::weak_ptr<ghost::Publisher> released = publisher;
+	auto writer = publisher->getWriter<google::protobuf::DoubleValue>();
+
+	// the handler is called by the thread forwarding the messages of the publisher
+	std::atomic_bool handled(false);
+	auto subscriber = _connectionManager->createSubscriber(_config);
+	auto handler = subscriber->addMessageHandler();
+	handler->addHandler<google::protobuf::DoubleValue>([&](const google::protobuf::DoubleValue& message) {
+		publisher->stop();
+		publisher.reset();
+		handled = true;
+	});
+	ASSERT_TRUE(subscriber->start());
+
+	ASSERT_TRUE(writer->write(google::protobuf::DoubleValue::default_instance()));
+	waitUntil([&] { return handled && released.expired(); });
+	ASSERT_TRUE(handled);
+	ASSERT_TRUE(released.expired());
+	ASSERT_FALSE(subscriber->isRunning());
+}
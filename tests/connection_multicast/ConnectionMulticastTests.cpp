@@ -0,0 +1,238 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <arpa/inet.h>
+#include <google/protobuf/wrappers.pb.h>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <ghost/connection/ConnectionManager.hpp>
+#include <ghost/connection/Writer.hpp>
+#include <ghost/connection_multicast/ConnectionConfigurationMulticast.hpp>
+#include <ghost/connection_multicast/ConnectionMulticast.hpp>
+#include <mutex>
+#include <thread>
+
+#include "../../src/connection_multicast/Datagram.hpp"
+#include "../../src/connection_multicast/SubscriberMulticast.hpp"
+#include "../connection/ConnectionTestUtils.hpp"
+
+using namespace ghost;
+
+/**
+ *	This test class groups the following test categories:
+ *	- connection factory configuration (API works)
+ *	- Connectivity subscriber-publisher on the loopback interface
+ *	- Fragmentation of large messages
+ *	- Detection and handling of lost messages
+ */
+class ConnectionMulticastTests : public testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		_connectionManager = ghost::ConnectionManager::create();
+		ghost::ConnectionMulticast::initialize(_connectionManager, _config);
+
+		_config.setServerIpAddress(TEST_GROUP);
+		_config.setServerPortNumber(TEST_PORT);
+		_config.setInterfaceAddress("127.0.0.1");
+
+		_receivedCount = 0;
+	}
+
+	void TearDown() override
+	{
+		_connectionManager.reset();
+	}
+
+	void createPublisher(const ghost::NetworkConnectionConfiguration& config)
+	{
+		_publisher = _connectionManager->createPublisher(config);
+		ASSERT_TRUE(_publisher);
+		ASSERT_FALSE(_publisher->isRunning());
+		bool startResult = _publisher->start();
+		ASSERT_TRUE(startResult);
+		ASSERT_TRUE(_publisher->isRunning());
+	}
+
+	std::shared_ptr<ghost::Subscriber> startSubscriber(const ghost::NetworkConnectionConfiguration& config)
+	{
+		auto subscriber = _connectionManager->createSubscriber(config);
+		EXPECT_TRUE(subscriber);
+		auto handler = subscriber->addMessageHandler();
+		handler->addHandler<google::protobuf::Int32Value>(
+		    [this](const google::protobuf::Int32Value& message) { _receivedCount++; });
+		EXPECT_TRUE(subscriber->start());
+		EXPECT_TRUE(subscriber->isRunning());
+		return subscriber;
+	}
+
+	/// Sends the datagrams of a publisher of identifier "source" directly, skipping the ones listed.
+	void sendDatagrams(uint64_t source, int messageCount, const std::vector<int>& skipped)
+	{
+		int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+		ASSERT_TRUE(fd >= 0);
+		in_addr interface;
+		inet_pton(AF_INET, "127.0.0.1", &interface);
+		setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &interface, sizeof(interface));
+		sockaddr_in group{};
+		group.sin_family = AF_INET;
+		group.sin_port = htons(TEST_PORT);
+		inet_pton(AF_INET, TEST_GROUP.c_str(), &group.sin_addr);
+
+		internal::DatagramBatch batch(source, 1472);
+		for (int i = 0; i < messageCount; ++i)
+		{
+			google::protobuf::Int32Value value;
+			value.set_value(i);
+			google::protobuf::Any message;
+			message.PackFrom(value);
+			std::string serialized = message.SerializeAsString();
+
+			batch.clear();
+			ASSERT_TRUE(batch.add(serialized));
+			if (std::find(skipped.begin(), skipped.end(), i) != skipped.end()) continue;
+
+			std::string datagram(reinterpret_cast<const char*>(batch.getHeader(0)),
+					     internal::DatagramHeader::SIZE);
+			datagram += serialized;
+			::sendto(fd, datagram.data(), datagram.size(), 0, reinterpret_cast<sockaddr*>(&group),
+				 sizeof(group));
+		}
+		::close(fd);
+	}
+
+	void waitUntil(const std::function<bool()>& condition)
+	{
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+		while (!condition() && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	std::shared_ptr<ghost::ConnectionManager> _connectionManager;
+	ghost::ConnectionConfigurationMulticast _config;
+	std::shared_ptr<ghost::Publisher> _publisher;
+	std::atomic_int _receivedCount;
+
+	static const std::string TEST_GROUP;
+	static const int TEST_PORT;
+};
+
+const std::string ConnectionMulticastTests::TEST_GROUP = "239.255.42.1";
+const int ConnectionMulticastTests::TEST_PORT = 5700;
+
+TEST_F(ConnectionMulticastTests, test_ConnectionMulticast_populatesConnectionManagerWithRules)
+{
+	ASSERT_TRUE(_connectionManager->createPublisher(_config));
+	ASSERT_TRUE(_connectionManager->createSubscriber(_config));
+	// multicast groups have no servers nor clients
+	ASSERT_FALSE(_connectionManager->createServer(_config));
+	ASSERT_FALSE(_connectionManager->createClient(_config));
+}
+
+TEST_F(ConnectionMulticastTests, test_ConnectionMulticast_doesNotStart_When_addressIsNotMulticast)
+{
+	_config.setServerIpAddress("127.0.0.1");
+	auto publisher = _connectionManager->createPublisher(_config);
+	ASSERT_FALSE(publisher->start());
+	auto subscriber = _connectionManager->createSubscriber(_config);
+	ASSERT_FALSE(subscriber->start());
+}
+
+TEST_F(ConnectionMulticastTests, test_PublisherMulticast_sendsMessagesToAllSubscribers)
+{
+	std::vector<std::shared_ptr<ghost::Subscriber>> subscribers;
+	for (int i = 0; i < 3; ++i) subscribers.push_back(startSubscriber(_config));
+	createPublisher(_config);
+
+	auto writer = _publisher->getWriter<google::protobuf::Int32Value>();
+	for (int i = 0; i < 10; ++i) ASSERT_TRUE(writer->write(google::protobuf::Int32Value::default_instance()));
+
+	waitUntil([&] { return _receivedCount >= 30; });
+	ASSERT_TRUE(_receivedCount == 30);
+	for (const auto& subscriber : subscribers)
+	{
+		auto internalSubscriber = std::dynamic_pointer_cast<ghost::internal::SubscriberMulticast>(subscriber);
+		ASSERT_TRUE(internalSubscriber->getLostCount() == 0);
+	}
+}
+
+TEST_F(ConnectionMulticastTests, test_SubscriberMulticast_measuresLatency_When_latencyTracingIsEnabled)
+{
+	// the header of the latency tracing travels with the envelope of the message in the datagrams
+	_config.setLatencyTracingEnabled(true);
+	auto subscriber = startSubscriber(_config);
+	createPublisher(_config);
+
+	ASSERT_TRUE(_publisher->getWriter<google::protobuf::Int32Value>()->write(google::protobuf::Int32Value()));
+	waitUntil([&] { return subscriber->getLatencyStatistics().endToEnd.samples == 1; });
+
+	auto statistics = subscriber->getLatencyStatistics();
+	ASSERT_TRUE(_receivedCount == 1);
+	ASSERT_TRUE(statistics.handler.samples == 1);
+	ASSERT_TRUE(statistics.endToEnd.samples == 1);
+	ASSERT_TRUE(statistics.endToEnd.p50 > std::chrono::nanoseconds(0));
+}
+
+TEST_F(ConnectionMulticastTests, test_SubscriberMulticast_receivesMessage_When_messageIsFragmented)
+{
+	_config.setMaximumDatagramSize(512);
+	auto subscriber = _connectionManager->createSubscriber(_config);
+	ASSERT_TRUE(subscriber->start());
+	createPublisher(_config);
+
+	google::protobuf::BytesValue message;
+	message.set_value(std::string(100 * 1024, 'g'));
+	ASSERT_TRUE(_publisher->getWriter<google::protobuf::BytesValue>()->write(message));
+
+	auto reader = subscriber->getReader<google::protobuf::BytesValue>();
+	std::vector<google::protobuf::BytesValue> messages;
+	bool readResult = reader->readBatch(messages, 1, std::chrono::seconds(1));
+	ASSERT_TRUE(readResult);
+	ASSERT_TRUE(messages.size() == 1);
+	ASSERT_TRUE(messages[0].value() == message.value());
+}
+
+TEST_F(ConnectionMulticastTests, test_SubscriberMulticast_countsLostMessages_When_datagramsAreMissing)
+{
+	auto subscriber = startSubscriber(_config);
+	auto internalSubscriber = std::dynamic_pointer_cast<ghost::internal::SubscriberMulticast>(subscriber);
+
+	sendDatagrams(42, 10, {3, 4, 7});
+
+	waitUntil([&] { return _receivedCount >= 7; });
+	ASSERT_TRUE(_receivedCount == 7);
+	ASSERT_TRUE(internalSubscriber->getLostCount() == 3);
+	ASSERT_TRUE(subscriber->isRunning());
+}
+
+TEST_F(ConnectionMulticastTests, test_SubscriberMulticast_stops_When_messagesAreLostAndPolicyIsStop)
+{
+	_config.setLossPolicy(ghost::ConnectionConfigurationMulticast::LossPolicy::STOP);
+	auto subscriber = startSubscriber(_config);
+
+	sendDatagrams(42, 3, {1});
+
+	waitUntil([&] { return !subscriber->isRunning(); });
+	ASSERT_FALSE(subscriber->isRunning());
+	ASSERT_TRUE(_receivedCount == 1);
+}
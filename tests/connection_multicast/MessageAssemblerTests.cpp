@@ -0,0 +1,175 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <google/protobuf/wrappers.pb.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "../../src/connection_multicast/Datagram.hpp"
+#include "../../src/connection_multicast/MessageAssembler.hpp"
+
+using namespace ghost::internal;
+
+/**
+ *	This test class groups the following test categories:
+ *	- Fragmentation of the messages into datagrams
+ *	- Reassembly of the fragments, in any order
+ *	- Detection of duplicated and lost messages
+ */
+class MessageAssemblerTests : public testing::Test
+{
+protected:
+	static const size_t DATAGRAM_SIZE = 100;
+
+	void SetUp() override
+	{
+		_delivered.clear();
+	}
+
+	void TearDown() override
+	{
+	}
+
+	/// Returns the datagrams of a message as they are sent by a publisher.
+	std::vector<std::string> makeDatagrams(DatagramBatch& batch, const std::string& message)
+	{
+		batch.clear();
+		EXPECT_TRUE(batch.add(message));
+
+		std::vector<std::string> datagrams;
+		for (size_t i = 0; i < batch.size(); ++i)
+		{
+			std::string datagram(reinterpret_cast<const char*>(batch.getHeader(i)), DatagramHeader::SIZE);
+			datagram.append(reinterpret_cast<const char*>(batch.getPayload(i)), batch.getPayloadSize(i));
+			datagrams.push_back(datagram);
+		}
+		return datagrams;
+	}
+
+	bool receive(const std::string& datagram)
+	{
+		return _assembler.onDatagram(reinterpret_cast<const uint8_t*>(datagram.data()), datagram.size(),
+					     [this](const uint8_t* data, size_t size) {
+						     _delivered.emplace_back(reinterpret_cast<const char*>(data), size);
+					     });
+	}
+
+	MessageAssembler _assembler;
+	std::vector<std::string> _delivered;
+};
+
+const size_t MessageAssemblerTests::DATAGRAM_SIZE;
+
+TEST_F(MessageAssemblerTests, test_DatagramBatch_fragmentsMessage_When_largerThanDatagram)
+{
+	DatagramBatch batch(1, DATAGRAM_SIZE);
+	auto datagrams = makeDatagrams(batch, std::string(250, 'g'));
+
+	size_t payloadSize = DATAGRAM_SIZE - DatagramHeader::SIZE;
+	ASSERT_TRUE(datagrams.size() == (250 + payloadSize - 1) / payloadSize);
+	for (const auto& datagram : datagrams) ASSERT_TRUE(datagram.size() <= DATAGRAM_SIZE);
+
+	// an empty message is sent as well
+	ASSERT_TRUE(makeDatagrams(batch, "").size() == 1);
+	ASSERT_TRUE(batch.getNextSequence() == 2);
+}
+
+TEST_F(MessageAssemblerTests, test_MessageAssembler_deliversMessage_When_allFragmentsAreReceivedInAnyOrder)
+{
+	DatagramBatch batch(1, DATAGRAM_SIZE);
+	std::string message;
+	for (int i = 0; i < 300; ++i) message.push_back(static_cast<char>(i));
+	auto datagrams = makeDatagrams(batch, message);
+	ASSERT_TRUE(datagrams.size() > 2);
+
+	for (size_t i = datagrams.size(); i > 1; --i)
+	{
+		ASSERT_TRUE(receive(datagrams[i - 1]));
+		ASSERT_TRUE(_delivered.empty());
+	}
+	ASSERT_TRUE(receive(datagrams[1])); // duplicated fragment
+	ASSERT_TRUE(receive(datagrams[0]));
+
+	ASSERT_TRUE(_delivered.size() == 1);
+	ASSERT_TRUE(_delivered[0] == message);
+	ASSERT_TRUE(_assembler.getLostCount() == 0);
+}
+
+TEST_F(MessageAssemblerTests, test_MessageAssembler_ignoresMessage_When_duplicatedOrLate)
+{
+	DatagramBatch batch(1, DATAGRAM_SIZE);
+	auto first = makeDatagrams(batch, "first");
+	auto second = makeDatagrams(batch, "second");
+
+	ASSERT_TRUE(receive(first[0]));
+	ASSERT_TRUE(receive(second[0]));
+	ASSERT_TRUE(receive(second[0]));
+	ASSERT_TRUE(receive(first[0]));
+
+	ASSERT_TRUE(_delivered.size() == 2);
+	ASSERT_TRUE(_delivered[1] == "second");
+}
+
+TEST_F(MessageAssemblerTests, test_MessageAssembler_countsLostMessages_When_sequenceHasGaps)
+{
+	DatagramBatch batch(1, DATAGRAM_SIZE);
+	std::vector<std::vector<std::string>> messages;
+	for (int i = 0; i < 5; ++i) messages.push_back(makeDatagrams(batch, std::to_string(i)));
+	auto fragmented = makeDatagrams(batch, std::string(200, 'g'));
+	auto last = makeDatagrams(batch, "last");
+
+	ASSERT_TRUE(receive(messages[0][0]));
+	ASSERT_TRUE(receive(messages[3][0]));
+	ASSERT_TRUE(_assembler.getLostCount() == 2);
+
+	// a message partially received is lost once a later one is delivered
+	ASSERT_TRUE(receive(fragmented[0]));
+	ASSERT_TRUE(receive(last[0]));
+	ASSERT_TRUE(_assembler.getLostCount() == 4);
+	ASSERT_TRUE(receive(fragmented[1]));
+	ASSERT_TRUE(receive(fragmented[2]));
+
+	ASSERT_TRUE(_delivered.size() == 3);
+	ASSERT_TRUE(_delivered[2] == "last");
+}
+
+TEST_F(MessageAssemblerTests, test_MessageAssembler_doesNotCountLoss_When_publisherIsNewOrRestarted)
+{
+	DatagramBatch batch(1, DATAGRAM_SIZE);
+	for (int i = 0; i < 10; ++i) makeDatagrams(batch, "skipped");
+	auto joined = makeDatagrams(batch, "joined");
+
+	DatagramBatch restarted(2, DATAGRAM_SIZE);
+	auto first = makeDatagrams(restarted, "restarted");
+
+	ASSERT_TRUE(receive(joined[0]));
+	ASSERT_TRUE(receive(first[0]));
+	ASSERT_TRUE(_delivered.size() == 2);
+	ASSERT_TRUE(_assembler.getLostCount() == 0);
+}
+
+TEST_F(MessageAssemblerTests, test_MessageAssembler_refusesDatagram_When_invalid)
+{
+	ASSERT_FALSE(receive("not a datagram of a publisher"));
+
+	DatagramBatch batch(1, DATAGRAM_SIZE);
+	auto datagrams = makeDatagrams(batch, "message");
+	ASSERT_FALSE(receive(datagrams[0] + "trailing bytes"));
+	ASSERT_TRUE(_delivered.empty());
+}
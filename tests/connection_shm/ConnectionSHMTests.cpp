@@ -0,0 +1,202 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <google/protobuf/wrappers.pb.h>
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <ghost/connection/ConnectionManager.hpp>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <ghost/connection/Writer.hpp>
+#include <ghost/connection_shm/ConnectionConfigurationSHM.hpp>
+#include <ghost/connection_shm/ConnectionSHM.hpp>
+#include <thread>
+
+#include "../../src/connection_shm/ShmClientSlot.hpp"
+#include "../../src/connection_shm/SubscriberSHM.hpp"
+#include "../connection/TransportConnectionTests.hpp"
+
+using namespace ghost;
+
+using ::testing::_;
+
+/**
+ *	The shared memory connections run the tests shared by the transports, see TransportConnectionTests.hpp.
+ */
+struct SHMTransport
+{
+	using Configuration = ghost::ConnectionConfigurationSHM;
+
+	static const int PORT = 5680;
+
+	static void initialize(const std::shared_ptr<ghost::ConnectionManager>& connectionManager,
+			       const ghost::NetworkConnectionConfiguration& configuration)
+	{
+		ghost::ConnectionSHM::initialize(connectionManager, configuration);
+	}
+
+	static bool hasSubscribers(const std::shared_ptr<ghost::Publisher>& publisher, size_t count)
+	{
+		return true; // the subscribers read the segment without registering to the publisher
+	}
+};
+
+INSTANTIATE_TYPED_TEST_CASE_P(SHM, TransportConnectionTests, SHMTransport);
+
+/**
+ *	This test class groups the following test categories, the other ones are shared by the transports:
+ *	- Detection of peers that died
+ *	- Messages lost by the slow subscribers
+ */
+class ConnectionSHMTests : public TransportConnectionTests<SHMTransport>
+{
+protected:
+	// Starts a process that does nothing until killProcess() is called, to impersonate a peer that dies.
+	int32_t startProcess()
+	{
+		int fds[2];
+		if (pipe(fds) != 0) return 0;
+
+		pid_t pid = fork();
+		if (pid == 0)
+		{
+			char c;
+			::close(fds[1]);
+			while (::read(fds[0], &c, 1) < 0)
+				;
+			_exit(0);
+		}
+		::close(fds[0]);
+		_processPipe = fds[1];
+		return pid;
+	}
+
+	void killProcess(int32_t pid)
+	{
+		::close(_processPipe);
+		waitpid(pid, nullptr, 0);
+	}
+
+	int _processPipe;
+};
+
+TEST_F(ConnectionSHMTests, test_SubscriberSHM_stops_When_publisherDies)
+{
+	createPublisher(_config);
+	startSubscribers(_config, 1);
+
+	// the segment now seems to be owned by another process, which dies
+	auto segment = internal::SharedMemorySegment::open(internal::SharedMemorySegment::getName(_config));
+	ASSERT_TRUE(segment);
+	int32_t pid = startProcess();
+	ASSERT_TRUE(pid > 0);
+	segment->getHeader()->ownerPid = pid;
+	killProcess(pid);
+
+	waitUntil([&] { return !_subscribers[0]->isRunning(); });
+	ASSERT_FALSE(_subscribers[0]->isRunning());
+}
+
+TEST_F(ConnectionSHMTests, test_PublisherSHM_replacesSegment_When_previousOwnerDied)
+{
+	auto segment = internal::SharedMemorySegment::create(internal::SharedMemorySegment::getName(_config), 4096);
+	ASSERT_TRUE(segment);
+	int32_t pid = startProcess();
+	ASSERT_TRUE(pid > 0);
+	segment->getHeader()->ownerPid = pid;
+	segment->getHeader()->magic = internal::SharedMemorySegment::MAGIC;
+
+	auto publisher = _connectionManager->createPublisher(_config);
+	ASSERT_FALSE(publisher->start()); // the owner is still running
+
+	killProcess(pid);
+	ASSERT_TRUE(publisher->start());
+}
+
+TEST_F(ConnectionSHMTests, test_ServerSHM_stopsRemoteClient_When_clientDies)
+{
+	createServer(_config);
+	startServer();
+
+	std::shared_ptr<ghost::Client> remote;
+	EXPECT_CALL(*_clientHandlerMock, configureClient(_)).Times(1);
+	EXPECT_CALL(*_clientHandlerMock, handle(_, _))
+	    .Times(1)
+	    .WillRepeatedly(testing::DoAll(testing::SetArgReferee<1>(true), testing::SaveArg<0>(&remote),
+					   testing::Return(true)));
+
+	startClients(_config, 1, false);
+	waitUntil([&] { return remote != nullptr; });
+	ASSERT_TRUE(remote);
+
+	// the slot now seems to be used by another process, which dies
+	auto segment = std::shared_ptr<internal::SharedMemorySegment>(
+	    internal::SharedMemorySegment::open(internal::SharedMemorySegment::getName(_config)));
+	ASSERT_TRUE(segment);
+	internal::ShmClientSlot slot(segment, 0);
+	ASSERT_TRUE(slot.getState() == internal::ShmClientSlot::CONNECTED);
+	int32_t pid = startProcess();
+	ASSERT_TRUE(pid > 0);
+	slot.getHeader()->clientPid = pid;
+	killProcess(pid);
+
+	waitUntil([&] { return !remote->isRunning(); });
+	ASSERT_FALSE(remote->isRunning());
+	ASSERT_FALSE(_clients[0]->isRunning());
+}
+
+TEST_F(ConnectionSHMTests, test_SubscriberSHM_losesMessages_When_tooSlow)
+{
+	_config.setRingSize(4096);
+	createPublisher(_config);
+
+	std::atomic_bool blocked(true);
+	std::atomic_int lastValue(-1);
+	// the handler is called by the thread reading the ring: the messages queue up in the ring
+	auto subscriber = _connectionManager->createSubscriber(_config);
+	auto handler = subscriber->addMessageHandler();
+	handler->addHandler<google::protobuf::Int32Value>([&](const google::protobuf::Int32Value& message) {
+		while (blocked) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		lastValue = message.value();
+	});
+	ASSERT_TRUE(subscriber->start());
+
+	// the publisher does not wait for the subscriber
+	auto writer = _publisher->getWriter<google::protobuf::Int32Value>();
+	google::protobuf::Int32Value message;
+	for (int i = 0; i < 1000; ++i)
+	{
+		message.set_value(i);
+		ASSERT_TRUE(writer->write(message));
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	blocked = false;
+
+	// the subscriber skips the messages that were overwritten
+	auto internalSubscriber = std::dynamic_pointer_cast<ghost::internal::SubscriberSHM>(subscriber);
+	waitUntil([&] { return internalSubscriber->getLostCount() > 0; });
+	ASSERT_TRUE(internalSubscriber->getLostCount() > 0);
+	ASSERT_TRUE(lastValue < 999);
+
+	// and continues with the next ones
+	message.set_value(1000);
+	ASSERT_TRUE(writer->write(message));
+	waitUntil([&] { return lastValue == 1000; });
+	ASSERT_TRUE(lastValue == 1000);
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <google/protobuf/wrappers.pb.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../../src/connection_shm/ShmRing.hpp"
+
+using namespace ghost::internal;
+
+/**
+ *	This test class groups the following test categories:
+ *	- ShmRing write and read operations, including the wrap around the end of the data
+ *	- Loss of messages by slow consumers and flow control with a single consumer
+ */
+
+class ShmRingTests : public testing::Test
+{
+protected:
+	static const size_t RING_CAPACITY = 1024;
+
+	void SetUp() override
+	{
+		// the ring normally lives in shared memory, any zero-filled memory works for the tests
+		_memory.assign(ShmRing::getSize(RING_CAPACITY) / sizeof(uint64_t) + 1, 0);
+		ShmRing::initialize(_memory.data(), RING_CAPACITY);
+	}
+
+	void TearDown() override
+	{
+	}
+
+	static google::protobuf::Any makeMessage(int value)
+	{
+		google::protobuf::Int32Value message;
+		message.set_value(value);
+		google::protobuf::Any any;
+		any.PackFrom(message);
+		return any;
+	}
+
+	static int getValue(const google::protobuf::Any& any)
+	{
+		google::protobuf::Int32Value message;
+		any.UnpackTo(&message);
+		return message.value();
+	}
+
+	std::vector<uint64_t> _memory;
+};
+
+TEST_F(ShmRingTests, test_ShmRing_readsMessagesInOrder_When_dataWrapsAround)
+{
+	ShmRing ring(_memory.data());
+	ShmRingReader reader(ring, true);
+
+	google::protobuf::Any message;
+	ASSERT_TRUE(reader.read(message) == ShmRingReader::Result::EMPTY);
+
+	// many times the capacity of the ring
+	for (int i = 0; i < 1000; ++i)
+	{
+		ASSERT_TRUE(ring.write(makeMessage(i)));
+		ASSERT_TRUE(reader.read(message) == ShmRingReader::Result::MESSAGE);
+		ASSERT_TRUE(getValue(message) == i);
+	}
+	ASSERT_TRUE(reader.read(message) == ShmRingReader::Result::EMPTY);
+	ASSERT_TRUE(reader.getLostCount() == 0);
+}
+
+TEST_F(ShmRingTests, test_ShmRing_refusesMessage_When_messageIsTooLarge)
+{
+	ShmRing ring(_memory.data());
+
+	google::protobuf::StringValue large;
+	large.set_value(std::string(RING_CAPACITY, 'a'));
+	google::protobuf::Any message;
+	message.PackFrom(large);
+
+	ASSERT_FALSE(ring.write(message));
+}
+
+TEST_F(ShmRingTests, test_ShmRingReader_readsOnlyNewMessages_When_severalConsumers)
+{
+	ShmRing ring(_memory.data());
+	ASSERT_TRUE(ring.write(makeMessage(1)));
+
+	ShmRingReader reader(ring, false);
+	google::protobuf::Any message;
+	ASSERT_TRUE(reader.read(message) == ShmRingReader::Result::EMPTY);
+
+	ASSERT_TRUE(ring.write(makeMessage(2)));
+	ASSERT_TRUE(reader.read(message) == ShmRingReader::Result::MESSAGE);
+	ASSERT_TRUE(getValue(message) == 2);
+}
+
+TEST_F(ShmRingTests, test_ShmRingReader_losesMessages_When_messagesWereOverwritten)
+{
+	ShmRing ring(_memory.data());
+	ShmRingReader reader(ring, false);
+
+	// the writer does not wait for the reader
+	for (int i = 0; i < 1000; ++i) ASSERT_TRUE(ring.write(makeMessage(i)));
+
+	google::protobuf::Any message;
+	ASSERT_TRUE(reader.read(message) == ShmRingReader::Result::LOST);
+	ASSERT_TRUE(reader.getLostCount() == 1);
+	ASSERT_TRUE(reader.read(message) == ShmRingReader::Result::EMPTY);
+
+	// the reader continues with the next messages
+	ASSERT_TRUE(ring.write(makeMessage(1000)));
+	ASSERT_TRUE(reader.read(message) == ShmRingReader::Result::MESSAGE);
+	ASSERT_TRUE(getValue(message) == 1000);
+}
+
+TEST_F(ShmRingTests, test_ShmRing_waitsForConsumer_When_ringIsFull)
+{
+	ShmRing ring(_memory.data());
+	ShmRingReader reader(ring, true);
+
+	std::atomic_bool waiting(true);
+	auto canWait = [&] { return waiting.load(); };
+
+	std::thread producer([&] {
+		for (int i = 0; i < 1000; ++i) ring.write(makeMessage(i), canWait);
+	});
+
+	// the single consumer receives every message
+	google::protobuf::Any message;
+	int expected = 0;
+	while (expected < 1000)
+	{
+		auto result = reader.read(message);
+		ASSERT_TRUE(result != ShmRingReader::Result::LOST);
+		if (result == ShmRingReader::Result::EMPTY)
+		{
+			reader.wait(std::chrono::milliseconds(10));
+			continue;
+		}
+		ASSERT_TRUE(getValue(message) == expected);
+		++expected;
+	}
+	producer.join();
+	ASSERT_TRUE(reader.getLostCount() == 0);
+}
+
+TEST_F(ShmRingTests, test_ShmRing_stopsWaiting_When_waitingIsNotAllowedAnymore)
+{
+	ShmRing ring(_memory.data());
+	ShmRingReader reader(ring, true);
+
+	int written = 0;
+	while (ring.write(makeMessage(written), [] { return false; })) ++written;
+
+	// the ring is full and nobody reads it
+	ASSERT_TRUE(written > 0);
+	ASSERT_FALSE(ring.write(makeMessage(written), [] { return false; }));
+	ring.close();
+	ASSERT_TRUE(reader.isClosed());
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <google/protobuf/wrappers.pb.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <ghost/connection/ConnectionManager.hpp>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <ghost/connection/Writer.hpp>
+#include <ghost/connection_tcp/ConnectionConfigurationTCP.hpp>
+#include <ghost/connection_tcp/ConnectionTCP.hpp>
+
+#include "../../src/connection_tcp/PublisherTCP.hpp"
+#include "../connection/TransportConnectionTests.hpp"
+
+using namespace ghost;
+
+using ::testing::_;
+
+/**
+ *	The TCP connections run the tests shared by the transports, see TransportConnectionTests.hpp.
+ */
+struct TCPTransport
+{
+	using Configuration = ghost::ConnectionConfigurationTCP;
+
+	static const int PORT = 5690;
+
+	static void initialize(const std::shared_ptr<ghost::ConnectionManager>& connectionManager,
+			       const ghost::NetworkConnectionConfiguration& configuration)
+	{
+		ghost::ConnectionTCP::initialize(connectionManager, configuration);
+	}
+
+	static bool hasSubscribers(const std::shared_ptr<ghost::Publisher>& publisher, size_t count)
+	{
+		auto internalPublisher = std::dynamic_pointer_cast<ghost::internal::PublisherTCP>(publisher);
+		return internalPublisher && internalPublisher->countSubscribers() == count;
+	}
+};
+
+INSTANTIATE_TYPED_TEST_CASE_P(TCP, TransportConnectionTests, TCPTransport);
+
+/**
+ *	This test class groups the following test categories, the other ones are shared by the transports:
+ *	- Exchange of large and numerous messages
+ *	- Connections over Unix domain sockets
+ */
+class ConnectionTCPTests : public TransportConnectionTests<TCPTransport>
+{
+protected:
+	static const std::string TEST_SOCKET_PATH;
+};
+
+const std::string ConnectionTCPTests::TEST_SOCKET_PATH = "/tmp/ghost_connection_tcp_tests.sock";
+
+TEST_F(ConnectionTCPTests, test_ClientTCP_receivesMessagesInOrder_When_manyMessagesAreWritten)
+{
+	createServer(_config);
+	startServer();
+
+	const int count = 10000;
+	std::atomic_int received(0);
+	std::atomic_bool ordered(true);
+	EXPECT_CALL(*_clientHandlerMock, configureClient(_))
+	    .Times(1)
+	    .WillRepeatedly([&](const std::shared_ptr<ghost::Client>& client) {
+		    auto handler = client->addMessageHandler();
+		    handler->addHandler<google::protobuf::Int32Value>([&](const google::protobuf::Int32Value& message) {
+			    if (message.value() != received) ordered = false;
+			    received++;
+		    });
+	    });
+	EXPECT_CALL(*_clientHandlerMock, handle(_, _))
+	    .Times(1)
+	    .WillRepeatedly(testing::DoAll(testing::SetArgReferee<1>(true), testing::Return(true)));
+
+	startClients(_config, 1, false);
+	auto writer = _clients[0]->getWriter<google::protobuf::Int32Value>();
+	google::protobuf::Int32Value message;
+	for (int i = 0; i < count; ++i)
+	{
+		message.set_value(i);
+		ASSERT_TRUE(writer->write(message));
+	}
+
+	waitUntil([&] { return received == count; });
+	ASSERT_TRUE(received == count);
+	ASSERT_TRUE(ordered);
+}
+
+TEST_F(ConnectionTCPTests, test_ClientTCP_receivesMessages_When_messagesAreLargerThanSocketBuffers)
+{
+	createServer(_config);
+	startServer();
+
+	const size_t size = 8 * 1024 * 1024;
+	EXPECT_CALL(*_clientHandlerMock, configureClient(_)).Times(1);
+	EXPECT_CALL(*_clientHandlerMock, handle(_, _))
+	    .Times(1)
+	    .WillRepeatedly([&](std::shared_ptr<ghost::Client> client, bool& keepClientAlive) {
+		    google::protobuf::BytesValue message;
+		    message.set_value(std::string(size, 'g'));
+		    client->getWriter<google::protobuf::BytesValue>()->write(message);
+		    client->getWriter<google::protobuf::BytesValue>()->write(message);
+		    keepClientAlive = true;
+		    return true;
+	    });
+
+	startClients(_config, 1, false);
+	auto reader = _clients[0]->getReader<google::protobuf::BytesValue>();
+	std::vector<google::protobuf::BytesValue> messages;
+	while (messages.size() < 2 && reader->readBatch(messages, 2 - messages.size(), std::chrono::seconds(5)))
+		;
+	ASSERT_TRUE(messages.size() == 2);
+	ASSERT_TRUE(messages[0].value().size() == size);
+	ASSERT_TRUE(messages[1].value() == std::string(size, 'g'));
+}
+
+TEST_F(ConnectionTCPTests, test_ClientTCP_connects_When_unixSocketPathIsSet)
+{
+	ghost::ConnectionConfigurationTCP config;
+	config.setUnixSocketPath(TEST_SOCKET_PATH);
+	config.setServerPortNumber(TCPTransport::PORT); // the minimum configuration of the factory contains the port
+
+	createServer(config);
+	startServer();
+
+	EXPECT_CALL(*_clientHandlerMock, configureClient(_)).Times(1);
+	EXPECT_CALL(*_clientHandlerMock, handle(_, _))
+	    .Times(1)
+	    .WillRepeatedly([&](std::shared_ptr<ghost::Client> client, bool& keepClientAlive) {
+		    google::protobuf::DoubleValue message;
+		    message.set_value(42.0);
+		    client->getWriter<google::protobuf::DoubleValue>()->write(message);
+		    keepClientAlive = true;
+		    return true;
+	    });
+
+	startClients(config, 1, false);
+	auto reader = _clients[0]->getReader<google::protobuf::DoubleValue>();
+	std::vector<google::protobuf::DoubleValue> messages;
+	bool readResult = reader->readBatch(messages, 1, std::chrono::seconds(1));
+	ASSERT_TRUE(readResult);
+	ASSERT_TRUE(messages.size() == 1);
+	ASSERT_TRUE(messages[0].value() == 42.0);
+
+	// the socket file is removed when the server stops
+	ASSERT_TRUE(_server->stop());
+	ASSERT_TRUE(::access(TEST_SOCKET_PATH.c_str(), F_OK) != 0);
+}
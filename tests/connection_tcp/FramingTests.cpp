@@ -0,0 +1,141 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <google/protobuf/wrappers.pb.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "../../src/connection_tcp/Framing.hpp"
+
+using namespace ghost::internal;
+
+/**
+ *	This test class groups the following test categories:
+ *	- Varint encoding of the frame sizes
+ *	- Decoding of streams containing complete, split and invalid frames
+ */
+class FramingTests : public testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		_decoded.clear();
+	}
+
+	void TearDown() override
+	{
+	}
+
+	static google::protobuf::Any makeMessage(int value)
+	{
+		google::protobuf::Int32Value message;
+		message.set_value(value);
+		google::protobuf::Any any;
+		any.PackFrom(message);
+		return any;
+	}
+
+	bool feed(FrameDecoder& decoder, const std::string& data)
+	{
+		auto consumer = [this](const uint8_t* payload, size_t size) {
+			google::protobuf::Any any;
+			google::protobuf::Int32Value message;
+			if (any.ParseFromArray(payload, static_cast<int>(size)) && any.UnpackTo(&message))
+				_decoded.push_back(message.value());
+			else
+				_decoded.push_back(-1);
+		};
+		return decoder.feed(reinterpret_cast<const uint8_t*>(data.data()), data.size(), consumer);
+	}
+
+	std::vector<int> _decoded;
+};
+
+TEST_F(FramingTests, test_Framing_decodesVarint_When_encoded)
+{
+	uint8_t buffer[Framing::MAXIMUM_HEADER_SIZE];
+	for (uint64_t value : {0ULL, 1ULL, 127ULL, 128ULL, 300ULL, 16384ULL, 0xFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL})
+	{
+		size_t size = Framing::encodeVarint(value, buffer);
+		uint64_t decoded = 0;
+		ASSERT_TRUE(Framing::decodeVarint(buffer, size, decoded) == static_cast<int>(size));
+		ASSERT_TRUE(decoded == value);
+		// one byte less is incomplete
+		ASSERT_TRUE(Framing::decodeVarint(buffer, size - 1, decoded) == 0);
+	}
+}
+
+TEST_F(FramingTests, test_Framing_refusesVarint_When_tooLong)
+{
+	std::vector<uint8_t> buffer(Framing::MAXIMUM_HEADER_SIZE + 1, 0x80);
+	uint64_t decoded;
+	ASSERT_TRUE(Framing::decodeVarint(buffer.data(), buffer.size(), decoded) == -1);
+}
+
+TEST_F(FramingTests, test_FrameDecoder_decodesAllFrames_When_dataContainsCompleteFrames)
+{
+	std::string data;
+	for (int i = 0; i < 10; ++i) data += *Framing::encode(makeMessage(i));
+
+	FrameDecoder decoder;
+	ASSERT_TRUE(feed(decoder, data));
+	ASSERT_TRUE(_decoded.size() == 10);
+	for (int i = 0; i < 10; ++i) ASSERT_TRUE(_decoded[i] == i);
+	ASSERT_TRUE(decoder.getBufferedSize() == 0);
+}
+
+TEST_F(FramingTests, test_FrameDecoder_decodesFrames_When_dataIsSplit)
+{
+	std::string data;
+	for (int i = 0; i < 10; ++i) data += *Framing::encode(makeMessage(i * 1000));
+
+	// the frames arrive one byte at a time
+	FrameDecoder decoder;
+	for (char c : data) ASSERT_TRUE(feed(decoder, std::string(1, c)));
+
+	ASSERT_TRUE(_decoded.size() == 10);
+	for (int i = 0; i < 10; ++i) ASSERT_TRUE(_decoded[i] == i * 1000);
+	ASSERT_TRUE(decoder.getBufferedSize() == 0);
+}
+
+TEST_F(FramingTests, test_FrameDecoder_keepsIncompleteFrame_When_restIsMissing)
+{
+	std::string first = *Framing::encode(makeMessage(1));
+	std::string second = *Framing::encode(makeMessage(2));
+	std::string data = first + second.substr(0, second.size() - 1);
+
+	FrameDecoder decoder;
+	ASSERT_TRUE(feed(decoder, data));
+	ASSERT_TRUE(_decoded.size() == 1);
+	ASSERT_TRUE(decoder.getBufferedSize() == second.size() - 1);
+
+	ASSERT_TRUE(feed(decoder, second.substr(second.size() - 1)));
+	ASSERT_TRUE(_decoded.size() == 2);
+	ASSERT_TRUE(_decoded[1] == 2);
+}
+
+TEST_F(FramingTests, test_FrameDecoder_fails_When_frameIsTooLarge)
+{
+	uint8_t header[Framing::MAXIMUM_HEADER_SIZE];
+	size_t size = Framing::encodeVarint(1025, header);
+
+	FrameDecoder decoder(1024);
+	ASSERT_FALSE(feed(decoder, std::string(reinterpret_cast<char*>(header), size)));
+	ASSERT_TRUE(_decoded.empty());
+}
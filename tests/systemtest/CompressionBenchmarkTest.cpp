@@ -0,0 +1,171 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CompressionBenchmarkTest.hpp"
+
+#include <google/protobuf/wrappers.pb.h>
+#include <sys/resource.h>
+
+#include <atomic>
+#include <chrono>
+#include <ghost/connection/Writer.hpp>
+#include <ghost/connection_grpc/ConnectionGRPC.hpp>
+#include <thread>
+
+const std::string CompressionBenchmarkTest::TEST_NAME = "CompressionBenchmark";
+const size_t CompressionBenchmarkTest::MESSAGES_PER_RUN = 20000;
+
+namespace
+{
+/// Returns the CPU time consumed by all the threads of the process, in microseconds.
+double getProcessCPUMicroseconds()
+{
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e6 + usage.ru_utime.tv_usec +
+	       usage.ru_stime.tv_usec;
+}
+
+/// Creates a payload that compresses like structured text would, rather than a single repeated byte.
+std::string createPayload(size_t size)
+{
+	static const std::string words[] = {"ghost ", "module ", "connection ", "publisher ", "subscriber ",
+					    "message ", "42 ", "3.14159 ", "timestamp ", "value "};
+	std::string payload;
+	payload.reserve(size);
+	for (size_t i = 0; payload.size() < size; ++i) payload += words[(i * 7 + i / 3) % 10];
+	payload.resize(size);
+	return payload;
+}
+} // namespace
+
+CompressionBenchmarkTest::CompressionBenchmarkTest(const std::shared_ptr<ghost::Logger>& logger) : Systemtest(logger)
+{
+}
+
+bool CompressionBenchmarkTest::setUp()
+{
+	_connectionManager = ghost::ConnectionManager::create();
+	ghost::ConnectionGRPC::initialize(_connectionManager);
+	_results.clear();
+	return true;
+}
+
+void CompressionBenchmarkTest::tearDown()
+{
+	_connectionManager.reset();
+}
+
+bool CompressionBenchmarkTest::run()
+{
+	using Compression = ghost::ConnectionConfigurationGRPC::Compression;
+
+	bool result = true;
+	for (size_t payloadSize : {1024, 16 * 1024, 64 * 1024})
+	{
+		result = result && runBenchmark("none", Compression::NONE, payloadSize);
+		result = result && runBenchmark("deflate", Compression::DEFLATE, payloadSize);
+		result = result && runBenchmark("gzip", Compression::GZIP, payloadSize);
+	}
+
+	return result;
+}
+
+bool CompressionBenchmarkTest::runBenchmark(const std::string& compressionName,
+					    ghost::ConnectionConfigurationGRPC::Compression compression,
+					    size_t payloadSize)
+{
+	ghost::ConnectionConfigurationGRPC configuration("127.0.0.1", 17110);
+	configuration.setCompression(compression);
+	configuration.setCompressionThreshold(0); // every message is compressed
+
+	auto publisher = _connectionManager->createPublisher(configuration);
+	auto subscriber = _connectionManager->createSubscriber(configuration);
+	require(publisher && subscriber);
+	if (!publisher || !subscriber) return false;
+
+	std::atomic<size_t> received(0);
+	auto messageHandler = subscriber->addMessageHandler();
+	messageHandler->addHandler<google::protobuf::BytesValue>(
+	    [&received](const google::protobuf::BytesValue& message) { received++; });
+
+	bool startResult = publisher->start() && subscriber->start();
+	require(startResult);
+
+	auto writer = publisher->getWriter<google::protobuf::BytesValue>();
+	google::protobuf::BytesValue message;
+	message.set_value(createPayload(payloadSize));
+
+	// the subscription may be established asynchronously: probe until a message goes through
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (startResult && received == 0 && std::chrono::steady_clock::now() < deadline)
+	{
+		writer->write(message);
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	startResult = startResult && received > 0;
+	require(startResult);
+
+	Result result{compressionName, payloadSize, 0.0, 0.0, 0.0};
+	bool success = startResult;
+	if (success)
+	{
+		// the CPU time includes the compression by the publisher and the decompression by the subscriber
+		size_t target = received + MESSAGES_PER_RUN;
+		double cpuStart = getProcessCPUMicroseconds();
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < MESSAGES_PER_RUN; ++i) writer->write(message);
+
+		deadline = start + std::chrono::seconds(60);
+		while (received < target && getState() == State::EXECUTING &&
+		       std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		success = received >= target;
+
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		result.messagesPerSecond = MESSAGES_PER_RUN / seconds;
+		result.megabytesPerSecond = result.messagesPerSecond * payloadSize / (1024.0 * 1024.0);
+		result.cpuMicrosecondsPerMessage = (getProcessCPUMicroseconds() - cpuStart) / MESSAGES_PER_RUN;
+	}
+
+	subscriber->stop();
+	publisher->stop();
+
+	require(success);
+	if (!success) return false;
+
+	_results.push_back(result);
+	printResult(result);
+	return true;
+}
+
+void CompressionBenchmarkTest::onPrintSummary() const
+{
+	for (const auto& result : _results) printResult(result);
+}
+
+void CompressionBenchmarkTest::printResult(const Result& result) const
+{
+	GHOST_INFO(_logger) << result.compression << ", " << result.payloadSize
+			    << " bytes payload: " << (size_t)result.messagesPerSecond << " messages/s, "
+			    << (size_t)result.megabytesPerSecond << " MB/s, " << result.cpuMicrosecondsPerMessage
+			    << " us CPU time per message";
+}
+
+std::string CompressionBenchmarkTest::getName() const
+{
+	return TEST_NAME;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_TESTS_COMPRESSIONBENCHMARKTEST_HPP
+#define GHOST_TESTS_COMPRESSIONBENCHMARKTEST_HPP
+
+#include <ghost/connection/ConnectionManager.hpp>
+#include <ghost/connection_grpc/ConnectionConfigurationGRPC.hpp>
+#include <string>
+#include <vector>
+
+#include "Systemtest.hpp"
+
+/**
+ *	Compares the publisher/subscriber throughput and the CPU time per message of gRPC
+ *	connections on the loopback interface for each compression algorithm, with text-like
+ *	payloads between 1 and 64 kilobytes.
+ */
+class CompressionBenchmarkTest : public Systemtest
+{
+public:
+	CompressionBenchmarkTest(const std::shared_ptr<ghost::Logger>& logger);
+
+	std::string getName() const override;
+
+private:
+	bool setUp() override;
+	void tearDown() override;
+	bool run() override;
+	void onPrintSummary() const override;
+
+	static const std::string TEST_NAME;
+	static const size_t MESSAGES_PER_RUN;
+
+	struct Result
+	{
+		std::string compression;
+		size_t payloadSize;
+		double messagesPerSecond;
+		double megabytesPerSecond;
+		double cpuMicrosecondsPerMessage;
+	};
+
+	bool runBenchmark(const std::string& compressionName,
+			  ghost::ConnectionConfigurationGRPC::Compression compression, size_t payloadSize);
+	void printResult(const Result& result) const;
+
+	std::shared_ptr<ghost::ConnectionManager> _connectionManager;
+	std::vector<Result> _results;
+};
+
+#endif // GHOST_TESTS_COMPRESSIONBENCHMARKTEST_HPP
@@ -19,6 +19,8 @@
 #include <thread>
 
 const std::string ConnectionStressTest::TEST_NAME = "ConnectionStress";
+const std::string ConnectionStressTest::SOCKET_PATH = "/tmp/ghost_connection_stress_test.sock";
+const std::chrono::seconds ConnectionStressTest::UNLIMITED_RUN_DURATION = std::chrono::seconds(10);
 
 ConnectionStressTest::ConnectionStressTest(const std::shared_ptr<ghost::Logger>& logger)
     : Systemtest(logger), _messageSentIndex(0)
@@ -26,17 +28,47 @@ ConnectionStressTest::ConnectionStressTest(const std::shared_ptr<ghost::Logger>&
 }
 
 bool ConnectionStressTest::setUp()
+{
+	std::string endpoint = "both";
+	if (getParameter().commandLine.hasParameter("endpoint"))
+		endpoint = getParameter().commandLine.getParameter<std::string>("endpoint");
+
+	// set up the configurations to use for the static pubsub
+	_endpoints.clear();
+	if (endpoint == "tcp" || endpoint == "both")
+	{
+		ghost::ConnectionConfigurationGRPC configuration;
+		configuration.setServerPortNumber(17000);
+		_endpoints.push_back(Endpoint{"TCP", configuration, 0, 0, std::chrono::steady_clock::duration::zero()});
+	}
+	if (endpoint == "unix" || endpoint == "both")
+	{
+		auto configuration = ghost::ConnectionConfigurationGRPC::createForUnixSocket(SOCKET_PATH);
+		_endpoints.push_back(
+		    Endpoint{"Unix socket", configuration, 0, 0, std::chrono::steady_clock::duration::zero()});
+	}
+
+	require(!_endpoints.empty());
+	if (_endpoints.empty()) return false;
+
+	for (auto& endpoint : _endpoints) endpoint.configuration.setOperationBlocking(false);
+
+	return true;
+}
+
+void ConnectionStressTest::tearDown()
+{
+	stopConnections();
+	_endpoints.clear();
+}
+
+bool ConnectionStressTest::startConnections(const ghost::ConnectionConfigurationGRPC& configuration)
 {
 	_connectionManager = ghost::ConnectionManager::create();
 	ghost::ConnectionGRPC::initialize(_connectionManager);
 	_messageSentIndex = 0;
 	_messageReceivedIndex.clear();
 
-	// set up the configuration to use for the static pubsub
-	ghost::ConnectionConfigurationGRPC configuration;
-	configuration.setServerPortNumber(17000);
-	configuration.setOperationBlocking(false);
-
 	// create a publisher to send test messages
 	auto publisher = _connectionManager->createPublisher(configuration);
 	require(publisher.operator bool());
@@ -73,7 +105,7 @@ bool ConnectionStressTest::setUp()
 	return publisherStartResult && subscriberStartResult;
 }
 
-void ConnectionStressTest::tearDown()
+void ConnectionStressTest::stopConnections()
 {
 	_publisherWriter.reset();
 	_connectionManager.reset();
@@ -83,10 +115,39 @@ void ConnectionStressTest::tearDown()
 
 bool ConnectionStressTest::run()
 {
+	// without a test duration, the endpoints take turns until the test is stopped
+	auto runDuration = UNLIMITED_RUN_DURATION;
+	if (getParameter().duration.count() != 0) runDuration = getParameter().duration / (long long)_endpoints.size();
+
+	bool result = true;
+	do
+	{
+		for (auto& endpoint : _endpoints)
+		{
+			if (getState() != State::EXECUTING || !checkTestDuration()) break;
+
+			result = runEndpoint(endpoint, std::chrono::steady_clock::now() + runDuration) && result;
+		}
+	} while (result && getParameter().duration.count() == 0 && getState() == State::EXECUTING);
+
+	return result;
+}
+
+bool ConnectionStressTest::runEndpoint(Endpoint& endpoint, std::chrono::steady_clock::time_point end)
+{
+	GHOST_INFO(_logger) << "Running over the endpoint: " << endpoint.name;
+	bool startResult = startConnections(endpoint.configuration);
+	if (!startResult)
+	{
+		stopConnections();
+		return false;
+	}
+
 	auto state = getState();
-	auto nextLog = std::chrono::steady_clock::now();
+	auto start = std::chrono::steady_clock::now();
+	auto nextLog = start;
 
-	while (state == State::EXECUTING && checkTestDuration())
+	while (state == State::EXECUTING && checkTestDuration() && std::chrono::steady_clock::now() < end)
 	{
 		if (_messageSentIndex % 100'000 != 0 || _messageSentIndex == _messageReceivedIndex[0])
 		{
@@ -117,13 +178,24 @@ bool ConnectionStressTest::run()
 		state = getState();
 	}
 
+	endpoint.duration += std::chrono::steady_clock::now() - start;
+	endpoint.messagesSent += _messageSentIndex;
+	endpoint.messagesReceived += _messageReceivedIndex[0];
+	stopConnections();
+
 	return true;
 }
 
 void ConnectionStressTest::onPrintSummary() const
 {
-	GHOST_INFO(_logger) << "Sent " << _messageSentIndex << " and received " << _messageReceivedIndex[0]
-			    << " messages.";
+	for (const auto& endpoint : _endpoints)
+	{
+		double seconds = std::chrono::duration<double>(endpoint.duration).count();
+		size_t messagesPerSecond = seconds > 0 ? endpoint.messagesReceived / seconds : 0;
+		GHOST_INFO(_logger) << endpoint.name << ": sent " << endpoint.messagesSent << " and received "
+				    << endpoint.messagesReceived << " messages (" << messagesPerSecond
+				    << " messages/s).";
+	}
 }
 
 bool ConnectionStressTest::messageHandler(const google::protobuf::StringValue& message, size_t subscriberId)
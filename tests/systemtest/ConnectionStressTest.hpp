@@ -24,8 +24,16 @@
 #include <ghost/connection/Writer.hpp>
 #include <ghost/connection_grpc/ConnectionGRPC.hpp>
 
+#include <string>
+#include <vector>
+
 #include "Systemtest.hpp"
 
+/**
+ *	Sends messages as fast as possible from a gRPC publisher to a subscriber. The test runs over
+ *	TCP and over a Unix domain socket, one after the other, and compares the results. The command
+ *	line parameter "endpoint" ("tcp", "unix" or "both", the default) selects the endpoints.
+ */
 class ConnectionStressTest : public Systemtest
 {
 public:
@@ -40,9 +48,26 @@ private:
 	void onPrintSummary() const override;
 
 	static const std::string TEST_NAME;
+	static const std::string SOCKET_PATH;
+	/// Duration of the runs over each endpoint when the test duration is not limited.
+	static const std::chrono::seconds UNLIMITED_RUN_DURATION;
 
+	struct Endpoint
+	{
+		std::string name;
+		ghost::ConnectionConfigurationGRPC configuration;
+		long long messagesSent;
+		long long messagesReceived;
+		std::chrono::steady_clock::duration duration;
+	};
+
+	bool startConnections(const ghost::ConnectionConfigurationGRPC& configuration);
+	void stopConnections();
+	bool runEndpoint(Endpoint& endpoint, std::chrono::steady_clock::time_point end);
 	bool messageHandler(const google::protobuf::StringValue& message, size_t subscriberId);
 
+	std::vector<Endpoint> _endpoints;
+
 	std::shared_ptr<ghost::ConnectionManager> _connectionManager;
 
 	std::shared_ptr<ghost::Writer<google::protobuf::StringValue>> _publisherWriter;
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueueBenchmarkTest.hpp"
+
+#include <google/protobuf/wrappers.pb.h>
+
+#include <atomic>
+#include <thread>
+
+#include "../../src/connection/WriterSink.hpp"
+
+const std::string QueueBenchmarkTest::TEST_NAME = "QueueBenchmark";
+const size_t QueueBenchmarkTest::MESSAGES_PER_RUN = 1'000'000;
+
+QueueBenchmarkTest::QueueBenchmarkTest(const std::shared_ptr<ghost::Logger>& logger) : Systemtest(logger)
+{
+}
+
+bool QueueBenchmarkTest::run()
+{
+	_results.clear();
+
+	bool result = true;
+	for (size_t producers : {1, 2, 4, 8})
+	{
+		result = result &&
+			 runBenchmark(ghost::ConnectionConfiguration::QueueType::BLOCKING_QUEUE, "BlockingQueue", producers);
+		// the writer sinks use the MPSC ring buffer when the SPSC one is configured: it is not measured
+		result = result && runBenchmark(ghost::ConnectionConfiguration::QueueType::MPSC_RING_BUFFER,
+						"MPSCRingBuffer", producers);
+	}
+
+	return result;
+}
+
+bool QueueBenchmarkTest::runBenchmark(ghost::ConnectionConfiguration::QueueType type, const std::string& backend,
+				      size_t producers)
+{
+	ghost::ConnectionConfiguration configuration;
+	configuration.setQueueType(type);
+	ghost::internal::WriterSink sink(configuration);
+
+	google::protobuf::StringValue value;
+	value.set_value("queue benchmark message");
+	google::protobuf::Any message;
+	message.PackFrom(value);
+
+	size_t messagesPerProducer = MESSAGES_PER_RUN / producers;
+	size_t expected = messagesPerProducer * producers;
+
+	auto start = std::chrono::steady_clock::now();
+
+	std::atomic<size_t> finishedProducers(0);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < producers; ++i)
+	{
+		threads.emplace_back([&]() {
+			for (size_t j = 0; j < messagesPerProducer; ++j)
+			{
+				if (!sink.push(message, false)) break;
+			}
+			finishedProducers++;
+		});
+	}
+
+	size_t received = 0;
+	google::protobuf::Any output;
+	while (received < expected && getState() == State::EXECUTING)
+	{
+		if (sink.get(output, std::chrono::milliseconds(100)))
+		{
+			sink.pop();
+			received++;
+		}
+	}
+
+	auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+	// if the test was stopped, frees the producers waiting for space in a ring buffer
+	sink.drain();
+	while (finishedProducers < producers) sink.pop();
+	for (auto& thread : threads) thread.join();
+
+	if (getState() != State::EXECUTING) return false;
+
+	double messagesPerSecond = expected / duration.count();
+	_results.push_back({backend, producers, messagesPerSecond});
+	GHOST_INFO(_logger) << backend << " with " << producers << " producer(s): " << (size_t)messagesPerSecond
+			    << " messages/s";
+	return true;
+}
+
+void QueueBenchmarkTest::onPrintSummary() const
+{
+	for (const auto& result : _results)
+	{
+		GHOST_INFO(_logger) << result.backend << " with " << result.producers
+				    << " producer(s): " << (size_t)result.messagesPerSecond << " messages/s";
+	}
+}
+
+std::string QueueBenchmarkTest::getName() const
+{
+	return TEST_NAME;
+}
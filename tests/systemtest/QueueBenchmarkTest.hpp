@@ -0,0 +1,57 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_TESTS_QUEUEBENCHMARKTEST_HPP
+#define GHOST_TESTS_QUEUEBENCHMARKTEST_HPP
+
+#include <ghost/connection/ConnectionConfiguration.hpp>
+#include <string>
+#include <vector>
+
+#include "Systemtest.hpp"
+
+/**
+ *	Measures the throughput of the writer sink for each queue backend, with
+ *	1, 2, 4 and 8 producing threads and one consuming thread.
+ */
+class QueueBenchmarkTest : public Systemtest
+{
+public:
+	QueueBenchmarkTest(const std::shared_ptr<ghost::Logger>& logger);
+
+	std::string getName() const override;
+
+private:
+	bool run() override;
+	void onPrintSummary() const override;
+
+	static const std::string TEST_NAME;
+	static const size_t MESSAGES_PER_RUN;
+
+	struct Result
+	{
+		std::string backend;
+		size_t producers;
+		double messagesPerSecond;
+	};
+
+	bool runBenchmark(ghost::ConnectionConfiguration::QueueType type, const std::string& backend,
+			  size_t producers);
+
+	std::vector<Result> _results;
+};
+
+#endif // GHOST_TESTS_QUEUEBENCHMARKTEST_HPP
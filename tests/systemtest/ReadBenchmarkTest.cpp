@@ -0,0 +1,102 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ReadBenchmarkTest.hpp"
+
+#include <google/protobuf/wrappers.pb.h>
+
+#include <algorithm>
+#include <chrono>
+#include <ghost/connection/Reader.hpp>
+
+#include "../../src/connection/ReaderSink.hpp"
+
+const std::string ReadBenchmarkTest::TEST_NAME = "ReadBenchmark";
+const size_t ReadBenchmarkTest::BYTES_PER_RUN = 256 * 1024 * 1024;
+
+ReadBenchmarkTest::ReadBenchmarkTest(const std::shared_ptr<ghost::Logger>& logger) : Systemtest(logger)
+{
+}
+
+bool ReadBenchmarkTest::run()
+{
+	_results.clear();
+
+	bool result = true;
+	for (size_t payloadSize : {100, 1024, 10 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024})
+	{
+		result = result && runBenchmark(payloadSize);
+	}
+
+	return result;
+}
+
+bool ReadBenchmarkTest::runBenchmark(size_t payloadSize)
+{
+	size_t messages = std::max<size_t>(BYTES_PER_RUN / payloadSize, 1000);
+	// fills the sink in chunks to bound the memory used by the benchmark
+	size_t chunkSize = std::min<size_t>(messages, std::max<size_t>(1, 64 * 1024 * 1024 / payloadSize));
+
+	google::protobuf::BytesValue value;
+	value.set_value(std::string(payloadSize, 'x'));
+	google::protobuf::Any message;
+	message.PackFrom(value);
+
+	auto sink = std::make_shared<ghost::internal::ReaderSink>();
+	auto reader = ghost::Reader<google::protobuf::BytesValue>::create(sink, false);
+
+	google::protobuf::BytesValue output;
+	std::chrono::steady_clock::duration duration(0);
+	size_t read = 0;
+	while (read < messages)
+	{
+		if (getState() != State::EXECUTING) return false;
+
+		size_t count = std::min(chunkSize, messages - read);
+		for (size_t i = 0; i < count; ++i) sink->put(google::protobuf::Any(message));
+
+		// only the read path is measured
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (!reader->read(output) || output.value().size() != payloadSize) return false;
+		}
+		duration += std::chrono::steady_clock::now() - start;
+		read += count;
+	}
+
+	double seconds = std::chrono::duration<double>(duration).count();
+	double messagesPerSecond = messages / seconds;
+	double megabytesPerSecond = messagesPerSecond * payloadSize / (1024.0 * 1024.0);
+	_results.push_back({payloadSize, messagesPerSecond, megabytesPerSecond});
+	GHOST_INFO(_logger) << payloadSize << " bytes payload: " << (size_t)messagesPerSecond << " messages/s, "
+			    << (size_t)megabytesPerSecond << " MB/s";
+	return true;
+}
+
+void ReadBenchmarkTest::onPrintSummary() const
+{
+	for (const auto& result : _results)
+	{
+		GHOST_INFO(_logger) << result.payloadSize << " bytes payload: " << (size_t)result.messagesPerSecond
+				    << " messages/s, " << (size_t)result.megabytesPerSecond << " MB/s";
+	}
+}
+
+std::string ReadBenchmarkTest::getName() const
+{
+	return TEST_NAME;
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GHOST_TESTS_READBENCHMARKTEST_HPP
+#define GHOST_TESTS_READBENCHMARKTEST_HPP
+
+#include <string>
+#include <vector>
+
+#include "Systemtest.hpp"
+
+/**
+ *	Measures the throughput of the read path, from the reader sink to a typed
+ *	reader, for payloads between 100 bytes and 1 megabyte.
+ */
+class ReadBenchmarkTest : public Systemtest
+{
+public:
+	ReadBenchmarkTest(const std::shared_ptr<ghost::Logger>& logger);
+
+	std::string getName() const override;
+
+private:
+	bool run() override;
+	void onPrintSummary() const override;
+
+	static const std::string TEST_NAME;
+	static const size_t BYTES_PER_RUN;
+
+	struct Result
+	{
+		size_t payloadSize;
+		double messagesPerSecond;
+		double megabytesPerSecond;
+	};
+
+	bool runBenchmark(size_t payloadSize);
+
+	std::vector<Result> _results;
+};
+
+#endif // GHOST_TESTS_READBENCHMARKTEST_HPP
@@ -18,10 +18,14 @@
 
 #include <gtest/gtest.h>
 
+#include "CompressionBenchmarkTest.hpp"
 #include "ConnectionMonkeyTest.hpp"
 #include "ConnectionStressTest.hpp"
+#include "QueueBenchmarkTest.hpp"
+#include "ReadBenchmarkTest.hpp"
 #include "StopSystemtestCommand.hpp"
 #include "SystemtestCommand.hpp"
+#include "TransportBenchmarkTest.hpp"
 
 bool SystemtestExecutorModule::initialize(const ghost::Module& module)
 {
@@ -33,6 +37,10 @@ bool SystemtestExecutorModule::initialize(const ghost::Module& module)
 
 	registerSystemtest(std::make_shared<ConnectionStressTest>(_logger));
 	registerSystemtest(std::make_shared<ConnectionMonkeyTest>(_logger));
+	registerSystemtest(std::make_shared<QueueBenchmarkTest>(_logger));
+	registerSystemtest(std::make_shared<ReadBenchmarkTest>(_logger));
+	registerSystemtest(std::make_shared<TransportBenchmarkTest>(_logger));
+	registerSystemtest(std::make_shared<CompressionBenchmarkTest>(_logger));
 
 	GHOST_INFO(_logger) << "Systemtest executor initialized";
 	return true;
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "TransportBenchmarkTest.hpp"
+
+#include <google/protobuf/wrappers.pb.h>
+
+#include <atomic>
+#include <chrono>
+#include <ghost/connection/Writer.hpp>
+#include <ghost/connection_grpc/ConnectionGRPC.hpp>
+#include <ghost/connection_inproc/ConnectionInproc.hpp>
+#include <thread>
+
+const std::string TransportBenchmarkTest::TEST_NAME = "TransportBenchmark";
+const size_t TransportBenchmarkTest::MESSAGES_PER_RUN = 100000;
+const size_t TransportBenchmarkTest::LATENCY_SAMPLES = 1000;
+
+TransportBenchmarkTest::TransportBenchmarkTest(const std::shared_ptr<ghost::Logger>& logger) : Systemtest(logger)
+{
+}
+
+bool TransportBenchmarkTest::setUp()
+{
+	_connectionManager = ghost::ConnectionManager::create();
+	ghost::ConnectionGRPC::initialize(_connectionManager);
+	ghost::ConnectionInproc::initialize(_connectionManager);
+	_results.clear();
+	return true;
+}
+
+void TransportBenchmarkTest::tearDown()
+{
+	_connectionManager.reset();
+}
+
+bool TransportBenchmarkTest::run()
+{
+	ghost::ConnectionConfigurationGRPC grpcConfiguration("127.0.0.1", 17100);
+	ghost::ConnectionConfigurationInproc inprocConfiguration("127.0.0.1", 17100);
+
+	bool result = true;
+	for (size_t payloadSize : {100, 1024, 64 * 1024})
+	{
+		result = result && runBenchmark("gRPC", grpcConfiguration, payloadSize);
+		result = result && runBenchmark("inproc", inprocConfiguration, payloadSize);
+	}
+
+	return result;
+}
+
+bool TransportBenchmarkTest::runBenchmark(const std::string& transport,
+					  const ghost::NetworkConnectionConfiguration& configuration,
+					  size_t payloadSize)
+{
+	auto publisher = _connectionManager->createPublisher(configuration);
+	auto subscriber = _connectionManager->createSubscriber(configuration);
+	require(publisher && subscriber);
+	if (!publisher || !subscriber) return false;
+
+	std::atomic<size_t> received(0);
+	auto messageHandler = subscriber->addMessageHandler();
+	messageHandler->addHandler<google::protobuf::BytesValue>(
+	    [&received](const google::protobuf::BytesValue& message) { received++; });
+
+	bool startResult = publisher->start() && subscriber->start();
+	require(startResult);
+
+	auto writer = publisher->getWriter<google::protobuf::BytesValue>();
+	google::protobuf::BytesValue message;
+	message.set_value(std::string(payloadSize, 'x'));
+
+	// waits until "count" messages were received, or gives up after a while
+	auto waitForMessages = [&](size_t count) {
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+		while (received < count && getState() == State::EXECUTING &&
+		       std::chrono::steady_clock::now() < deadline)
+			std::this_thread::yield();
+		return received >= count;
+	};
+
+	// the subscription may be established asynchronously: probe until a message goes through
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (startResult && received == 0 && std::chrono::steady_clock::now() < deadline)
+	{
+		writer->write(message);
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	startResult = startResult && received > 0;
+	require(startResult);
+
+	Result result{transport, payloadSize, 0.0, 0.0, 0.0};
+	bool success = startResult;
+	if (success)
+	{
+		// throughput: messages are written as fast as possible
+		size_t target = received + MESSAGES_PER_RUN;
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < MESSAGES_PER_RUN; ++i) writer->write(message);
+		success = waitForMessages(target);
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		result.messagesPerSecond = MESSAGES_PER_RUN / seconds;
+		result.megabytesPerSecond = result.messagesPerSecond * payloadSize / (1024.0 * 1024.0);
+	}
+
+	if (success)
+	{
+		// latency: one message at a time, from the write call to the subscriber's handler
+		std::chrono::steady_clock::duration total(0);
+		for (size_t i = 0; i < LATENCY_SAMPLES && success; ++i)
+		{
+			size_t target = received + 1;
+			auto start = std::chrono::steady_clock::now();
+			writer->write(message);
+			success = waitForMessages(target);
+			total += std::chrono::steady_clock::now() - start;
+		}
+		result.averageLatencyMicroseconds =
+		    std::chrono::duration<double, std::micro>(total).count() / LATENCY_SAMPLES;
+	}
+
+	subscriber->stop();
+	publisher->stop();
+
+	require(success);
+	if (!success) return false;
+
+	_results.push_back(result);
+	printResult(result);
+	return true;
+}
+
+void TransportBenchmarkTest::onPrintSummary() const
+{
+	for (const auto& result : _results) printResult(result);
+}
+
+void TransportBenchmarkTest::printResult(const Result& result) const
+{
+	GHOST_INFO(_logger) << result.transport << ", " << result.payloadSize
+			    << " bytes payload: " << (size_t)result.messagesPerSecond << " messages/s, "
+			    << (size_t)result.megabytesPerSecond << " MB/s, " << result.averageLatencyMicroseconds
+			    << " us average latency";
+}
+
+std::string TransportBenchmarkTest::getName() const
+{
+	return TEST_NAME;
+}
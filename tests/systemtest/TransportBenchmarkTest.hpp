@@ -0,0 +1,67 @@
+/*
+ * Copyright 2019 Mathieu Nassar
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GHOST_TESTS_TRANSPORTBENCHMARKTEST_HPP
+#define GHOST_TESTS_TRANSPORTBENCHMARKTEST_HPP
+
+#include <ghost/connection/ConnectionManager.hpp>
+#include <ghost/connection/NetworkConnectionConfiguration.hpp>
+#include <string>
+#include <vector>
+
+#include "Systemtest.hpp"
+
+/**
+ *	Compares the publisher/subscriber throughput and the one-way latency of the in-process
+ *	connections with the ones of gRPC connections on the loopback interface, for payloads
+ *	between 100 bytes and 64 kilobytes.
+ */
+class TransportBenchmarkTest : public Systemtest
+{
+public:
+	TransportBenchmarkTest(const std::shared_ptr<ghost::Logger>& logger);
+
+	std::string getName() const override;
+
+private:
+	bool setUp() override;
+	void tearDown() override;
+	bool run() override;
+	void onPrintSummary() const override;
+
+	static const std::string TEST_NAME;
+	static const size_t MESSAGES_PER_RUN;
+	static const size_t LATENCY_SAMPLES;
+
+	struct Result
+	{
+		std::string transport;
+		size_t payloadSize;
+		double messagesPerSecond;
+		double megabytesPerSecond;
+		double averageLatencyMicroseconds;
+	};
+
+	bool runBenchmark(const std::string& transport, const ghost::NetworkConnectionConfiguration& configuration,
+			  size_t payloadSize);
+	void printResult(const Result& result) const;
+
+	std::shared_ptr<ghost::ConnectionManager> _connectionManager;
+	std::vector<Result> _results;
+};
+
+#endif // GHOST_TESTS_TRANSPORTBENCHMARKTEST_HPP